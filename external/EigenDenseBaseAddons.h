@@ -5,9 +5,7 @@ void save(Archive & ar, const unsigned int version) const {
   const Index rows = derived().rows(), cols = derived().cols();
   ar & rows;
   ar & cols;
-  for (Index j = 0; j < cols; ++j )
-    for (Index i = 0; i < rows; ++i )
-      ar & derived().coeff(i, j);
+  ar & boost::serialization::make_array(derived().data(), derived().size());
 }
 
 template<class Archive>
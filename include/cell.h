@@ -1,9 +1,11 @@
 #ifndef MPM_CELL_H_
 #define MPM_CELL_H_
 
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -27,6 +29,30 @@ class Cell {
   //! Define a vector of size dimension
   using VectorDim = Eigen::Matrix<double, Tdim, 1>;
 
+  //! Define a vector of 6 dof (Voigt stress / strain)
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  //! Maximum number of nodes per cell
+  static constexpr unsigned max_nnodes = 27;
+
+  //! Nodal scalars of a cell (1 x nnodes, no heap allocation)
+  using NodalScalars =
+      Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, max_nnodes>;
+
+  //! Nodal vectors of a cell (Tdim x nnodes, no heap allocation)
+  using NodalVectors = Eigen::Matrix<double, Tdim, Eigen::Dynamic,
+                                    Eigen::ColMajor, Tdim, max_nnodes>;
+
+  //! Particle contributions to the nodes of a cell
+  struct NodalContributions {
+    //! Mass
+    NodalScalars mass;
+    //! Momentum
+    NodalVectors momentum;
+    //! Body and internal forces
+    NodalVectors force;
+  };
+
   //! Constructor with id and coordinates
   Cell(Index id, unsigned nnodes);
 
@@ -58,14 +84,28 @@ class Cell {
   };
 
   //! Add node to cell
-  bool add_node(unsigned local_id, const std::shared_ptr<Node<Tdim>>& node);
+  bool add_node(unsigned local_id, Node<Tdim>* node);
+
+  //! Return node at a local id
+  //! \param[in] local_id Local id of the node in the cell
+  Node<Tdim>* node(unsigned local_id) const { return nodes_[local_id]; }
 
   //! Add neighbouring cell
-  bool add_neighbour(unsigned id, const std::shared_ptr<Cell<Tdim>>& neighbour);
+  bool add_neighbour(unsigned id, Cell<Tdim>* neighbour);
 
   //! Number of neighbours
   unsigned nneighbours() const { return neighbour_cells_.size(); }
 
+  //! Return neighbouring cells
+  const Handler<Cell<Tdim>>& neighbours() const { return neighbour_cells_; }
+
+  //! Assign colour
+  //! \param[in] colour Colour such that cells sharing a node differ
+  void assign_colour(unsigned colour) { colour_ = colour; }
+
+  //! Return colour
+  unsigned colour() const { return colour_; }
+
   //! Add particle id
   bool add_particle_id(Index id);
 
@@ -75,6 +115,65 @@ class Cell {
   //! Active cell (if a particle is present)
   bool status() const { return particles_.size(); }
 
+  //! Return particle ids in cell
+  std::vector<Index> particles() const { return particles_; }
+
+  //! Initialise cell properties once all nodes are added
+  bool initialise();
+
+  //! Return nodal coordinates (nnodes x Tdim)
+  Eigen::MatrixXd nodal_coordinates() const { return nodal_coordinates_; }
+
+  //! Compute local (unit cell) coordinates of a point
+  VectorDim transform_real_to_unit_cell(const VectorDim& point) const;
+
+  //! Check if a point is in the cell
+  bool point_in_cell(const VectorDim& point) const;
+
+  //! Evaluate shape functions at local coordinates
+  Eigen::VectorXd compute_shapefn(const VectorDim& xi) const;
+
+  //! Evaluate gradient of shape functions in real coordinates
+  Eigen::MatrixXd compute_grad_shapefn(const VectorDim& xi) const;
+
+  //! Compute contributions of the particles in the cell to its nodes
+  template <typename Tparticle>
+  NodalContributions compute_nodal_contributions(
+      const std::vector<Tparticle*>& particles, bool map_mass,
+      bool map_momentum, bool map_forces, const VectorDim& gravity) const;
+
+  //! Scatter nodal contributions to the nodes of the cell
+  void scatter_nodal_contributions(const NodalContributions& contributions,
+                                   bool lock);
+
+  //! Map mass and momentum of the particles in the cell to nodes
+  template <typename Tparticle>
+  void map_mass_momentum_to_nodes(const std::vector<Tparticle*>& particles);
+
+  //! Map momentum of the particles in the cell to nodes
+  template <typename Tparticle>
+  void map_momentum_to_nodes(const std::vector<Tparticle*>& particles);
+
+  //! Map body and internal forces of the particles in the cell to nodes
+  template <typename Tparticle>
+  void map_forces_to_nodes(const std::vector<Tparticle*>& particles,
+                           const VectorDim& gravity);
+
+  //! Map mass, momentum and forces of the particles in the cell to nodes
+  template <typename Tparticle>
+  void map_mass_momentum_forces_to_nodes(
+      const std::vector<Tparticle*>& particles, const VectorDim& gravity);
+
+  //! Update velocity and position of the particles in the cell
+  template <typename Tparticle>
+  void update_particles_velocity_position(
+      const std::vector<Tparticle*>& particles, double dt);
+
+  //! Compute strain of the particles in the cell
+  template <typename Tparticle>
+  void compute_particles_strain(const std::vector<Tparticle*>& particles,
+                                double dt);
+
  protected:
   //! cell id
   Index id_{std::numeric_limits<Index>::max()};
@@ -85,9 +184,32 @@ class Cell {
   //! particles ids in cell
   std::vector<Index> particles_;
 
+  //! Mutex to protect particle ids during concurrent relocation
+  std::mutex cell_mutex_;
+
+  //! Nodal coordinates (nnodes x Tdim)
+  Eigen::MatrixXd nodal_coordinates_;
+
+  //! Lower corner of the bounding box of the cell
+  VectorDim bbox_min_;
+
+  //! Upper corner of the bounding box of the cell
+  VectorDim bbox_max_;
+
+  //! Colour of the cell
+  unsigned colour_{0};
+
+ private:
+  //! Gather a nodal vector quantity of the nodes of the cell
+  template <typename Tgetter>
+  NodalVectors gather_nodal_vectors(Tgetter getter) const;
+
   //! Container of node pointers (local id, node pointer)
   Handler<Node<Tdim>> nodes_;
 
+  //! Nodes by local id, for loops over particles
+  std::vector<Node<Tdim>*> node_ptrs_;
+
   //! Container of cell neighbours
   Handler<Cell<Tdim>> neighbour_cells_;
 
@@ -12,6 +12,11 @@ mpm::Cell<Tdim>::Cell(Index id, unsigned nnodes) : id_{id}, nnodes_{nnodes} {
       throw std::runtime_error(
           "Specified number of nodes for a cell is too low");
     }
+    // Number of nodes should fit the fixed-size nodal blocks
+    if (nnodes > max_nnodes) {
+      throw std::runtime_error(
+          "Specified number of nodes for a cell is too high");
+    }
   } catch (std::exception& exception) {
     std::cerr << exception.what() << '\n';
     std::abort();
@@ -64,12 +69,12 @@ bool mpm::Cell<Tdim>::shapefn(
 
 //! Add a node pointer
 //! \param[in] local_id local id of the node
-//! \param[in] ptr A shared pointer
+//! \param[in] node_ptr A pointer to a node, owned by the mesh
 //! \retval insertion_status Return the successful addition of a node
 //! \tparam Tdim Dimension
 template <unsigned Tdim>
-bool mpm::Cell<Tdim>::add_node(
-    unsigned local_id, const std::shared_ptr<mpm::Node<Tdim>>& node_ptr) {
+bool mpm::Cell<Tdim>::add_node(unsigned local_id,
+                               mpm::Node<Tdim>* node_ptr) {
   bool insertion_status = false;
   try {
     // If number of node ptrs in a cell is less than the maximum number of nodes
@@ -78,6 +83,10 @@ bool mpm::Cell<Tdim>::add_node(
     if (nodes_.size() < this->nnodes_ &&
         (local_id >= 0 && local_id < this->nnodes_)) {
       insertion_status = nodes_.insert(local_id, node_ptr);
+      if (insertion_status) {
+        node_ptrs_.resize(this->nnodes_, nullptr);
+        node_ptrs_[local_id] = node_ptr;
+      }
     } else {
       throw std::runtime_error(
           "Number nodes in a cell exceeds the maximum allowed per cell");
@@ -90,12 +99,12 @@ bool mpm::Cell<Tdim>::add_node(
 
 //! Add a neighbour cell
 //! \param[in] local_id local id of the cell
-//! \param[in] ptr A shared pointer to cell
+//! \param[in] cell_ptr A pointer to a cell, owned by the mesh
 //! \retval insertion_status Return the successful addition of a node
 //! \tparam Tdim Dimension
 template <unsigned Tdim>
-bool mpm::Cell<Tdim>::add_neighbour(
-    unsigned local_id, const std::shared_ptr<mpm::Cell<Tdim>>& cell_ptr) {
+bool mpm::Cell<Tdim>::add_neighbour(unsigned local_id,
+                                    mpm::Cell<Tdim>* cell_ptr) {
   bool insertion_status = false;
   try {
     // If number of cell ptrs id is not the current cell id
@@ -117,6 +126,7 @@ bool mpm::Cell<Tdim>::add_neighbour(
 template <unsigned Tdim>
 bool mpm::Cell<Tdim>::add_particle_id(Index id) {
   bool status = false;
+  std::lock_guard<std::mutex> guard(cell_mutex_);
   // Check if it is found in the container
   auto itr = std::find(particles_.begin(), particles_.end(), id);
 
@@ -134,6 +144,334 @@ bool mpm::Cell<Tdim>::add_particle_id(Index id) {
 //! \tparam Tdim Dimension
 template <unsigned Tdim>
 void mpm::Cell<Tdim>::remove_particle_id(Index id) {
+  std::lock_guard<std::mutex> guard(cell_mutex_);
   particles_.erase(std::remove(particles_.begin(), particles_.end(), id),
                    particles_.end());
 }
+
+//! Initialise cell properties
+//! \details Caches nodal coordinates and the bounding box of the cell, which
+//! requires all nodes and the shape function to be assigned
+//! \retval status Return the successful initialisation of the cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Cell<Tdim>::initialise() {
+  bool status = false;
+  try {
+    if (nodes_.size() != this->nnodes_ || shapefn_ == nullptr) {
+      throw std::runtime_error(
+          "Cell is not initialised, nodes or shape function is missing");
+    }
+
+    nodal_coordinates_.resize(this->nnodes_, Tdim);
+    for (unsigned i = 0; i < this->nnodes_; ++i)
+      nodal_coordinates_.row(i) = node_ptrs_[i]->coordinates().transpose();
+
+    bbox_min_ = nodal_coordinates_.colwise().minCoeff().transpose();
+    bbox_max_ = nodal_coordinates_.colwise().maxCoeff().transpose();
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Compute local coordinates of a point using Newton-Raphson iterations of
+//! the isoparametric map x(xi) = X^T N(xi)
+//! \param[in] point Coordinates of a point
+//! \retval xi Local coordinates of the point
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+typename mpm::Cell<Tdim>::VectorDim
+    mpm::Cell<Tdim>::transform_real_to_unit_cell(const VectorDim& point) const {
+  // Maximum number of iterations and tolerance
+  const unsigned max_iterations = 10;
+  const double tolerance = 1.E-10;
+
+  // Start at the centre of the unit cell
+  VectorDim xi = VectorDim::Zero();
+  for (unsigned iter = 0; iter < max_iterations; ++iter) {
+    const Eigen::MatrixXd shapefn = shapefn_->shapefn(xi);
+    const Eigen::MatrixXd grad_shapefn = shapefn_->grad_shapefn(xi);
+
+    // Residual r = x(xi) - point
+    const VectorDim residual =
+        (nodal_coordinates_.transpose() * shapefn.topRows(this->nnodes_))
+            .col(0) -
+        point;
+    if (residual.norm() < tolerance) break;
+
+    // Jacobian dx/dxi
+    const Eigen::Matrix<double, Tdim, Tdim> jacobian =
+        nodal_coordinates_.transpose() * grad_shapefn.topRows(this->nnodes_);
+    xi -= jacobian.inverse() * residual;
+  }
+  return xi;
+}
+
+//! Check if a point is in the cell
+//! \param[in] point Coordinates of a point
+//! \retval status Return true if the point is inside the cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Cell<Tdim>::point_in_cell(const VectorDim& point) const {
+  const double tolerance = 1.E-12;
+
+  // Cheap rejection using the bounding box
+  for (unsigned i = 0; i < Tdim; ++i)
+    if (point(i) < bbox_min_(i) - tolerance ||
+        point(i) > bbox_max_(i) + tolerance)
+      return false;
+
+  // Local coordinates should lie in [-1, 1]
+  const VectorDim xi = this->transform_real_to_unit_cell(point);
+  for (unsigned i = 0; i < Tdim; ++i)
+    if (std::fabs(xi(i)) > 1. + 1.E-10) return false;
+  return true;
+}
+
+//! Evaluate shape functions at local coordinates
+//! \param[in] xi Local coordinates
+//! \retval shapefn Shape functions of the nodes of the cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+Eigen::VectorXd mpm::Cell<Tdim>::compute_shapefn(const VectorDim& xi) const {
+  return shapefn_->shapefn(xi).col(0).head(this->nnodes_);
+}
+
+//! Evaluate gradient of shape functions in real coordinates
+//! \details dN/dx = dN/dxi J^-1, where J = dx/dxi
+//! \param[in] xi Local coordinates
+//! \retval grad_shapefn Gradient of shape functions (nnodes x Tdim)
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+Eigen::MatrixXd mpm::Cell<Tdim>::compute_grad_shapefn(
+    const VectorDim& xi) const {
+  const Eigen::MatrixXd grad_shapefn =
+      shapefn_->grad_shapefn(xi).topRows(this->nnodes_);
+  const Eigen::Matrix<double, Tdim, Tdim> jacobian =
+      nodal_coordinates_.transpose() * grad_shapefn;
+  return grad_shapefn * jacobian.inverse();
+}
+
+//! Map mass and momentum of the particles in the cell to nodes
+//! \param[in] particles Particles in the cell
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+template <unsigned Tdim>
+template <typename Tparticle>
+void mpm::Cell<Tdim>::map_mass_momentum_to_nodes(
+    const std::vector<Tparticle*>& particles) {
+  this->scatter_nodal_contributions(
+      this->compute_nodal_contributions(particles, true, true, false,
+                                        VectorDim::Zero()),
+      true);
+}
+
+//! Map momentum of the particles in the cell to nodes
+//! \param[in] particles Particles in the cell
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+template <unsigned Tdim>
+template <typename Tparticle>
+void mpm::Cell<Tdim>::map_momentum_to_nodes(
+    const std::vector<Tparticle*>& particles) {
+  this->scatter_nodal_contributions(
+      this->compute_nodal_contributions(particles, false, true, false,
+                                        VectorDim::Zero()),
+      true);
+}
+
+//! Map body and internal forces of the particles in the cell to nodes
+//! \param[in] particles Particles in the cell
+//! \param[in] gravity Gravity acceleration
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+template <unsigned Tdim>
+template <typename Tparticle>
+void mpm::Cell<Tdim>::map_forces_to_nodes(
+    const std::vector<Tparticle*>& particles, const VectorDim& gravity) {
+  this->scatter_nodal_contributions(
+      this->compute_nodal_contributions(particles, false, false, true,
+                                        gravity),
+      true);
+}
+
+//! Map mass, momentum and forces of the particles in the cell to nodes
+//! \param[in] particles Particles in the cell
+//! \param[in] gravity Gravity acceleration
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+template <unsigned Tdim>
+template <typename Tparticle>
+void mpm::Cell<Tdim>::map_mass_momentum_forces_to_nodes(
+    const std::vector<Tparticle*>& particles, const VectorDim& gravity) {
+  this->scatter_nodal_contributions(
+      this->compute_nodal_contributions(particles, true, true, true, gravity),
+      true);
+}
+
+//! Compute contributions of the particles in the cell to its nodes
+//! \details The shape functions of each particle are read once and reused
+//! for every requested field. Contributions are summed in fixed-size nodal
+//! blocks, so each node is updated once per cell instead of once per
+//! particle. Particle quantities are converted to double, so contributions
+//! of particles of any scalar type are accumulated in double.
+//! \param[in] particles Particles in the cell
+//! \param[in] map_mass Map particle mass
+//! \param[in] map_momentum Map particle momentum
+//! \param[in] map_forces Map body and internal forces
+//! \param[in] gravity Gravity acceleration
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+//! \retval contributions Nodal mass, momentum and force
+template <unsigned Tdim>
+template <typename Tparticle>
+typename mpm::Cell<Tdim>::NodalContributions
+    mpm::Cell<Tdim>::compute_nodal_contributions(
+        const std::vector<Tparticle*>& particles, bool map_mass,
+        bool map_momentum, bool map_forces, const VectorDim& gravity) const {
+  const unsigned nnodes = this->nnodes_;
+  NodalContributions contributions;
+  NodalScalars& mass = contributions.mass;
+  NodalVectors& momentum = contributions.momentum;
+  NodalVectors& force = contributions.force;
+  mass.setZero(1, nnodes);
+  momentum.setZero(Tdim, nnodes);
+  force.setZero(Tdim, nnodes);
+
+  for (const auto& particle : particles) {
+    if (!particle->status()) continue;
+    const auto& shapefn = particle->shapefn().template cast<double>();
+    const double pmass = particle->mass();
+
+    if (map_mass) mass.noalias() += pmass * shapefn.transpose();
+
+    if (map_momentum)
+      momentum.noalias() +=
+          (pmass * particle->velocity().template cast<double>()) *
+          shapefn.transpose();
+
+    if (map_forces) {
+      // Body force
+      force.noalias() += (pmass * gravity) * shapefn.transpose();
+
+      // Internal force f = -V sigma dN^T
+      const auto& grad_shapefn =
+          particle->grad_shapefn().template cast<double>();
+      const Vector6d pstress = particle->stress().template cast<double>();
+      const double pvolume = particle->volume();
+      Eigen::Matrix<double, Tdim, Tdim> stress;
+      switch (Tdim) {
+        case 1:
+          stress(0, 0) = pstress(0);
+          break;
+        case 2:
+          stress(0, 0) = pstress(0);
+          stress(0, 1) = stress(1, 0) = pstress(3);
+          stress(1, 1) = pstress(1);
+          break;
+        case 3:
+          stress(0, 0) = pstress(0);
+          stress(1, 1) = pstress(1);
+          stress(2, 2) = pstress(2);
+          stress(0, 1) = stress(1, 0) = pstress(3);
+          stress(1, 2) = stress(2, 1) = pstress(4);
+          stress(0, 2) = stress(2, 0) = pstress(5);
+          break;
+      }
+      force.noalias() -=
+          (pvolume * stress) * grad_shapefn.transpose();
+    }
+  }
+
+  return contributions;
+}
+
+//! Scatter nodal contributions to the nodes of the cell
+//! \param[in] contributions Nodal mass, momentum and force
+//! \param[in] lock Lock nodes, false only if no other thread updates them
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Cell<Tdim>::scatter_nodal_contributions(
+    const NodalContributions& contributions, bool lock) {
+  for (unsigned i = 0; i < this->nnodes_; ++i)
+    node_ptrs_[i]->update_mass_momentum_force(contributions.mass(i),
+                                              contributions.momentum.col(i),
+                                              contributions.force.col(i), lock);
+}
+
+//! Gather a nodal vector quantity of the nodes of the cell
+//! \param[in] getter Callable returning the nodal vector of a node
+//! \retval vectors Nodal vectors (Tdim x nnodes)
+//! \tparam Tdim Dimension
+//! \tparam Tgetter Callable type
+template <unsigned Tdim>
+template <typename Tgetter>
+typename mpm::Cell<Tdim>::NodalVectors mpm::Cell<Tdim>::gather_nodal_vectors(
+    Tgetter getter) const {
+  NodalVectors vectors(Tdim, this->nnodes_);
+  for (unsigned i = 0; i < this->nnodes_; ++i)
+    vectors.col(i) = getter(node_ptrs_[i]).head(Tdim);
+  return vectors;
+}
+
+//! Update velocity and position of the particles in the cell
+//! \details Nodal velocities and accelerations are gathered once per cell
+//! \param[in] particles Particles in the cell
+//! \param[in] dt Time-step
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+template <unsigned Tdim>
+template <typename Tparticle>
+void mpm::Cell<Tdim>::update_particles_velocity_position(
+    const std::vector<Tparticle*>& particles, double dt) {
+  const NodalVectors velocity = this->gather_nodal_vectors(
+      [](const Node<Tdim>* node) -> const Eigen::VectorXd& {
+        return node->velocity();
+      });
+  const NodalVectors acceleration = this->gather_nodal_vectors(
+      [](const Node<Tdim>* node) -> const Eigen::VectorXd& {
+        return node->acceleration();
+      });
+
+  for (const auto& particle : particles) {
+    if (!particle->status()) continue;
+    const auto& shapefn = particle->shapefn().template cast<double>();
+    particle->compute_updated_velocity_position(acceleration * shapefn,
+                                                velocity * shapefn, dt);
+  }
+}
+
+//! Compute strain of the particles in the cell
+//! \details Nodal velocities are gathered once per cell
+//! \param[in] particles Particles in the cell
+//! \param[in] dt Time-step
+//! \tparam Tdim Dimension
+//! \tparam Tparticle Particle type
+template <unsigned Tdim>
+template <typename Tparticle>
+void mpm::Cell<Tdim>::compute_particles_strain(
+    const std::vector<Tparticle*>& particles, double dt) {
+  const NodalVectors velocity = this->gather_nodal_vectors(
+      [](const Node<Tdim>* node) -> const Eigen::VectorXd& {
+        return node->velocity();
+      });
+
+  for (const auto& particle : particles) {
+    if (!particle->status()) continue;
+    // Velocity gradient L_ij = dv_i / dx_j
+    const Eigen::Matrix<double, Tdim, Tdim> gradient =
+        velocity * particle->grad_shapefn().template cast<double>();
+
+    // Engineering strain rate in Voigt notation (xx, yy, zz, xy, yz, xz)
+    Vector6d strain_rate = Vector6d::Zero();
+    for (unsigned i = 0; i < Tdim; ++i) strain_rate(i) = gradient(i, i);
+    if (Tdim > 1) strain_rate(3) = gradient(0, 1) + gradient(1, 0);
+    if (Tdim > 2) {
+      strain_rate(4) = gradient(1, 2) + gradient(2, 1);
+      strain_rate(5) = gradient(0, 2) + gradient(2, 0);
+    }
+    particle->compute_strain(strain_rate, dt);
+  }
+}
@@ -23,11 +23,15 @@ class Container {
   Container<T>() = default;
 
   //! Add a pointer to an element
-  bool add(const std::shared_ptr<T>&);
+  bool add(const std::shared_ptr<T>&, bool check_duplicates = true);
 
   //! Remove an element pointer
   bool remove(const std::shared_ptr<T>&);
 
+  //! Remove all elements satisfying a predicate in a single pass
+  template <class Tunarypred>
+  std::size_t remove_if(Tunarypred pred);
+
   //! Return number of elements in the container
   std::size_t size() const { return elements_.size(); }
 
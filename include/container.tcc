@@ -1,14 +1,18 @@
 //! Add an element pointer
 //! \param[in] ptr A shared pointer
+//! \param[in] check_duplicates Search the container for the id (linear)
 //! \tparam T A class with a template argument Tdim
 template <class T>
-bool mpm::Container<T>::add(const std::shared_ptr<T>& ptr) {
+bool mpm::Container<T>::add(const std::shared_ptr<T>& ptr,
+                            bool check_duplicates) {
   bool insertion_status = false;
   // Check if it is found in the container
-  auto itr = std::find_if(this->cbegin(), this->cend(),
-                          [ptr](std::shared_ptr<T> const& element) {
-                            return element->id() == ptr->id();
-                          });
+  auto itr = this->cend();
+  if (check_duplicates)
+    itr = std::find_if(this->cbegin(), this->cend(),
+                       [&ptr](const std::shared_ptr<T>& element) {
+                         return element->id() == ptr->id();
+                       });
 
   if (itr == this->cend()) {
     elements_.push_back(ptr);
@@ -27,7 +31,7 @@ bool mpm::Container<T>::remove(const std::shared_ptr<T>& ptr) {
 
   // Check if it is found in the container
   auto itr = std::find_if(this->cbegin(), this->cend(),
-                          [ptr](std::shared_ptr<T> const& element) {
+                          [&ptr](const std::shared_ptr<T>& element) {
                             return element->id() == ptr->id();
                           });
 
@@ -37,7 +41,7 @@ bool mpm::Container<T>::remove(const std::shared_ptr<T>& ptr) {
     new_elements.reserve(elements_.size() - 1);
     auto it = std::copy_if(elements_.begin(), elements_.end(),
                            std::back_inserter(new_elements),
-                           [ptr](std::shared_ptr<T> const& element) {
+                           [&ptr](const std::shared_ptr<T>& element) {
                              return element->id() != ptr->id();
                            });
 
@@ -47,6 +51,23 @@ bool mpm::Container<T>::remove(const std::shared_ptr<T>& ptr) {
   return removal_status;
 }
 
+//! Remove all elements satisfying a predicate in a single pass
+//! \tparam T A class with a template argument Tdim
+//! \tparam Tunarypred A unary predicate on an element pointer
+//! \retval nremoved Number of elements removed
+template <class T>
+template <class Tunarypred>
+std::size_t mpm::Container<T>::remove_if(Tunarypred pred) {
+  tbb::concurrent_vector<std::shared_ptr<T>> new_elements;
+  new_elements.reserve(elements_.size());
+  for (const auto& element : elements_)
+    if (!pred(element)) new_elements.push_back(element);
+
+  const std::size_t nremoved = elements_.size() - new_elements.size();
+  if (nremoved > 0) elements_.swap(new_elements);
+  return nremoved;
+}
+
 //! Iterate over elements in the container
 //! \tparam T A class with a template argument Tdim
 //! \tparam Tunaryfn A unary function
@@ -1,17 +1,27 @@
 #ifndef _FACTORY_H_
 #define _FACTORY_H_
 
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 //! \brief Singleton factory implementation
 //! \tparam Tbaseclass Base class
 //! \tparam Targs variadic template arguments
 template <typename Tbaseclass, typename... Targs>
 class Factory {
+ private:
+  struct CreatorBase;
+
  public:
+  //! Handle to the factory function of a registered class
+  using Handle = std::shared_ptr<CreatorBase>;
+
   //! Get the single instance of the factory
   static Factory* instance() {
     static Factory factory;
@@ -34,6 +44,35 @@ class Factory {
     return registry.at(key)->create(std::forward<Targs>(args)...);
   }
 
+  //! Return the handle to the factory function of a registered class
+  //! \details The handle stays valid if the key is registered again
+  //! \param[in] key key to item in registry
+  //! \retval handle Handle to the factory function
+  Handle handle(const std::string& key) const { return registry.at(key); }
+
+  //! Create an instance of a registered class without a lookup
+  //! \param[in] handle Handle to the factory function
+  //! \param[in] args Variadic template arguments
+  //! \retval shared_ptr<Tbaseclass> Shared pointer to a base class
+  std::shared_ptr<Tbaseclass> create(const Handle& handle, Targs&&... args) {
+    return handle->create(std::forward<Targs>(args)...);
+  }
+
+  //! Create instances of a registered class in a single allocation
+  //! \details Instances are constructed with the same arguments and
+  //! appended to objects, which is reserved first. They share the storage,
+  //! which is freed with the last of them.
+  //! \param[in] handle Handle to the factory function
+  //! \param[in] n Number of instances
+  //! \param[in,out] objects Container the instances are appended to
+  //! \param[in] args Variadic template arguments
+  void create_n(const Handle& handle, std::size_t n,
+                std::vector<std::shared_ptr<Tbaseclass>>& objects,
+                const Targs&... args) {
+    objects.reserve(objects.size() + n);
+    handle->create_n(n, objects, args...);
+  }
+
   //! List registered elements
   //! \retval factory_items Return list of items in the registry
   std::vector<std::string> list() const {
@@ -49,18 +88,56 @@ class Factory {
 
   //! A base class creator struct
   struct CreatorBase {
+    //! Virtual destructor
+    virtual ~CreatorBase() = default;
     //! A virtual create function
     virtual std::shared_ptr<Tbaseclass> create(Targs&&...) = 0;
+    //! A virtual function creating instances in a single allocation
+    virtual void create_n(std::size_t n,
+                          std::vector<std::shared_ptr<Tbaseclass>>& objects,
+                          const Targs&...) = 0;
   };
 
   //! Creator class
   //! \tparam Tderivedclass Derived class
   template <typename Tderivedclass>
   struct Creator : public CreatorBase {
+    //! Storage of instances created together
+    struct Block {
+      //! Storage of an instance
+      using Storage = typename std::aligned_storage<
+          sizeof(Tderivedclass), alignof(Tderivedclass)>::type;
+      //! Allocate storage of n instances
+      explicit Block(std::size_t n) : storage(new Storage[n]) {}
+      //! Destroy the constructed instances
+      ~Block() {
+        for (std::size_t i = 0; i < size; ++i)
+          reinterpret_cast<Tderivedclass*>(&storage[i])->~Tderivedclass();
+      }
+      //! Storage of instances
+      std::unique_ptr<Storage[]> storage;
+      //! Number of constructed instances
+      std::size_t size{0};
+    };
+
     //! Create instance of object
     std::shared_ptr<Tbaseclass> create(Targs&&... args) override {
       return std::make_shared<Tderivedclass>(std::forward<Targs>(args)...);
     }
+
+    //! Create instances of object in a single allocation
+    void create_n(std::size_t n,
+                  std::vector<std::shared_ptr<Tbaseclass>>& objects,
+                  const Targs&... args) override {
+      if (n == 0) return;
+      const auto block = std::make_shared<Block>(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        auto object = new (&block->storage[i]) Tderivedclass(args...);
+        ++block->size;
+        // Instances share the ownership of the block
+        objects.emplace_back(block, static_cast<Tbaseclass*>(object));
+      }
+    }
   };
   // Register of factory functions
   std::map<std::string, std::shared_ptr<CreatorBase>> registry;
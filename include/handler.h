@@ -2,6 +2,7 @@
 #define MPM_HANDLER_H_
 
 #include <algorithm>
+#include <memory>
 #include <unordered_map>
 
 namespace mpm {
@@ -11,6 +12,8 @@ using Index = unsigned long long;
 
 // handler class
 //! \brief A class that offers a container and iterators
+//! \details The handler does not own its elements, which are owned by the
+//! containers of a mesh and must outlive the handler
 //! \tparam T A class with a template argument Tdim
 //! \tparam Tdim Dimension
 template <class T>
@@ -20,23 +23,25 @@ class Handler {
   Handler<T>() = default;
 
   //! Insert a pointer
-  bool insert(const std::shared_ptr<T>&);
+  bool insert(T*);
 
   //! Insert an id and a pointer
-  bool insert(Index, const std::shared_ptr<T>&);
+  bool insert(Index, T*);
 
   //! Return number of elements in the container
   std::size_t size() const { return elements_.size(); }
 
+  //! Return the pointer stored at a given id
+  //! \param[in] id Global/local index of the pointer
+  T* operator[](Index id) const { return elements_.at(id); }
+
   //! Return begin iterator of nodes
-  typename std::unordered_map<Index, std::shared_ptr<T>>::const_iterator begin()
-      const {
+  typename std::unordered_map<Index, T*>::const_iterator begin() const {
     return elements_.cbegin();
   }
 
   //! Return end iterator of nodes
-  typename std::unordered_map<Index, std::shared_ptr<T>>::const_iterator end()
-      const {
+  typename std::unordered_map<Index, T*>::const_iterator end() const {
     return elements_.cend();
   }
 
@@ -46,7 +51,7 @@ class Handler {
 
  private:
   // Unordered map of index and pointer
-  std::unordered_map<Index, std::shared_ptr<T>> elements_;
+  std::unordered_map<Index, T*> elements_;
 };  // Handler class
 
 #include "handler.tcc"
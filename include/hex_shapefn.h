@@ -14,23 +14,26 @@ namespace mpm {
 //! Hexahedron shape function class derived from ShapeFn class
 //! \brief Shape functions of a hexahedron element
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-class HexahedronShapeFn : public ShapeFn<Tdim> {
+//! \tparam Treal Scalar type of local coordinates and shape functions
+template <unsigned Tdim, typename Treal = double>
+class HexahedronShapeFn : public ShapeFn<Tdim, Treal> {
 
  public:
   //! Define a vector of size dimension
-  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+  using VectorDim = Eigen::Matrix<Treal, Tdim, 1>;
+
+  //! Define a matrix of shape functions or of their gradients
+  using Matrix = Eigen::Matrix<Treal, Eigen::Dynamic, Eigen::Dynamic>;
 
   //! constructor with number of shape functions
-  HexahedronShapeFn(unsigned nfunctions) : mpm::ShapeFn<Tdim>(nfunctions) {
+  HexahedronShapeFn(unsigned nfunctions)
+      : mpm::ShapeFn<Tdim, Treal>(nfunctions) {
     static_assert(Tdim == 3, "Invalid dimension for a hexahedron element");
     try {
       if (!(nfunctions == 8 || nfunctions == 20)) {
         throw std::runtime_error(
             "Specified number of shape functions is not defined");
       }
-      shapefn_.resize(this->nfunctions_, 1);
-      grad_shapefn_.resize(this->nfunctions_, Tdim);
     } catch (std::exception& exception) {
       std::cerr << exception.what() << '\n';
       std::abort();
@@ -39,19 +42,15 @@ class HexahedronShapeFn : public ShapeFn<Tdim> {
 
   //! Evaluate shape functions at given local coordinates
   //! \param[in] xi given local coordinates
-  Eigen::MatrixXd shapefn(const VectorDim& xi);
+  Matrix shapefn(const VectorDim& xi) const;
 
   //! Evaluate gradient of shape functions
   //! \param[in] xi given local coordinates
-  Eigen::MatrixXd grad_shapefn(const VectorDim& xi);
+  Matrix grad_shapefn(const VectorDim& xi) const;
 
  protected:
   // Number of functions
-  using ShapeFn<Tdim>::nfunctions_;
-  // Shape functions
-  using ShapeFn<Tdim>::shapefn_;
-  // Gradient shape functions
-  using ShapeFn<Tdim>::grad_shapefn_;
+  using ShapeFn<Tdim, Treal>::nfunctions_;
 };
 
 }  // namespace mpm
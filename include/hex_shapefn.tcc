@@ -58,196 +58,201 @@
 //! \param[in] xi Coordinates of point of interest
 //! \retval shapefn Shape function of a given cell
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-inline Eigen::MatrixXd mpm::HexahedronShapeFn<Tdim>::shapefn(
-    const mpm::HexahedronShapeFn<Tdim>::VectorDim& xi) {
+//! \tparam Treal Scalar type
+template <unsigned Tdim, typename Treal>
+inline typename mpm::HexahedronShapeFn<Tdim, Treal>::Matrix
+    mpm::HexahedronShapeFn<Tdim, Treal>::shapefn(
+        const mpm::HexahedronShapeFn<Tdim, Treal>::VectorDim& xi) const {
+  Matrix shapefn;
   switch (this->nfunctions_) {
     case 8:
       // 8-noded
-      shapefn_.resize(8, 1);
-      shapefn_(0) = 0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 - xi(2));
-      shapefn_(1) = 0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 - xi(2));
-      shapefn_(2) = 0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 - xi(2));
-      shapefn_(3) = 0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 - xi(2));
-      shapefn_(4) = 0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 + xi(2));
-      shapefn_(5) = 0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 + xi(2));
-      shapefn_(6) = 0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 + xi(2));
-      shapefn_(7) = 0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 + xi(2));
+      shapefn.resize(8, 1);
+      shapefn(0) = 0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 - xi(2));
+      shapefn(1) = 0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 - xi(2));
+      shapefn(2) = 0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 - xi(2));
+      shapefn(3) = 0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 - xi(2));
+      shapefn(4) = 0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 + xi(2));
+      shapefn(5) = 0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 + xi(2));
+      shapefn(6) = 0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 + xi(2));
+      shapefn(7) = 0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 + xi(2));
       break;
     case 20:
       // 20-noded
-      shapefn_.resize(20, 1);
-      shapefn_(0) = -0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 - xi(2)) *
+      shapefn.resize(20, 1);
+      shapefn(0) = -0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 - xi(2)) *
                     (2 + xi(0) + xi(1) + xi(2));
-      shapefn_(1) = -0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 - xi(2)) *
+      shapefn(1) = -0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 - xi(2)) *
                     (2 - xi(0) + xi(1) + xi(2));
-      shapefn_(2) = -0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 - xi(2)) *
+      shapefn(2) = -0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 - xi(2)) *
                     (2 - xi(0) - xi(1) + xi(2));
-      shapefn_(3) = -0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 - xi(2)) *
+      shapefn(3) = -0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 - xi(2)) *
                     (2 + xi(0) - xi(1) + xi(2));
-      shapefn_(4) = -0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 + xi(2)) *
+      shapefn(4) = -0.125 * (1 - xi(0)) * (1 - xi(1)) * (1 + xi(2)) *
                     (2 + xi(0) + xi(1) - xi(2));
-      shapefn_(5) = -0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 + xi(2)) *
+      shapefn(5) = -0.125 * (1 + xi(0)) * (1 - xi(1)) * (1 + xi(2)) *
                     (2 - xi(0) + xi(1) - xi(2));
-      shapefn_(6) = -0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 + xi(2)) *
+      shapefn(6) = -0.125 * (1 + xi(0)) * (1 + xi(1)) * (1 + xi(2)) *
                     (2 - xi(0) - xi(1) - xi(2));
-      shapefn_(7) = -0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 + xi(2)) *
+      shapefn(7) = -0.125 * (1 - xi(0)) * (1 + xi(1)) * (1 + xi(2)) *
                     (2 + xi(0) - xi(1) - xi(2));
 
-      shapefn_(8) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1)) * (1 - xi(2));
-      shapefn_(11) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0)) * (1 - xi(2));
-      shapefn_(13) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1)) * (1 - xi(2));
-      shapefn_(9) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0)) * (1 - xi(2));
-      shapefn_(10) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0)) * (1 - xi(1));
-      shapefn_(12) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0)) * (1 - xi(1));
-      shapefn_(14) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0)) * (1 + xi(1));
-      shapefn_(15) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0)) * (1 + xi(1));
-      shapefn_(16) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1)) * (1 + xi(2));
-      shapefn_(18) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0)) * (1 + xi(2));
-      shapefn_(19) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1)) * (1 + xi(2));
-      shapefn_(17) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0)) * (1 + xi(2));
+      shapefn(8) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1)) * (1 - xi(2));
+      shapefn(11) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0)) * (1 - xi(2));
+      shapefn(13) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1)) * (1 - xi(2));
+      shapefn(9) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0)) * (1 - xi(2));
+      shapefn(10) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0)) * (1 - xi(1));
+      shapefn(12) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0)) * (1 - xi(1));
+      shapefn(14) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0)) * (1 + xi(1));
+      shapefn(15) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0)) * (1 + xi(1));
+      shapefn(16) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1)) * (1 + xi(2));
+      shapefn(18) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0)) * (1 + xi(2));
+      shapefn(19) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1)) * (1 + xi(2));
+      shapefn(17) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0)) * (1 + xi(2));
       break;
     default:
       // Throw error
       break;
   }
-  return shapefn_;
+  return shapefn;
 }
 
 //! Return gradient of shape functions of a cell
 //! \param[in] xi Coordinates of point of interest
 //! \retval grad_shapefn Gradient of shape function of a given cell
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-inline Eigen::MatrixXd mpm::HexahedronShapeFn<Tdim>::grad_shapefn(
-    const mpm::HexahedronShapeFn<Tdim>::VectorDim& xi) {
-  Eigen::MatrixXd grad_shapefn;
+//! \tparam Treal Scalar type
+template <unsigned Tdim, typename Treal>
+inline typename mpm::HexahedronShapeFn<Tdim, Treal>::Matrix
+    mpm::HexahedronShapeFn<Tdim, Treal>::grad_shapefn(
+        const mpm::HexahedronShapeFn<Tdim, Treal>::VectorDim& xi) const {
+  Matrix grad_shapefn;
   switch (this->nfunctions_) {
     case 8:
       // 8-noded
-      grad_shapefn_.resize(8, 3);
-      grad_shapefn_(0, 0) = -0.125 * (1 - xi(1)) * (1 - xi(2));
-      grad_shapefn_(1, 0) = 0.125 * (1 - xi(1)) * (1 - xi(2));
-      grad_shapefn_(2, 0) = 0.125 * (1 + xi(1)) * (1 - xi(2));
-      grad_shapefn_(3, 0) = -0.125 * (1 + xi(1)) * (1 - xi(2));
-      grad_shapefn_(4, 0) = -0.125 * (1 - xi(1)) * (1 + xi(2));
-      grad_shapefn_(5, 0) = 0.125 * (1 - xi(1)) * (1 + xi(2));
-      grad_shapefn_(6, 0) = 0.125 * (1 + xi(1)) * (1 + xi(2));
-      grad_shapefn_(7, 0) = -0.125 * (1 + xi(1)) * (1 + xi(2));
+      grad_shapefn.resize(8, 3);
+      grad_shapefn(0, 0) = -0.125 * (1 - xi(1)) * (1 - xi(2));
+      grad_shapefn(1, 0) = 0.125 * (1 - xi(1)) * (1 - xi(2));
+      grad_shapefn(2, 0) = 0.125 * (1 + xi(1)) * (1 - xi(2));
+      grad_shapefn(3, 0) = -0.125 * (1 + xi(1)) * (1 - xi(2));
+      grad_shapefn(4, 0) = -0.125 * (1 - xi(1)) * (1 + xi(2));
+      grad_shapefn(5, 0) = 0.125 * (1 - xi(1)) * (1 + xi(2));
+      grad_shapefn(6, 0) = 0.125 * (1 + xi(1)) * (1 + xi(2));
+      grad_shapefn(7, 0) = -0.125 * (1 + xi(1)) * (1 + xi(2));
 
-      grad_shapefn_(0, 1) = -0.125 * (1 - xi(0)) * (1 - xi(2));
-      grad_shapefn_(1, 1) = -0.125 * (1 + xi(0)) * (1 - xi(2));
-      grad_shapefn_(2, 1) = 0.125 * (1 + xi(0)) * (1 - xi(2));
-      grad_shapefn_(3, 1) = 0.125 * (1 - xi(0)) * (1 - xi(2));
-      grad_shapefn_(4, 1) = -0.125 * (1 - xi(0)) * (1 + xi(2));
-      grad_shapefn_(5, 1) = -0.125 * (1 + xi(0)) * (1 + xi(2));
-      grad_shapefn_(6, 1) = 0.125 * (1 + xi(0)) * (1 + xi(2));
-      grad_shapefn_(7, 1) = 0.125 * (1 - xi(0)) * (1 + xi(2));
+      grad_shapefn(0, 1) = -0.125 * (1 - xi(0)) * (1 - xi(2));
+      grad_shapefn(1, 1) = -0.125 * (1 + xi(0)) * (1 - xi(2));
+      grad_shapefn(2, 1) = 0.125 * (1 + xi(0)) * (1 - xi(2));
+      grad_shapefn(3, 1) = 0.125 * (1 - xi(0)) * (1 - xi(2));
+      grad_shapefn(4, 1) = -0.125 * (1 - xi(0)) * (1 + xi(2));
+      grad_shapefn(5, 1) = -0.125 * (1 + xi(0)) * (1 + xi(2));
+      grad_shapefn(6, 1) = 0.125 * (1 + xi(0)) * (1 + xi(2));
+      grad_shapefn(7, 1) = 0.125 * (1 - xi(0)) * (1 + xi(2));
 
-      grad_shapefn_(0, 2) = -0.125 * (1 - xi(0)) * (1 - xi(1));
-      grad_shapefn_(1, 2) = -0.125 * (1 + xi(0)) * (1 - xi(1));
-      grad_shapefn_(2, 2) = -0.125 * (1 + xi(0)) * (1 + xi(1));
-      grad_shapefn_(3, 2) = -0.125 * (1 - xi(0)) * (1 + xi(1));
-      grad_shapefn_(4, 2) = 0.125 * (1 - xi(0)) * (1 - xi(1));
-      grad_shapefn_(5, 2) = 0.125 * (1 + xi(0)) * (1 - xi(1));
-      grad_shapefn_(6, 2) = 0.125 * (1 + xi(0)) * (1 + xi(1));
-      grad_shapefn_(7, 2) = 0.125 * (1 - xi(0)) * (1 + xi(1));
-      return grad_shapefn_;
+      grad_shapefn(0, 2) = -0.125 * (1 - xi(0)) * (1 - xi(1));
+      grad_shapefn(1, 2) = -0.125 * (1 + xi(0)) * (1 - xi(1));
+      grad_shapefn(2, 2) = -0.125 * (1 + xi(0)) * (1 + xi(1));
+      grad_shapefn(3, 2) = -0.125 * (1 - xi(0)) * (1 + xi(1));
+      grad_shapefn(4, 2) = 0.125 * (1 - xi(0)) * (1 - xi(1));
+      grad_shapefn(5, 2) = 0.125 * (1 + xi(0)) * (1 - xi(1));
+      grad_shapefn(6, 2) = 0.125 * (1 + xi(0)) * (1 + xi(1));
+      grad_shapefn(7, 2) = 0.125 * (1 - xi(0)) * (1 + xi(1));
+      return grad_shapefn;
       break;
     case 20:
       // 20-noded
-      grad_shapefn_.resize(20, 3);
+      grad_shapefn.resize(20, 3);
 
-      grad_shapefn_(0, 0) =
+      grad_shapefn(0, 0) =
           0.125 * (2 * xi(0) + xi(1) + xi(2) + 1) * (1 - xi(1)) * (1 - xi(2));
-      grad_shapefn_(1, 0) =
+      grad_shapefn(1, 0) =
           -0.125 * (-2 * xi(0) + xi(1) + xi(2) + 1) * (1 - xi(1)) * (1 - xi(2));
-      grad_shapefn_(2, 0) =
+      grad_shapefn(2, 0) =
           -0.125 * (-2 * xi(0) - xi(1) + xi(2) + 1) * (1 + xi(1)) * (1 - xi(2));
-      grad_shapefn_(3, 0) =
+      grad_shapefn(3, 0) =
           0.125 * (2 * xi(0) - xi(1) + xi(2) + 1) * (1 + xi(1)) * (1 - xi(2));
-      grad_shapefn_(4, 0) =
+      grad_shapefn(4, 0) =
           0.125 * (2 * xi(0) + xi(1) - xi(2) + 1) * (1 - xi(1)) * (1 + xi(2));
-      grad_shapefn_(5, 0) =
+      grad_shapefn(5, 0) =
           -0.125 * (-2 * xi(0) + xi(1) - xi(2) + 1) * (1 - xi(1)) * (1 + xi(2));
-      grad_shapefn_(6, 0) =
+      grad_shapefn(6, 0) =
           -0.125 * (-2 * xi(0) - xi(1) - xi(2) + 1) * (1 + xi(1)) * (1 + xi(2));
-      grad_shapefn_(7, 0) =
+      grad_shapefn(7, 0) =
           0.125 * (2 * xi(0) - xi(1) - xi(2) + 1) * (1 + xi(1)) * (1 + xi(2));
-      grad_shapefn_(8, 0) = -0.5 * xi(0) * (1 - xi(1)) * (1 - xi(2));
-      grad_shapefn_(11, 0) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(2));
-      grad_shapefn_(13, 0) = -0.5 * xi(0) * (1 + xi(1)) * (1 - xi(2));
-      grad_shapefn_(9, 0) = -0.25 * (1 - xi(1) * xi(1)) * (1 - xi(2));
-      grad_shapefn_(10, 0) = -0.25 * (1 - xi(2) * xi(2)) * (1 - xi(1));
-      grad_shapefn_(12, 0) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(1));
-      grad_shapefn_(14, 0) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(1));
-      grad_shapefn_(15, 0) = -0.25 * (1 - xi(2) * xi(2)) * (1 + xi(1));
-      grad_shapefn_(16, 0) = -0.5 * xi(0) * (1 - xi(1)) * (1 + xi(2));
-      grad_shapefn_(18, 0) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(2));
-      grad_shapefn_(19, 0) = -0.5 * xi(0) * (1 + xi(1)) * (1 + xi(2));
-      grad_shapefn_(17, 0) = -0.25 * (1 - xi(1) * xi(1)) * (1 + xi(2));
+      grad_shapefn(8, 0) = -0.5 * xi(0) * (1 - xi(1)) * (1 - xi(2));
+      grad_shapefn(11, 0) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(2));
+      grad_shapefn(13, 0) = -0.5 * xi(0) * (1 + xi(1)) * (1 - xi(2));
+      grad_shapefn(9, 0) = -0.25 * (1 - xi(1) * xi(1)) * (1 - xi(2));
+      grad_shapefn(10, 0) = -0.25 * (1 - xi(2) * xi(2)) * (1 - xi(1));
+      grad_shapefn(12, 0) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(1));
+      grad_shapefn(14, 0) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(1));
+      grad_shapefn(15, 0) = -0.25 * (1 - xi(2) * xi(2)) * (1 + xi(1));
+      grad_shapefn(16, 0) = -0.5 * xi(0) * (1 - xi(1)) * (1 + xi(2));
+      grad_shapefn(18, 0) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(2));
+      grad_shapefn(19, 0) = -0.5 * xi(0) * (1 + xi(1)) * (1 + xi(2));
+      grad_shapefn(17, 0) = -0.25 * (1 - xi(1) * xi(1)) * (1 + xi(2));
 
-      grad_shapefn_(0, 1) =
+      grad_shapefn(0, 1) =
           0.125 * (xi(0) + 2 * xi(1) + xi(2) + 1) * (1 - xi(0)) * (1 - xi(2));
-      grad_shapefn_(1, 1) =
+      grad_shapefn(1, 1) =
           0.125 * (-xi(0) + 2 * xi(1) + xi(2) + 1) * (1 + xi(0)) * (1 - xi(2));
-      grad_shapefn_(2, 1) =
+      grad_shapefn(2, 1) =
           -0.125 * (-xi(0) - 2 * xi(1) + xi(2) + 1) * (1 + xi(0)) * (1 - xi(2));
-      grad_shapefn_(3, 1) =
+      grad_shapefn(3, 1) =
           -0.125 * (xi(0) - 2 * xi(1) + xi(2) + 1) * (1 - xi(1)) * (1 - xi(2));
-      grad_shapefn_(4, 1) =
+      grad_shapefn(4, 1) =
           0.125 * (xi(0) + 2 * xi(1) - xi(2) + 1) * (1 - xi(0)) * (1 + xi(2));
-      grad_shapefn_(5, 1) =
+      grad_shapefn(5, 1) =
           0.125 * (-xi(0) + 2 * xi(1) - xi(2) + 1) * (1 + xi(0)) * (1 + xi(2));
-      grad_shapefn_(6, 1) =
+      grad_shapefn(6, 1) =
           -0.125 * (-xi(0) - 2 * xi(1) - xi(2) + 1) * (1 + xi(0)) * (1 + xi(2));
-      grad_shapefn_(7, 1) =
+      grad_shapefn(7, 1) =
           -0.125 * (xi(0) - 2 * xi(1) - xi(2) + 1) * (1 - xi(1)) * (1 + xi(2));
-      grad_shapefn_(8, 1) = -0.25 * (1 - xi(0) * xi(0)) * (1 - xi(2));
-      grad_shapefn_(11, 1) = -0.5 * xi(1) * (1 + xi(0)) * (1 - xi(2));
-      grad_shapefn_(13, 1) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(2));
-      grad_shapefn_(9, 1) = -0.5 * xi(1) * (1 - xi(0)) * (1 - xi(2));
-      grad_shapefn_(10, 1) = -0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0));
-      grad_shapefn_(12, 1) = -0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0));
-      grad_shapefn_(14, 1) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0));
-      grad_shapefn_(15, 1) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0));
-      grad_shapefn_(16, 1) = -0.25 * (1 - xi(0) * xi(0)) * (1 + xi(2));
-      grad_shapefn_(18, 1) = -0.5 * xi(1) * (1 + xi(0)) * (1 + xi(2));
-      grad_shapefn_(19, 1) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(2));
-      grad_shapefn_(17, 1) = -0.5 * xi(1) * (1 - xi(0)) * (1 + xi(2));
+      grad_shapefn(8, 1) = -0.25 * (1 - xi(0) * xi(0)) * (1 - xi(2));
+      grad_shapefn(11, 1) = -0.5 * xi(1) * (1 + xi(0)) * (1 - xi(2));
+      grad_shapefn(13, 1) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(2));
+      grad_shapefn(9, 1) = -0.5 * xi(1) * (1 - xi(0)) * (1 - xi(2));
+      grad_shapefn(10, 1) = -0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0));
+      grad_shapefn(12, 1) = -0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0));
+      grad_shapefn(14, 1) = 0.25 * (1 - xi(2) * xi(2)) * (1 + xi(0));
+      grad_shapefn(15, 1) = 0.25 * (1 - xi(2) * xi(2)) * (1 - xi(0));
+      grad_shapefn(16, 1) = -0.25 * (1 - xi(0) * xi(0)) * (1 + xi(2));
+      grad_shapefn(18, 1) = -0.5 * xi(1) * (1 + xi(0)) * (1 + xi(2));
+      grad_shapefn(19, 1) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(2));
+      grad_shapefn(17, 1) = -0.5 * xi(1) * (1 - xi(0)) * (1 + xi(2));
 
-      grad_shapefn_(0, 2) =
+      grad_shapefn(0, 2) =
           0.125 * (xi(0) + xi(1) + 2 * xi(2) + 1) * (1 - xi(0)) * (1 - xi(1));
-      grad_shapefn_(1, 2) =
+      grad_shapefn(1, 2) =
           0.125 * (-xi(0) + xi(1) + 2 * xi(2) + 1) * (1 + xi(0)) * (1 - xi(1));
-      grad_shapefn_(2, 2) =
+      grad_shapefn(2, 2) =
           0.125 * (-xi(0) - xi(1) + 2 * xi(2) + 1) * (1 + xi(0)) * (1 + xi(1));
-      grad_shapefn_(3, 2) =
+      grad_shapefn(3, 2) =
           0.125 * (xi(0) - xi(1) + 2 * xi(2) + 1) * (1 - xi(1)) * (1 + xi(1));
-      grad_shapefn_(4, 2) =
+      grad_shapefn(4, 2) =
           -0.125 * (xi(0) + xi(1) - 2 * xi(2) + 1) * (1 - xi(0)) * (1 - xi(1));
-      grad_shapefn_(5, 2) =
+      grad_shapefn(5, 2) =
           -0.125 * (-xi(0) + xi(1) - 2 * xi(2) + 1) * (1 + xi(0)) * (1 - xi(1));
-      grad_shapefn_(6, 2) =
+      grad_shapefn(6, 2) =
           -0.125 * (-xi(0) - xi(1) - 2 * xi(2) + 1) * (1 + xi(0)) * (1 + xi(1));
-      grad_shapefn_(7, 2) =
+      grad_shapefn(7, 2) =
           -0.125 * (xi(0) - xi(1) - 2 * xi(2) + 1) * (1 - xi(1)) * (1 + xi(1));
-      grad_shapefn_(8, 2) = -0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1));
-      grad_shapefn_(11, 2) = -0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0));
-      grad_shapefn_(13, 2) = -0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1));
-      grad_shapefn_(9, 2) = -0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0));
-      grad_shapefn_(10, 2) = -0.5 * xi(2) * (1 - xi(0)) * (1 - xi(1));
-      grad_shapefn_(12, 2) = -0.5 * xi(2) * (1 + xi(0)) * (1 - xi(1));
-      grad_shapefn_(14, 2) = -0.5 * xi(2) * (1 + xi(0)) * (1 + xi(1));
-      grad_shapefn_(15, 2) = -0.5 * xi(2) * (1 - xi(0)) * (1 + xi(1));
-      grad_shapefn_(16, 2) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1));
-      grad_shapefn_(18, 2) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0));
-      grad_shapefn_(19, 2) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1));
-      grad_shapefn_(17, 2) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0));
+      grad_shapefn(8, 2) = -0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1));
+      grad_shapefn(11, 2) = -0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0));
+      grad_shapefn(13, 2) = -0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1));
+      grad_shapefn(9, 2) = -0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0));
+      grad_shapefn(10, 2) = -0.5 * xi(2) * (1 - xi(0)) * (1 - xi(1));
+      grad_shapefn(12, 2) = -0.5 * xi(2) * (1 + xi(0)) * (1 - xi(1));
+      grad_shapefn(14, 2) = -0.5 * xi(2) * (1 + xi(0)) * (1 + xi(1));
+      grad_shapefn(15, 2) = -0.5 * xi(2) * (1 - xi(0)) * (1 + xi(1));
+      grad_shapefn(16, 2) = 0.25 * (1 - xi(0) * xi(0)) * (1 - xi(1));
+      grad_shapefn(18, 2) = 0.25 * (1 - xi(1) * xi(1)) * (1 + xi(0));
+      grad_shapefn(19, 2) = 0.25 * (1 - xi(0) * xi(0)) * (1 + xi(1));
+      grad_shapefn(17, 2) = 0.25 * (1 - xi(1) * xi(1)) * (1 - xi(0));
       break;
     default:
       // Throw error
       break;
   }
-  return grad_shapefn_;
+  return grad_shapefn;
 }
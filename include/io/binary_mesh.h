@@ -0,0 +1,206 @@
+#ifndef MPM_IO_BINARY_MESH_H_
+#define MPM_IO_BINARY_MESH_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include "hex_shapefn.h"
+#include "io/memory_map.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+
+namespace mpm {
+
+//! Binary cells of a dimension
+//! \brief Shape function of cells by their number of nodes
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+struct BinaryCells;
+
+//! Quadrilateral cells of 4, 8 or 9 nodes
+template <>
+struct BinaryCells<2> {
+  //! Return shape function, nullptr if the number of nodes is invalid
+  static std::shared_ptr<ShapeFn<2>> shapefn(unsigned nnodes) {
+    if (nnodes == 4 || nnodes == 8 || nnodes == 9)
+      return std::make_shared<QuadrilateralShapeFn<2>>(nnodes);
+    return nullptr;
+  }
+};
+
+//! Hexahedron cells of 8 or 20 nodes
+template <>
+struct BinaryCells<3> {
+  //! Return shape function, nullptr if the number of nodes is invalid
+  static std::shared_ptr<ShapeFn<3>> shapefn(unsigned nnodes) {
+    if (nnodes == 8 || nnodes == 20)
+      return std::make_shared<HexahedronShapeFn<3>>(nnodes);
+    return nullptr;
+  }
+};
+
+//! BinaryMesh class
+//! \brief Memory mapped binary file of nodes, cells and particles
+//! \details A file is a header, a table of sections and the sections. Each
+//! section is a column of rows with a fixed number of values, either
+//! 64-bit ids or doubles, aligned to 64 bytes. Sections of an unknown type
+//! are skipped. A file is written once from a mesh built from any input.
+//! Reading maps the file and validates the table without touching the
+//! data; columns are used in place and objects are created in parallel
+//! without parsing.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class BinaryMesh {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Section types
+  enum class Column : std::uint32_t {
+    NodeIds = 1,
+    NodeCoordinates = 2,
+    CellIds = 3,
+    CellNodes = 4,
+    ParticleIds = 5,
+    ParticleCoordinates = 6,
+    ParticleMass = 7,
+    ParticleVolume = 8
+  };
+
+  //! File header
+  struct Header {
+    //! Magic bytes
+    char magic[8];
+    //! Format version
+    std::uint32_t version;
+    //! Byte order mark
+    std::uint32_t endian;
+    //! Dimension
+    std::uint32_t dimension;
+    //! Number of sections
+    std::uint32_t nsections;
+  };
+
+  //! Entry of the table of sections
+  struct Section {
+    //! Column type
+    std::uint32_t type;
+    //! Number of values per row
+    std::uint32_t ncolumns;
+    //! Number of rows
+    std::uint64_t nrows;
+    //! Offset of the data from the beginning of the file
+    std::uint64_t offset;
+  };
+
+  //! Format version
+  static const std::uint32_t format_version = 1;
+
+  //! Alignment of sections in bytes
+  static const std::uint64_t alignment = 64;
+
+  //! Write nodes, cells and particles of a mesh
+  static bool write(const std::string& filename,
+                    const std::shared_ptr<Mesh<Tdim>>& mesh);
+
+  //! Map and validate a file
+  bool read(const std::string& filename);
+
+  //! Number of nodes
+  Index nnodes() const { return nnodes_; }
+
+  //! Number of cells
+  Index ncells() const { return ncells_; }
+
+  //! Number of nodes per cell
+  unsigned nnodes_cell() const { return nnodes_cell_; }
+
+  //! Number of particles
+  Index nparticles() const { return nparticles_; }
+
+  //! Node ids
+  const Index* node_ids() const { return column<Index>(Column::NodeIds); }
+
+  //! Nodal coordinates, Tdim per node
+  const double* node_coordinates() const {
+    return column<double>(Column::NodeCoordinates);
+  }
+
+  //! Cell ids
+  const Index* cell_ids() const { return column<Index>(Column::CellIds); }
+
+  //! Node ids of cells, nnodes_cell per cell
+  const Index* cell_nodes() const {
+    return column<Index>(Column::CellNodes);
+  }
+
+  //! Particle ids
+  const Index* particle_ids() const {
+    return column<Index>(Column::ParticleIds);
+  }
+
+  //! Particle coordinates, Tdim per particle
+  const double* particle_coordinates() const {
+    return column<double>(Column::ParticleCoordinates);
+  }
+
+  //! Particle mass, nullptr if absent
+  const double* particle_mass() const {
+    return column<double>(Column::ParticleMass);
+  }
+
+  //! Particle volume, nullptr if absent
+  const double* particle_volume() const {
+    return column<double>(Column::ParticleVolume);
+  }
+
+  //! Create nodes, cells and particles and add them to a mesh in bulk
+  bool create_mesh(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                   unsigned dof = Tdim) const;
+
+ private:
+  //! Return a column in the mapped file, nullptr if absent
+  template <typename T>
+  const T* column(Column type) const {
+    const Section* section = sections_[static_cast<unsigned>(type)];
+    return section ? reinterpret_cast<const T*>(file_.data() + section->offset)
+                   : nullptr;
+  }
+
+  //! Check the rows and columns of a section
+  bool check_section(Column type, Index nrows, unsigned ncolumns) const;
+
+  //! Mapped file
+  MemoryMap file_;
+  //! Sections by column type
+  std::array<const Section*, 9> sections_{};
+  //! Number of nodes
+  Index nnodes_{0};
+  //! Number of cells
+  Index ncells_{0};
+  //! Number of nodes per cell
+  unsigned nnodes_cell_{0};
+  //! Number of particles
+  Index nparticles_{0};
+};  // BinaryMesh class
+}  // mpm namespace
+
+#include "binary_mesh.tcc"
+
+#endif  // MPM_IO_BINARY_MESH_H_
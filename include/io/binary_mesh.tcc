@@ -0,0 +1,341 @@
+//! Write nodes, cells and particles of a mesh
+//! \details Rows are sorted by id, cells must have the same number of nodes
+//! \param[in] filename Name of the file
+//! \param[in] mesh Mesh
+//! \retval status Return false if the file cannot be written
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::BinaryMesh<Tdim>::write(const std::string& filename,
+                                  const std::shared_ptr<Mesh<Tdim>>& mesh) {
+  static_assert(sizeof(Header) == 24 && sizeof(Section) == 24,
+                "Invalid size of binary mesh header");
+  static_assert(sizeof(Index) == sizeof(std::uint64_t),
+                "Ids are written as 64-bit integers");
+  bool status = false;
+  try {
+    // Collect elements and sort them by id for a reproducible file
+    tbb::concurrent_vector<std::shared_ptr<mpm::Node<Tdim>>> node_list;
+    mesh->iterate_over_nodes([&](std::shared_ptr<mpm::Node<Tdim>> node) {
+      node_list.push_back(node);
+    });
+    tbb::concurrent_vector<std::shared_ptr<mpm::Cell<Tdim>>> cell_list;
+    mesh->iterate_over_cells([&](std::shared_ptr<mpm::Cell<Tdim>> cell) {
+      cell_list.push_back(cell);
+    });
+    tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Tdim>>> particle_list;
+    mesh->iterate_over_particles(
+        [&](std::shared_ptr<mpm::Particle<Tdim>> particle) {
+          particle_list.push_back(particle);
+        });
+    const auto by_id = [](const std::shared_ptr<mpm::Node<Tdim>>& lhs,
+                          const std::shared_ptr<mpm::Node<Tdim>>& rhs) {
+      return lhs->id() < rhs->id();
+    };
+    const auto cell_by_id = [](const std::shared_ptr<mpm::Cell<Tdim>>& lhs,
+                               const std::shared_ptr<mpm::Cell<Tdim>>& rhs) {
+      return lhs->id() < rhs->id();
+    };
+    const auto particle_by_id =
+        [](const std::shared_ptr<mpm::Particle<Tdim>>& lhs,
+           const std::shared_ptr<mpm::Particle<Tdim>>& rhs) {
+          return lhs->id() < rhs->id();
+        };
+    tbb::parallel_sort(node_list.begin(), node_list.end(), by_id);
+    tbb::parallel_sort(cell_list.begin(), cell_list.end(), cell_by_id);
+    tbb::parallel_sort(particle_list.begin(), particle_list.end(),
+                       particle_by_id);
+
+    // Columns
+    const std::size_t nnodes = node_list.size();
+    std::vector<Index> node_ids(nnodes);
+    std::vector<double> node_coordinates(nnodes * Tdim);
+    for (std::size_t i = 0; i < nnodes; ++i) {
+      node_ids[i] = node_list[i]->id();
+      Eigen::Map<VectorDim> coordinates(&node_coordinates[i * Tdim]);
+      coordinates = node_list[i]->coordinates();
+    }
+
+    const std::size_t ncells = cell_list.size();
+    const unsigned nnodes_cell = ncells ? cell_list[0]->nnodes() : 0;
+    std::vector<Index> cell_ids(ncells);
+    std::vector<Index> cell_nodes(ncells * nnodes_cell);
+    for (std::size_t i = 0; i < ncells; ++i) {
+      const auto& cell = cell_list[i];
+      if (cell->nnodes() != nnodes_cell)
+        throw std::runtime_error("Cells have different numbers of nodes");
+      cell_ids[i] = cell->id();
+      for (unsigned j = 0; j < nnodes_cell; ++j)
+        cell_nodes[i * nnodes_cell + j] = cell->node(j)->id();
+    }
+
+    const std::size_t nparticles = particle_list.size();
+    std::vector<Index> particle_ids(nparticles);
+    std::vector<double> particle_coordinates(nparticles * Tdim);
+    std::vector<double> particle_mass(nparticles), particle_volume(nparticles);
+    for (std::size_t i = 0; i < nparticles; ++i) {
+      const auto& particle = particle_list[i];
+      particle_ids[i] = particle->id();
+      Eigen::Map<VectorDim> coordinates(&particle_coordinates[i * Tdim]);
+      coordinates = particle->coordinates();
+      particle_mass[i] = particle->mass();
+      particle_volume[i] = particle->volume();
+    }
+
+    // Sections and their data
+    std::vector<Section> sections;
+    std::vector<const void*> data;
+    const auto add_section = [&](Column type, unsigned ncolumns,
+                                 std::size_t nrows, const void* values) {
+      Section section;
+      section.type = static_cast<std::uint32_t>(type);
+      section.ncolumns = ncolumns;
+      section.nrows = nrows;
+      section.offset = 0;
+      sections.emplace_back(section);
+      data.emplace_back(values);
+    };
+    add_section(Column::NodeIds, 1, nnodes, node_ids.data());
+    add_section(Column::NodeCoordinates, Tdim, nnodes,
+                node_coordinates.data());
+    add_section(Column::CellIds, 1, ncells, cell_ids.data());
+    add_section(Column::CellNodes, nnodes_cell, ncells, cell_nodes.data());
+    add_section(Column::ParticleIds, 1, nparticles, particle_ids.data());
+    add_section(Column::ParticleCoordinates, Tdim, nparticles,
+                particle_coordinates.data());
+    add_section(Column::ParticleMass, 1, nparticles, particle_mass.data());
+    add_section(Column::ParticleVolume, 1, nparticles,
+                particle_volume.data());
+
+    // Offsets aligned after the header and table
+    const auto align = [](std::uint64_t offset) {
+      return (offset + alignment - 1) / alignment * alignment;
+    };
+    std::uint64_t offset =
+        align(sizeof(Header) + sections.size() * sizeof(Section));
+    for (auto& section : sections) {
+      section.offset = offset;
+      offset = align(offset + section.nrows * section.ncolumns * 8);
+    }
+
+    Header header;
+    std::memcpy(header.magic, "MPMMESH", 8);
+    header.version = format_version;
+    header.endian = 0x01020304;
+    header.dimension = Tdim;
+    header.nsections = sections.size();
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      throw std::runtime_error("Cannot open binary mesh file: " + filename);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(sections.data()),
+               sections.size() * sizeof(Section));
+    const std::vector<char> padding(alignment, 0);
+    std::uint64_t position = sizeof(Header) + sections.size() * sizeof(Section);
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+      file.write(padding.data(), sections[i].offset - position);
+      const std::uint64_t bytes = sections[i].nrows * sections[i].ncolumns * 8;
+      file.write(static_cast<const char*>(data[i]), bytes);
+      position = sections[i].offset + bytes;
+    }
+    if (!file.good())
+      throw std::runtime_error("Cannot write binary mesh file: " + filename);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Check the rows and columns of a section
+//! \param[in] type Column type
+//! \param[in] nrows Number of rows
+//! \param[in] ncolumns Number of values per row
+//! \retval status Return true if the section matches or is absent and empty
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::BinaryMesh<Tdim>::check_section(Column type, Index nrows,
+                                          unsigned ncolumns) const {
+  const Section* section = sections_[static_cast<unsigned>(type)];
+  if (section == nullptr) return nrows == 0;
+  return section->nrows == nrows && section->ncolumns == ncolumns;
+}
+
+//! Map and validate a file
+//! \details Only the header and the table of sections are read
+//! \param[in] filename Name of the file
+//! \retval status Return false if the file is not a valid binary mesh
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::BinaryMesh<Tdim>::read(const std::string& filename) {
+  bool status = false;
+  sections_.fill(nullptr);
+  nnodes_ = ncells_ = nparticles_ = 0;
+  nnodes_cell_ = 0;
+  try {
+    if (!file_.open(filename))
+      throw std::runtime_error("Cannot map binary mesh file: " + filename);
+    const std::uint64_t size = file_.size();
+
+    if (size < sizeof(Header))
+      throw std::runtime_error("Invalid binary mesh file: " + filename);
+    const Header* header = reinterpret_cast<const Header*>(file_.data());
+    if (std::memcmp(header->magic, "MPMMESH", 8) != 0)
+      throw std::runtime_error("Invalid binary mesh file: " + filename);
+    if (header->endian != 0x01020304)
+      throw std::runtime_error("Binary mesh has a different byte order");
+    if (header->version != format_version)
+      throw std::runtime_error("Binary mesh has an unsupported version");
+    if (header->dimension != Tdim)
+      throw std::runtime_error("Binary mesh has a different dimension");
+    if (header->nsections > (size - sizeof(Header)) / sizeof(Section))
+      throw std::runtime_error("Binary mesh table is truncated");
+
+    // Sections within the file
+    const Section* table =
+        reinterpret_cast<const Section*>(file_.data() + sizeof(Header));
+    for (unsigned i = 0; i < header->nsections; ++i) {
+      const Section& section = table[i];
+      if (section.offset % alignment != 0 || section.offset > size ||
+          (section.ncolumns > 0 &&
+           section.nrows > (size - section.offset) / 8 / section.ncolumns))
+        throw std::runtime_error("Binary mesh section is truncated");
+      // Unknown sections are skipped
+      if (section.type > 0 && section.type < sections_.size())
+        sections_[section.type] = &section;
+    }
+
+    // Rows and columns are consistent
+    const auto rows = [this](Column type) -> Index {
+      const Section* section = sections_[static_cast<unsigned>(type)];
+      return section ? section->nrows : 0;
+    };
+    nnodes_ = rows(Column::NodeIds);
+    ncells_ = rows(Column::CellIds);
+    nparticles_ = rows(Column::ParticleIds);
+    const Section* cell_nodes =
+        sections_[static_cast<unsigned>(Column::CellNodes)];
+    nnodes_cell_ = cell_nodes ? cell_nodes->ncolumns : 0;
+
+    if (!check_section(Column::NodeIds, nnodes_, 1) ||
+        !check_section(Column::NodeCoordinates, nnodes_, Tdim) ||
+        !check_section(Column::CellIds, ncells_, 1) ||
+        !check_section(Column::CellNodes, ncells_, nnodes_cell_) ||
+        !check_section(Column::ParticleIds, nparticles_, 1) ||
+        !check_section(Column::ParticleCoordinates, nparticles_, Tdim))
+      throw std::runtime_error("Binary mesh sections are inconsistent");
+    for (const auto type : {Column::ParticleMass, Column::ParticleVolume})
+      if (sections_[static_cast<unsigned>(type)] &&
+          !check_section(type, nparticles_, 1))
+        throw std::runtime_error("Binary mesh sections are inconsistent");
+    if (ncells_ > 0 && mpm::BinaryCells<Tdim>::shapefn(nnodes_cell_) == nullptr)
+      throw std::runtime_error("Binary mesh cells have invalid nodes");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+    file_.close();
+    sections_.fill(nullptr);
+    nnodes_ = ncells_ = nparticles_ = 0;
+    nnodes_cell_ = 0;
+  }
+  return status;
+}
+
+//! Create nodes, cells and particles and add them to a mesh in bulk
+//! \details Objects are created in parallel from the mapped columns
+//! \param[in] mesh Mesh
+//! \param[in] dof Degrees of freedom of nodes
+//! \retval status Return false if a cell refers to a missing node or an id
+//! exists in the mesh
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::BinaryMesh<Tdim>::create_mesh(
+    const std::shared_ptr<Mesh<Tdim>>& mesh, unsigned dof) const {
+  bool status = false;
+  try {
+    if (!file_.is_open()) throw std::runtime_error("No binary mesh is read");
+
+    // Nodes
+    const Index* node_ids = this->node_ids();
+    const double* node_coordinates = this->node_coordinates();
+    std::vector<std::shared_ptr<mpm::Node<Tdim>>> nodes(nnodes_);
+    tbb::parallel_for(Index(0), nnodes_, [&](Index i) {
+      nodes[i] = mesh->make_node(
+          node_ids[i], Eigen::Map<const VectorDim>(node_coordinates + i * Tdim),
+          dof);
+    });
+
+    // Positions of nodes sorted by id, written files are already sorted
+    std::vector<Index> order;
+    if (!std::is_sorted(node_ids, node_ids + nnodes_)) {
+      order.resize(nnodes_);
+      for (Index i = 0; i < nnodes_; ++i) order[i] = i;
+      tbb::parallel_sort(order.begin(), order.end(), [&](Index a, Index b) {
+        return node_ids[a] < node_ids[b];
+      });
+    }
+    const auto find_node = [&](Index id) -> std::shared_ptr<Node<Tdim>> {
+      Index first = 0, count = nnodes_;
+      // Binary search of the id
+      while (count > 0) {
+        const Index step = count / 2;
+        const Index position = order.empty() ? first + step
+                                             : order[first + step];
+        if (node_ids[position] < id) {
+          first += step + 1;
+          count -= step + 1;
+        } else {
+          count = step;
+        }
+      }
+      if (first == nnodes_) return nullptr;
+      const Index position = order.empty() ? first : order[first];
+      return node_ids[position] == id ? nodes[position] : nullptr;
+    };
+
+    // Cells
+    const Index* cell_ids = this->cell_ids();
+    const Index* cell_nodes = this->cell_nodes();
+    const auto shapefn = mpm::BinaryCells<Tdim>::shapefn(nnodes_cell_);
+    std::vector<std::shared_ptr<mpm::Cell<Tdim>>> cells(ncells_);
+    std::atomic<bool> valid{true};
+    tbb::parallel_for(Index(0), ncells_, [&](Index i) {
+      auto cell = mesh->make_cell(cell_ids[i], nnodes_cell_, shapefn);
+      for (unsigned j = 0; j < nnodes_cell_; ++j) {
+        const auto node = find_node(cell_nodes[i * nnodes_cell_ + j]);
+        if (node == nullptr) {
+          valid = false;
+          return;
+        }
+        cell->add_node(j, node.get());
+      }
+      cell->initialise();
+      cells[i] = cell;
+    });
+    if (!valid)
+      throw std::runtime_error("Binary mesh cell refers to a missing node");
+
+    // Particles
+    const Index* particle_ids = this->particle_ids();
+    const double* particle_coordinates = this->particle_coordinates();
+    const double* particle_mass = this->particle_mass();
+    const double* particle_volume = this->particle_volume();
+    std::vector<std::shared_ptr<mpm::Particle<Tdim>>> particles(nparticles_);
+    tbb::parallel_for(Index(0), nparticles_, [&](Index i) {
+      auto particle = mesh->make_particle(
+          particle_ids[i],
+          Eigen::Map<const VectorDim>(particle_coordinates + i * Tdim));
+      if (particle_mass) particle->assign_mass(particle_mass[i]);
+      if (particle_volume) particle->assign_volume(particle_volume[i]);
+      particles[i] = particle;
+    });
+
+    if (!mesh->add_nodes(nodes) || !mesh->add_cells(cells) ||
+        !mesh->add_particles(particles))
+      throw std::runtime_error("Binary mesh is not added to mesh");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
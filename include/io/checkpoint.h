@@ -0,0 +1,159 @@
+#ifndef MPM_IO_CHECKPOINT_H_
+#define MPM_IO_CHECKPOINT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include "io/binary_mesh.h"
+#include "io/memory_map.h"
+#include "material/material.h"
+#include "mesh.h"
+#include "serialize.h"
+
+namespace mpm {
+
+//! Checkpoint class
+//! \brief Checkpoint and restart of the state of a simulation
+//! \details A checkpoint holds the step counter, the nodes with their
+//! kinematics and constraints, the cells with their node ids and the
+//! particles with their kinematics, stress, strain, material id and the
+//! values of their material state variables. Nodes, cells and particles
+//! are sorted by id and split into chunks that are serialized in parallel
+//! into portable binary archives. A checkpoint is memory mapped to
+//! restart, and chunks are read back in parallel. Materials are not saved;
+//! they are created from the input and matched by id on restart.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class Checkpoint {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Constructor with the number of elements per chunk
+  explicit Checkpoint(std::size_t chunk_size = 1 << 14)
+      : chunk_size_{std::max<std::size_t>(chunk_size, 1)} {}
+
+  //! Write the state of a mesh and the step counter
+  bool write(const std::string& filename,
+             const std::shared_ptr<Mesh<Tdim>>& mesh,
+             unsigned long long step) const;
+
+  //! Serialize the state of a mesh and the step counter
+  std::string image(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                    unsigned long long step) const;
+
+  //! Map and validate a checkpoint
+  bool read(const std::string& filename);
+
+  //! Return the step counter
+  unsigned long long step() const { return step_; }
+
+  //! Number of nodes
+  Index nnodes() const { return nnodes_; }
+
+  //! Number of cells
+  Index ncells() const { return ncells_; }
+
+  //! Number of particles
+  Index nparticles() const { return nparticles_; }
+
+  //! Create nodes, cells and particles and add them to a mesh
+  bool create_mesh(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                   const std::map<unsigned, std::shared_ptr<Material>>&
+                       materials) const;
+
+  //! Create particles and add them to a mesh with its own topology
+  bool create_particles(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                        const std::map<unsigned, std::shared_ptr<Material>>&
+                            materials) const;
+
+ private:
+  //! Order of nodes, cells or particles by id
+  struct IdLess {
+    template <typename T>
+    bool operator()(const std::shared_ptr<T>& lhs,
+                    const std::shared_ptr<T>& rhs) const {
+      return lhs->id() < rhs->id();
+    }
+  };
+
+  //! Stream buffer reading a range of memory
+  class MemoryBuffer : public std::streambuf {
+   public:
+    MemoryBuffer(const char* data, std::size_t size) {
+      char* begin = const_cast<char*>(data);
+      this->setg(begin, begin, begin + size);
+    }
+  };
+
+  //! Chunk of elements in the file
+  struct Chunk {
+    //! Offset from the beginning of the file
+    std::uint64_t offset;
+    //! Size in bytes
+    std::uint64_t size;
+  };
+
+  //! Serialize elements in chunks in parallel
+  template <typename T, typename Tsave>
+  std::vector<std::string> save_chunks(
+      const std::vector<std::shared_ptr<T>>& elements, Tsave save) const;
+
+  //! Deserialize chunks in parallel
+  template <typename Tload>
+  void load_chunks(const std::vector<Chunk>& chunks, Index nelements,
+                   Tload load) const;
+
+  //! Deserialize nodes in the node pool of a mesh
+  std::vector<std::shared_ptr<Node<Tdim>>> load_nodes(
+      const std::shared_ptr<Mesh<Tdim>>& mesh) const;
+
+  //! Deserialize particles in the particle pool of a mesh
+  std::vector<std::shared_ptr<Particle<Tdim>>> load_particles(
+      const std::shared_ptr<Mesh<Tdim>>& mesh,
+      const std::map<unsigned, std::shared_ptr<Material>>& materials) const;
+
+  //! Number of elements per chunk
+  std::size_t chunk_size_;
+  //! Number of elements per chunk of the mapped checkpoint
+  std::uint64_t file_chunk_size_{0};
+  //! Step counter
+  unsigned long long step_{0};
+  //! Number of nodes
+  Index nnodes_{0};
+  //! Number of cells
+  Index ncells_{0};
+  //! Number of particles
+  Index nparticles_{0};
+  //! Mapped file
+  MemoryMap file_;
+  //! Chunks of nodes
+  std::vector<Chunk> node_chunks_;
+  //! Chunks of cells
+  std::vector<Chunk> cell_chunks_;
+  //! Chunks of particles
+  std::vector<Chunk> particle_chunks_;
+};  // Checkpoint class
+}  // mpm namespace
+
+#include "checkpoint.tcc"
+
+#endif  // MPM_IO_CHECKPOINT_H_
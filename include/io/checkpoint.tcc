@@ -0,0 +1,383 @@
+//! Write the state of a mesh and the step counter
+//! \param[in] filename Name of the file
+//! \param[in] mesh Mesh
+//! \param[in] step Step counter
+//! \retval status Return false if the file cannot be written
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Checkpoint<Tdim>::write(const std::string& filename,
+                                  const std::shared_ptr<Mesh<Tdim>>& mesh,
+                                  unsigned long long step) const {
+  bool status = false;
+  try {
+    const std::string data = this->image(mesh, step);
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      throw std::runtime_error("Cannot open checkpoint file: " + filename);
+    file.write(data.data(), data.size());
+    if (!file.good())
+      throw std::runtime_error("Cannot write checkpoint file: " + filename);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Serialize the state of a mesh and the step counter
+//! \details The image is a magic string, the size of the header, a portable
+//! binary header with the counts and the sizes of the chunks, and the
+//! chunks of nodes, cells and particles. Numbers have a fixed size, so the
+//! images of a mesh with the same elements have the same layout.
+//! \param[in] mesh Mesh
+//! \param[in] step Step counter
+//! \retval image Content of a checkpoint file
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+std::string mpm::Checkpoint<Tdim>::image(
+    const std::shared_ptr<Mesh<Tdim>>& mesh, unsigned long long step) const {
+  // Collect elements and sort them by id
+  tbb::concurrent_vector<std::shared_ptr<mpm::Node<Tdim>>> node_list;
+  mesh->iterate_over_nodes([&](std::shared_ptr<mpm::Node<Tdim>> node) {
+    node_list.push_back(node);
+  });
+  tbb::concurrent_vector<std::shared_ptr<mpm::Cell<Tdim>>> cell_list;
+  mesh->iterate_over_cells([&](std::shared_ptr<mpm::Cell<Tdim>> cell) {
+    cell_list.push_back(cell);
+  });
+  tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Tdim>>> particle_list;
+  mesh->iterate_over_particles(
+      [&](std::shared_ptr<mpm::Particle<Tdim>> particle) {
+        particle_list.push_back(particle);
+      });
+  std::vector<std::shared_ptr<mpm::Node<Tdim>>> nodes(node_list.begin(),
+                                                      node_list.end());
+  std::vector<std::shared_ptr<mpm::Cell<Tdim>>> cells(cell_list.begin(),
+                                                      cell_list.end());
+  std::vector<std::shared_ptr<mpm::Particle<Tdim>>> particles(
+      particle_list.begin(), particle_list.end());
+  tbb::parallel_sort(nodes.begin(), nodes.end(), IdLess());
+  tbb::parallel_sort(cells.begin(), cells.end(), IdLess());
+  tbb::parallel_sort(particles.begin(), particles.end(), IdLess());
+
+  // Serialize chunks in parallel
+  const auto node_chunks = this->save_chunks(
+      nodes, [](mpm::PortableBinaryOArchive& oa,
+                const std::shared_ptr<mpm::Node<Tdim>>& node) {
+        oa << *node;
+      });
+  const auto cell_chunks = this->save_chunks(
+      cells, [](mpm::PortableBinaryOArchive& oa,
+                const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
+        const Index id = cell->id();
+        const unsigned nnodes = cell->nnodes();
+        oa << id << nnodes;
+        for (unsigned i = 0; i < nnodes; ++i) {
+          const Index node = cell->node(i)->id();
+          oa << node;
+        }
+      });
+  const auto particle_chunks = this->save_chunks(
+      particles, [](mpm::PortableBinaryOArchive& oa,
+                    const std::shared_ptr<mpm::Particle<Tdim>>& particle) {
+        oa << *particle;
+        const unsigned material =
+            particle->material() ? particle->material()->id()
+                                 : std::numeric_limits<unsigned>::max();
+        const std::vector<double> state =
+            particle->material()
+                ? particle->material()->state().values(particle->state())
+                : std::vector<double>();
+        oa << material << state;
+      });
+
+  // Header with counts and sizes of chunks
+  const auto sizes = [](const std::vector<std::string>& chunks) {
+    std::vector<std::uint64_t> sizes;
+    for (const auto& chunk : chunks) sizes.emplace_back(chunk.size());
+    return sizes;
+  };
+  std::ostringstream header(std::ios::binary);
+  {
+    mpm::PortableBinaryOArchive oa(header);
+    const unsigned dimension = Tdim;
+    const std::uint64_t chunk_size = chunk_size_;
+    const std::uint64_t nnodes = nodes.size(), ncells = cells.size(),
+                        nparticles = particles.size();
+    oa << dimension << chunk_size << step << nnodes << ncells << nparticles;
+    oa << sizes(node_chunks) << sizes(cell_chunks) << sizes(particle_chunks);
+  }
+  const std::string header_data = header.str();
+
+  std::string data("MPMCKPT", 8);
+  const std::uint64_t header_size = header_data.size();
+  for (unsigned i = 0; i < 8; ++i)
+    data.push_back(static_cast<char>((header_size >> (8 * i)) & 0xff));
+  data += header_data;
+  for (const auto* chunks : {&node_chunks, &cell_chunks, &particle_chunks})
+    for (const auto& chunk : *chunks) data += chunk;
+  return data;
+}
+
+//! Serialize elements in chunks in parallel
+//! \param[in] elements Elements
+//! \param[in] save Callable saving an element to an archive
+//! \retval chunks Serialized chunks
+//! \tparam T Node, cell or particle
+//! \tparam Tsave Callable object
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+template <typename T, typename Tsave>
+std::vector<std::string> mpm::Checkpoint<Tdim>::save_chunks(
+    const std::vector<std::shared_ptr<T>>& elements, Tsave save) const {
+  const std::size_t nchunks =
+      (elements.size() + chunk_size_ - 1) / chunk_size_;
+  std::vector<std::string> chunks(nchunks);
+  tbb::parallel_for(std::size_t(0), nchunks, [&](std::size_t chunk) {
+    std::ostringstream os(std::ios::binary);
+    {
+      mpm::PortableBinaryOArchive oa(os, boost::archive::no_header);
+      const std::size_t end =
+          std::min(elements.size(), (chunk + 1) * chunk_size_);
+      for (std::size_t i = chunk * chunk_size_; i < end; ++i)
+        save(oa, elements[i]);
+    }
+    chunks[chunk] = os.str();
+  });
+  return chunks;
+}
+
+//! Map and validate a checkpoint
+//! \details Only the header is read
+//! \param[in] filename Name of the file
+//! \retval status Return false if the file is not a valid checkpoint
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Checkpoint<Tdim>::read(const std::string& filename) {
+  bool status = false;
+  try {
+    if (!file_.open(filename))
+      throw std::runtime_error("Cannot map checkpoint file: " + filename);
+    const std::uint64_t size = file_.size();
+    if (size < 16 || std::memcmp(file_.data(), "MPMCKPT", 8) != 0)
+      throw std::runtime_error("Invalid checkpoint file: " + filename);
+    std::uint64_t header_size = 0;
+    for (unsigned i = 0; i < 8; ++i)
+      header_size |= std::uint64_t(static_cast<unsigned char>(
+                         file_.data()[8 + i]))
+                     << (8 * i);
+    if (header_size > size - 16)
+      throw std::runtime_error("Checkpoint header is truncated");
+
+    unsigned dimension = 0;
+    std::uint64_t nnodes = 0, ncells = 0, nparticles = 0;
+    std::vector<std::uint64_t> sizes[3];
+    {
+      MemoryBuffer buffer(file_.data() + 16, header_size);
+      std::istream is(&buffer);
+      mpm::PortableBinaryIArchive ia(is);
+      ia >> dimension >> file_chunk_size_ >> step_ >> nnodes >> ncells >>
+          nparticles;
+      ia >> sizes[0] >> sizes[1] >> sizes[2];
+    }
+    if (dimension != Tdim)
+      throw std::runtime_error("Checkpoint has a different dimension");
+    nnodes_ = nnodes;
+    ncells_ = ncells;
+    nparticles_ = nparticles;
+
+    // Chunks follow the header
+    const Index counts[3] = {nnodes_, ncells_, nparticles_};
+    std::vector<Chunk>* chunks[3] = {&node_chunks_, &cell_chunks_,
+                                     &particle_chunks_};
+    std::uint64_t offset = 16 + header_size;
+    for (unsigned i = 0; i < 3; ++i) {
+      if (file_chunk_size_ == 0 ||
+          sizes[i].size() !=
+              (counts[i] + file_chunk_size_ - 1) / file_chunk_size_)
+        throw std::runtime_error("Checkpoint chunks are inconsistent");
+      chunks[i]->clear();
+      for (const auto chunk_size : sizes[i]) {
+        if (chunk_size > size - offset)
+          throw std::runtime_error("Checkpoint is truncated");
+        chunks[i]->push_back(Chunk{offset, chunk_size});
+        offset += chunk_size;
+      }
+    }
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+    file_.close();
+    step_ = 0;
+    nnodes_ = ncells_ = nparticles_ = 0;
+    node_chunks_.clear();
+    cell_chunks_.clear();
+    particle_chunks_.clear();
+  }
+  return status;
+}
+
+//! Deserialize chunks in parallel
+//! \param[in] chunks Chunks of elements
+//! \param[in] nelements Number of elements
+//! \param[in] load Callable loading an element from an archive by index
+//! \tparam Tload Callable object
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+template <typename Tload>
+void mpm::Checkpoint<Tdim>::load_chunks(const std::vector<Chunk>& chunks,
+                                        Index nelements, Tload load) const {
+  tbb::parallel_for(std::size_t(0), chunks.size(), [&](std::size_t chunk) {
+    MemoryBuffer buffer(file_.data() + chunks[chunk].offset,
+                        chunks[chunk].size);
+    std::istream is(&buffer);
+    mpm::PortableBinaryIArchive ia(is, boost::archive::no_header);
+    const Index end =
+        std::min<Index>(nelements, (chunk + 1) * file_chunk_size_);
+    for (Index i = chunk * file_chunk_size_; i < end; ++i) load(ia, i);
+  });
+}
+
+//! Deserialize nodes in the node pool of a mesh
+//! \param[in] mesh Mesh
+//! \retval nodes Nodes sorted by id
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+std::vector<std::shared_ptr<mpm::Node<Tdim>>>
+    mpm::Checkpoint<Tdim>::load_nodes(
+        const std::shared_ptr<Mesh<Tdim>>& mesh) const {
+  std::vector<std::shared_ptr<mpm::Node<Tdim>>> nodes(nnodes_);
+  this->load_chunks(
+      node_chunks_, nnodes_, [&](mpm::PortableBinaryIArchive& ia, Index i) {
+        auto node = mesh->make_node(0, VectorDim::Zero(), Tdim);
+        ia >> *node;
+        nodes[i] = node;
+      });
+  return nodes;
+}
+
+//! Deserialize particles in the particle pool of a mesh
+//! \param[in] mesh Mesh
+//! \param[in] materials Materials by id
+//! \retval particles Particles sorted by id
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+std::vector<std::shared_ptr<mpm::Particle<Tdim>>>
+    mpm::Checkpoint<Tdim>::load_particles(
+        const std::shared_ptr<Mesh<Tdim>>& mesh,
+        const std::map<unsigned, std::shared_ptr<Material>>& materials)
+        const {
+  std::vector<std::shared_ptr<mpm::Particle<Tdim>>> particles(nparticles_);
+  std::atomic<bool> valid{true};
+  this->load_chunks(
+      particle_chunks_, nparticles_,
+      [&](mpm::PortableBinaryIArchive& ia, Index i) {
+        auto particle = mesh->make_particle(0, VectorDim::Zero().eval());
+        unsigned material = 0;
+        std::vector<double> state;
+        ia >> *particle >> material >> state;
+        if (material != std::numeric_limits<unsigned>::max()) {
+          // Materials declare the same state variables
+          const auto itr = materials.find(material);
+          if (itr != materials.end() &&
+              itr->second->state().size() == state.size()) {
+            particle->assign_material(itr->second.get());
+            if (!state.empty())
+              itr->second->state().assign(particle->state(), state);
+          } else {
+            valid = false;
+          }
+        }
+        particles[i] = particle;
+      });
+  if (!valid) throw std::runtime_error("Checkpoint material is not defined");
+  return particles;
+}
+
+//! Create nodes, cells and particles and add them to a mesh
+//! \param[in] mesh Mesh without the nodes, cells and particles
+//! \param[in] materials Materials by id
+//! \retval status Return false if the checkpoint is invalid, a material is
+//! missing or an id exists in the mesh
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Checkpoint<Tdim>::create_mesh(
+    const std::shared_ptr<Mesh<Tdim>>& mesh,
+    const std::map<unsigned, std::shared_ptr<Material>>& materials) const {
+  bool status = false;
+  try {
+    if (!file_.is_open()) throw std::runtime_error("No checkpoint is read");
+    const auto nodes = this->load_nodes(mesh);
+
+    // Shape functions by number of nodes
+    std::vector<std::shared_ptr<mpm::ShapeFn<Tdim>>> shapefns;
+    for (unsigned i = 0; i <= mpm::Cell<Tdim>::max_nnodes; ++i)
+      shapefns.emplace_back(mpm::BinaryCells<Tdim>::shapefn(i));
+
+    std::vector<std::shared_ptr<mpm::Cell<Tdim>>> cells(ncells_);
+    std::atomic<bool> valid{true};
+    this->load_chunks(
+        cell_chunks_, ncells_, [&](mpm::PortableBinaryIArchive& ia, Index i) {
+          Index id = 0;
+          unsigned nnodes = 0;
+          ia >> id >> nnodes;
+          if (nnodes >= shapefns.size() || shapefns[nnodes] == nullptr) {
+            valid = false;
+            return;
+          }
+          auto cell = mesh->make_cell(id, nnodes, shapefns[nnodes]);
+          for (unsigned j = 0; j < nnodes; ++j) {
+            Index node_id = 0;
+            ia >> node_id;
+            // Nodes are sorted by id
+            const auto node = std::lower_bound(
+                nodes.begin(), nodes.end(), node_id,
+                [](const std::shared_ptr<mpm::Node<Tdim>>& node, Index id) {
+                  return node->id() < id;
+                });
+            if (node == nodes.end() || (*node)->id() != node_id) {
+              valid = false;
+              return;
+            }
+            cell->add_node(j, node->get());
+          }
+          cell->initialise();
+          cells[i] = cell;
+        });
+    if (!valid) throw std::runtime_error("Checkpoint cells are invalid");
+
+    const auto particles = this->load_particles(mesh, materials);
+    if (!mesh->add_nodes(nodes) || !mesh->add_cells(cells) ||
+        !mesh->add_particles(particles))
+      throw std::runtime_error("Checkpoint is not added to mesh");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Create particles and add them to a mesh with its own topology
+//! \details For meshes that create nodes and cells on demand, such as
+//! structured and sparse meshes, nodes and cells are created again when
+//! particles are located. Nodal kinematics are recomputed by each step.
+//! \param[in] mesh Mesh
+//! \param[in] materials Materials by id
+//! \retval status Return false if the checkpoint is invalid, a material is
+//! missing or an id exists in the mesh
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Checkpoint<Tdim>::create_particles(
+    const std::shared_ptr<Mesh<Tdim>>& mesh,
+    const std::map<unsigned, std::shared_ptr<Material>>& materials) const {
+  bool status = false;
+  try {
+    if (!file_.is_open()) throw std::runtime_error("No checkpoint is read");
+    if (!mesh->add_particles(this->load_particles(mesh, materials)))
+      throw std::runtime_error("Checkpoint particles are not added to mesh");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
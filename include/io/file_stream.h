@@ -0,0 +1,92 @@
+#ifndef MPM_IO_FILE_STREAM_H_
+#define MPM_IO_FILE_STREAM_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace mpm {
+
+//! FileStream class
+//! \brief Buffered reader of ASCII and binary files
+//! \details Reads a file in chunks through a fixed buffer and parses
+//! numbers without locale or stream overhead, so large files are processed
+//! at the speed of the disk. ASCII tokens are separated by white space.
+class FileStream {
+ public:
+  //! Constructor with buffer size
+  explicit FileStream(std::size_t buffer_size = 1 << 20);
+
+  //! Destructor
+  ~FileStream();
+
+  //! Delete copy constructor
+  FileStream(const FileStream&) = delete;
+
+  //! Delete assignement operator
+  FileStream& operator=(const FileStream&) = delete;
+
+  //! Open a file
+  bool open(const std::string& filename);
+
+  //! Close the file
+  void close();
+
+  //! Read a token delimited by white space
+  bool read_token(std::string* token);
+
+  //! Read an integer
+  template <typename Tint>
+  bool read_integer(Tint* value);
+
+  //! Read a floating point number
+  bool read_double(double* value);
+
+  //! Read raw bytes
+  bool read_bytes(void* data, std::size_t nbytes);
+
+  //! Skip the rest of the current line
+  bool skip_line();
+
+  //! Skip past the next occurrence of a marker
+  bool skip_to(const std::string& marker);
+
+ private:
+  //! Make at least n bytes available in the buffer if the file has them
+  bool fill(std::size_t n);
+
+  //! Skip white space
+  void skip_whitespace();
+
+  //! File
+  std::FILE* file_{nullptr};
+  //! Buffer
+  std::vector<char> buffer_;
+  //! Position of the next byte in the buffer
+  std::size_t begin_{0};
+  //! End of valid bytes in the buffer
+  std::size_t end_{0};
+  //! End of file is reached
+  bool eof_{true};
+};  // FileStream class
+
+//! Parse a floating point number
+inline bool parse_double(const char* begin, const char* end, double* value,
+                         const char** next);
+
+//! Parse an integer
+template <typename Tint>
+inline bool parse_integer(const char* begin, const char* end, Tint* value,
+                          const char** next);
+
+}  // mpm namespace
+
+#include "file_stream.tcc"
+
+#endif  // MPM_IO_FILE_STREAM_H_
@@ -0,0 +1,240 @@
+//! Constructor with buffer size
+//! \param[in] buffer_size Size of the read buffer in bytes
+inline mpm::FileStream::FileStream(std::size_t buffer_size)
+    : buffer_(std::max<std::size_t>(buffer_size, 256)) {}
+
+//! Destructor
+inline mpm::FileStream::~FileStream() { this->close(); }
+
+//! Open a file
+//! \param[in] filename Name of the file
+//! \retval status Return false if the file cannot be opened
+inline bool mpm::FileStream::open(const std::string& filename) {
+  this->close();
+  file_ = std::fopen(filename.c_str(), "rb");
+  begin_ = end_ = 0;
+  eof_ = (file_ == nullptr);
+  return file_ != nullptr;
+}
+
+//! Close the file
+inline void mpm::FileStream::close() {
+  if (file_ != nullptr) std::fclose(file_);
+  file_ = nullptr;
+  begin_ = end_ = 0;
+  eof_ = true;
+}
+
+//! Make at least n bytes available in the buffer if the file has them
+//! \param[in] n Number of bytes, at most the size of the buffer
+//! \retval status Return false if fewer bytes remain in the file
+inline bool mpm::FileStream::fill(std::size_t n) {
+  if (end_ - begin_ >= n) return true;
+  if (eof_) return false;
+  // Move the remaining bytes to the front and read more
+  std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+  end_ -= begin_;
+  begin_ = 0;
+  while (end_ < buffer_.size() && !eof_) {
+    const std::size_t nread =
+        std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+    if (nread == 0) eof_ = true;
+    end_ += nread;
+  }
+  return end_ - begin_ >= n;
+}
+
+//! Skip white space
+inline void mpm::FileStream::skip_whitespace() {
+  while (this->fill(1)) {
+    const char c = buffer_[begin_];
+    if (!(c == ' ' || c == '\n' || c == '\r' || c == '\t')) return;
+    ++begin_;
+  }
+}
+
+//! Read a token delimited by white space
+//! \param[out] token Token
+//! \retval status Return false at the end of the file
+inline bool mpm::FileStream::read_token(std::string* token) {
+  this->skip_whitespace();
+  token->clear();
+  while (this->fill(1)) {
+    const char c = buffer_[begin_];
+    if (c == ' ' || c == '\n' || c == '\r' || c == '\t') break;
+    token->push_back(c);
+    ++begin_;
+  }
+  return !token->empty();
+}
+
+//! Read an integer
+//! \param[out] value Integer
+//! \retval status Return false if no integer is found
+//! \tparam Tint Integer type
+template <typename Tint>
+inline bool mpm::FileStream::read_integer(Tint* value) {
+  this->skip_whitespace();
+  // Numbers are shorter than 64 characters
+  this->fill(64);
+  const char* next = nullptr;
+  const bool status = mpm::parse_integer(
+      buffer_.data() + begin_, buffer_.data() + end_, value, &next);
+  if (status) begin_ = next - buffer_.data();
+  return status;
+}
+
+//! Read a floating point number
+//! \param[out] value Number
+//! \retval status Return false if no number is found
+inline bool mpm::FileStream::read_double(double* value) {
+  this->skip_whitespace();
+  // Numbers are shorter than 64 characters
+  this->fill(64);
+  const char* next = nullptr;
+  const bool status = mpm::parse_double(
+      buffer_.data() + begin_, buffer_.data() + end_, value, &next);
+  if (status) begin_ = next - buffer_.data();
+  return status;
+}
+
+//! Read raw bytes
+//! \param[out] data Destination of at least nbytes
+//! \param[in] nbytes Number of bytes
+//! \retval status Return false if the file ends before nbytes
+inline bool mpm::FileStream::read_bytes(void* data, std::size_t nbytes) {
+  char* destination = static_cast<char*>(data);
+  while (nbytes > 0) {
+    if (!this->fill(1)) return false;
+    const std::size_t n = std::min(nbytes, end_ - begin_);
+    std::memcpy(destination, buffer_.data() + begin_, n);
+    begin_ += n;
+    destination += n;
+    nbytes -= n;
+  }
+  return true;
+}
+
+//! Skip the rest of the current line
+//! \retval status Return false at the end of the file
+inline bool mpm::FileStream::skip_line() {
+  while (this->fill(1)) {
+    if (buffer_[begin_++] == '\n') return true;
+  }
+  return false;
+}
+
+//! Skip past the next occurrence of a marker
+//! \details The first character of the marker must not appear again in
+//! the marker, as for section markers such as $EndNodes
+//! \param[in] marker Marker
+//! \retval status Return false if the marker is not found
+inline bool mpm::FileStream::skip_to(const std::string& marker) {
+  std::size_t matched = 0;
+  while (matched < marker.size() && this->fill(1)) {
+    const char c = buffer_[begin_++];
+    if (c == marker[matched])
+      ++matched;
+    else
+      matched = (c == marker[0]) ? 1 : 0;
+  }
+  return matched == marker.size();
+}
+
+//! Parse an integer
+//! \param[in] begin Begin of the characters
+//! \param[in] end End of the characters
+//! \param[out] value Integer
+//! \param[out] next Character after the integer
+//! \retval status Return false if no digit is found
+//! \tparam Tint Integer type
+template <typename Tint>
+inline bool mpm::parse_integer(const char* begin, const char* end, Tint* value,
+                               const char** next) {
+  const char* p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+  const char* digits = p;
+  unsigned long long number = 0;
+  while (p < end && *p >= '0' && *p <= '9') number = number * 10 + (*p++ - '0');
+  if (p == digits) return false;
+  *value = negative ? static_cast<Tint>(-static_cast<long long>(number))
+                    : static_cast<Tint>(number);
+  *next = p;
+  return true;
+}
+
+//! Parse a floating point number
+//! \details Digits are accumulated in a 64-bit integer and scaled by an
+//! exact power of ten, which is correctly rounded if the mantissa is exact
+//! in double and the exponent is within 22. Other numbers are converted by
+//! strtod, so every number is correctly rounded. The decimal separator is a
+//! point.
+//! \param[in] begin Begin of the characters
+//! \param[in] end End of the characters
+//! \param[out] value Number
+//! \param[out] next Character after the number
+//! \retval status Return false if no digit is found
+inline bool mpm::parse_double(const char* begin, const char* end,
+                              double* value, const char** next) {
+  // Exact powers of ten
+  static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+
+  const char* p = begin;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+  unsigned long long mantissa = 0;
+  int exponent = 0;
+  unsigned ndigits = 0;
+  bool digits = false;
+  // Integer part
+  for (; p < end && *p >= '0' && *p <= '9'; ++p, digits = true) {
+    if (ndigits < 19) {
+      mantissa = mantissa * 10 + (*p - '0');
+      if (mantissa) ++ndigits;
+    } else {
+      ++exponent;
+    }
+  }
+  // Fraction
+  if (p < end && *p == '.') {
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p, digits = true) {
+      if (ndigits < 19) {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa) ++ndigits;
+        --exponent;
+      }
+    }
+  }
+  if (!digits) return false;
+
+  // Exponent
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    int power = 0;
+    const char* q = nullptr;
+    if (mpm::parse_integer(p + 1, end, &power, &q)) {
+      exponent += power;
+      p = q;
+    }
+  }
+
+  // Largest mantissa exact in double
+  const unsigned long long exact = 1ULL << 53;
+  double number = static_cast<double>(mantissa);
+  if (mantissa == 0)
+    number = 0.;
+  else if (mantissa <= exact && exponent >= 0 && exponent <= 22)
+    number *= powers[exponent];
+  else if (mantissa <= exact && exponent < 0 && exponent >= -22)
+    number /= powers[-exponent];
+  else
+    number = std::abs(std::strtod(std::string(begin, p).c_str(), nullptr));
+
+  *value = negative ? -number : number;
+  *next = p;
+  return true;
+}
@@ -0,0 +1,109 @@
+#ifndef MPM_IO_INCREMENTAL_CHECKPOINT_H_
+#define MPM_IO_INCREMENTAL_CHECKPOINT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// TBB
+#include <tbb/parallel_for.h>
+
+#include <zlib.h>
+
+#include "io/checkpoint.h"
+#include "io/memory_map.h"
+#include "mesh.h"
+#include "serialize.h"
+
+namespace mpm {
+
+//! IncrementalCheckpoint class
+//! \brief Checkpoints written as a full base and deltas against it
+//! \details Every interval checkpoints, a full checkpoint is written as the
+//! base and kept in memory. Checkpoints in between are written as a delta:
+//! the checkpoint image is XORed word by word with the image of the base,
+//! split into blocks, and the blocks that changed are compressed with zlib
+//! in parallel. Numbers of unchanged elements give zero words and blocks
+//! without changes are not written. A delta refers to its base by name, in
+//! the same directory, and reconstruct rebuilds the full checkpoint of any
+//! step, which is then read as a Checkpoint.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class IncrementalCheckpoint {
+ public:
+  //! Constructor with the interval between bases and compression
+  //! \param[in] interval Number of checkpoints per base, including it
+  //! \param[in] level Compression level, from 1 (fast) to 9 (small)
+  //! \param[in] block_size Size of blocks of the delta (bytes)
+  //! \param[in] chunk_size Number of elements per chunk of checkpoints
+  explicit IncrementalCheckpoint(unsigned interval = 10, int level = 1,
+                                 std::size_t block_size = 1 << 16,
+                                 std::size_t chunk_size = 1 << 14)
+      : checkpoint_{chunk_size},
+        interval_{std::max(interval, 1u)},
+        level_{std::min(std::max(level, 1), 9)},
+        block_size_{std::max<std::size_t>(block_size, 8)} {}
+
+  //! Write a base or a delta checkpoint of a mesh and the step counter
+  bool write(const std::string& filename,
+             const std::shared_ptr<Mesh<Tdim>>& mesh, unsigned long long step);
+
+  //! Reconstruct the full checkpoint of a base or a delta
+  static bool reconstruct(const std::string& filename,
+                          const std::string& output);
+
+  //! Return true if the last checkpoint written is a base
+  bool base() const { return count_ == 1; }
+
+  //! Number of bytes written
+  std::uint64_t nbytes() const { return nbytes_; }
+
+  //! Number of bytes of the checkpoints written in full
+  std::uint64_t nbytes_full() const { return nbytes_full_; }
+
+ private:
+  //! Write an image as a delta against the base
+  std::uint64_t write_delta(const std::string& filename,
+                            const std::string& image) const;
+
+  //! Write a file
+  static void write_file(const std::string& filename, const std::string& data);
+
+  //! Directory of a file, with its separator
+  static std::string directory(const std::string& filename);
+
+  //! XOR of a block of an image with the base, zero beyond the base
+  static bool xor_block(const char* base, std::size_t base_size,
+                        std::size_t offset, const char* data,
+                        std::size_t size, char* delta);
+
+  //! Checkpoint
+  Checkpoint<Tdim> checkpoint_;
+  //! Number of checkpoints per base
+  unsigned interval_;
+  //! Compression level
+  int level_;
+  //! Size of blocks of the delta
+  std::size_t block_size_;
+  //! Number of checkpoints written since the base
+  unsigned count_{0};
+  //! Image of the base
+  std::string base_;
+  //! Name of the base file, without its directory
+  std::string base_name_;
+  //! Number of bytes written
+  std::uint64_t nbytes_{0};
+  //! Number of bytes of the checkpoints in full
+  std::uint64_t nbytes_full_{0};
+};  // IncrementalCheckpoint class
+}  // mpm namespace
+
+#include "incremental_checkpoint.tcc"
+
+#endif  // MPM_IO_INCREMENTAL_CHECKPOINT_H_
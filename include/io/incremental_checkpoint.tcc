@@ -0,0 +1,239 @@
+//! Write a base or a delta checkpoint of a mesh and the step counter
+//! \details A base is written first, after interval checkpoints and after
+//! a base that could not be written
+//! \param[in] filename Name of the file
+//! \param[in] mesh Mesh
+//! \param[in] step Step counter
+//! \retval status Return false if the file cannot be written
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::IncrementalCheckpoint<Tdim>::write(
+    const std::string& filename, const std::shared_ptr<Mesh<Tdim>>& mesh,
+    unsigned long long step) {
+  bool status = false;
+  try {
+    std::string image = checkpoint_.image(mesh, step);
+    const std::uint64_t size = image.size();
+    if (base_.empty() || count_ >= interval_) {
+      base_.clear();
+      write_file(filename, image);
+      base_.swap(image);
+      base_name_ = filename.substr(directory(filename).size());
+      count_ = 1;
+      nbytes_ += size;
+    } else {
+      nbytes_ += this->write_delta(filename, image);
+      ++count_;
+    }
+    nbytes_full_ += size;
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Write an image as a delta against the base
+//! \details The file is a magic string, the size of the header, a portable
+//! binary header with the name and size of the base, the size of the image
+//! and of the blocks and the compressed size of each block, zero if the
+//! block has no changes, and the compressed blocks
+//! \param[in] filename Name of the file
+//! \param[in] image Checkpoint image
+//! \retval nbytes Number of bytes written
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+std::uint64_t mpm::IncrementalCheckpoint<Tdim>::write_delta(
+    const std::string& filename, const std::string& image) const {
+  // XOR and compress blocks in parallel
+  const std::size_t nblocks = (image.size() + block_size_ - 1) / block_size_;
+  std::vector<std::string> blocks(nblocks);
+  std::vector<int> results(nblocks, Z_OK);
+  tbb::parallel_for(std::size_t(0), nblocks, [&](std::size_t i) {
+    const std::size_t offset = i * block_size_;
+    const std::size_t size = std::min(block_size_, image.size() - offset);
+    std::string delta(size, '\0');
+    if (!xor_block(base_.data(), base_.size(), offset, image.data() + offset,
+                   size, &delta[0]))
+      return;
+    uLongf length = compressBound(size);
+    blocks[i].resize(length);
+    results[i] = compress2(reinterpret_cast<Bytef*>(&blocks[i][0]), &length,
+                           reinterpret_cast<const Bytef*>(delta.data()),
+                           size, level_);
+    blocks[i].resize(length);
+  });
+  if (std::any_of(results.begin(), results.end(),
+                  [](int result) { return result != Z_OK; }))
+    throw std::runtime_error("Checkpoint delta is not compressed");
+
+  std::vector<std::uint64_t> sizes;
+  for (const auto& block : blocks) sizes.emplace_back(block.size());
+  std::ostringstream header(std::ios::binary);
+  {
+    mpm::PortableBinaryOArchive oa(header);
+    const unsigned dimension = Tdim;
+    const std::uint64_t base_size = base_.size(), image_size = image.size(),
+                        block_size = block_size_;
+    oa << dimension << base_name_ << base_size << image_size << block_size;
+    oa << sizes;
+  }
+  const std::string header_data = header.str();
+
+  std::string data("MPMDELT", 8);
+  const std::uint64_t header_size = header_data.size();
+  for (unsigned i = 0; i < 8; ++i)
+    data.push_back(static_cast<char>((header_size >> (8 * i)) & 0xff));
+  data += header_data;
+  for (const auto& block : blocks) data += block;
+  write_file(filename, data);
+  return data.size();
+}
+
+//! Reconstruct the full checkpoint of a base or a delta
+//! \details A base is copied. The base of a delta is read from the
+//! directory of the delta.
+//! \param[in] filename Name of the base or delta file
+//! \param[in] output Name of the full checkpoint file
+//! \retval status Return false if the file or its base is invalid
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::IncrementalCheckpoint<Tdim>::reconstruct(const std::string& filename,
+                                                   const std::string& output) {
+  bool status = false;
+  try {
+    MemoryMap file;
+    if (!file.open(filename))
+      throw std::runtime_error("Cannot map checkpoint file: " + filename);
+    const std::uint64_t size = file.size();
+    if (size >= 16 && std::memcmp(file.data(), "MPMCKPT", 8) == 0) {
+      write_file(output, std::string(file.data(), size));
+      return true;
+    }
+    if (size < 16 || std::memcmp(file.data(), "MPMDELT", 8) != 0)
+      throw std::runtime_error("Invalid checkpoint file: " + filename);
+    std::uint64_t header_size = 0;
+    for (unsigned i = 0; i < 8; ++i)
+      header_size |=
+          std::uint64_t(static_cast<unsigned char>(file.data()[8 + i]))
+          << (8 * i);
+    if (header_size > size - 16)
+      throw std::runtime_error("Checkpoint header is truncated");
+
+    unsigned dimension = 0;
+    std::string base_name;
+    std::uint64_t base_size = 0, image_size = 0, block_size = 0;
+    std::vector<std::uint64_t> sizes;
+    {
+      std::istringstream is(std::string(file.data() + 16, header_size),
+                            std::ios::binary);
+      mpm::PortableBinaryIArchive ia(is);
+      ia >> dimension >> base_name >> base_size >> image_size >> block_size;
+      ia >> sizes;
+    }
+    if (dimension != Tdim)
+      throw std::runtime_error("Checkpoint has a different dimension");
+    if (block_size == 0 ||
+        sizes.size() != (image_size + block_size - 1) / block_size)
+      throw std::runtime_error("Checkpoint delta blocks are inconsistent");
+
+    // Offsets of compressed blocks
+    std::vector<std::uint64_t> offsets(sizes.size());
+    std::uint64_t offset = 16 + header_size;
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+      if (sizes[i] > size - offset)
+        throw std::runtime_error("Checkpoint delta is truncated");
+      offsets[i] = offset;
+      offset += sizes[i];
+    }
+
+    MemoryMap base;
+    const std::string base_filename = directory(filename) + base_name;
+    if (!base.open(base_filename) || base.size() != base_size ||
+        base_size < 16 || std::memcmp(base.data(), "MPMCKPT", 8) != 0)
+      throw std::runtime_error("Invalid checkpoint base: " + base_filename);
+
+    // Decompress blocks and XOR them with the base in parallel
+    std::string image(image_size, '\0');
+    std::vector<char> valid(sizes.size(), 1);
+    tbb::parallel_for(std::size_t(0), sizes.size(), [&](std::size_t i) {
+      const std::size_t begin = i * block_size;
+      const std::size_t length = std::min(block_size, image_size - begin);
+      std::string delta(length, '\0');
+      if (sizes[i] != 0) {
+        uLongf nbytes = length;
+        valid[i] = uncompress(reinterpret_cast<Bytef*>(&delta[0]), &nbytes,
+                              reinterpret_cast<const Bytef*>(file.data() +
+                                                             offsets[i]),
+                              sizes[i]) == Z_OK &&
+                   nbytes == length;
+      }
+      xor_block(base.data(), base_size, begin, delta.data(), length,
+                &image[begin]);
+    });
+    if (std::count(valid.begin(), valid.end(), 0) != 0)
+      throw std::runtime_error("Checkpoint delta is corrupt: " + filename);
+    write_file(output, image);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Write a file
+//! \param[in] filename Name of the file
+//! \param[in] data Content of the file
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::IncrementalCheckpoint<Tdim>::write_file(const std::string& filename,
+                                                  const std::string& data) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Cannot open checkpoint file: " + filename);
+  file.write(data.data(), data.size());
+  if (!file.good())
+    throw std::runtime_error("Cannot write checkpoint file: " + filename);
+}
+
+//! Directory of a file, with its separator
+//! \param[in] filename Name of the file
+//! \retval directory Directory, empty for the working directory
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+std::string mpm::IncrementalCheckpoint<Tdim>::directory(
+    const std::string& filename) {
+  const auto separator = filename.find_last_of('/');
+  return (separator == std::string::npos) ? std::string()
+                                          : filename.substr(0, separator + 1);
+}
+
+//! XOR of a block of an image with the base, zero beyond the base
+//! \details Bytes are combined as 8-byte words, so a double that does not
+//! change gives a zero word
+//! \param[in] base Image of the base
+//! \param[in] base_size Size of the base
+//! \param[in] offset Offset of the block in the image
+//! \param[in] data Block of the image
+//! \param[in] size Size of the block
+//! \param[out] delta XOR of the block with the base
+//! \retval changed Return true if the block differs from the base
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::IncrementalCheckpoint<Tdim>::xor_block(
+    const char* base, std::size_t base_size, std::size_t offset,
+    const char* data, std::size_t size, char* delta) {
+  std::uint64_t changed = 0;
+  for (std::size_t i = 0; i < size; i += 8) {
+    const std::size_t nbytes = std::min<std::size_t>(8, size - i);
+    std::uint64_t word = 0, reference = 0;
+    std::memcpy(&word, data + i, nbytes);
+    if (offset + i < base_size)
+      std::memcpy(&reference, base + offset + i,
+                  std::min(nbytes, base_size - offset - i));
+    word ^= reference;
+    std::memcpy(delta + i, &word, nbytes);
+    changed |= word;
+  }
+  return changed != 0;
+}
@@ -0,0 +1,57 @@
+#ifndef MPM_IO_MEMORY_MAP_H_
+#define MPM_IO_MEMORY_MAP_H_
+
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mpm {
+
+//! MemoryMap class
+//! \brief Read-only memory map of a file
+//! \details The file is mapped into the address space, so pages are read
+//! on demand by the kernel and can be shared by threads without copies
+class MemoryMap {
+ public:
+  //! Default constructor
+  MemoryMap() = default;
+
+  //! Destructor
+  ~MemoryMap() { this->close(); }
+
+  //! Delete copy constructor
+  MemoryMap(const MemoryMap&) = delete;
+
+  //! Delete assignement operator
+  MemoryMap& operator=(const MemoryMap&) = delete;
+
+  //! Map a file
+  bool open(const std::string& filename);
+
+  //! Unmap the file
+  void close();
+
+  //! Return true if a file is mapped
+  bool is_open() const { return data_ != nullptr; }
+
+  //! Return the first byte of the file
+  const char* data() const { return data_; }
+
+  //! Return the size of the file in bytes
+  std::size_t size() const { return size_; }
+
+ private:
+  //! Mapped bytes
+  const char* data_{nullptr};
+  //! Size of the file
+  std::size_t size_{0};
+};  // MemoryMap class
+}  // mpm namespace
+
+#include "memory_map.tcc"
+
+#endif  // MPM_IO_MEMORY_MAP_H_
@@ -0,0 +1,30 @@
+//! Map a file
+//! \param[in] filename Name of the file
+//! \retval status Return false if the file cannot be mapped or is empty
+inline bool mpm::MemoryMap::open(const std::string& filename) {
+  this->close();
+  const int descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (descriptor < 0) return false;
+
+  struct stat status;
+  if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+    void* data = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE,
+                        descriptor, 0);
+    if (data != MAP_FAILED) {
+      // Pages are read in order by the parsers
+      ::madvise(data, status.st_size, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(data);
+      size_ = status.st_size;
+    }
+  }
+  // The mapping remains valid after the descriptor is closed
+  ::close(descriptor);
+  return data_ != nullptr;
+}
+
+//! Unmap the file
+inline void mpm::MemoryMap::close() {
+  if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+}
@@ -0,0 +1,154 @@
+#ifndef MPM_IO_READ_MESH_GMSH_H_
+#define MPM_IO_READ_MESH_GMSH_H_
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/parallel_for.h>
+
+#include "hex_shapefn.h"
+#include "io/file_stream.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+
+namespace mpm {
+
+//! Gmsh cells of a dimension
+//! \brief Shape function of the Gmsh element types read as cells
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+struct GmshCells;
+
+//! Quadrilateral cells: quad4 (3), quad9 (10) and quad8 (16)
+template <>
+struct GmshCells<2> {
+  //! Return true if an element type is a cell
+  static bool cell(unsigned type) {
+    return type == 3 || type == 10 || type == 16;
+  }
+
+  //! Return shape function of an element type, nullptr if not a cell
+  static std::shared_ptr<ShapeFn<2>> shapefn(unsigned type) {
+    switch (type) {
+      case 3:
+        return std::make_shared<QuadrilateralShapeFn<2>>(4);
+      case 10:
+        return std::make_shared<QuadrilateralShapeFn<2>>(9);
+      case 16:
+        return std::make_shared<QuadrilateralShapeFn<2>>(8);
+      default:
+        return nullptr;
+    }
+  }
+};
+
+//! Hexahedron cells: hex8 (5) and hex20 (17)
+template <>
+struct GmshCells<3> {
+  //! Return true if an element type is a cell
+  static bool cell(unsigned type) { return type == 5 || type == 17; }
+
+  //! Return shape function of an element type, nullptr if not a cell
+  static std::shared_ptr<ShapeFn<3>> shapefn(unsigned type) {
+    switch (type) {
+      case 5:
+        return std::make_shared<HexahedronShapeFn<3>>(8);
+      case 17:
+        return std::make_shared<HexahedronShapeFn<3>>(20);
+      default:
+        return nullptr;
+    }
+  }
+};
+
+//! ReadMeshGmsh class
+//! \brief Reader of Gmsh .msh files, versions 2.2 and 4.1, ASCII or binary
+//! \details The file is streamed through a fixed buffer and numbers are
+//! parsed without locale. Elements of the mesh dimension are read as cells
+//! (quad4, quad8 and quad9 in 2D, hex8 and hex20 in 3D); Gmsh and the
+//! shape functions share the node ordering. Other elements are skipped.
+//! Nodes and cells keep their Gmsh tags as ids.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class ReadMeshGmsh {
+ public:
+  //! Constructor with nodal degrees of freedom
+  explicit ReadMeshGmsh(unsigned dof = Tdim) : dof_{dof} {}
+
+  //! Read a mesh file
+  bool read_mesh(const std::string& filename);
+
+  //! Number of nodes read
+  Index nnodes() const { return node_ids_.size(); }
+
+  //! Number of cells read
+  Index ncells() const { return cell_ids_.size(); }
+
+  //! Return Gmsh version (2 or 4)
+  unsigned version() const { return version_; }
+
+  //! Return true if the file is binary
+  bool binary() const { return binary_; }
+
+  //! Create nodes and cells and add them to a mesh in bulk
+  bool create_mesh(const std::shared_ptr<Mesh<Tdim>>& mesh) const;
+
+  //! Number of nodes of a Gmsh element type, zero if unknown
+  static unsigned nnodes_element(unsigned type);
+
+ private:
+  //! Read mesh format
+  bool read_format(FileStream& stream);
+
+  //! Read nodes in version 2
+  bool read_nodes_v2(FileStream& stream);
+
+  //! Read elements in version 2
+  bool read_elements_v2(FileStream& stream);
+
+  //! Read nodes in version 4
+  bool read_nodes_v4(FileStream& stream);
+
+  //! Read elements in version 4
+  bool read_elements_v4(FileStream& stream);
+
+  //! Read an integer of the version 4 binary size type (size_t)
+  bool read_size(FileStream& stream, std::size_t* value) const;
+
+  //! Store an element if it is a cell
+  template <typename Tnodes>
+  void add_element(Index id, unsigned type, const Tnodes* nodes);
+
+  //! Degrees of freedom of nodes
+  unsigned dof_{Tdim};
+  //! Gmsh version
+  unsigned version_{0};
+  //! Binary file
+  bool binary_{false};
+  //! Node ids
+  std::vector<Index> node_ids_;
+  //! Nodal coordinates (x, y, z) of each node
+  std::vector<double> node_coordinates_;
+  //! Cell ids
+  std::vector<Index> cell_ids_;
+  //! Gmsh element type of each cell
+  std::vector<unsigned> cell_types_;
+  //! Node ids of all cells
+  std::vector<Index> cell_nodes_;
+  //! Offset of the node ids of each cell, ncells + 1 entries
+  std::vector<std::size_t> cell_offsets_{0};
+};  // ReadMeshGmsh class
+}  // mpm namespace
+
+#include "read_mesh_gmsh.tcc"
+
+#endif  // MPM_IO_READ_MESH_GMSH_H_
@@ -0,0 +1,378 @@
+//! Number of nodes of a Gmsh element type, zero if unknown
+//! \param[in] type Gmsh element type
+template <unsigned Tdim>
+unsigned mpm::ReadMeshGmsh<Tdim>::nnodes_element(unsigned type) {
+  // Number of nodes of element types 1 to 31
+  static const unsigned nnodes[] = {0,  2,  3,  4,  4,  8,  6,  5,
+                                    3,  6,  9,  10, 27, 18, 14, 1,
+                                    8,  20, 15, 13, 9,  10, 12, 15,
+                                    15, 21, 4,  5,  6,  20, 35, 56};
+  return (type < sizeof(nnodes) / sizeof(nnodes[0])) ? nnodes[type] : 0;
+}
+
+//! Read a mesh file
+//! \param[in] filename Name of the .msh file
+//! \retval status Return false if the file cannot be read
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_mesh(const std::string& filename) {
+  bool status = false;
+  try {
+    mpm::FileStream stream;
+    if (!stream.open(filename))
+      throw std::runtime_error("Cannot open mesh file: " + filename);
+
+    node_ids_.clear();
+    node_coordinates_.clear();
+    cell_ids_.clear();
+    cell_types_.clear();
+    cell_nodes_.clear();
+    cell_offsets_.assign(1, 0);
+
+    std::string section;
+    bool format = false, nodes = false;
+    while (stream.read_token(&section)) {
+      bool section_status = true;
+      if (section == "$MeshFormat") {
+        section_status = format = this->read_format(stream);
+      } else if (section == "$Nodes") {
+        if (!format) throw std::runtime_error("Gmsh mesh format is missing");
+        section_status = nodes = (version_ == 2) ? this->read_nodes_v2(stream)
+                                                 : this->read_nodes_v4(stream);
+      } else if (section == "$Elements") {
+        if (!format) throw std::runtime_error("Gmsh mesh format is missing");
+        section_status = (version_ == 2) ? this->read_elements_v2(stream)
+                                         : this->read_elements_v4(stream);
+      } else if (section.empty() || section[0] != '$') {
+        throw std::runtime_error("Invalid Gmsh section: " + section);
+      }
+      if (!section_status)
+        throw std::runtime_error("Invalid Gmsh section: " + section);
+
+      // Skip the remainder of the section
+      if (!stream.skip_to("$End" + section.substr(1)))
+        throw std::runtime_error("Gmsh section is not terminated: " + section);
+    }
+    if (!nodes) throw std::runtime_error("Gmsh nodes are missing");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Read mesh format
+//! \param[in] stream File stream after $MeshFormat
+//! \retval status Return false if the version is not supported
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_format(FileStream& stream) {
+  double version = 0.;
+  int file_type = 0, data_size = 0;
+  if (!stream.read_double(&version) || !stream.read_integer(&file_type) ||
+      !stream.read_integer(&data_size))
+    return false;
+
+  if (version >= 2. && version < 3.)
+    version_ = 2;
+  else if (version >= 4.1 - 1.E-6 && version < 5.)
+    version_ = 4;
+  else
+    return false;
+
+  binary_ = (file_type == 1);
+  if (binary_) {
+    // Binary data is little endian with 4-byte int and 8-byte size_t
+    if (data_size != 8 || sizeof(std::size_t) != 8) return false;
+    int one = 0;
+    if (!stream.skip_line() || !stream.read_bytes(&one, sizeof(int)) ||
+        one != 1)
+      return false;
+  }
+  return true;
+}
+
+//! Store an element if it is a cell
+//! \param[in] id Element tag
+//! \param[in] type Gmsh element type
+//! \param[in] nodes Node tags of the element
+//! \tparam Tdim Dimension
+//! \tparam Tnodes Integer type of node tags
+template <unsigned Tdim>
+template <typename Tnodes>
+void mpm::ReadMeshGmsh<Tdim>::add_element(Index id, unsigned type,
+                                          const Tnodes* nodes) {
+  if (!mpm::GmshCells<Tdim>::cell(type)) return;
+  const unsigned nnodes = nnodes_element(type);
+  cell_ids_.emplace_back(id);
+  cell_types_.emplace_back(type);
+  cell_nodes_.insert(cell_nodes_.end(), nodes, nodes + nnodes);
+  cell_offsets_.emplace_back(cell_nodes_.size());
+}
+
+//! Read nodes in version 2
+//! \param[in] stream File stream after $Nodes
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_nodes_v2(FileStream& stream) {
+  std::size_t nnodes = 0;
+  if (!stream.read_integer(&nnodes)) return false;
+  node_ids_.resize(nnodes);
+  node_coordinates_.resize(3 * nnodes);
+
+  if (binary_) {
+    if (!stream.skip_line()) return false;
+    for (std::size_t i = 0; i < nnodes; ++i) {
+      int id = 0;
+      if (!stream.read_bytes(&id, sizeof(int)) ||
+          !stream.read_bytes(&node_coordinates_[3 * i], 3 * sizeof(double)))
+        return false;
+      node_ids_[i] = id;
+    }
+  } else {
+    for (std::size_t i = 0; i < nnodes; ++i)
+      if (!stream.read_integer(&node_ids_[i]) ||
+          !stream.read_double(&node_coordinates_[3 * i]) ||
+          !stream.read_double(&node_coordinates_[3 * i + 1]) ||
+          !stream.read_double(&node_coordinates_[3 * i + 2]))
+        return false;
+  }
+  return true;
+}
+
+//! Read elements in version 2
+//! \param[in] stream File stream after $Elements
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_elements_v2(FileStream& stream) {
+  std::size_t nelements = 0;
+  if (!stream.read_integer(&nelements)) return false;
+
+  if (binary_) {
+    if (!stream.skip_line()) return false;
+    // Blocks of elements of a type: type, number of elements, tags
+    std::vector<int> data;
+    for (std::size_t read = 0; read < nelements;) {
+      int header[3];
+      if (!stream.read_bytes(header, sizeof(header))) return false;
+      const unsigned type = header[0];
+      const unsigned nnodes = nnodes_element(type);
+      if (nnodes == 0 || header[1] < 0 || header[2] < 0) return false;
+      // Id, tags and nodes of each element
+      const std::size_t nvalues = 1 + header[2] + nnodes;
+      data.resize(nvalues * header[1]);
+      if (!stream.read_bytes(data.data(), data.size() * sizeof(int)))
+        return false;
+      for (int i = 0; i < header[1]; ++i) {
+        const int* element = &data[i * nvalues];
+        this->add_element(element[0], type, element + 1 + header[2]);
+      }
+      read += header[1];
+    }
+  } else {
+    Index nodes[64];
+    for (std::size_t i = 0; i < nelements; ++i) {
+      Index id = 0;
+      unsigned type = 0, ntags = 0;
+      if (!stream.read_integer(&id) || !stream.read_integer(&type) ||
+          !stream.read_integer(&ntags))
+        return false;
+      // Elements other than cells are skipped
+      if (!mpm::GmshCells<Tdim>::cell(type)) {
+        if (!stream.skip_line()) return false;
+        continue;
+      }
+      Index tag;
+      for (unsigned j = 0; j < ntags; ++j)
+        if (!stream.read_integer(&tag)) return false;
+      for (unsigned j = 0; j < nnodes_element(type); ++j)
+        if (!stream.read_integer(&nodes[j])) return false;
+      this->add_element(id, type, nodes);
+    }
+  }
+  return true;
+}
+
+//! Read an integer of the version 4 binary size type (size_t)
+//! \param[in] stream File stream
+//! \param[out] value Integer
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_size(FileStream& stream,
+                                        std::size_t* value) const {
+  return binary_ ? stream.read_bytes(value, sizeof(std::size_t))
+                 : stream.read_integer(value);
+}
+
+//! Read nodes in version 4
+//! \details Nodes are grouped in entity blocks: tags, then coordinates and
+//! parametric coordinates if present
+//! \param[in] stream File stream after $Nodes
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_nodes_v4(FileStream& stream) {
+  // Binary data starts on the line after the section marker
+  if (binary_ && !stream.skip_line()) return false;
+  // Blocks, nodes, minimum and maximum tag
+  std::size_t header[4];
+  for (auto& value : header)
+    if (!this->read_size(stream, &value)) return false;
+  node_ids_.reserve(header[1]);
+  node_coordinates_.reserve(3 * header[1]);
+
+  std::vector<double> parametric;
+  for (std::size_t block = 0; block < header[0]; ++block) {
+    // Entity dimension, entity tag, parametric and number of nodes
+    int entity[3];
+    std::size_t nnodes = 0;
+    if (binary_) {
+      if (!stream.read_bytes(entity, sizeof(entity))) return false;
+    } else {
+      for (auto& value : entity)
+        if (!stream.read_integer(&value)) return false;
+    }
+    if (!this->read_size(stream, &nnodes)) return false;
+
+    const std::size_t first = node_ids_.size();
+    node_ids_.resize(first + nnodes);
+    node_coordinates_.resize(3 * (first + nnodes));
+    for (std::size_t i = 0; i < nnodes; ++i) {
+      std::size_t tag = 0;
+      if (!this->read_size(stream, &tag)) return false;
+      node_ids_[first + i] = tag;
+    }
+
+    // Coordinates followed by parametric coordinates
+    const unsigned nparametric = entity[2] ? entity[0] : 0;
+    parametric.resize(nparametric);
+    for (std::size_t i = 0; i < nnodes; ++i) {
+      double* coordinates = &node_coordinates_[3 * (first + i)];
+      if (binary_) {
+        if (!stream.read_bytes(coordinates, 3 * sizeof(double)) ||
+            !stream.read_bytes(parametric.data(),
+                               nparametric * sizeof(double)))
+          return false;
+      } else {
+        for (unsigned j = 0; j < 3; ++j)
+          if (!stream.read_double(&coordinates[j])) return false;
+        for (unsigned j = 0; j < nparametric; ++j)
+          if (!stream.read_double(&parametric[j])) return false;
+      }
+    }
+  }
+  return true;
+}
+
+//! Read elements in version 4
+//! \details Elements are grouped in entity blocks of a single type
+//! \param[in] stream File stream after $Elements
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::read_elements_v4(FileStream& stream) {
+  // Binary data starts on the line after the section marker
+  if (binary_ && !stream.skip_line()) return false;
+  // Blocks, elements, minimum and maximum tag
+  std::size_t header[4];
+  for (auto& value : header)
+    if (!this->read_size(stream, &value)) return false;
+  cell_ids_.reserve(header[1]);
+  cell_types_.reserve(header[1]);
+
+  std::vector<std::size_t> data;
+  for (std::size_t block = 0; block < header[0]; ++block) {
+    // Entity dimension, entity tag, element type and number of elements
+    int entity[3];
+    std::size_t nelements = 0;
+    if (binary_) {
+      if (!stream.read_bytes(entity, sizeof(entity))) return false;
+    } else {
+      for (auto& value : entity)
+        if (!stream.read_integer(&value)) return false;
+    }
+    if (!this->read_size(stream, &nelements)) return false;
+
+    const unsigned type = entity[2];
+    const unsigned nnodes = nnodes_element(type);
+    if (nnodes == 0) return false;
+
+    // Tag and node tags of each element
+    data.resize((1 + nnodes) * nelements);
+    if (binary_) {
+      if (!stream.read_bytes(data.data(), data.size() * sizeof(std::size_t)))
+        return false;
+    } else {
+      for (auto& value : data)
+        if (!stream.read_integer(&value)) return false;
+    }
+    for (std::size_t i = 0; i < nelements; ++i) {
+      const std::size_t* element = &data[i * (1 + nnodes)];
+      this->add_element(element[0], type, element + 1);
+    }
+  }
+  return true;
+}
+
+//! Create nodes and cells and add them to a mesh in bulk
+//! \details Nodes and cells are created in parallel and inserted in bulk.
+//! Nodes of cells are found by a binary search of the sorted node tags, so
+//! memory does not depend on the largest tag of a sparsely numbered mesh
+//! \param[in] mesh Mesh
+//! \retval status Return false if a cell refers to a missing node
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadMeshGmsh<Tdim>::create_mesh(
+    const std::shared_ptr<Mesh<Tdim>>& mesh) const {
+  bool status = false;
+  try {
+    // Node tags with the index of the node, sorted by tag
+    std::vector<std::pair<Index, std::size_t>> tags(node_ids_.size());
+    for (std::size_t i = 0; i < node_ids_.size(); ++i)
+      tags[i] = std::make_pair(node_ids_[i], i);
+    std::sort(tags.begin(), tags.end());
+    std::vector<std::shared_ptr<mpm::Node<Tdim>>> nodes(node_ids_.size());
+
+    const unsigned dof = dof_;
+    tbb::parallel_for(std::size_t(0), node_ids_.size(), [&](std::size_t i) {
+      Eigen::Matrix<double, Tdim, 1> coordinates;
+      for (unsigned j = 0; j < Tdim; ++j)
+        coordinates(j) = node_coordinates_[3 * i + j];
+      nodes[i] = mesh->make_node(node_ids_[i], coordinates, dof);
+    });
+
+    // Shape function of each element type
+    std::vector<std::shared_ptr<mpm::ShapeFn<Tdim>>> shapefns;
+    for (const auto type : cell_types_) {
+      if (type >= shapefns.size()) shapefns.resize(type + 1);
+      if (shapefns[type] == nullptr)
+        shapefns[type] = mpm::GmshCells<Tdim>::shapefn(type);
+    }
+
+    std::vector<std::shared_ptr<mpm::Cell<Tdim>>> cells(cell_ids_.size());
+    std::atomic<bool> valid{true};
+    tbb::parallel_for(std::size_t(0), cell_ids_.size(), [&](std::size_t i) {
+      const unsigned nnodes = cell_offsets_[i + 1] - cell_offsets_[i];
+      auto cell =
+          mesh->make_cell(cell_ids_[i], nnodes, shapefns[cell_types_[i]]);
+      for (unsigned j = 0; j < nnodes; ++j) {
+        const Index tag = cell_nodes_[cell_offsets_[i] + j];
+        const auto node = std::lower_bound(
+            tags.begin(), tags.end(), std::make_pair(tag, std::size_t(0)));
+        if (node == tags.end() || node->first != tag) {
+          valid = false;
+          return;
+        }
+        cell->add_node(j, nodes[node->second].get());
+      }
+      cell->initialise();
+      cells[i] = cell;
+    });
+    if (!valid) throw std::runtime_error("Gmsh cell refers to a missing node");
+
+    if (!mesh->add_nodes(nodes) || !mesh->add_cells(cells))
+      throw std::runtime_error("Gmsh nodes or cells are not added to mesh");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
@@ -0,0 +1,96 @@
+#ifndef MPM_IO_READ_POINTS_ASCII_H_
+#define MPM_IO_READ_POINTS_ASCII_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/parallel_for.h>
+
+#include "io/file_stream.h"
+#include "io/memory_map.h"
+#include "mesh.h"
+
+namespace mpm {
+
+//! ReadPointsAscii class
+//! \brief Parallel reader of ASCII particle and node files
+//! \details Each line holds the coordinates of a point followed by optional
+//! attributes, separated by white space. Blank lines and lines starting
+//! with # are skipped. The file is memory mapped and split into line
+//! aligned chunks that are counted and then parsed by parallel tasks
+//! straight into a single array, so reading scales with the number of
+//! cores. Points are numbered in the order of the file.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class ReadPointsAscii {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Constructor with the size of chunks in bytes
+  explicit ReadPointsAscii(std::size_t chunk_size = 1 << 22)
+      : chunk_size_{std::max<std::size_t>(chunk_size, 1)} {}
+
+  //! Read a file
+  bool read_points(const std::string& filename);
+
+  //! Number of points read
+  Index npoints() const { return values_.size() / ncolumns_; }
+
+  //! Number of attributes of each point
+  unsigned nattributes() const { return ncolumns_ - Tdim; }
+
+  //! Return coordinates of a point
+  VectorDim coordinates(Index point) const {
+    return Eigen::Map<const VectorDim>(&values_[point * ncolumns_]);
+  }
+
+  //! Return an attribute of a point
+  double attribute(Index point, unsigned attribute) const {
+    return values_[point * ncolumns_ + Tdim + attribute];
+  }
+
+  //! Create particles and add them to a mesh in bulk
+  bool create_particles(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                        Index first_id,
+                        const std::vector<std::string>& attributes =
+                            std::vector<std::string>()) const;
+
+  //! Create nodes and add them to a mesh in bulk
+  bool create_nodes(const std::shared_ptr<Mesh<Tdim>>& mesh, Index first_id,
+                    unsigned dof = Tdim) const;
+
+ private:
+  //! Return the first character of a line if it has data, else nullptr
+  static const char* data_line(const char* line, const char* end);
+
+  //! Return true if a character separates numbers
+  static bool separator(char c);
+
+  //! Return the beginning of the next line
+  static const char* next_line(const char* line, const char* end);
+
+  //! Number of columns of a line
+  static unsigned ncolumns(const char* line, const char* end);
+
+  //! Size of chunks in bytes
+  std::size_t chunk_size_;
+  //! Number of columns: coordinates and attributes
+  unsigned ncolumns_{Tdim};
+  //! Coordinates and attributes of points, a row per point
+  std::vector<double> values_;
+};  // ReadPointsAscii class
+}  // mpm namespace
+
+#include "read_points_ascii.tcc"
+
+#endif  // MPM_IO_READ_POINTS_ASCII_H_
@@ -0,0 +1,211 @@
+//! Return the first character of a line if it has data, else nullptr
+//! \param[in] line Beginning of the line
+//! \param[in] end End of the characters
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+const char* mpm::ReadPointsAscii<Tdim>::data_line(const char* line,
+                                                  const char* end) {
+  while (line < end && (*line == ' ' || *line == '\t' || *line == '\r'))
+    ++line;
+  if (line == end || *line == '\n' || *line == '#') return nullptr;
+  return line;
+}
+
+//! Return true if a character separates numbers
+//! \param[in] c Character
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadPointsAscii<Tdim>::separator(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '#';
+}
+
+//! Return the beginning of the next line
+//! \param[in] line Character in the line
+//! \param[in] end End of the characters
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+const char* mpm::ReadPointsAscii<Tdim>::next_line(const char* line,
+                                                  const char* end) {
+  const void* newline = std::memchr(line, '\n', end - line);
+  return newline ? static_cast<const char*>(newline) + 1 : end;
+}
+
+//! Number of columns of a line
+//! \param[in] line First character of data in the line
+//! \param[in] end End of the characters
+//! \retval ncolumns Number of numbers, zero if the line has other tokens
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+unsigned mpm::ReadPointsAscii<Tdim>::ncolumns(const char* line,
+                                              const char* end) {
+  const char* line_end = next_line(line, end);
+  unsigned ncolumns = 0;
+  double value;
+  while (const char* p = data_line(line, line_end)) {
+    if (!mpm::parse_double(p, line_end, &value, &line)) return 0;
+    if (line < line_end && !separator(*line)) return 0;
+    ++ncolumns;
+  }
+  return ncolumns;
+}
+
+//! Read a file
+//! \param[in] filename Name of the file
+//! \retval status Return false if the file cannot be read or a line does
+//! not have the columns of the first line
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadPointsAscii<Tdim>::read_points(const std::string& filename) {
+  bool status = false;
+  values_.clear();
+  try {
+    mpm::MemoryMap file;
+    if (!file.open(filename))
+      throw std::runtime_error("Cannot map points file: " + filename);
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+
+    // Number of columns of the first line with data
+    const char* first = nullptr;
+    for (const char* line = begin; line < end && first == nullptr;
+         line = next_line(line, end))
+      first = data_line(line, end);
+    if (first == nullptr)
+      throw std::runtime_error("No points in file: " + filename);
+    ncolumns_ = ncolumns(first, end);
+    if (ncolumns_ < Tdim)
+      throw std::runtime_error("Points have fewer columns than dimensions");
+
+    // Chunks end after a newline
+    std::vector<const char*> chunks(1, begin);
+    while (chunks.back() < end) {
+      const char* chunk = chunks.back();
+      if (static_cast<std::size_t>(end - chunk) <= chunk_size_)
+        chunks.emplace_back(end);
+      else
+        chunks.emplace_back(next_line(chunk + chunk_size_ - 1, end));
+    }
+    const std::size_t nchunks = chunks.size() - 1;
+
+    // Count points of each chunk to place them in the array
+    std::vector<Index> offsets(nchunks + 1, 0);
+    tbb::parallel_for(std::size_t(0), nchunks, [&](std::size_t chunk) {
+      Index npoints = 0;
+      for (const char* line = chunks[chunk]; line < chunks[chunk + 1];
+           line = next_line(line, chunks[chunk + 1]))
+        if (data_line(line, chunks[chunk + 1])) ++npoints;
+      offsets[chunk + 1] = npoints;
+    });
+    for (std::size_t chunk = 0; chunk < nchunks; ++chunk)
+      offsets[chunk + 1] += offsets[chunk];
+    values_.resize(offsets.back() * ncolumns_);
+
+    // Parse chunks and record the first invalid line
+    std::atomic<std::size_t> error{file.size()};
+    const unsigned ncolumns = ncolumns_;
+    tbb::parallel_for(std::size_t(0), nchunks, [&](std::size_t chunk) {
+      const char* chunk_end = chunks[chunk + 1];
+      double* values = values_.data() + offsets[chunk] * ncolumns;
+      for (const char* line = chunks[chunk]; line < chunk_end;) {
+        const char* line_end = next_line(line, chunk_end);
+        const char* p = data_line(line, line_end);
+        if (p != nullptr) {
+          unsigned column = 0;
+          for (; p != nullptr && column < ncolumns; ++column, ++values) {
+            if (!mpm::parse_double(p, line_end, values, &p) ||
+                (p < line_end && !separator(*p)))
+              break;
+            p = data_line(p, line_end);
+          }
+          // Columns are missing or followed by other tokens
+          if (column < ncolumns || p != nullptr) {
+            std::size_t offset = line - begin;
+            std::size_t current = error.load();
+            while (offset < current &&
+                   !error.compare_exchange_weak(current, offset)) {
+            }
+            return;
+          }
+        }
+        line = line_end;
+      }
+    });
+    if (error.load() < file.size()) {
+      const std::size_t line =
+          1 + std::count(begin, begin + error.load(), '\n');
+      throw std::runtime_error("Invalid point in " + filename + " at line " +
+                               std::to_string(line));
+    }
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+    values_.clear();
+  }
+  return status;
+}
+
+//! Create particles and add them to a mesh in bulk
+//! \details Particle ids are consecutive from the first id in the order of
+//! the file. Attributes named mass and volume are assigned to particles,
+//! attributes with an empty name are ignored.
+//! \param[in] mesh Mesh
+//! \param[in] first_id Id of the first particle
+//! \param[in] attributes Name of each attribute, or empty
+//! \retval status Return false if an attribute is unknown or an id exists
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadPointsAscii<Tdim>::create_particles(
+    const std::shared_ptr<Mesh<Tdim>>& mesh, Index first_id,
+    const std::vector<std::string>& attributes) const {
+  bool status = false;
+  try {
+    if (!attributes.empty() && attributes.size() != this->nattributes())
+      throw std::runtime_error("Names do not match the point attributes");
+
+    // Columns of mass and volume
+    int mass = -1, volume = -1;
+    for (unsigned i = 0; i < attributes.size(); ++i) {
+      if (attributes[i] == "mass")
+        mass = i;
+      else if (attributes[i] == "volume")
+        volume = i;
+      else if (!attributes[i].empty())
+        throw std::runtime_error("Invalid particle attribute: " +
+                                 attributes[i]);
+    }
+
+    std::vector<std::shared_ptr<mpm::Particle<Tdim>>> particles(
+        this->npoints());
+    tbb::parallel_for(Index(0), this->npoints(), [&](Index i) {
+      auto particle = mesh->make_particle(first_id + i, this->coordinates(i));
+      if (mass >= 0) particle->assign_mass(this->attribute(i, mass));
+      if (volume >= 0) particle->assign_volume(this->attribute(i, volume));
+      particles[i] = particle;
+    });
+    if (!mesh->add_particles(particles))
+      throw std::runtime_error("Particles are not added to mesh");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Create nodes and add them to a mesh in bulk
+//! \details Node ids are consecutive from the first id in the order of the
+//! file, attributes are ignored
+//! \param[in] mesh Mesh
+//! \param[in] first_id Id of the first node
+//! \param[in] dof Degrees of freedom of nodes
+//! \retval status Return false if an id exists
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ReadPointsAscii<Tdim>::create_nodes(
+    const std::shared_ptr<Mesh<Tdim>>& mesh, Index first_id,
+    unsigned dof) const {
+  std::vector<std::shared_ptr<mpm::Node<Tdim>>> nodes(this->npoints());
+  tbb::parallel_for(Index(0), this->npoints(), [&](Index i) {
+    nodes[i] = mesh->make_node(first_id + i, this->coordinates(i), dof);
+  });
+  return mesh->add_nodes(nodes);
+}
@@ -0,0 +1,138 @@
+#ifndef MPM_IO_RESULT_WRITER_H_
+#define MPM_IO_RESULT_WRITER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/snapshot.h"
+#include "io/vtk_writer.h"
+#include "mesh.h"
+
+namespace mpm {
+
+//! Format of results
+//! \brief LegacyVTK: legacy VTK binary (.vtk), VTK: XML VTK with appended
+//! raw arrays (.vtp, .vtu), CompressedVTK: XML VTK with zlib compressed
+//! arrays
+enum class ResultFormat { LegacyVTK, VTK, CompressedVTK };
+
+//! ResultWriter class
+//! \brief Asynchronous writer of particle and nodal results
+//! \details Results are copied in parallel into one of a fixed number of
+//! staging buffers and handed to a background thread, which encodes and
+//! writes them while the next steps compute. When every buffer is in use
+//! the caller waits for the writer to release one, so memory is bounded
+//! when the writer falls behind. Buffers are reused, so snapshots do not
+//! allocate once their capacity is reached. Particles are written as points
+//! and meshes as cells, see VtkWriter.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class ResultWriter {
+ public:
+  //! Timings of the writer
+  struct Metrics {
+    //! Number of snapshots written
+    unsigned long long nsnapshots{0};
+    //! Number of snapshots that failed to be written
+    unsigned long long nfailed{0};
+    //! Time spent copying results into staging buffers (seconds)
+    double snapshot_time{0.};
+    //! Time spent waiting for a free staging buffer or in flush (seconds)
+    double wait_time{0.};
+    //! Time spent encoding and writing in the background (seconds)
+    double write_time{0.};
+
+    //! Fraction of the writing time hidden behind computation
+    double overlap() const {
+      return (write_time > 0.)
+                 ? std::max(0., 1. - wait_time / write_time)
+                 : 0.;
+    }
+  };
+
+  //! Constructor with the number of staging buffers and the format
+  explicit ResultWriter(unsigned nbuffers = 2,
+                        ResultFormat format = ResultFormat::LegacyVTK,
+                        unsigned npieces = 1);
+
+  //! Destructor waits for pending snapshots
+  ~ResultWriter();
+
+  //! Delete copy constructor
+  ResultWriter(const ResultWriter<Tdim>&) = delete;
+
+  //! Delete assignement operator
+  ResultWriter& operator=(const ResultWriter<Tdim>&) = delete;
+
+  //! Snapshot particle fields and write them in the background
+  bool write_particles(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                       const std::vector<std::string>& fields,
+                       const std::string& filename, unsigned long long step);
+
+  //! Snapshot nodal fields and write them in the background
+  bool write_nodes(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                   const std::vector<std::string>& fields,
+                   const std::string& filename, unsigned long long step);
+
+  //! Snapshot nodal fields and cells and write them in the background
+  bool write_mesh(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                  const std::vector<std::string>& fields,
+                  const std::string& filename, unsigned long long step);
+
+  //! Wait until pending snapshots are written
+  bool flush();
+
+  //! Return timings of the writer
+  Metrics metrics() const;
+
+ private:
+  //! Wait for a free staging buffer
+  std::unique_ptr<Snapshot> acquire();
+
+  //! Copy results into a staging buffer and queue it to the writer thread
+  template <typename Tcopy>
+  bool write(const std::string& filename, unsigned long long step,
+             Tcopy copy);
+
+  //! Encode and write queued snapshots until the writer is stopped
+  void run();
+
+  //! Mutex guarding the buffers, the queue and the metrics
+  mutable std::mutex mutex_;
+  //! Signalled when a buffer is released
+  std::condition_variable released_;
+  //! Signalled when a snapshot is queued or the writer stops
+  std::condition_variable queued_;
+  //! Free staging buffers
+  std::vector<std::unique_ptr<Snapshot>> free_;
+  //! Snapshots waiting to be written
+  std::deque<std::unique_ptr<Snapshot>> queue_;
+  //! Number of staging buffers
+  unsigned nbuffers_;
+  //! Format of results
+  ResultFormat format_;
+  //! Number of pieces of XML results
+  unsigned npieces_;
+  //! Writer of XML results
+  VtkWriter vtk_;
+  //! Number of snapshots failed since the last flush
+  unsigned long long nfailed_flush_{0};
+  //! Stop the writer thread
+  bool stop_{false};
+  //! Timings
+  Metrics metrics_;
+  //! Writer thread
+  std::thread thread_;
+};  // ResultWriter class
+}  // mpm namespace
+
+#include "result_writer.tcc"
+
+#endif  // MPM_IO_RESULT_WRITER_H_
@@ -0,0 +1,190 @@
+//! Constructor with the number of staging buffers and the format
+//! \param[in] nbuffers Number of staging buffers, at least one
+//! \param[in] format Format of results
+//! \param[in] npieces Number of pieces of XML results, a parallel file
+//! referencing the pieces is written if there are more than one
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+mpm::ResultWriter<Tdim>::ResultWriter(unsigned nbuffers, ResultFormat format,
+                                      unsigned npieces)
+    : nbuffers_{std::max(nbuffers, 1u)},
+      format_{format},
+      npieces_{std::max(npieces, 1u)},
+      vtk_{format == ResultFormat::CompressedVTK} {
+  for (unsigned i = 0; i < nbuffers_; ++i)
+    free_.emplace_back(new Snapshot());
+  thread_ = std::thread(&mpm::ResultWriter<Tdim>::run, this);
+}
+
+//! Destructor waits for pending snapshots
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+mpm::ResultWriter<Tdim>::~ResultWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queued_.notify_one();
+  thread_.join();
+}
+
+//! Snapshot particle fields and write them in the background
+//! \param[in] mesh Mesh
+//! \param[in] fields Names of the fields, see Snapshot::copy_particles
+//! \param[in] filename Name of the output file
+//! \param[in] step Step
+//! \retval status Return false if a field is unknown
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ResultWriter<Tdim>::write_particles(
+    const std::shared_ptr<Mesh<Tdim>>& mesh,
+    const std::vector<std::string>& fields, const std::string& filename,
+    unsigned long long step) {
+  return this->write(filename, step, [&](Snapshot* snapshot) {
+    return snapshot->copy_particles(mesh, fields);
+  });
+}
+
+//! Snapshot nodal fields and write them in the background
+//! \param[in] mesh Mesh
+//! \param[in] fields Names of the fields, see Snapshot::copy_nodes
+//! \param[in] filename Name of the output file
+//! \param[in] step Step
+//! \retval status Return false if a field is unknown
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ResultWriter<Tdim>::write_nodes(
+    const std::shared_ptr<Mesh<Tdim>>& mesh,
+    const std::vector<std::string>& fields, const std::string& filename,
+    unsigned long long step) {
+  return this->write(filename, step, [&](Snapshot* snapshot) {
+    return snapshot->copy_nodes(mesh, fields);
+  });
+}
+
+//! Snapshot nodal fields and cells and write them in the background
+//! \param[in] mesh Mesh
+//! \param[in] fields Names of the nodal fields, see Snapshot::copy_nodes
+//! \param[in] filename Name of the output file
+//! \param[in] step Step
+//! \retval status Return false if a field is unknown or a cell is not
+//! supported
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ResultWriter<Tdim>::write_mesh(
+    const std::shared_ptr<Mesh<Tdim>>& mesh,
+    const std::vector<std::string>& fields, const std::string& filename,
+    unsigned long long step) {
+  return this->write(filename, step, [&](Snapshot* snapshot) {
+    return snapshot->copy_mesh(mesh, fields);
+  });
+}
+
+//! Copy results into a staging buffer and queue it to the writer thread
+//! \param[in] filename Name of the output file
+//! \param[in] step Step
+//! \param[in] copy Callable copying results into a snapshot
+//! \retval status Return false if results are not copied
+//! \tparam Tcopy Callable object
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+template <typename Tcopy>
+bool mpm::ResultWriter<Tdim>::write(const std::string& filename,
+                                    unsigned long long step, Tcopy copy) {
+  auto snapshot = this->acquire();
+  const auto start = std::chrono::steady_clock::now();
+  snapshot->filename = filename;
+  snapshot->step = step;
+  const bool status = copy(snapshot.get());
+  const auto end = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  metrics_.snapshot_time += std::chrono::duration<double>(end - start).count();
+  if (status) {
+    queue_.emplace_back(std::move(snapshot));
+    lock.unlock();
+    queued_.notify_one();
+  } else {
+    free_.emplace_back(std::move(snapshot));
+    lock.unlock();
+    released_.notify_all();
+  }
+  return status;
+}
+
+//! Wait until pending snapshots are written
+//! \details The time blocked is counted as wait time, as the caller does not
+//! compute while pending snapshots are written
+//! \retval status Return false if a snapshot failed since the last flush
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::ResultWriter<Tdim>::flush() {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  released_.wait(lock, [this] { return free_.size() == nbuffers_; });
+  const auto end = std::chrono::steady_clock::now();
+  metrics_.wait_time += std::chrono::duration<double>(end - start).count();
+  const bool status = (nfailed_flush_ == 0);
+  nfailed_flush_ = 0;
+  return status;
+}
+
+//! Return timings of the writer
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+typename mpm::ResultWriter<Tdim>::Metrics mpm::ResultWriter<Tdim>::metrics()
+    const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return metrics_;
+}
+
+//! Wait for a free staging buffer
+//! \retval snapshot Staging buffer
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+std::unique_ptr<mpm::Snapshot> mpm::ResultWriter<Tdim>::acquire() {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  released_.wait(lock, [this] { return !free_.empty(); });
+  auto snapshot = std::move(free_.back());
+  free_.pop_back();
+  const auto end = std::chrono::steady_clock::now();
+  metrics_.wait_time += std::chrono::duration<double>(end - start).count();
+  return snapshot;
+}
+
+//! Encode and write queued snapshots until the writer is stopped
+//! \details Pending snapshots are written before the thread returns
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::ResultWriter<Tdim>::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queued_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) break;
+    auto snapshot = std::move(queue_.front());
+    queue_.pop_front();
+
+    // Encode and write without holding the lock
+    lock.unlock();
+    const auto start = std::chrono::steady_clock::now();
+    bool status = false;
+    if (format_ == ResultFormat::LegacyVTK)
+      status = mpm::VtkWriter::write_legacy(*snapshot, snapshot->filename);
+    else if (npieces_ > 1)
+      status = vtk_.write_pieces(*snapshot, snapshot->filename, npieces_);
+    else
+      status = vtk_.write(*snapshot, snapshot->filename);
+    const auto end = std::chrono::steady_clock::now();
+    lock.lock();
+
+    metrics_.write_time += std::chrono::duration<double>(end - start).count();
+    ++metrics_.nsnapshots;
+    if (!status) {
+      ++metrics_.nfailed;
+      ++nfailed_flush_;
+    }
+    free_.emplace_back(std::move(snapshot));
+    released_.notify_all();
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef MPM_IO_SNAPSHOT_H_
+#define MPM_IO_SNAPSHOT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include "mesh.h"
+
+namespace mpm {
+
+//! Snapshot struct
+//! \brief Copy of the points, cells and fields of particles or of a mesh
+//! \details Points are particles or nodes, with coordinates padded to 3
+//! components. Cells refer to points by index, with the end offset of each
+//! cell in the connectivity and VTK cell types, and are empty for
+//! particles. Vectors keep their capacity, so a snapshot reused for the
+//! same mesh does not allocate.
+struct Snapshot {
+  //! Field of a snapshot, stored point by point
+  struct Field {
+    //! Name
+    std::string name;
+    //! Number of components per point
+    unsigned ncomponents{1};
+    //! Values
+    std::vector<double> values;
+  };
+
+  //! Copy particle fields
+  template <unsigned Tdim>
+  bool copy_particles(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                      const std::vector<std::string>& names);
+
+  //! Copy nodal fields
+  template <unsigned Tdim>
+  bool copy_nodes(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                  const std::vector<std::string>& names);
+
+  //! Copy nodal fields and cells
+  template <unsigned Tdim>
+  bool copy_mesh(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                 const std::vector<std::string>& names);
+
+  //! Number of cells
+  Index ncells() const { return offsets.size(); }
+
+  //! VTK cell type of a cell and the order of its nodes
+  template <unsigned Tdim>
+  static unsigned cell_type(unsigned nnodes, std::vector<unsigned>* order);
+
+  //! Name of the output file
+  std::string filename;
+  //! Step
+  unsigned long long step{0};
+  //! Number of points
+  Index npoints{0};
+  //! Ids of particles or nodes
+  std::vector<Index> ids;
+  //! Coordinates, 3 components per point
+  std::vector<double> coordinates;
+  //! Point indices of the nodes of cells
+  std::vector<std::uint64_t> connectivity;
+  //! End offset of each cell in the connectivity
+  std::vector<std::uint64_t> offsets;
+  //! VTK cell types
+  std::vector<std::uint8_t> types;
+  //! Fields
+  std::vector<Field> fields;
+};  // Snapshot struct
+}  // mpm namespace
+
+#include "snapshot.tcc"
+
+#endif  // MPM_IO_SNAPSHOT_H_
@@ -0,0 +1,272 @@
+//! Copy particle fields
+//! \details Fields are mass, volume, velocity, stress and strain. Only
+//! particles with an active status are copied, in parallel and in no
+//! particular order.
+//! \param[in] mesh Mesh
+//! \param[in] names Names of the fields
+//! \retval status Return false if a field is unknown
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Snapshot::copy_particles(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                                   const std::vector<std::string>& names) {
+  bool status = false;
+  try {
+    // Index of each field in the list of particle fields
+    const std::vector<std::string> known{"mass", "volume", "velocity",
+                                         "stress", "strain"};
+    std::vector<unsigned> kinds;
+    for (const auto& field : names) {
+      const auto itr = std::find(known.begin(), known.end(), field);
+      if (itr == known.end())
+        throw std::runtime_error("Unknown particle field: " + field);
+      kinds.emplace_back(itr - known.begin());
+    }
+
+    const Index nparticles = mesh->nparticles();
+    ids.resize(nparticles);
+    coordinates.resize(3 * nparticles);
+    connectivity.clear();
+    offsets.clear();
+    types.clear();
+    fields.resize(names.size());
+    for (unsigned i = 0; i < names.size(); ++i) {
+      fields[i].name = names[i];
+      fields[i].ncomponents = (kinds[i] < 2) ? 1 : (kinds[i] == 2) ? Tdim : 6;
+      fields[i].values.resize(fields[i].ncomponents * nparticles);
+    }
+
+    // Each particle claims the next slot
+    std::atomic<Index> count{0};
+    mesh->iterate_over_particles(
+        [&](const std::shared_ptr<mpm::Particle<Tdim>>& particle) {
+          if (!particle->status()) return;
+          const Index i = count++;
+          ids[i] = particle->id();
+          const auto coords = particle->coordinates();
+          for (unsigned j = 0; j < 3; ++j)
+            coordinates[3 * i + j] = (j < Tdim) ? coords(j) : 0.;
+          for (unsigned f = 0; f < kinds.size(); ++f) {
+            auto& field = fields[f];
+            double* values = field.values.data() + field.ncomponents * i;
+            switch (kinds[f]) {
+              case 0:
+                values[0] = particle->mass();
+                break;
+              case 1:
+                values[0] = particle->volume();
+                break;
+              case 2: {
+                const auto velocity = particle->velocity();
+                std::copy(velocity.data(), velocity.data() + Tdim, values);
+                break;
+              }
+              case 3: {
+                const auto stress = particle->stress();
+                std::copy(stress.data(), stress.data() + 6, values);
+                break;
+              }
+              default: {
+                const auto strain = particle->strain();
+                std::copy(strain.data(), strain.data() + 6, values);
+              }
+            }
+          }
+        });
+    npoints = count;
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Copy nodal fields
+//! \details Fields are mass, velocity, momentum, acceleration and force of
+//! the first phase. Nodes are sorted by id.
+//! \param[in] mesh Mesh
+//! \param[in] names Names of the fields
+//! \retval status Return false if a field is unknown
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Snapshot::copy_nodes(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                               const std::vector<std::string>& names) {
+  bool status = false;
+  try {
+    // Index of each field in the list of nodal fields
+    const std::vector<std::string> known{"mass", "velocity", "momentum",
+                                         "acceleration", "force"};
+    std::vector<unsigned> kinds;
+    for (const auto& field : names) {
+      const auto itr = std::find(known.begin(), known.end(), field);
+      if (itr == known.end())
+        throw std::runtime_error("Unknown nodal field: " + field);
+      kinds.emplace_back(itr - known.begin());
+    }
+
+    tbb::concurrent_vector<std::shared_ptr<mpm::Node<Tdim>>> node_list;
+    mesh->iterate_over_nodes([&](std::shared_ptr<mpm::Node<Tdim>> node) {
+      node_list.push_back(node);
+    });
+    std::vector<std::shared_ptr<mpm::Node<Tdim>>> nodes(node_list.begin(),
+                                                        node_list.end());
+    tbb::parallel_sort(nodes.begin(), nodes.end(),
+                       [](const std::shared_ptr<mpm::Node<Tdim>>& lhs,
+                          const std::shared_ptr<mpm::Node<Tdim>>& rhs) {
+                         return lhs->id() < rhs->id();
+                       });
+
+    npoints = nodes.size();
+    ids.resize(npoints);
+    coordinates.resize(3 * npoints);
+    connectivity.clear();
+    offsets.clear();
+    types.clear();
+    fields.resize(names.size());
+    for (unsigned i = 0; i < names.size(); ++i) {
+      fields[i].name = names[i];
+      fields[i].ncomponents = (kinds[i] == 0) ? 1 : Tdim;
+      fields[i].values.resize(fields[i].ncomponents * npoints);
+    }
+
+    tbb::parallel_for(Index(0), npoints, [&](Index i) {
+      const auto& node = nodes[i];
+      ids[i] = node->id();
+      const auto coords = node->coordinates();
+      for (unsigned j = 0; j < 3; ++j)
+        coordinates[3 * i + j] = (j < Tdim) ? coords(j) : 0.;
+      for (unsigned f = 0; f < kinds.size(); ++f) {
+        auto& field = fields[f];
+        double* values = field.values.data() + field.ncomponents * i;
+        if (kinds[f] == 0) {
+          values[0] = node->mass();
+          continue;
+        }
+        const Eigen::VectorXd* vector = &node->force();
+        if (kinds[f] == 1)
+          vector = &node->velocity();
+        else if (kinds[f] == 2)
+          vector = &node->momentum();
+        else if (kinds[f] == 3)
+          vector = &node->acceleration();
+        // Components of the first phase
+        for (unsigned j = 0; j < Tdim; ++j)
+          values[j] = (j < vector->size()) ? (*vector)(j) : 0.;
+      }
+    });
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Copy nodal fields and cells
+//! \param[in] mesh Mesh
+//! \param[in] names Names of the nodal fields
+//! \retval status Return false if a field is unknown, a cell has an
+//! unsupported number of nodes or refers to a node outside the mesh
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Snapshot::copy_mesh(const std::shared_ptr<Mesh<Tdim>>& mesh,
+                              const std::vector<std::string>& names) {
+  bool status = false;
+  try {
+    if (!this->copy_nodes(mesh, names))
+      throw std::runtime_error("Nodes of the mesh are not copied");
+
+    tbb::concurrent_vector<std::shared_ptr<mpm::Cell<Tdim>>> cell_list;
+    mesh->iterate_over_cells([&](std::shared_ptr<mpm::Cell<Tdim>> cell) {
+      cell_list.push_back(cell);
+    });
+    std::vector<std::shared_ptr<mpm::Cell<Tdim>>> cells(cell_list.begin(),
+                                                        cell_list.end());
+    tbb::parallel_sort(cells.begin(), cells.end(),
+                       [](const std::shared_ptr<mpm::Cell<Tdim>>& lhs,
+                          const std::shared_ptr<mpm::Cell<Tdim>>& rhs) {
+                         return lhs->id() < rhs->id();
+                       });
+
+    // Cell types and node orders by number of nodes
+    std::vector<unsigned> cell_types(mpm::Cell<Tdim>::max_nnodes + 1);
+    std::vector<std::vector<unsigned>> orders(cell_types.size());
+    for (unsigned i = 0; i < cell_types.size(); ++i)
+      cell_types[i] = cell_type<Tdim>(i, &orders[i]);
+
+    offsets.resize(cells.size());
+    types.resize(cells.size());
+    std::uint64_t offset = 0;
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+      const unsigned nnodes = cells[i]->nnodes();
+      if (nnodes >= cell_types.size() || cell_types[nnodes] == 0)
+        throw std::runtime_error("Unsupported number of nodes in a cell");
+      types[i] = cell_types[nnodes];
+      offset += orders[nnodes].size();
+      offsets[i] = offset;
+    }
+
+    // Nodes are sorted by id
+    connectivity.resize(offset);
+    std::atomic<bool> valid{true};
+    tbb::parallel_for(std::size_t(0), cells.size(), [&](std::size_t i) {
+      const auto& order = orders[cells[i]->nnodes()];
+      std::uint64_t* points = connectivity.data() + offsets[i] - order.size();
+      for (unsigned j = 0; j < order.size(); ++j) {
+        const auto node = cells[i]->node(order[j]);
+        const auto itr =
+            (node != nullptr)
+                ? std::lower_bound(ids.begin(), ids.end(), node->id())
+                : ids.end();
+        if (itr == ids.end() || *itr != node->id()) {
+          valid = false;
+          return;
+        }
+        points[j] = itr - ids.begin();
+      }
+    });
+    if (!valid) throw std::runtime_error("Cell refers to a missing node");
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+    offsets.clear();
+    types.clear();
+    connectivity.clear();
+  }
+  return status;
+}
+
+//! VTK cell type of a cell and the order of its nodes
+//! \details Quadrilaterals of 4, 8 and 9 nodes and hexahedra of 8 and 20
+//! nodes keep their type. Edge nodes of 20-node hexahedra are reordered
+//! from the Gmsh to the VTK convention. 27-node hexahedra are written by
+//! their corners.
+//! \param[in] nnodes Number of nodes of the cell
+//! \param[out] order Nodes of the cell in VTK order
+//! \retval type VTK cell type, zero if the cell is not supported
+template <unsigned Tdim>
+unsigned mpm::Snapshot::cell_type(unsigned nnodes,
+                                  std::vector<unsigned>* order) {
+  order->clear();
+  unsigned type = 0;
+  unsigned ncorners = 0;
+  if (Tdim == 2) {
+    if (nnodes == 4) type = 9;
+    if (nnodes == 8) type = 23;
+    if (nnodes == 9) type = 28;
+    if (type != 0) ncorners = nnodes;
+  } else if (Tdim == 3) {
+    if (nnodes == 8 || nnodes == 27) {
+      type = 12;
+      ncorners = 8;
+    } else if (nnodes == 20) {
+      type = 25;
+      ncorners = 8;
+      // Edges of VTK 20-node hexahedra in Gmsh numbering
+      const unsigned edges[12] = {8, 11, 13, 9, 16, 18, 19, 17, 10, 12, 14, 15};
+      for (unsigned i = 0; i < ncorners; ++i) order->emplace_back(i);
+      order->insert(order->end(), edges, edges + 12);
+      return type;
+    }
+  }
+  for (unsigned i = 0; i < ncorners; ++i) order->emplace_back(i);
+  return type;
+}
@@ -0,0 +1,88 @@
+#ifndef MPM_IO_VTK_WRITER_H_
+#define MPM_IO_VTK_WRITER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// TBB
+#include <tbb/parallel_for.h>
+
+#include <zlib.h>
+
+#include "io/snapshot.h"
+
+namespace mpm {
+
+//! VtkWriter class
+//! \brief Writer of snapshots as VTK files
+//! \details Particles are written as poly data (.vtp) with a vertex per
+//! particle and meshes as unstructured grids (.vtu). Arrays are appended
+//! raw binary after the XML header, optionally compressed with zlib in
+//! blocks that are compressed in parallel. A snapshot can be split into
+//! pieces written in parallel and referenced by a parallel file (.pvtp,
+//! .pvtu); meshes are split by cells and particles by points.
+class VtkWriter {
+ public:
+  //! Constructor with compression
+  //! \param[in] compress Compress arrays with zlib
+  //! \param[in] level Compression level, from 1 (fast) to 9 (small)
+  //! \param[in] block_size Size of blocks compressed in parallel (bytes)
+  explicit VtkWriter(bool compress = false, int level = 1,
+                     std::size_t block_size = 1 << 20)
+      : compress_{compress},
+        level_{std::min(std::max(level, 1), 9)},
+        block_size_{std::max<std::size_t>(block_size, 1)} {}
+
+  //! Write a snapshot as poly data or unstructured grid
+  bool write(const Snapshot& snapshot, const std::string& filename) const;
+
+  //! Write a snapshot as pieces and a parallel file referencing them
+  bool write_pieces(const Snapshot& snapshot, const std::string& filename,
+                    unsigned npieces) const;
+
+  //! Write a snapshot as legacy VTK binary
+  static bool write_legacy(const Snapshot& snapshot,
+                           const std::string& filename);
+
+ private:
+  //! Points and cells of a piece
+  struct Piece {
+    //! All points of the snapshot
+    bool all{true};
+    //! Indices of the points in the snapshot, sorted
+    std::vector<Index> points;
+    //! First cell
+    Index cell_begin{0};
+    //! End of cells
+    Index cell_end{0};
+  };
+
+  //! Write a piece of a snapshot
+  void write_piece(const Snapshot& snapshot, const Piece& piece,
+                   const std::string& filename) const;
+
+  //! Encode an array as an appended block with its header
+  std::string encode(const void* data, std::size_t size) const;
+
+  //! Byte order of the machine
+  static const char* byte_order();
+
+  //! Compress with zlib
+  bool compress_;
+  //! Compression level
+  int level_;
+  //! Size of compressed blocks
+  std::size_t block_size_;
+};  // VtkWriter class
+}  // mpm namespace
+
+#include "vtk_writer.tcc"
+
+#endif  // MPM_IO_VTK_WRITER_H_
@@ -0,0 +1,359 @@
+//! Write a snapshot as poly data or unstructured grid
+//! \param[in] snapshot Snapshot of particles or of a mesh
+//! \param[in] filename Name of the file (.vtp or .vtu)
+//! \retval status Return false if the file cannot be written
+inline bool mpm::VtkWriter::write(const Snapshot& snapshot,
+                                  const std::string& filename) const {
+  bool status = false;
+  try {
+    Piece piece;
+    piece.cell_end = snapshot.ncells();
+    this->write_piece(snapshot, piece, filename);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Write a snapshot as pieces and a parallel file referencing them
+//! \details Pieces are named after the parallel file with the index of the
+//! piece, e.g. results_0.vtu for results.pvtu, and are written in parallel
+//! \param[in] snapshot Snapshot of particles or of a mesh
+//! \param[in] filename Name of the parallel file (.pvtp or .pvtu)
+//! \param[in] npieces Number of pieces
+//! \retval status Return false if a file cannot be written
+inline bool mpm::VtkWriter::write_pieces(const Snapshot& snapshot,
+                                         const std::string& filename,
+                                         unsigned npieces) const {
+  bool status = false;
+  try {
+    npieces = std::max(npieces, 1u);
+    const bool grid = (snapshot.ncells() > 0);
+    const std::string type = grid ? "UnstructuredGrid" : "PolyData";
+
+    // Pieces are written next to the parallel file
+    const auto slash = filename.find_last_of('/');
+    const std::string directory =
+        (slash == std::string::npos) ? "" : filename.substr(0, slash + 1);
+    std::string base = filename.substr(directory.size());
+    base = base.substr(0, base.find_last_of('.'));
+    std::vector<std::string> names(npieces);
+    for (unsigned i = 0; i < npieces; ++i)
+      names[i] = base + "_" + std::to_string(i) + (grid ? ".vtu" : ".vtp");
+
+    // Meshes are split by cells and particles by points
+    const Index nitems = grid ? snapshot.ncells() : snapshot.npoints;
+    std::atomic<bool> valid{true};
+    tbb::parallel_for(0u, npieces, [&](unsigned i) {
+      Piece piece;
+      piece.all = false;
+      const Index begin = nitems * i / npieces;
+      const Index end = nitems * (i + 1) / npieces;
+      if (grid) {
+        piece.cell_begin = begin;
+        piece.cell_end = end;
+        const std::uint64_t first =
+            (begin == 0) ? 0 : snapshot.offsets[begin - 1];
+        const std::uint64_t last = (end == 0) ? 0 : snapshot.offsets[end - 1];
+        piece.points.assign(snapshot.connectivity.begin() + first,
+                            snapshot.connectivity.begin() + last);
+        std::sort(piece.points.begin(), piece.points.end());
+        piece.points.erase(
+            std::unique(piece.points.begin(), piece.points.end()),
+            piece.points.end());
+      } else {
+        for (Index point = begin; point < end; ++point)
+          piece.points.emplace_back(point);
+      }
+      try {
+        this->write_piece(snapshot, piece, directory + names[i]);
+      } catch (std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        valid = false;
+      }
+    });
+    if (!valid) throw std::runtime_error("Pieces are not written");
+
+    std::ofstream file(filename, std::ios::trunc);
+    if (!file.is_open())
+      throw std::runtime_error("Cannot open VTK file: " + filename);
+    file << "<?xml version=\"1.0\"?>\n<VTKFile type=\"P" << type
+         << "\" version=\"1.0\" byte_order=\"" << byte_order()
+         << "\" header_type=\"UInt64\">\n  <P" << type
+         << " GhostLevel=\"0\">\n    <PPointData>\n"
+         << "      <PDataArray type=\"UInt64\" Name=\"id\"/>\n";
+    for (const auto& field : snapshot.fields)
+      file << "      <PDataArray type=\"Float64\" Name=\"" << field.name
+           << "\" NumberOfComponents=\"" << field.ncomponents << "\"/>\n";
+    file << "    </PPointData>\n    <PPoints>\n"
+         << "      <PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n"
+         << "    </PPoints>\n";
+    for (const auto& name : names)
+      file << "    <Piece Source=\"" << name << "\"/>\n";
+    file << "  </P" << type << ">\n</VTKFile>\n";
+    if (!file.good())
+      throw std::runtime_error("Cannot write VTK file: " + filename);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Write a piece of a snapshot
+//! \param[in] snapshot Snapshot of particles or of a mesh
+//! \param[in] piece Points and cells of the piece
+//! \param[in] filename Name of the file
+inline void mpm::VtkWriter::write_piece(const Snapshot& snapshot,
+                                        const Piece& piece,
+                                        const std::string& filename) const {
+  const bool grid = (snapshot.ncells() > 0);
+  const Index npoints = piece.all ? snapshot.npoints : piece.points.size();
+  const Index ncells = piece.cell_end - piece.cell_begin;
+
+  // Appended blocks and the XML elements referring to them
+  std::vector<std::string> blocks;
+  std::ostringstream xml;
+  std::uint64_t offset = 0;
+  const auto array = [&](const std::string& type, const std::string& name,
+                         unsigned ncomponents, const void* data,
+                         std::size_t size) {
+    xml << "        <DataArray type=\"" << type << "\"";
+    if (!name.empty()) xml << " Name=\"" << name << "\"";
+    xml << " NumberOfComponents=\"" << ncomponents
+        << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+    blocks.emplace_back(this->encode(data, size));
+    offset += blocks.back().size();
+  };
+
+  // Values of the points of the piece
+  std::vector<double> buffer;
+  const auto gather = [&](const double* values,
+                          unsigned ncomponents) -> const double* {
+    if (piece.all) return values;
+    buffer.resize(ncomponents * npoints);
+    for (Index i = 0; i < npoints; ++i)
+      for (unsigned j = 0; j < ncomponents; ++j)
+        buffer[ncomponents * i + j] =
+            values[ncomponents * piece.points[i] + j];
+    return buffer.data();
+  };
+
+  xml << "      <PointData>\n";
+  std::vector<std::uint64_t> ids(npoints);
+  for (Index i = 0; i < npoints; ++i)
+    ids[i] = snapshot.ids[piece.all ? i : piece.points[i]];
+  array("UInt64", "id", 1, ids.data(), 8 * npoints);
+  for (const auto& field : snapshot.fields)
+    array("Float64", field.name, field.ncomponents,
+          gather(field.values.data(), field.ncomponents),
+          8 * field.ncomponents * npoints);
+  xml << "      </PointData>\n      <Points>\n";
+  array("Float64", "", 3, gather(snapshot.coordinates.data(), 3),
+        24 * npoints);
+  xml << "      </Points>\n";
+
+  std::vector<std::uint64_t> connectivity, offsets;
+  if (grid) {
+    // Cells refer to the points of the piece
+    const std::uint64_t first =
+        (piece.cell_begin == 0) ? 0 : snapshot.offsets[piece.cell_begin - 1];
+    const std::uint64_t last =
+        (ncells == 0) ? first : snapshot.offsets[piece.cell_end - 1];
+    connectivity.assign(snapshot.connectivity.begin() + first,
+                        snapshot.connectivity.begin() + last);
+    if (!piece.all)
+      for (auto& point : connectivity)
+        point = std::lower_bound(piece.points.begin(), piece.points.end(),
+                                 point) -
+                piece.points.begin();
+    offsets.assign(snapshot.offsets.begin() + piece.cell_begin,
+                   snapshot.offsets.begin() + piece.cell_end);
+    for (auto& cell_offset : offsets) cell_offset -= first;
+    xml << "      <Cells>\n";
+    array("Int64", "connectivity", 1, connectivity.data(),
+          8 * connectivity.size());
+    array("Int64", "offsets", 1, offsets.data(), 8 * ncells);
+    array("UInt8", "types", 1,
+          snapshot.types.data() + piece.cell_begin, ncells);
+    xml << "      </Cells>\n";
+  } else {
+    // A vertex per point
+    connectivity.resize(npoints);
+    offsets.resize(npoints);
+    for (Index i = 0; i < npoints; ++i) {
+      connectivity[i] = i;
+      offsets[i] = i + 1;
+    }
+    xml << "      <Verts>\n";
+    array("Int64", "connectivity", 1, connectivity.data(),
+          8 * npoints);
+    array("Int64", "offsets", 1, offsets.data(), 8 * npoints);
+    xml << "      </Verts>\n";
+  }
+
+  const std::string type = grid ? "UnstructuredGrid" : "PolyData";
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    throw std::runtime_error("Cannot open VTK file: " + filename);
+  file << "<?xml version=\"1.0\"?>\n<VTKFile type=\"" << type
+       << "\" version=\"1.0\" byte_order=\"" << byte_order()
+       << "\" header_type=\"UInt64\"";
+  if (compress_) file << " compressor=\"vtkZLibDataCompressor\"";
+  file << ">\n  <" << type << ">\n    <Piece NumberOfPoints=\"" << npoints
+       << "\" ";
+  if (grid)
+    file << "NumberOfCells=\"" << ncells << "\">\n";
+  else
+    file << "NumberOfVerts=\"" << npoints << "\" NumberOfLines=\"0\" "
+         << "NumberOfStrips=\"0\" NumberOfPolys=\"0\">\n";
+  file << xml.str() << "    </Piece>\n  </" << type << ">\n"
+       << "  <AppendedData encoding=\"raw\">\n_";
+  for (const auto& block : blocks) file.write(block.data(), block.size());
+  file << "\n  </AppendedData>\n</VTKFile>\n";
+  if (!file.good())
+    throw std::runtime_error("Cannot write VTK file: " + filename);
+}
+
+//! Encode an array as an appended block with its header
+//! \details An uncompressed block is its size followed by the data. A
+//! compressed block is the number of blocks, the size of blocks, the size
+//! of the last block if it is partial and the compressed size of each
+//! block, followed by the compressed blocks.
+//! \param[in] data Data of the array
+//! \param[in] size Size of the array in bytes
+//! \retval block Encoded block
+inline std::string mpm::VtkWriter::encode(const void* data,
+                                          std::size_t size) const {
+  const char* bytes = static_cast<const char*>(data);
+  std::string block;
+  const auto append = [&block](std::uint64_t value) {
+    block.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  if (!compress_) {
+    append(size);
+    block.append(bytes, size);
+    return block;
+  }
+
+  const std::size_t nblocks = (size + block_size_ - 1) / block_size_;
+  std::vector<std::string> compressed(nblocks);
+  tbb::parallel_for(std::size_t(0), nblocks, [&](std::size_t i) {
+    const std::size_t begin = i * block_size_;
+    const std::size_t length = std::min(block_size_, size - begin);
+    uLongf compressed_size = compressBound(length);
+    compressed[i].resize(compressed_size);
+    if (compress2(reinterpret_cast<Bytef*>(&compressed[i][0]),
+                  &compressed_size,
+                  reinterpret_cast<const Bytef*>(bytes + begin), length,
+                  level_) != Z_OK)
+      throw std::runtime_error("Cannot compress VTK array");
+    compressed[i].resize(compressed_size);
+  });
+  append(nblocks);
+  append(block_size_);
+  append(size % block_size_);
+  for (const auto& part : compressed) append(part.size());
+  for (const auto& part : compressed) block.append(part);
+  return block;
+}
+
+//! Byte order of the machine
+inline const char* mpm::VtkWriter::byte_order() {
+  const std::uint16_t value = 1;
+  unsigned char first;
+  std::memcpy(&first, &value, 1);
+  return (first == 1) ? "LittleEndian" : "BigEndian";
+}
+
+//! Write a snapshot as legacy VTK binary
+//! \details Particles are poly data with a vertex per point and meshes are
+//! unstructured grids. Binary legacy VTK is big endian.
+//! \param[in] snapshot Snapshot of particles or of a mesh
+//! \param[in] filename Name of the file (.vtk)
+//! \retval status Return false if the file cannot be written
+inline bool mpm::VtkWriter::write_legacy(const Snapshot& snapshot,
+                                         const std::string& filename) {
+  bool status = false;
+  try {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      throw std::runtime_error("Cannot open VTK file: " + filename);
+
+    // Write values as big endian
+    std::vector<unsigned char> bytes;
+    const auto write = [&](const double* values, std::size_t size) {
+      bytes.resize(8 * size);
+      for (std::size_t i = 0; i < size; ++i) {
+        std::uint64_t bits;
+        std::memcpy(&bits, values + i, sizeof(bits));
+        for (unsigned j = 0; j < 8; ++j)
+          bytes[8 * i + j] = static_cast<unsigned char>(bits >> (56 - 8 * j));
+      }
+      file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+    const auto write_integers = [&](const std::vector<std::uint32_t>& values) {
+      bytes.resize(4 * values.size());
+      for (std::size_t i = 0; i < values.size(); ++i)
+        for (unsigned j = 0; j < 4; ++j)
+          bytes[4 * i + j] =
+              static_cast<unsigned char>(values[i] >> (24 - 8 * j));
+      file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    };
+
+    const Index npoints = snapshot.npoints;
+    const Index ncells = snapshot.ncells();
+    file << "# vtk DataFile Version 3.0\n"
+         << "MPM step " << snapshot.step << "\nBINARY\nDATASET "
+         << ((ncells > 0) ? "UNSTRUCTURED_GRID" : "POLYDATA") << '\n'
+         << "POINTS " << npoints << " double\n";
+    write(snapshot.coordinates.data(), 3 * npoints);
+
+    std::vector<std::uint32_t> cells;
+    if (ncells > 0) {
+      // Number of nodes followed by the nodes of each cell
+      std::uint64_t first = 0;
+      for (Index i = 0; i < ncells; ++i) {
+        cells.emplace_back(snapshot.offsets[i] - first);
+        for (auto j = first; j < snapshot.offsets[i]; ++j)
+          cells.emplace_back(snapshot.connectivity[j]);
+        first = snapshot.offsets[i];
+      }
+      file << "\nCELLS " << ncells << ' ' << cells.size() << '\n';
+      write_integers(cells);
+      file << "\nCELL_TYPES " << ncells << '\n';
+      write_integers(std::vector<std::uint32_t>(snapshot.types.begin(),
+                                                snapshot.types.end()));
+    } else {
+      // A vertex per point
+      for (Index i = 0; i < npoints; ++i) {
+        cells.emplace_back(1);
+        cells.emplace_back(i);
+      }
+      file << "\nVERTICES " << npoints << ' ' << 2 * npoints << '\n';
+      write_integers(cells);
+    }
+
+    // Ids, exact up to 2^53, and fields
+    file << "\nPOINT_DATA " << npoints << "\nFIELD FieldData "
+         << snapshot.fields.size() + 1 << '\n';
+    std::vector<double> ids(snapshot.ids.begin(),
+                            snapshot.ids.begin() + npoints);
+    file << "id 1 " << npoints << " double\n";
+    write(ids.data(), npoints);
+    for (const auto& field : snapshot.fields) {
+      file << '\n'
+           << field.name << ' ' << field.ncomponents << ' ' << npoints
+           << " double\n";
+      write(field.values.data(), field.ncomponents * npoints);
+    }
+    file << '\n';
+    if (!file.good())
+      throw std::runtime_error("Cannot write VTK file: " + filename);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
@@ -0,0 +1,91 @@
+#ifndef MPM_DRUCKER_PRAGER_H_
+#define MPM_DRUCKER_PRAGER_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "material.h"
+
+namespace mpm {
+
+//! DruckerPrager class
+//! \brief Perfectly plastic Drucker-Prager material model
+//! \details The cone is fitted to the compression corners of Mohr-Coulomb
+//! with the friction angle and cohesion, and plastic flow follows the cone
+//! of the dilation angle. Stresses are positive in tension. A batch is
+//! computed in two passes: elastic trial stresses and the list of yielding
+//! particles, then the return mapping of yielding particles only. The
+//! accumulated plastic multiplier of particles is a state variable.
+class DruckerPrager : public Material {
+ public:
+  //! Define a vector of 6 dof
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+  //! Define a Matrix of 6 x 6
+  using Matrix6x6 = Eigen::Matrix<double, 6, 6>;
+
+  //! Constructor with id
+  DruckerPrager(unsigned id) : Material(id){};
+
+  //! Destructor
+  virtual ~DruckerPrager(){};
+
+  //! Delete copy constructor
+  DruckerPrager(const DruckerPrager&) = delete;
+
+  //! Delete assignement operator
+  DruckerPrager& operator=(const DruckerPrager&) = delete;
+
+  //! Read material properties
+  void properties(const Json&);
+
+  //! Compute elastic tensor
+  Matrix6x6 elastic_tensor();
+
+  //! Compute stress
+  void compute_stress(Vector6d& stress, const Vector6d& strain);
+
+  //! Compute stresses of a batch of particles
+  void compute_stress(Vector6d* stresses, const Vector6d* strains,
+                      const std::size_t* states, std::size_t nparticles);
+
+  //! Return the state variables of particles of the material
+  std::vector<StateVariable> state_variables() const {
+    return {{"plastic_multiplier", 1, 0.}};
+  }
+
+  //! Yield function
+  double yield(const Vector6d& stress) const;
+
+ private:
+  //! Add the elastic stress increment
+  void elastic_trial(Vector6d& stress, const Vector6d& strain) const;
+
+  //! Return a stress outside the cone to the cone
+  double return_mapping(Vector6d& stress) const;
+
+  //! Youngs modulus
+  double youngs_modulus_{std::numeric_limits<double>::max()};
+  //! Poisson ratio
+  double poisson_ratio_{std::numeric_limits<double>::max()};
+  //! Bulk modulus
+  double bulk_modulus_{0.};
+  //! Shear modulus
+  double shear_modulus_{0.};
+  //! Friction coefficient of the cone
+  double alpha_{0.};
+  //! Dilation coefficient of the plastic potential
+  double alpha_dilation_{0.};
+  //! Cohesion coefficient of the cone
+  double k_{std::numeric_limits<double>::max()};
+};  // DruckerPrager class
+}  // mpm namespace
+
+#include "drucker_prager.tcc"
+
+static Register<mpm::Material, mpm::DruckerPrager, unsigned> drucker_prager(
+    "DruckerPrager");
+
+#endif  // MPM_DRUCKER_PRAGER_H_
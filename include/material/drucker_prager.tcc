@@ -0,0 +1,145 @@
+//! Read material properties
+//! \details Friction and dilation angles are in degrees
+//! \param[in] material_properties Material properties
+inline void mpm::DruckerPrager::properties(const Json& material_properties) {
+  try {
+    youngs_modulus_ =
+        material_properties["youngs_modulus"].template get<double>();
+    poisson_ratio_ =
+        material_properties["poisson_ratio"].template get<double>();
+    const double friction =
+        material_properties["friction"].template get<double>() * M_PI / 180.;
+    const double dilation =
+        material_properties["dilation"].template get<double>() * M_PI / 180.;
+    const double cohesion =
+        material_properties["cohesion"].template get<double>();
+
+    bulk_modulus_ = youngs_modulus_ / (3.0 * (1. - 2. * poisson_ratio_));
+    shear_modulus_ = youngs_modulus_ / (2.0 * (1. + poisson_ratio_));
+
+    // Cone through the compression corners of Mohr-Coulomb
+    const double sin_friction = std::sin(friction);
+    const double sin_dilation = std::sin(dilation);
+    alpha_ = 2. * sin_friction / (std::sqrt(3.) * (3. - sin_friction));
+    alpha_dilation_ = 2. * sin_dilation / (std::sqrt(3.) * (3. - sin_dilation));
+    k_ = 6. * cohesion * std::cos(friction) /
+         (std::sqrt(3.) * (3. - sin_friction));
+  } catch (std::exception& except) {
+    std::cerr << "Material parameter not set: " << except.what() << '\n';
+  }
+}
+
+//! Return elastic tensor
+//! \retval de Elastic tensor
+inline mpm::Material::Matrix6x6 mpm::DruckerPrager::elastic_tensor() {
+  const double G = shear_modulus_;
+  const double a1 = bulk_modulus_ + (4.0 / 3.0) * G;
+  const double a2 = bulk_modulus_ - (2.0 / 3.0) * G;
+
+  Matrix6x6 de = Matrix6x6::Zero();
+  de.topLeftCorner(3, 3).setConstant(a2);
+  de.diagonal() << a1, a1, a1, G, G, G;
+  return de;
+}
+
+//! Yield function
+//! \param[in] stress Stress
+//! \retval yield Square root of J2 plus alpha I1 minus k, positive outside
+//! the cone
+inline double mpm::DruckerPrager::yield(const Vector6d& stress) const {
+  const double I1 = stress(0) + stress(1) + stress(2);
+  const double mean = I1 / 3.;
+  const double J2 = 0.5 * ((stress(0) - mean) * (stress(0) - mean) +
+                           (stress(1) - mean) * (stress(1) - mean) +
+                           (stress(2) - mean) * (stress(2) - mean)) +
+                    stress(3) * stress(3) + stress(4) * stress(4) +
+                    stress(5) * stress(5);
+  return std::sqrt(J2) + alpha_ * I1 - k_;
+}
+
+//! Add the elastic stress increment
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+inline void mpm::DruckerPrager::elastic_trial(Vector6d& stress,
+                                              const Vector6d& strain) const {
+  const double G = shear_modulus_;
+  const double volumetric = (bulk_modulus_ - (2.0 / 3.0) * G) *
+                            (strain(0) + strain(1) + strain(2));
+  stress(0) += volumetric + 2. * G * strain(0);
+  stress(1) += volumetric + 2. * G * strain(1);
+  stress(2) += volumetric + 2. * G * strain(2);
+  stress(3) += G * strain(3);
+  stress(4) += G * strain(4);
+  stress(5) += G * strain(5);
+}
+
+//! Return a stress outside the cone to the cone
+//! \details The deviatoric stress is scaled and the mean stress shifted
+//! along the plastic potential. Stresses beyond the apex return to it.
+//! \param[in,out] stress Trial stress, returned stress
+//! \retval multiplier Plastic multiplier
+inline double mpm::DruckerPrager::return_mapping(Vector6d& stress) const {
+  const double G = shear_modulus_;
+  const double K = bulk_modulus_;
+  const double mean = (stress(0) + stress(1) + stress(2)) / 3.;
+  Vector6d deviatoric = stress;
+  deviatoric.head(3).array() -= mean;
+  const double sqrt_J2 =
+      std::sqrt(0.5 * deviatoric.head(3).squaredNorm() +
+                deviatoric.tail(3).squaredNorm());
+
+  const double multiplier =
+      this->yield(stress) / (G + 9. * K * alpha_ * alpha_dilation_);
+  if (sqrt_J2 - G * multiplier >= 0.) {
+    // Smooth part of the cone
+    stress = deviatoric * ((sqrt_J2 - G * multiplier) / sqrt_J2);
+    stress.head(3).array() += mean - 3. * K * alpha_dilation_ * multiplier;
+  } else {
+    // Apex of the cone
+    stress.setZero();
+    stress.head(3).setConstant(k_ / (3. * alpha_));
+  }
+  return multiplier;
+}
+
+//! Compute stress
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+inline void mpm::DruckerPrager::compute_stress(Vector6d& stress,
+                                               const Vector6d& strain) {
+  this->elastic_trial(stress, strain);
+  if (this->yield(stress) > 0.) this->return_mapping(stress);
+}
+
+//! Compute stresses of a batch of particles
+//! \details Indices of particles are written to the list of yielding
+//! particles unconditionally and kept if the trial stress yields, so the
+//! elastic pass has no branch
+//! \param[in,out] stresses Stresses of particles, updated
+//! \param[in] strains Strain increments of particles
+//! \param[in] states Slots of particles, or nullptr without state
+//! \param[in] nparticles Number of particles in the batch
+inline void mpm::DruckerPrager::compute_stress(Vector6d* stresses,
+                                               const Vector6d* strains,
+                                               const std::size_t* states,
+                                               std::size_t nparticles) {
+  thread_local std::vector<std::size_t> yielding;
+  yielding.resize(nparticles + 1);
+
+  // Elastic trial stresses and yielding particles
+  std::size_t nyielding = 0;
+  for (std::size_t i = 0; i < nparticles; ++i) {
+    this->elastic_trial(stresses[i], strains[i]);
+    yielding[nyielding] = i;
+    nyielding += (this->yield(stresses[i]) > 0.);
+  }
+
+  // Plastic correction of yielding particles
+  double* multipliers =
+      (states != nullptr) ? this->state().column(0) : nullptr;
+  for (std::size_t j = 0; j < nyielding; ++j) {
+    const std::size_t i = yielding[j];
+    const double multiplier = this->return_mapping(stresses[i]);
+    if (multipliers != nullptr) multipliers[states[i]] += multiplier;
+  }
+}
@@ -11,7 +11,9 @@ namespace mpm {
 
 //! LinearElastic class
 //! \brief Linear Elastic material model
-//! \details LinearElastic class stresses and strains
+//! \details LinearElastic class stresses and strains. Lame constants are
+//! computed when properties are read, and stresses are updated with the
+//! isotropic closed form. The elastic tensor is only built on request.
 class LinearElastic : public Material {
  public:
   //! Define a vector of 6 dof
@@ -40,9 +42,19 @@ class LinearElastic : public Material {
   //! Compute elastic tensor
   Matrix6x6 elastic_tensor();
 
+  //! Return the first Lame constant
+  double lambda() const { return lambda_; }
+
+  //! Return the shear modulus
+  double shear_modulus() const { return shear_modulus_; }
+
   //! Compute stress
   void compute_stress(Vector6d& stress, const Vector6d& strain);
 
+  //! Compute stresses of a batch of particles
+  void compute_stress(Vector6d* stresses, const Vector6d* strains,
+                      const std::size_t* states, std::size_t nparticles);
+
  protected:
   //! material id
   using Material::id_;
@@ -54,6 +66,10 @@ class LinearElastic : public Material {
   double youngs_modulus_{std::numeric_limits<double>::max()};
   //! Poisson ratio
   double poisson_ratio_{std::numeric_limits<double>::max()};
+  //! First Lame constant
+  double lambda_{0.};
+  //! Shear modulus, second Lame constant
+  double shear_modulus_{0.};
 };  // LinearElastic class
 }  // mpm namespace
 
@@ -1,11 +1,16 @@
 //! Read material properties
+//! \details Lame constants are computed from the Young's modulus and the
+//! Poisson ratio
 //! \param[in] materail_properties Material properties
-void mpm::LinearElastic::properties(const Json& materail_properties) {
+inline void mpm::LinearElastic::properties(const Json& materail_properties) {
   try {
     youngs_modulus_ =
         materail_properties["youngs_modulus"].template get<double>();
     poisson_ratio_ =
         materail_properties["poisson_ratio"].template get<double>();
+    lambda_ = youngs_modulus_ * poisson_ratio_ /
+              ((1. + poisson_ratio_) * (1. - 2. * poisson_ratio_));
+    shear_modulus_ = youngs_modulus_ / (2.0 * (1. + poisson_ratio_));
   } catch (std::exception& except) {
     std::cerr << "Material parameter not set: " << except.what() << '\n';
   }
@@ -13,13 +18,12 @@ void mpm::LinearElastic::properties(const Json& materail_properties) {
 
 //! Return elastic tensor
 //! \retval de_ Elastic tensor
-mpm::Material::Matrix6x6 mpm::LinearElastic::elastic_tensor() {
-  // Bulk and shear modulus
-  const double K = youngs_modulus_ / (3.0 * (1. - 2. * poisson_ratio_));
-  const double G = youngs_modulus_ / (2.0 * (1. + poisson_ratio_));
+inline mpm::Material::Matrix6x6 mpm::LinearElastic::elastic_tensor() {
+  // Shear modulus
+  const double G = shear_modulus_;
 
-  const double a1 = K + (4.0 / 3.0) * G;
-  const double a2 = K - (2.0 / 3.0) * G;
+  const double a1 = lambda_ + 2. * G;
+  const double a2 = lambda_;
 
   // clang-format off
   // compute elasticityTensor
@@ -35,11 +39,46 @@ mpm::Material::Matrix6x6 mpm::LinearElastic::elastic_tensor() {
 }
 
 //! Compute stress
+//! \details Normal stresses change by the first Lame constant times the
+//! volumetric strain plus twice the shear modulus times the normal strain,
+//! and shear stresses by the shear modulus times the engineering shear
+//! strain
 //! \param[in] strain Strain
 //! \param[in] stress Stress
 //! \retval updated_stress Updated value of stress
-void mpm::LinearElastic::compute_stress(Vector6d& stress,
-                                        const Vector6d& strain) {
-  Vector6d dstress = de_ * strain;
-  stress += dstress;
+inline void mpm::LinearElastic::compute_stress(Vector6d& stress,
+                                               const Vector6d& strain) {
+  const double G2 = 2. * shear_modulus_;
+  const double volumetric = lambda_ * (strain(0) + strain(1) + strain(2));
+  stress(0) += volumetric + G2 * strain(0);
+  stress(1) += volumetric + G2 * strain(1);
+  stress(2) += volumetric + G2 * strain(2);
+  stress(3) += shear_modulus_ * strain(3);
+  stress(4) += shear_modulus_ * strain(4);
+  stress(5) += shear_modulus_ * strain(5);
+}
+
+//! Compute stresses of a batch of particles
+//! \details Slots of particles are unused without state variables
+//! \param[in,out] stresses Stresses of particles, updated
+//! \param[in] strains Strain increments of particles
+//! \param[in] nparticles Number of particles in the batch
+inline void mpm::LinearElastic::compute_stress(Vector6d* stresses,
+                                               const Vector6d* strains,
+                                               const std::size_t* /*states*/,
+                                               std::size_t nparticles) {
+  const double lambda = lambda_;
+  const double G = shear_modulus_;
+  const double G2 = 2. * G;
+  for (std::size_t i = 0; i < nparticles; ++i) {
+    const Vector6d& strain = strains[i];
+    Vector6d& stress = stresses[i];
+    const double volumetric = lambda * (strain(0) + strain(1) + strain(2));
+    stress(0) += volumetric + G2 * strain(0);
+    stress(1) += volumetric + G2 * strain(1);
+    stress(2) += volumetric + G2 * strain(2);
+    stress(3) += G * strain(3);
+    stress(4) += G * strain(4);
+    stress(5) += G * strain(5);
+  }
 }
@@ -1,12 +1,16 @@
 #ifndef MPM_MATERIAL_H_
 #define MPM_MATERIAL_H_
 
+#include <cstddef>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 #include "Eigen/Dense"
 #include "json.hpp"
 
 #include "factory.h"
+#include "material/material_state.h"
 
 // JSON
 using Json = nlohmann::json;
@@ -22,6 +26,8 @@ class Material {
   using Vector6d = Eigen::Matrix<double, 6, 1>;
   //! Define a Matrix of 6 x 6
   using Matrix6x6 = Eigen::Matrix<double, 6, 6>;
+  //! Define a state variable
+  using StateVariable = MaterialState::Variable;
 
   //! Constructor with id
   Material(unsigned id);
@@ -47,9 +53,28 @@ class Material {
   //! Compute stress
   virtual void compute_stress(Vector6d& stress, const Vector6d& strain) = 0;
 
+  //! Compute stresses of a batch of particles
+  virtual void compute_stress(Vector6d* stresses, const Vector6d* strains,
+                              const std::size_t* states,
+                              std::size_t nparticles);
+
+  //! Return the state variables of particles of the material
+  virtual std::vector<StateVariable> state_variables() const {
+    return std::vector<StateVariable>();
+  }
+
+  //! Return the pool of state variables of particles
+  MaterialState& state();
+
  protected:
   //! material id
   unsigned id_{std::numeric_limits<unsigned>::max()};
+
+ private:
+  //! State variables of particles
+  MaterialState state_;
+  //! Declaration of state variables
+  std::once_flag state_flag_;
 };  // Material class
 }  // mpm namespace
 
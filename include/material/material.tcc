@@ -1,3 +1,28 @@
 // Constructor with id
 //! \param[in] id Material id
-mpm::Material::Material(unsigned id) : id_{id} {}
+inline mpm::Material::Material(unsigned id) : id_{id} {}
+
+//! Compute stresses of a batch of particles
+//! \details Models override it with a loop over the batch, so that the
+//! virtual call is made once per batch; the slots of particles in the pool
+//! of state variables are unused by models without state variables
+//! \param[in,out] stresses Stresses of particles, updated
+//! \param[in] strains Strain increments of particles
+//! \param[in] nparticles Number of particles in the batch
+inline void mpm::Material::compute_stress(Vector6d* stresses,
+                                          const Vector6d* strains,
+                                          const std::size_t* /*states*/,
+                                          std::size_t nparticles) {
+  for (std::size_t i = 0; i < nparticles; ++i)
+    this->compute_stress(stresses[i], strains[i]);
+}
+
+//! Return the pool of state variables of particles
+//! \details State variables are declared when the pool is first used, so
+//! properties are read before particles are assigned to the material
+//! \retval state Pool of state variables
+inline mpm::MaterialState& mpm::Material::state() {
+  std::call_once(state_flag_,
+                 [this]() { state_.initialise(this->state_variables()); });
+  return state_;
+}
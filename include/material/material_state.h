@@ -0,0 +1,102 @@
+#ifndef MPM_MATERIAL_STATE_H_
+#define MPM_MATERIAL_STATE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mpm {
+
+//! MaterialState class
+//! \brief Pool of the state variables of the particles of a material
+//! \details Each state variable is a column of values stored contiguously,
+//! with the values of a particle at its slot. Slots of particles that leave
+//! the material are reused. Slots are allocated, released and assigned
+//! under a lock, while stresses are computed and columns are read without
+//! it, so allocation must not overlap the computation of stresses.
+class MaterialState {
+ public:
+  //! State variable
+  struct Variable {
+    //! Name
+    std::string name;
+    //! Number of values per particle
+    unsigned size;
+    //! Initial value
+    double initial;
+  };
+
+  //! Default constructor
+  MaterialState() = default;
+
+  //! Delete copy constructor
+  MaterialState(const MaterialState&) = delete;
+
+  //! Delete assignement operator
+  MaterialState& operator=(const MaterialState&) = delete;
+
+  //! Declare the state variables, before any slot is allocated
+  void initialise(const std::vector<Variable>& variables);
+
+  //! Number of state variables
+  unsigned nvariables() const { return variables_.size(); }
+
+  //! Return a state variable
+  const Variable& variable(unsigned index) const {
+    return variables_.at(index);
+  }
+
+  //! Index of a state variable, or nvariables if it is not declared
+  unsigned index(const std::string& name) const;
+
+  //! Number of values of all variables per particle
+  unsigned size() const { return size_; }
+
+  //! Number of slots, including released slots
+  std::size_t nslots() const { return nslots_; }
+
+  //! Number of slots in use
+  std::size_t nparticles() const { return nslots_ - free_.size(); }
+
+  //! Allocate a slot with the initial values
+  std::size_t allocate();
+
+  //! Release a slot
+  void release(std::size_t slot);
+
+  //! Assign the values of all variables of a slot
+  void assign(std::size_t slot, const std::vector<double>& values);
+
+  //! Return the values of all variables of a slot
+  std::vector<double> values(std::size_t slot) const;
+
+  //! Return the column of a state variable
+  double* column(unsigned index) { return columns_[index].data(); }
+
+  //! Return the column of a state variable
+  const double* column(unsigned index) const {
+    return columns_[index].data();
+  }
+
+ private:
+  //! State variables
+  std::vector<Variable> variables_;
+  //! Number of values of all variables per particle
+  unsigned size_{0};
+  //! Columns of values by variable
+  std::vector<std::vector<double>> columns_;
+  //! Number of slots
+  std::size_t nslots_{0};
+  //! Released slots
+  std::vector<std::size_t> free_;
+  //! Lock of allocation
+  std::mutex mutex_;
+};  // MaterialState class
+}  // mpm namespace
+
+#include "material_state.tcc"
+
+#endif  // MPM_MATERIAL_STATE_H_
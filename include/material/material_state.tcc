@@ -0,0 +1,81 @@
+//! Declare the state variables, before any slot is allocated
+//! \param[in] variables State variables
+inline void mpm::MaterialState::initialise(
+    const std::vector<Variable>& variables) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (nslots_ != 0)
+    throw std::runtime_error("State variables are declared after allocation");
+  variables_ = variables;
+  columns_.assign(variables_.size(), std::vector<double>());
+  size_ = 0;
+  for (const auto& variable : variables_) size_ += variable.size;
+}
+
+//! Index of a state variable, or nvariables if it is not declared
+//! \param[in] name Name of the state variable
+//! \retval index Index of the state variable
+inline unsigned mpm::MaterialState::index(const std::string& name) const {
+  unsigned index = 0;
+  while (index < variables_.size() && variables_[index].name != name) ++index;
+  return index;
+}
+
+//! Allocate a slot with the initial values
+//! \details Released slots are reused before columns grow
+//! \retval slot Slot of the particle
+inline std::size_t mpm::MaterialState::allocate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t slot = nslots_;
+  if (!free_.empty()) {
+    slot = free_.back();
+    free_.pop_back();
+  } else {
+    ++nslots_;
+    for (unsigned i = 0; i < variables_.size(); ++i)
+      columns_[i].resize(nslots_ * variables_[i].size);
+  }
+  for (unsigned i = 0; i < variables_.size(); ++i) {
+    const unsigned size = variables_[i].size;
+    std::fill_n(columns_[i].begin() + slot * size, size,
+                variables_[i].initial);
+  }
+  return slot;
+}
+
+//! Release a slot
+//! \param[in] slot Slot of the particle
+inline void mpm::MaterialState::release(std::size_t slot) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (slot < nslots_) free_.emplace_back(slot);
+}
+
+//! Assign the values of all variables of a slot
+//! \param[in] slot Slot of the particle
+//! \param[in] values Values of the variables, in order of declaration
+inline void mpm::MaterialState::assign(std::size_t slot,
+                                       const std::vector<double>& values) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (slot >= nslots_ || values.size() != size_)
+    throw std::runtime_error("Invalid material state of a particle");
+  auto value = values.begin();
+  for (unsigned i = 0; i < variables_.size(); ++i) {
+    const unsigned size = variables_[i].size;
+    std::copy(value, value + size, columns_[i].begin() + slot * size);
+    value += size;
+  }
+}
+
+//! Return the values of all variables of a slot
+//! \param[in] slot Slot of the particle
+//! \retval values Values of the variables, in order of declaration
+inline std::vector<double> mpm::MaterialState::values(std::size_t slot) const {
+  std::vector<double> values;
+  if (slot >= nslots_) return values;
+  values.reserve(size_);
+  for (unsigned i = 0; i < variables_.size(); ++i) {
+    const unsigned size = variables_[i].size;
+    values.insert(values.end(), columns_[i].begin() + slot * size,
+                  columns_[i].begin() + (slot + 1) * size);
+  }
+  return values;
+}
@@ -0,0 +1,161 @@
+#ifndef MPM_MODIFIED_CAM_CLAY_H_
+#define MPM_MODIFIED_CAM_CLAY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "material.h"
+
+namespace mpm {
+
+//! ModifiedCamClay class
+//! \brief Modified Cam-Clay critical state material model
+//! \details Stresses are positive in tension, while the mean stress p and
+//! the preconsolidation pressure pc of the model are positive in
+//! compression. The bulk modulus depends on the mean stress and the
+//! specific volume at the start of an increment, and the shear modulus
+//! follows from the Poisson ratio. Yielding stresses return implicitly to
+//! the ellipse q^2 / M^2 + p (p - pc) = 0 with a local Newton solver on p,
+//! pc and the plastic multiplier, with fixed size matrices and without
+//! allocation. Increments whose Newton iterations do not converge within
+//! the bounded number of iterations are split into substeps. A batch is
+//! computed in two passes: elastic trial stresses and the list of yielding
+//! particles, then the return mapping of yielding particles only. The
+//! preconsolidation pressure and the specific volume of particles are
+//! state variables.
+class ModifiedCamClay : public Material {
+ public:
+  //! Define a vector of 6 dof
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+  //! Define a Matrix of 6 x 6
+  using Matrix6x6 = Eigen::Matrix<double, 6, 6>;
+
+  //! Counters of stress updates
+  struct Statistics {
+    //! Number of stress updates
+    unsigned long long nupdates;
+    //! Number of stress updates with yielding
+    unsigned long long nyielding;
+    //! Number of Newton iterations
+    unsigned long long niterations;
+    //! Number of yielding stress updates split into substeps
+    unsigned long long nsubstepped;
+    //! Number of substeps of yielding stress updates
+    unsigned long long nsubsteps;
+    //! Number of yielding stress updates that did not converge
+    unsigned long long nfailed;
+  };
+
+  //! Constructor with id
+  ModifiedCamClay(unsigned id) : Material(id){};
+
+  //! Destructor
+  virtual ~ModifiedCamClay(){};
+
+  //! Delete copy constructor
+  ModifiedCamClay(const ModifiedCamClay&) = delete;
+
+  //! Delete assignement operator
+  ModifiedCamClay& operator=(const ModifiedCamClay&) = delete;
+
+  //! Read material properties
+  void properties(const Json&);
+
+  //! Compute elastic tensor at the initial preconsolidation pressure
+  Matrix6x6 elastic_tensor();
+
+  //! Compute stress from the initial state variables
+  void compute_stress(Vector6d& stress, const Vector6d& strain);
+
+  //! Compute stresses of a batch of particles
+  void compute_stress(Vector6d* stresses, const Vector6d* strains,
+                      const std::size_t* states, std::size_t nparticles);
+
+  //! Return the state variables of particles of the material
+  std::vector<StateVariable> state_variables() const {
+    return {{"preconsolidation_pressure", 1, preconsolidation_pressure_},
+            {"specific_volume", 1, 1. + void_ratio_}};
+  }
+
+  //! Yield function
+  double yield(const Vector6d& stress, double preconsolidation) const;
+
+  //! Return counters of stress updates since the last reset
+  Statistics statistics() const;
+
+  //! Reset counters of stress updates, e.g. at the start of a step
+  void reset_statistics();
+
+  //! Maximum number of Newton iterations of a return mapping
+  static constexpr unsigned max_iterations = 20;
+
+  //! Maximum number of substeps of an increment
+  static constexpr unsigned max_substeps = 64;
+
+ private:
+  //! Check if a stress yields, beyond the tolerance of the return mapping
+  bool yields(const Vector6d& stress, double preconsolidation) const;
+
+  //! Elastic moduli of a stress and specific volume
+  void elastic_moduli(const Vector6d& stress, double volume, double& bulk,
+                      double& shear) const;
+
+  //! Add the elastic stress increment
+  void elastic_trial(Vector6d& stress, const Vector6d& strain, double bulk,
+                     double shear) const;
+
+  //! Return a trial stress outside the surface to the surface
+  bool return_mapping(Vector6d& stress, double bulk, double shear,
+                      double& preconsolidation, double volume,
+                      unsigned long long& niterations) const;
+
+  //! Compute stress of a yielding increment with substepping
+  void plastic_update(Vector6d& stress, const Vector6d& strain,
+                      double& preconsolidation, double& volume,
+                      Statistics& statistics) const;
+
+  //! Add counters of a batch
+  void add_statistics(const Statistics& statistics);
+
+  //! Poisson ratio
+  double poisson_ratio_{std::numeric_limits<double>::max()};
+  //! Swelling index
+  double kappa_{std::numeric_limits<double>::max()};
+  //! Compression index
+  double lambda_{std::numeric_limits<double>::max()};
+  //! Slope of the critical state line
+  double critical_state_ratio_{std::numeric_limits<double>::max()};
+  //! Initial void ratio
+  double void_ratio_{std::numeric_limits<double>::max()};
+  //! Initial preconsolidation pressure
+  double preconsolidation_pressure_{std::numeric_limits<double>::max()};
+  //! Lower bound of the mean stress of elastic moduli
+  double minimum_pressure_{0.};
+  //! Relative tolerance of Newton iterations
+  double tolerance_{1.E-10};
+  //! Number of stress updates
+  std::atomic<unsigned long long> nupdates_{0};
+  //! Number of stress updates with yielding
+  std::atomic<unsigned long long> nyielding_{0};
+  //! Number of Newton iterations
+  std::atomic<unsigned long long> niterations_{0};
+  //! Number of yielding stress updates split into substeps
+  std::atomic<unsigned long long> nsubstepped_{0};
+  //! Number of substeps of yielding stress updates
+  std::atomic<unsigned long long> nsubsteps_{0};
+  //! Number of yielding stress updates that did not converge
+  std::atomic<unsigned long long> nfailed_{0};
+};  // ModifiedCamClay class
+}  // mpm namespace
+
+#include "modified_cam_clay.tcc"
+
+static Register<mpm::Material, mpm::ModifiedCamClay, unsigned>
+    modified_cam_clay("ModifiedCamClay");
+
+#endif  // MPM_MODIFIED_CAM_CLAY_H_
@@ -0,0 +1,322 @@
+//! Read material properties
+//! \details The minimum pressure of elastic moduli is optional, and is a
+//! thousandth of the preconsolidation pressure by default
+//! \param[in] material_properties Material properties
+inline void mpm::ModifiedCamClay::properties(const Json& material_properties) {
+  try {
+    poisson_ratio_ =
+        material_properties["poisson_ratio"].template get<double>();
+    kappa_ = material_properties["kappa"].template get<double>();
+    lambda_ = material_properties["lambda"].template get<double>();
+    critical_state_ratio_ =
+        material_properties["critical_state_ratio"].template get<double>();
+    void_ratio_ = material_properties["void_ratio"].template get<double>();
+    preconsolidation_pressure_ =
+        material_properties["preconsolidation_pressure"]
+            .template get<double>();
+    minimum_pressure_ = material_properties.value(
+        "minimum_pressure", 1.E-3 * preconsolidation_pressure_);
+  } catch (std::exception& except) {
+    std::cerr << "Material parameter not set: " << except.what() << '\n';
+  }
+}
+
+//! Return elastic tensor at the initial preconsolidation pressure
+//! \retval de Elastic tensor
+inline mpm::Material::Matrix6x6 mpm::ModifiedCamClay::elastic_tensor() {
+  Vector6d stress = Vector6d::Zero();
+  stress.head(3).setConstant(-preconsolidation_pressure_);
+  double K, G;
+  this->elastic_moduli(stress, 1. + void_ratio_, K, G);
+  const double a1 = K + (4.0 / 3.0) * G;
+  const double a2 = K - (2.0 / 3.0) * G;
+
+  Matrix6x6 de = Matrix6x6::Zero();
+  de.topLeftCorner(3, 3).setConstant(a2);
+  de.diagonal() << a1, a1, a1, G, G, G;
+  return de;
+}
+
+//! Yield function
+//! \param[in] stress Stress
+//! \param[in] preconsolidation Preconsolidation pressure
+//! \retval yield q^2 / M^2 + p (p - pc), positive outside the surface
+inline double mpm::ModifiedCamClay::yield(const Vector6d& stress,
+                                          double preconsolidation) const {
+  const double p = -(stress(0) + stress(1) + stress(2)) / 3.;
+  const double J2 = 0.5 * ((stress(0) + p) * (stress(0) + p) +
+                           (stress(1) + p) * (stress(1) + p) +
+                           (stress(2) + p) * (stress(2) + p)) +
+                    stress(3) * stress(3) + stress(4) * stress(4) +
+                    stress(5) * stress(5);
+  return 3. * J2 / (critical_state_ratio_ * critical_state_ratio_) +
+         p * (p - preconsolidation);
+}
+
+//! Check if a stress yields
+//! \details Stresses beyond the surface by less than the relative tolerance
+//! of the return mapping are on the surface and elastic, so that round-off
+//! is not counted as yielding
+//! \param[in] stress Stress
+//! \param[in] preconsolidation Preconsolidation pressure
+//! \retval yields Stress is outside the surface
+inline bool mpm::ModifiedCamClay::yields(const Vector6d& stress,
+                                         double preconsolidation) const {
+  return this->yield(stress, preconsolidation) >
+         tolerance_ * preconsolidation * preconsolidation;
+}
+
+//! Elastic moduli of a stress and specific volume
+//! \param[in] stress Stress
+//! \param[in] volume Specific volume
+//! \param[out] bulk Bulk modulus
+//! \param[out] shear Shear modulus
+inline void mpm::ModifiedCamClay::elastic_moduli(const Vector6d& stress,
+                                                 double volume, double& bulk,
+                                                 double& shear) const {
+  const double p = std::max(-(stress(0) + stress(1) + stress(2)) / 3.,
+                            minimum_pressure_);
+  bulk = volume * p / kappa_;
+  shear = 1.5 * bulk * (1. - 2. * poisson_ratio_) / (1. + poisson_ratio_);
+}
+
+//! Add the elastic stress increment
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+//! \param[in] bulk Bulk modulus
+//! \param[in] shear Shear modulus
+inline void mpm::ModifiedCamClay::elastic_trial(Vector6d& stress,
+                                                const Vector6d& strain,
+                                                double bulk,
+                                                double shear) const {
+  const double volumetric =
+      (bulk - (2.0 / 3.0) * shear) * (strain(0) + strain(1) + strain(2));
+  stress(0) += volumetric + 2. * shear * strain(0);
+  stress(1) += volumetric + 2. * shear * strain(1);
+  stress(2) += volumetric + 2. * shear * strain(2);
+  stress(3) += shear * strain(3);
+  stress(4) += shear * strain(4);
+  stress(5) += shear * strain(5);
+}
+
+//! Return a trial stress outside the surface to the surface
+//! \details The deviatoric stress keeps its direction, so the Newton
+//! iterations solve for the mean stress, the preconsolidation pressure and
+//! the plastic multiplier only. The residuals are the elastic volumetric
+//! relation, the exponential hardening law and the yield function.
+//! \param[in,out] stress Trial stress, returned stress if converged
+//! \param[in] bulk Bulk modulus
+//! \param[in] shear Shear modulus
+//! \param[in,out] preconsolidation Preconsolidation pressure, updated if
+//! converged
+//! \param[in] volume Specific volume
+//! \param[in,out] niterations Number of Newton iterations, incremented
+//! \retval status Return false if the iterations do not converge
+inline bool mpm::ModifiedCamClay::return_mapping(
+    Vector6d& stress, double bulk, double shear, double& preconsolidation,
+    double volume, unsigned long long& niterations) const {
+  const double M2 = critical_state_ratio_ * critical_state_ratio_;
+  const double theta = volume / (lambda_ - kappa_);
+  const double trial_p = -(stress(0) + stress(1) + stress(2)) / 3.;
+  Vector6d deviatoric = stress;
+  deviatoric.head(3).array() += trial_p;
+  const double trial_q2 = 3. * (0.5 * deviatoric.head(3).squaredNorm() +
+                                deviatoric.tail(3).squaredNorm());
+  const double initial = preconsolidation;
+
+  // Mean stress, preconsolidation pressure and plastic multiplier
+  Eigen::Vector3d unknowns(trial_p, initial, 0.);
+  Eigen::Vector3d residual;
+  Eigen::Matrix3d jacobian;
+  bool converged = false;
+  for (unsigned k = 0; k <= max_iterations; ++k) {
+    const double p = unknowns(0);
+    const double pc = unknowns(1);
+    const double multiplier = unknowns(2);
+    const double factor = 1. + 6. * shear * multiplier / M2;
+    const double q2 = trial_q2 / (factor * factor);
+    const double dyield = 2. * p - pc;
+    const double hardening =
+        initial * std::exp(theta * multiplier * dyield);
+    residual << p - trial_p + bulk * multiplier * dyield, pc - hardening,
+        q2 / M2 + p * (p - pc);
+    if (std::abs(residual(0)) <= tolerance_ * initial &&
+        std::abs(residual(1)) <= tolerance_ * initial &&
+        std::abs(residual(2)) <= tolerance_ * initial * initial) {
+      converged = true;
+      break;
+    }
+    if (k == max_iterations) break;
+
+    // clang-format off
+    jacobian << 1. + 2. * bulk * multiplier, -bulk * multiplier,
+                bulk * dyield,
+                -2. * hardening * theta * multiplier,
+                1. + hardening * theta * multiplier,
+                -hardening * theta * dyield,
+                dyield, -p, -12. * shear * q2 / (M2 * M2 * factor);
+    // clang-format on
+    unknowns -= jacobian.inverse() * residual;
+    ++niterations;
+  }
+  if (!converged || !(unknowns(1) > 0.) || !(unknowns(2) >= 0.))
+    return false;
+
+  const double factor = 1. + 6. * shear * unknowns(2) / M2;
+  stress = deviatoric / factor;
+  stress.head(3).array() -= unknowns(0);
+  preconsolidation = unknowns(1);
+  return true;
+}
+
+//! Compute stress of a yielding increment with substepping
+//! \details The increment is split into 2, 4, ... substeps until the
+//! return mapping of every substep converges. Increments that do not
+//! converge with the maximum number of substeps are elastic.
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+//! \param[in,out] preconsolidation Preconsolidation pressure
+//! \param[in,out] volume Specific volume
+//! \param[in,out] statistics Counters of stress updates
+inline void mpm::ModifiedCamClay::plastic_update(
+    Vector6d& stress, const Vector6d& strain, double& preconsolidation,
+    double& volume, Statistics& statistics) const {
+  double bulk, shear;
+  for (unsigned nsubsteps = 1; nsubsteps <= max_substeps; nsubsteps *= 2) {
+    Vector6d substress = stress;
+    double subconsolidation = preconsolidation;
+    double subvolume = volume;
+    const Vector6d increment = strain / nsubsteps;
+    const double volumetric = increment(0) + increment(1) + increment(2);
+    bool converged = true;
+    for (unsigned i = 0; i < nsubsteps && converged; ++i) {
+      this->elastic_moduli(substress, subvolume, bulk, shear);
+      this->elastic_trial(substress, increment, bulk, shear);
+      if (this->yields(substress, subconsolidation))
+        converged = this->return_mapping(substress, bulk, shear,
+                                         subconsolidation, subvolume,
+                                         statistics.niterations);
+      subvolume *= std::exp(volumetric);
+    }
+    if (converged) {
+      stress = substress;
+      preconsolidation = subconsolidation;
+      volume = subvolume;
+      statistics.nsubsteps += nsubsteps;
+      if (nsubsteps > 1) ++statistics.nsubstepped;
+      return;
+    }
+  }
+
+  // Elastic increment
+  ++statistics.nfailed;
+  this->elastic_moduli(stress, volume, bulk, shear);
+  this->elastic_trial(stress, strain, bulk, shear);
+  volume *= std::exp(strain(0) + strain(1) + strain(2));
+}
+
+//! Compute stress from the initial state variables
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+inline void mpm::ModifiedCamClay::compute_stress(Vector6d& stress,
+                                                 const Vector6d& strain) {
+  this->compute_stress(&stress, &strain, nullptr, 1);
+}
+
+//! Compute stresses of a batch of particles
+//! \details Indices of particles are written to the list of yielding
+//! particles unconditionally and kept if the trial stress yields. Yielding
+//! particles restart from the stress at the start of the increment, so
+//! that it can be split into substeps.
+//! \param[in,out] stresses Stresses of particles, updated
+//! \param[in] strains Strain increments of particles
+//! \param[in] states Slots of particles, or nullptr for the initial state
+//! variables
+//! \param[in] nparticles Number of particles in the batch
+inline void mpm::ModifiedCamClay::compute_stress(Vector6d* stresses,
+                                                 const Vector6d* strains,
+                                                 const std::size_t* states,
+                                                 std::size_t nparticles) {
+  thread_local std::vector<std::size_t> yielding;
+  yielding.resize(nparticles + 1);
+
+  double* consolidations =
+      (states != nullptr) ? this->state().column(0) : nullptr;
+  double* volumes = (states != nullptr) ? this->state().column(1) : nullptr;
+  Statistics statistics{nparticles, 0, 0, 0, 0, 0};
+
+  // Elastic trial stresses and yielding particles
+  std::size_t nyielding = 0;
+  for (std::size_t i = 0; i < nparticles; ++i) {
+    const double preconsolidation = (consolidations != nullptr)
+                                        ? consolidations[states[i]]
+                                        : preconsolidation_pressure_;
+    const double volume =
+        (volumes != nullptr) ? volumes[states[i]] : 1. + void_ratio_;
+    double bulk, shear;
+    this->elastic_moduli(stresses[i], volume, bulk, shear);
+    Vector6d trial = stresses[i];
+    this->elastic_trial(trial, strains[i], bulk, shear);
+    const bool yields = this->yields(trial, preconsolidation);
+    yielding[nyielding] = i;
+    nyielding += yields;
+    if (!yields) {
+      stresses[i] = trial;
+      if (volumes != nullptr)
+        volumes[states[i]] =
+            volume * std::exp(strains[i](0) + strains[i](1) + strains[i](2));
+    }
+  }
+
+  // Return mapping of yielding particles
+  statistics.nyielding = nyielding;
+  for (std::size_t j = 0; j < nyielding; ++j) {
+    const std::size_t i = yielding[j];
+    double preconsolidation = (consolidations != nullptr)
+                                  ? consolidations[states[i]]
+                                  : preconsolidation_pressure_;
+    double volume =
+        (volumes != nullptr) ? volumes[states[i]] : 1. + void_ratio_;
+    this->plastic_update(stresses[i], strains[i], preconsolidation, volume,
+                         statistics);
+    if (consolidations != nullptr) {
+      consolidations[states[i]] = preconsolidation;
+      volumes[states[i]] = volume;
+    }
+  }
+  this->add_statistics(statistics);
+}
+
+//! Return counters of stress updates since the last reset
+//! \details Iterations per yielding update and the rate of substepped
+//! updates are ratios of the counters
+//! \retval statistics Counters of stress updates
+inline mpm::ModifiedCamClay::Statistics mpm::ModifiedCamClay::statistics()
+    const {
+  return Statistics{nupdates_.load(),    nyielding_.load(),
+                    niterations_.load(), nsubstepped_.load(),
+                    nsubsteps_.load(),   nfailed_.load()};
+}
+
+//! Reset counters of stress updates, e.g. at the start of a step
+inline void mpm::ModifiedCamClay::reset_statistics() {
+  nupdates_ = 0;
+  nyielding_ = 0;
+  niterations_ = 0;
+  nsubstepped_ = 0;
+  nsubsteps_ = 0;
+  nfailed_ = 0;
+}
+
+//! Add counters of a batch
+//! \details Counters are added once per batch, as batches run in parallel
+//! \param[in] statistics Counters of a batch
+inline void mpm::ModifiedCamClay::add_statistics(
+    const Statistics& statistics) {
+  nupdates_ += statistics.nupdates;
+  nyielding_ += statistics.nyielding;
+  niterations_ += statistics.niterations;
+  nsubstepped_ += statistics.nsubstepped;
+  nsubsteps_ += statistics.nsubsteps;
+  nfailed_ += statistics.nfailed;
+}
@@ -0,0 +1,101 @@
+#ifndef MPM_MOHR_COULOMB_H_
+#define MPM_MOHR_COULOMB_H_
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "material.h"
+
+namespace mpm {
+
+//! MohrCoulomb class
+//! \brief Perfectly plastic Mohr-Coulomb material model
+//! \details Plastic flow follows the Mohr-Coulomb surface of the dilation
+//! angle. Stresses are positive in tension. Stresses are returned in the
+//! principal space to the main plane, to an edge or to the apex. A batch
+//! is computed in passes: elastic trial stresses with a bound of the yield
+//! function from the invariants, the principal stresses of particles near
+//! the surface, then the spectral decomposition and return mapping of
+//! yielding particles only. The accumulated plastic multiplier of
+//! particles is a state variable.
+class MohrCoulomb : public Material {
+ public:
+  //! Define a vector of 6 dof
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+  //! Define a Matrix of 6 x 6
+  using Matrix6x6 = Eigen::Matrix<double, 6, 6>;
+
+  //! Constructor with id
+  MohrCoulomb(unsigned id) : Material(id){};
+
+  //! Destructor
+  virtual ~MohrCoulomb(){};
+
+  //! Delete copy constructor
+  MohrCoulomb(const MohrCoulomb&) = delete;
+
+  //! Delete assignement operator
+  MohrCoulomb& operator=(const MohrCoulomb&) = delete;
+
+  //! Read material properties
+  void properties(const Json&);
+
+  //! Compute elastic tensor
+  Matrix6x6 elastic_tensor();
+
+  //! Compute stress
+  void compute_stress(Vector6d& stress, const Vector6d& strain);
+
+  //! Compute stresses of a batch of particles
+  void compute_stress(Vector6d* stresses, const Vector6d* strains,
+                      const std::size_t* states, std::size_t nparticles);
+
+  //! Return the state variables of particles of the material
+  std::vector<StateVariable> state_variables() const {
+    return {{"plastic_multiplier", 1, 0.}};
+  }
+
+  //! Principal stresses in decreasing order
+  static Eigen::Vector3d principal_stresses(const Vector6d& stress);
+
+  //! Yield function of principal stresses in decreasing order
+  double yield(const Eigen::Vector3d& principal) const;
+
+ private:
+  //! Upper bound of the yield function without the Lode angle
+  double yield_bound(const Vector6d& stress) const;
+
+  //! Add the elastic stress increment
+  void elastic_trial(Vector6d& stress, const Vector6d& strain) const;
+
+  //! Return a stress outside the surface to the surface
+  double return_mapping(Vector6d& stress) const;
+
+  //! Youngs modulus
+  double youngs_modulus_{std::numeric_limits<double>::max()};
+  //! Poisson ratio
+  double poisson_ratio_{std::numeric_limits<double>::max()};
+  //! Bulk modulus
+  double bulk_modulus_{0.};
+  //! Shear modulus
+  double shear_modulus_{0.};
+  //! Sine of the friction angle
+  double sin_friction_{0.};
+  //! Sine of the dilation angle
+  double sin_dilation_{0.};
+  //! Cohesion
+  double cohesion_{std::numeric_limits<double>::max()};
+  //! Twice the cohesion times the cosine of the friction angle
+  double cohesion_term_{std::numeric_limits<double>::max()};
+};  // MohrCoulomb class
+}  // mpm namespace
+
+#include "mohr_coulomb.tcc"
+
+static Register<mpm::Material, mpm::MohrCoulomb, unsigned> mohr_coulomb(
+    "MohrCoulomb");
+
+#endif  // MPM_MOHR_COULOMB_H_
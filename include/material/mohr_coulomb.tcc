@@ -0,0 +1,239 @@
+//! Read material properties
+//! \details Friction and dilation angles are in degrees
+//! \param[in] material_properties Material properties
+inline void mpm::MohrCoulomb::properties(const Json& material_properties) {
+  try {
+    youngs_modulus_ =
+        material_properties["youngs_modulus"].template get<double>();
+    poisson_ratio_ =
+        material_properties["poisson_ratio"].template get<double>();
+    const double friction =
+        material_properties["friction"].template get<double>() * M_PI / 180.;
+    const double dilation =
+        material_properties["dilation"].template get<double>() * M_PI / 180.;
+    cohesion_ = material_properties["cohesion"].template get<double>();
+
+    bulk_modulus_ = youngs_modulus_ / (3.0 * (1. - 2. * poisson_ratio_));
+    shear_modulus_ = youngs_modulus_ / (2.0 * (1. + poisson_ratio_));
+    sin_friction_ = std::sin(friction);
+    sin_dilation_ = std::sin(dilation);
+    cohesion_term_ = 2. * cohesion_ * std::cos(friction);
+  } catch (std::exception& except) {
+    std::cerr << "Material parameter not set: " << except.what() << '\n';
+  }
+}
+
+//! Return elastic tensor
+//! \retval de Elastic tensor
+inline mpm::Material::Matrix6x6 mpm::MohrCoulomb::elastic_tensor() {
+  const double G = shear_modulus_;
+  const double a1 = bulk_modulus_ + (4.0 / 3.0) * G;
+  const double a2 = bulk_modulus_ - (2.0 / 3.0) * G;
+
+  Matrix6x6 de = Matrix6x6::Zero();
+  de.topLeftCorner(3, 3).setConstant(a2);
+  de.diagonal() << a1, a1, a1, G, G, G;
+  return de;
+}
+
+//! Principal stresses in decreasing order
+//! \details Computed from the invariants and the Lode angle, without
+//! principal directions
+//! \param[in] stress Stress
+//! \retval principal Principal stresses
+inline Eigen::Vector3d mpm::MohrCoulomb::principal_stresses(
+    const Vector6d& stress) {
+  const double mean = (stress(0) + stress(1) + stress(2)) / 3.;
+  const double sxx = stress(0) - mean, syy = stress(1) - mean,
+               szz = stress(2) - mean;
+  const double sxy = stress(3), syz = stress(4), sxz = stress(5);
+  const double J2 = 0.5 * (sxx * sxx + syy * syy + szz * szz) + sxy * sxy +
+                    syz * syz + sxz * sxz;
+  const double J3 = sxx * syy * szz + 2. * sxy * syz * sxz - sxx * syz * syz -
+                    syy * sxz * sxz - szz * sxy * sxy;
+
+  // Lode angle between 0 and pi / 3
+  double cos3theta = 1.;
+  if (J2 > 0.) cos3theta = 1.5 * std::sqrt(3.) * J3 / (J2 * std::sqrt(J2));
+  cos3theta = std::min(std::max(cos3theta, -1.), 1.);
+  const double theta = std::acos(cos3theta) / 3.;
+  const double radius = 2. * std::sqrt(J2 / 3.);
+  return Eigen::Vector3d(mean + radius * std::cos(theta),
+                         mean + radius * std::cos(theta - 2. * M_PI / 3.),
+                         mean + radius * std::cos(theta + 2. * M_PI / 3.));
+}
+
+//! Yield function of principal stresses in decreasing order
+//! \param[in] principal Principal stresses
+//! \retval yield Positive outside the surface
+inline double mpm::MohrCoulomb::yield(const Eigen::Vector3d& principal) const {
+  return principal(0) - principal(2) +
+         (principal(0) + principal(2)) * sin_friction_ - cohesion_term_;
+}
+
+//! Upper bound of the yield function without the Lode angle
+//! \details The difference of the largest and smallest principal stresses
+//! is at most twice the square root of J2, and the intermediate deviatoric
+//! principal stress is at most the square root of J2 / 3 in magnitude
+//! \param[in] stress Stress
+//! \retval bound Not less than the yield function
+inline double mpm::MohrCoulomb::yield_bound(const Vector6d& stress) const {
+  const double mean = (stress(0) + stress(1) + stress(2)) / 3.;
+  const double J2 = 0.5 * ((stress(0) - mean) * (stress(0) - mean) +
+                           (stress(1) - mean) * (stress(1) - mean) +
+                           (stress(2) - mean) * (stress(2) - mean)) +
+                    stress(3) * stress(3) + stress(4) * stress(4) +
+                    stress(5) * stress(5);
+  const double sqrt_J2 = std::sqrt(J2);
+  return 2. * sqrt_J2 +
+         (2. * mean + sqrt_J2 / std::sqrt(3.)) * sin_friction_ -
+         cohesion_term_;
+}
+
+//! Add the elastic stress increment
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+inline void mpm::MohrCoulomb::elastic_trial(Vector6d& stress,
+                                            const Vector6d& strain) const {
+  const double G = shear_modulus_;
+  const double volumetric = (bulk_modulus_ - (2.0 / 3.0) * G) *
+                            (strain(0) + strain(1) + strain(2));
+  stress(0) += volumetric + 2. * G * strain(0);
+  stress(1) += volumetric + 2. * G * strain(1);
+  stress(2) += volumetric + 2. * G * strain(2);
+  stress(3) += G * strain(3);
+  stress(4) += G * strain(4);
+  stress(5) += G * strain(5);
+}
+
+//! Return a stress outside the surface to the surface
+//! \details Principal stresses return to the main plane, and if their
+//! order changes, to the right or left edge, and then to the apex. The
+//! return is exact, as the model is perfectly plastic.
+//! \param[in,out] stress Trial stress, returned stress
+//! \retval multiplier Plastic multiplier
+inline double mpm::MohrCoulomb::return_mapping(Vector6d& stress) const {
+  Eigen::Matrix3d tensor;
+  // clang-format off
+  tensor << stress(0), stress(3), stress(5),
+            stress(3), stress(1), stress(4),
+            stress(5), stress(4), stress(2);
+  // clang-format on
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+  solver.computeDirect(tensor);
+  // Eigenvalues are in increasing order
+  const Eigen::Vector3d trial = solver.eigenvalues().reverse();
+
+  const double G = shear_modulus_;
+  const double K = bulk_modulus_;
+  const double sf = sin_friction_;
+  const double sd = sin_dilation_;
+  // Changes of principal stresses per unit multiplier of the main plane
+  const double c1 = 2. * G * (1. + sd / 3.) + 2. * K * sd;
+  const double c2 = (4. * G / 3. - 2. * K) * sd;
+  const double c3 = 2. * G * (1. - sd / 3.) - 2. * K * sd;
+  const double a = 4. * G * (1. + sf * sd / 3.) + 4. * K * sf * sd;
+  const auto ordered = [](const Eigen::Vector3d& principal) {
+    return principal(0) >= principal(1) && principal(1) >= principal(2);
+  };
+
+  // Main plane
+  const double yield_a = this->yield(trial);
+  double multiplier = yield_a / a;
+  Eigen::Vector3d principal(trial(0) - c1 * multiplier,
+                            trial(1) + c2 * multiplier,
+                            trial(2) + c3 * multiplier);
+  if (!ordered(principal)) {
+    // Edge between the main plane and the plane of sigma 1 and sigma 2
+    // (right) or of sigma 2 and sigma 3 (left)
+    const bool right =
+        (1. - sd) * trial(0) - 2. * trial(1) + (1. + sd) * trial(2) > 0.;
+    double yield_b, b;
+    if (right) {
+      yield_b = trial(0) - trial(1) + (trial(0) + trial(1)) * sf -
+                cohesion_term_;
+      b = 2. * G * (1. + sf + sd - sf * sd / 3.) + 4. * K * sf * sd;
+    } else {
+      yield_b = trial(1) - trial(2) + (trial(1) + trial(2)) * sf -
+                cohesion_term_;
+      b = 2. * G * (1. - sf - sd - sf * sd / 3.) + 4. * K * sf * sd;
+    }
+    const double determinant = a * a - b * b;
+    const double multiplier_a = (a * yield_a - b * yield_b) / determinant;
+    const double multiplier_b = (a * yield_b - b * yield_a) / determinant;
+    multiplier = multiplier_a + multiplier_b;
+    if (right)
+      principal << trial(0) - c1 * multiplier,
+          trial(1) + c2 * multiplier_a + c3 * multiplier_b,
+          trial(2) + c3 * multiplier_a + c2 * multiplier_b;
+    else
+      principal << trial(0) - c1 * multiplier_a + c2 * multiplier_b,
+          trial(1) + c2 * multiplier_a - c1 * multiplier_b,
+          trial(2) + c3 * multiplier;
+
+    // Apex, which does not exist without friction
+    if (!ordered(principal) && sf > 0.)
+      principal.setConstant(0.5 * cohesion_term_ / sf);
+  }
+
+  // Principal directions of the trial stress
+  const Eigen::Matrix3d& directions = solver.eigenvectors();
+  tensor = directions * principal.reverse().asDiagonal() *
+           directions.transpose();
+  stress << tensor(0, 0), tensor(1, 1), tensor(2, 2), tensor(0, 1),
+      tensor(1, 2), tensor(0, 2);
+  return multiplier;
+}
+
+//! Compute stress
+//! \param[in,out] stress Stress
+//! \param[in] strain Strain increment
+inline void mpm::MohrCoulomb::compute_stress(Vector6d& stress,
+                                             const Vector6d& strain) {
+  this->elastic_trial(stress, strain);
+  if (this->yield_bound(stress) > 0. &&
+      this->yield(principal_stresses(stress)) > 0.)
+    this->return_mapping(stress);
+}
+
+//! Compute stresses of a batch of particles
+//! \details Indices of particles are written to the list of candidates
+//! unconditionally and kept if the bound of the yield function is
+//! positive, so the elastic pass has no branch. Candidates are compacted
+//! again by the yield function of their principal stresses.
+//! \param[in,out] stresses Stresses of particles, updated
+//! \param[in] strains Strain increments of particles
+//! \param[in] states Slots of particles, or nullptr without state
+//! \param[in] nparticles Number of particles in the batch
+inline void mpm::MohrCoulomb::compute_stress(Vector6d* stresses,
+                                             const Vector6d* strains,
+                                             const std::size_t* states,
+                                             std::size_t nparticles) {
+  thread_local std::vector<std::size_t> yielding;
+  yielding.resize(nparticles + 1);
+
+  // Elastic trial stresses and particles near the surface
+  std::size_t ncandidates = 0;
+  for (std::size_t i = 0; i < nparticles; ++i) {
+    this->elastic_trial(stresses[i], strains[i]);
+    yielding[ncandidates] = i;
+    ncandidates += (this->yield_bound(stresses[i]) > 0.);
+  }
+
+  // Yielding particles
+  std::size_t nyielding = 0;
+  for (std::size_t j = 0; j < ncandidates; ++j) {
+    const std::size_t i = yielding[j];
+    yielding[nyielding] = i;
+    nyielding += (this->yield(principal_stresses(stresses[i])) > 0.);
+  }
+
+  // Plastic correction of yielding particles
+  double* multipliers =
+      (states != nullptr) ? this->state().column(0) : nullptr;
+  for (std::size_t j = 0; j < nyielding; ++j) {
+    const std::size_t i = yielding[j];
+    const double multiplier = this->return_mapping(stresses[i]);
+    if (multipliers != nullptr) multipliers[states[i]] += multiplier;
+  }
+}
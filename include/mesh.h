@@ -1,96 +1,285 @@
 #ifndef MPM_MESH_H_
 #define MPM_MESH_H_
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Eigen/Dense"
 
+// TBB
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_for_each.h>
+#include <tbb/parallel_sort.h>
+
 #include "cell.h"
 #include "container.h"
 #include "node.h"
 #include "particle.h"
+#include "pool.h"
 
 namespace mpm {
 
+//! Scatter strategy for particle to node transfers
+//! \brief Atomic: nodes are locked on every update, Colouring: cells of a
+//! colour share no node and are processed in parallel without locks,
+//! Reduction: contributions are buffered per cell and summed per node in a
+//! fixed order, reproducible for any number of threads
+enum class Scatter { Atomic, Colouring, Reduction };
+
 //! Mesh class
 //! \brief Base class that stores the information about meshes
-//! \details Mesh class: id_ and coordinates.
+//! \details Mesh class: id_ and coordinates. The containers of the mesh own
+//! its particles, nodes and cells. Particles grouped by cell and by
+//! material, and active nodes, are raw pointers into these containers,
+//! which are valid until elements are removed from the mesh, so sweeps over
+//! them do not touch reference counts.
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal = double>
 class Mesh {
  public:
   //! Define a vector of size dimension
   using VectorDim = Eigen::Matrix<double, Tdim, 1>;
 
+  //! Particles of a cell or of a batch, owned by the mesh
+  using Particles = std::vector<mpm::Particle<Tdim, Treal>*>;
+
   //! Constructor with id
   Mesh(unsigned id);
 
   //! Destructor
-  ~Mesh(){};
+  virtual ~Mesh(){};
 
   //! Delete copy constructor
-  Mesh(const Mesh<Tdim>&) = delete;
+  Mesh(const Mesh<Tdim, Treal>&) = delete;
 
   //! Delete assignement operator
-  Mesh& operator=(const Mesh<Tdim>&) = delete;
+  Mesh& operator=(const Mesh<Tdim, Treal>&) = delete;
 
   //! Return id of the mesh
   unsigned id() const { return id_; }
 
   //! Add neighbouring mesh
-  bool add_neighbour(unsigned id, const std::shared_ptr<Mesh<Tdim>>& neighbour);
+  bool add_neighbour(unsigned id, Mesh<Tdim, Treal>* neighbour);
 
   //! Number of neighbours
   unsigned nneighbours() const { return neighbour_meshes_.size(); }
 
   //! Add particle
-  bool add_particle(const std::shared_ptr<mpm::Particle<Tdim>>& particle);
+  bool add_particle(
+      const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle);
+
+  //! Add particles in bulk
+  bool add_particles(const std::vector<
+                     std::shared_ptr<mpm::Particle<Tdim, Treal>>>& particles);
 
   //! Add particle
-  bool remove_particle(const std::shared_ptr<mpm::Particle<Tdim>>& particle);
+  bool remove_particle(
+      const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle);
 
   //! Number of particles
   mpm::Index nparticles() const { return particles_.size(); }
 
+  //! Number of active particles, i.e., located particles grouped by cell
+  mpm::Index nactive_particles() const;
+
   //! Add node
-  bool add_node(const std::shared_ptr<mpm::Node<Tdim>>& node);
+  virtual bool add_node(const std::shared_ptr<mpm::Node<Tdim>>& node);
+
+  //! Add nodes in bulk
+  virtual bool add_nodes(
+      const std::vector<std::shared_ptr<mpm::Node<Tdim>>>& nodes);
 
   //! Add node
-  bool remove_node(const std::shared_ptr<mpm::Node<Tdim>>& node);
+  virtual bool remove_node(const std::shared_ptr<mpm::Node<Tdim>>& node);
 
   //! Number of nodes
   mpm::Index nnodes() const { return nodes_.size(); }
 
+  //! Number of active nodes, i.e., nodes of cells containing particles
+  mpm::Index nactive_nodes() const { return active_nodes_.size(); }
+
   //! Add cell
-  bool add_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell);
+  virtual bool add_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell);
+
+  //! Add cells in bulk
+  virtual bool add_cells(
+      const std::vector<std::shared_ptr<mpm::Cell<Tdim>>>& cells);
 
   //! Add cell
-  bool remove_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell);
+  virtual bool remove_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell);
+
+  //! Create a particle in the particle pool of the mesh, to be added with
+  //! add_particle
+  template <typename... Targs>
+  std::shared_ptr<mpm::Particle<Tdim, Treal>> make_particle(Targs&&... args) {
+    return particle_pool_.create(std::forward<Targs>(args)...);
+  }
+
+  //! Create a node in the node pool of the mesh, to be added with add_node
+  template <typename... Targs>
+  std::shared_ptr<mpm::Node<Tdim>> make_node(Targs&&... args) {
+    return node_pool_.create(std::forward<Targs>(args)...);
+  }
+
+  //! Create a cell in the cell pool of the mesh, to be added with add_cell
+  template <typename... Targs>
+  std::shared_ptr<mpm::Cell<Tdim>> make_cell(Targs&&... args) {
+    return cell_pool_.create(std::forward<Targs>(args)...);
+  }
 
   //! Number of cells
   mpm::Index ncells() const { return cells_.size(); }
 
+  //! Number of active cells, i.e., cells containing particles
+  mpm::Index nactive_cells() const { return cell_particles_.size(); }
+
   //! Active mesh (if a particle is present)
   bool status() const { return particles_.size(); }
 
+  //! Iterate over particles in parallel
+  template <typename Toper>
+  void iterate_over_particles(Toper oper);
+
+  //! Iterate over nodes in parallel
+  template <typename Toper>
+  void iterate_over_nodes(Toper oper);
+
+  //! Iterate over active nodes in parallel
+  template <typename Toper>
+  void iterate_over_active_nodes(Toper oper);
+
+  //! Iterate over cells in parallel
+  template <typename Toper>
+  void iterate_over_cells(Toper oper);
+
+  //! Iterate over cells containing particles in parallel
+  template <typename Toper>
+  void iterate_over_cell_particles(Toper oper);
+
+  //! Iterate over batches of particles of the same material in parallel
+  template <typename Toper>
+  void iterate_over_material_particles(Toper oper);
+
+  //! Locate particles in cells
+  virtual bool locate_particles_mesh();
+
+  //! Group located particles by cell
+  void group_particles_by_cell();
+
+  //! Group located particles by material
+  void group_particles_by_material();
+
+  //! Number of batches of located particles of the same material
+  mpm::Index nmaterial_batches() const { return material_particles_.size(); }
+
+  //! Colour cells such that cells of the same colour share no node
+  virtual unsigned colour_cells();
+
+  //! Number of colours, zero if cells are not coloured
+  unsigned ncolours() const { return ncolours_; }
+
+  //! Iterate over cells containing particles, one colour at a time
+  template <typename Toper>
+  void for_each_cell_coloured(Toper oper);
+
+  //! Scatter particle contributions of each cell to its nodes
+  template <typename Toper>
+  void scatter_to_nodes(Toper oper, mpm::Scatter scatter);
+
  protected:
   //! mesh id
   unsigned id_{std::numeric_limits<unsigned>::max()};
 
   //! Container of mesh neighbours
-  Handler<Mesh<Tdim>> neighbour_meshes_;
+  Handler<Mesh<Tdim, Treal>> neighbour_meshes_;
+
+  //! Pool of particles, which outlives the mesh while particles exist
+  Pool<Particle<Tdim, Treal>> particle_pool_;
+
+  //! Pool of nodes
+  Pool<Node<Tdim>> node_pool_;
+
+  //! Pool of cells
+  Pool<Cell<Tdim>> cell_pool_;
 
   //! Container of particles
-  Container<Particle<Tdim>> particles_;
+  Container<Particle<Tdim, Treal>> particles_;
 
   //! Container of nodes
   Container<Node<Tdim>> nodes_;
 
   //! Container of cells
   Container<Cell<Tdim>> cells_;
+
+  //! Located particles grouped by cell (cell, particles in cell)
+  std::vector<std::pair<Cell<Tdim>*, Particles>> cell_particles_;
+
+  //! Located particles grouped by material, in the order of cells and in
+  //! batches of at most material_batch_size_ particles (material, particles)
+  std::vector<std::pair<Material*, Particles>> material_particles_;
+
+  //! Maximum number of particles in a batch of the same material
+  std::size_t material_batch_size_{1024};
+
+  //! Active cells of the last relocation sorted by id
+  std::vector<Cell<Tdim>*> active_cells_;
+
+  //! Active nodes sorted by id
+  std::vector<Node<Tdim>*> active_nodes_;
+
+  //! Number of active cells using each active node
+  std::unordered_map<Node<Tdim>*, unsigned> active_node_counts_;
+
+  //! Number of colours of cells
+  unsigned ncolours_{0};
+
+  //! Indices of cell_particles_ grouped by colour of the cell
+  std::vector<std::vector<std::size_t>> coloured_cell_particles_;
+
+  //! Nodes of cells containing particles with the (index in
+  //! cell_particles_, local node id) of each cell sharing the node
+  std::vector<
+      std::pair<Node<Tdim>*, std::vector<std::pair<std::size_t, unsigned>>>>
+      node_cell_particles_;
+
+  //! Status of node_cell_particles_ for the current cell_particles_
+  bool node_cell_particles_valid_{false};
+
+  //! Group cells containing particles by colour
+  void group_cell_particles_by_colour();
+
+  //! Return the particles of the mesh, for parallel loops by index
+  Particles particle_pointers() const;
+
+ private:
+  //! Check that ids of new elements are unique in a container
+  template <typename T>
+  bool unique_ids(const Container<T>& container,
+                  const std::vector<std::shared_ptr<T>>& elements) const;
+
+  //! Group cells containing particles by node
+  void group_cell_particles_by_node();
+
+  //! Update active nodes if the active cells changed
+  void update_active_nodes();
+
+  //! Update active nodes with the cells entering and leaving the active cells
+  void update_active_nodes(const std::vector<Cell<Tdim>*>& entering,
+                           const std::vector<Cell<Tdim>*>& leaving);
+
+  //! Reduce particle contributions of each cell to its nodes
+  template <typename Toper>
+  void reduce_to_nodes(Toper oper);
 };  // Mesh class
 }  // mpm namespace
 
@@ -1,8 +1,9 @@
 // Constructor with id
 //! \param[in] id Global mesh id
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-mpm::Mesh<Tdim>::Mesh(unsigned id) : id_{id} {
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Mesh<Tdim, Treal>::Mesh(unsigned id) : id_{id} {
   // Check if the dimension is between 1 & 3
   static_assert((Tdim >= 1 && Tdim <= 3), "Invalid global dimension");
   particles_.clear();
@@ -10,12 +11,13 @@ mpm::Mesh<Tdim>::Mesh(unsigned id) : id_{id} {
 
 //! Add a neighbour mesh
 //! \param[in] local_id local id of the mesh
-//! \param[in] ptr A shared pointer to mesh
+//! \param[in] mesh A pointer to mesh, which outlives this mesh
 //! \retval insertion_status Return the successful addition of a node
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::add_neighbour(
-    unsigned local_id, const std::shared_ptr<mpm::Mesh<Tdim>>& mesh) {
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_neighbour(unsigned local_id,
+                                           mpm::Mesh<Tdim, Treal>* mesh) {
   bool insertion_status = false;
   try {
     // If number of mesh ptrs id is not the current mesh id
@@ -34,22 +36,51 @@ bool mpm::Mesh<Tdim>::add_neighbour(
 //! \param[in] particle A shared pointer to particle
 //! \retval insertion_status Return the successful addition of a particle
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::add_particle(
-    const std::shared_ptr<mpm::Particle<Tdim>>& particle) {
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_particle(
+    const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle) {
   bool insertion_status = particles_.add(particle);
   return insertion_status;
 }
 
+//! Add particles in bulk
+//! \details Ids are checked for duplicates by sorting once instead of a
+//! linear search per particle
+//! \param[in] particles Shared pointers to particles
+//! \retval insertion_status Return false if an id is duplicated
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_particles(
+    const std::vector<std::shared_ptr<mpm::Particle<Tdim, Treal>>>& particles) {
+  bool insertion_status = false;
+  try {
+    if (!this->unique_ids(particles_, particles))
+      throw std::runtime_error(
+          "Duplicate particle ids, particles are not added");
+    for (const auto& particle : particles) particles_.add(particle, false);
+    insertion_status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return insertion_status;
+}
+
 //! Remove a particle
+//! \details The particle is detached from its cell
 //! \param[in] particle A shared pointer to particle
 //! \retval insertion_status Return the successful addition of a particle
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::remove_particle(
-    const std::shared_ptr<mpm::Particle<Tdim>>& particle) {
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::remove_particle(
+    const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle) {
   // Remove a particle if found in the container
   bool status = particles_.remove(particle);
+  if (status) particle->assign_cell(nullptr);
+  // Grouped particles do not own the particle
+  if (status && !cell_particles_.empty()) this->group_particles_by_cell();
   return status;
 }
 
@@ -57,18 +88,45 @@ bool mpm::Mesh<Tdim>::remove_particle(
 //! \param[in] node A shared pointer to node
 //! \retval insertion_status Return the successful addition of a node
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::add_node(const std::shared_ptr<mpm::Node<Tdim>>& node) {
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_node(
+    const std::shared_ptr<mpm::Node<Tdim>>& node) {
   bool insertion_status = nodes_.add(node);
   return insertion_status;
 }
 
+//! Add nodes in bulk
+//! \details Ids are checked for duplicates by sorting once instead of a
+//! linear search per node
+//! \param[in] nodes Shared pointers to nodes
+//! \retval insertion_status Return false if an id is duplicated
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_nodes(
+    const std::vector<std::shared_ptr<mpm::Node<Tdim>>>& nodes) {
+  bool insertion_status = false;
+  try {
+    if (!this->unique_ids(nodes_, nodes))
+      throw std::runtime_error("Duplicate node ids, nodes are not added");
+    for (const auto& node : nodes) nodes_.add(node, false);
+    insertion_status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return insertion_status;
+}
+
 //! Remove a node
+//! \details Cells refer to their nodes without owning them, so cells using
+//! the node should be removed first
 //! \param[in] node A shared pointer to node
 //! \retval insertion_status Return the successful addition of a node
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::remove_node(
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::remove_node(
     const std::shared_ptr<mpm::Node<Tdim>>& node) {
   // Remove a node if found in the container
   bool status = nodes_.remove(node);
@@ -79,20 +137,621 @@ bool mpm::Mesh<Tdim>::remove_node(
 //! \param[in] cell A shared pointer to cell
 //! \retval insertion_status Return the successful addition of a cell
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::add_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_cell(
+    const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
   bool insertion_status = cells_.add(cell);
+  // Colouring is invalidated
+  ncolours_ = 0;
   return insertion_status;
 }
 
+//! Add cells in bulk
+//! \details Ids are checked for duplicates by sorting once instead of a
+//! linear search per cell
+//! \param[in] cells Shared pointers to cells
+//! \retval insertion_status Return false if an id is duplicated
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::add_cells(
+    const std::vector<std::shared_ptr<mpm::Cell<Tdim>>>& cells) {
+  bool insertion_status = false;
+  try {
+    if (!this->unique_ids(cells_, cells))
+      throw std::runtime_error("Duplicate cell ids, cells are not added");
+    for (const auto& cell : cells) cells_.add(cell, false);
+    // Colouring is invalidated
+    ncolours_ = 0;
+    insertion_status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return insertion_status;
+}
+
+//! Check that ids of new elements are unique in a container
+//! \param[in] container Container of existing elements
+//! \param[in] elements New elements
+//! \retval status Return false if an id appears twice
+//! \tparam T Particle, node or cell
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename T>
+bool mpm::Mesh<Tdim, Treal>::unique_ids(
+    const Container<T>& container,
+    const std::vector<std::shared_ptr<T>>& elements) const {
+  std::vector<Index> ids;
+  ids.reserve(container.size() + elements.size());
+  for (auto itr = container.cbegin(); itr != container.cend(); ++itr)
+    ids.emplace_back((*itr)->id());
+  for (const auto& element : elements) ids.emplace_back(element->id());
+  tbb::parallel_sort(ids.begin(), ids.end());
+  return std::adjacent_find(ids.begin(), ids.end()) == ids.end();
+}
+
 //! Remove a cell
+//! \details Particles refer to their cell without owning it, so a cell
+//! containing particles is not removed
 //! \param[in] cell A shared pointer to cell
 //! \retval insertion_status Return the successful addition of a cell
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Mesh<Tdim>::remove_cell(
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::remove_cell(
     const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
-  // Remove a cell if found in the container
-  bool status = cells_.remove(cell);
+  bool status = false;
+  try {
+    if (cell->status())
+      throw std::runtime_error("Cell contains particles, it is not removed");
+    // Remove a cell if found in the container
+    status = cells_.remove(cell);
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  // Nodes of a removed active cell are no longer counted
+  const auto itr =
+      std::find(active_cells_.begin(), active_cells_.end(), cell.get());
+  if (status && itr != active_cells_.end()) {
+    active_cells_.erase(itr);
+    this->update_active_nodes({}, {cell.get()});
+  }
+  // Colouring is invalidated
+  ncolours_ = 0;
   return status;
 }
+
+//! Iterate over particles
+//! \tparam Toper Callable object typically a baseclass functor
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::iterate_over_particles(Toper oper) {
+  tbb::parallel_for_each(particles_.cbegin(), particles_.cend(), oper);
+}
+
+//! Return the particles of the mesh, for parallel loops by index
+//! \retval particles Particles in the order of the container
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::Mesh<Tdim, Treal>::Particles
+    mpm::Mesh<Tdim, Treal>::particle_pointers() const {
+  Particles particles;
+  particles.reserve(particles_.size());
+  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr)
+    particles.emplace_back(pitr->get());
+  return particles;
+}
+
+//! Iterate over nodes
+//! \tparam Toper Callable object typically a baseclass functor
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::iterate_over_nodes(Toper oper) {
+  tbb::parallel_for_each(nodes_.cbegin(), nodes_.cend(), oper);
+}
+
+//! Iterate over active nodes
+//! \details Active nodes belong to cells containing particles, as grouped
+//! by the last call to group_particles_by_cell. The operation is called
+//! with a pointer to each node.
+//! \tparam Toper Callable object typically a baseclass functor
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::iterate_over_active_nodes(Toper oper) {
+  tbb::parallel_for_each(active_nodes_.cbegin(), active_nodes_.cend(), oper);
+}
+
+//! Iterate over cells
+//! \tparam Toper Callable object typically a baseclass functor
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::iterate_over_cells(Toper oper) {
+  tbb::parallel_for_each(cells_.cbegin(), cells_.cend(), oper);
+}
+
+//! Iterate over cells containing particles
+//! \details The operation is called with a pointer to a cell and the
+//! pointers to the particles located in it, as grouped by the last call to
+//! group_particles_by_cell
+//! \tparam Toper Callable object taking a cell and a vector of particles
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::iterate_over_cell_particles(Toper oper) {
+  tbb::parallel_for_each(
+      cell_particles_.begin(), cell_particles_.end(),
+      [&oper](const std::pair<mpm::Cell<Tdim>*, Particles>& cell_particles) {
+        oper(cell_particles.first, cell_particles.second);
+      });
+}
+
+//! Iterate over batches of particles of the same material
+//! \details The operation is called with a pointer to a material and the
+//! pointers to a batch of its particles, as grouped by the last call to
+//! group_particles_by_material
+//! \tparam Toper Callable object taking a material and a vector of particles
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::iterate_over_material_particles(Toper oper) {
+  tbb::parallel_for_each(
+      material_particles_.begin(), material_particles_.end(),
+      [&oper](const std::pair<mpm::Material*, Particles>& material_particles) {
+        oper(material_particles.first, material_particles.second);
+      });
+}
+
+//! Iterate over cells containing particles, one colour at a time
+//! \details Colours are processed in sequence and the cells of a colour in
+//! parallel. As cells of a colour share no node, the operation may update
+//! nodes without locking. Cells are coloured on first use.
+//! \tparam Toper Callable object taking a cell and a vector of particles
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::for_each_cell_coloured(Toper oper) {
+  if (ncolours_ == 0) this->colour_cells();
+
+  for (const auto& colour : coloured_cell_particles_)
+    tbb::parallel_for_each(colour.begin(), colour.end(),
+                           [this, &oper](std::size_t index) {
+                             const auto& cell_particles =
+                                 cell_particles_[index];
+                             oper(cell_particles.first, cell_particles.second);
+                           });
+}
+
+//! Scatter particle contributions of each cell to its nodes
+//! \details Contributions are computed per cell and added to the nodes
+//! with locks (atomic), without locks one colour at a time (colouring) or
+//! through per-cell buffers summed in a fixed order (reduction)
+//! \param[in] oper Callable object taking a cell and a vector of particles
+//! and returning the nodal contributions of the cell
+//! \param[in] scatter Scatter strategy
+//! \tparam Toper Callable object returning Cell::NodalContributions
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::scatter_to_nodes(Toper oper,
+                                              mpm::Scatter scatter) {
+  // Cell and particles in the cell
+  using CellPtr = mpm::Cell<Tdim>*;
+
+  switch (scatter) {
+    case mpm::Scatter::Colouring:
+      this->for_each_cell_coloured(
+          [&oper](const CellPtr& cell, const Particles& particles) {
+            cell->scatter_nodal_contributions(oper(cell, particles), false);
+          });
+      break;
+    case mpm::Scatter::Reduction:
+      this->reduce_to_nodes(oper);
+      break;
+    case mpm::Scatter::Atomic:
+    default:
+      this->iterate_over_cell_particles(
+          [&oper](const CellPtr& cell, const Particles& particles) {
+            cell->scatter_nodal_contributions(oper(cell, particles), true);
+          });
+      break;
+  }
+}
+
+//! Reduce particle contributions of each cell to its nodes
+//! \details Each cell writes its contributions to a private buffer. The
+//! buffers of the cells sharing a node are then summed in the order of
+//! cell ids and added to the node, so results do not depend on the number
+//! of threads or on scheduling.
+//! \param[in] oper Callable object taking a cell and a vector of particles
+//! and returning the nodal contributions of the cell
+//! \tparam Toper Callable object returning Cell::NodalContributions
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+template <typename Toper>
+void mpm::Mesh<Tdim, Treal>::reduce_to_nodes(Toper oper) {
+  using NodalContributions = typename mpm::Cell<Tdim>::NodalContributions;
+
+  if (!node_cell_particles_valid_) this->group_cell_particles_by_node();
+
+  // Contributions of each cell containing particles
+  std::vector<NodalContributions, Eigen::aligned_allocator<NodalContributions>>
+      contributions(cell_particles_.size());
+  tbb::parallel_for(std::size_t(0), cell_particles_.size(),
+                    [this, &oper, &contributions](std::size_t i) {
+                      contributions[i] = oper(cell_particles_[i].first,
+                                              cell_particles_[i].second);
+                    });
+
+  // Sum contributions to each node in a fixed order
+  tbb::parallel_for(
+      std::size_t(0), node_cell_particles_.size(),
+      [this, &contributions](std::size_t i) {
+        const auto& node_cells = node_cell_particles_[i];
+        double mass = 0.;
+        VectorDim momentum = VectorDim::Zero();
+        VectorDim force = VectorDim::Zero();
+        for (const auto& cell_node : node_cells.second) {
+          const auto& contribution = contributions[cell_node.first];
+          mass += contribution.mass(cell_node.second);
+          momentum += contribution.momentum.col(cell_node.second);
+          force += contribution.force.col(cell_node.second);
+        }
+        node_cells.first->update_mass_momentum_force(mass, momentum, force,
+                                                     false);
+      });
+}
+
+//! Locate particles in cells
+//! \details A particle is searched in its current cell, then in the
+//! neighbours of that cell and finally in all cells of the mesh. Particles
+//! which are not found in any cell are deactivated.
+//! \retval status Return true if all active particles are located
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::Mesh<Tdim, Treal>::locate_particles_mesh() {
+  std::atomic<bool> status{true};
+
+  this->iterate_over_particles(
+      [this,
+       &status](const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle) {
+        if (!particle->status()) return;
+
+        // Cells compute in double
+        const VectorDim coordinates =
+            particle->coordinates().template cast<double>();
+        const auto cell = particle->cell();
+
+        // Check if the particle is still in its cell
+        if (cell != nullptr) {
+          if (cell->point_in_cell(coordinates)) return;
+
+          // Check the neighbours of the current cell
+          for (const auto& neighbour : cell->neighbours()) {
+            if (neighbour.second->point_in_cell(coordinates)) {
+              particle->assign_cell(neighbour.second);
+              return;
+            }
+          }
+        }
+
+        // Search all cells in the mesh
+        for (auto citr = cells_.cbegin(); citr != cells_.cend(); ++citr) {
+          if ((*citr)->point_in_cell(coordinates)) {
+            particle->assign_cell(citr->get());
+            return;
+          }
+        }
+
+        // Particle is outside the mesh
+        particle->assign_cell(nullptr);
+        particle->assign_status(false);
+        status = false;
+      });
+
+  this->group_particles_by_cell();
+  return status;
+}
+
+//! Number of active particles, i.e., located particles grouped by cell
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Index mpm::Mesh<Tdim, Treal>::nactive_particles() const {
+  mpm::Index nactive = 0;
+  for (const auto& cell_particles : cell_particles_)
+    nactive += cell_particles.second.size();
+  return nactive;
+}
+
+//! Group located particles by cell
+//! \details Particles are sorted by cell id and particle id, so the order
+//! of particles within a cell does not depend on the order of insertion or
+//! on the number of threads
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::Mesh<Tdim, Treal>::group_particles_by_cell() {
+  //! Particle with the id of its cell
+  struct LocatedParticle {
+    Index cell_id;
+    Index particle_id;
+    mpm::Particle<Tdim, Treal>* particle;
+  };
+
+  std::vector<LocatedParticle> located;
+  located.reserve(particles_.size());
+  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr) {
+    const auto cell = (*pitr)->cell();
+    if ((*pitr)->status() && cell != nullptr)
+      located.emplace_back(
+          LocatedParticle{cell->id(), (*pitr)->id(), pitr->get()});
+  }
+
+  tbb::parallel_sort(located.begin(), located.end(),
+                     [](const LocatedParticle& a, const LocatedParticle& b) {
+                       return (a.cell_id < b.cell_id) ||
+                              (a.cell_id == b.cell_id &&
+                               a.particle_id < b.particle_id);
+                     });
+
+  cell_particles_.clear();
+  for (const auto& located_particle : located) {
+    if (cell_particles_.empty() ||
+        cell_particles_.back().first->id() != located_particle.cell_id)
+      cell_particles_.emplace_back(located_particle.particle->cell(),
+                                   Particles());
+    cell_particles_.back().second.emplace_back(located_particle.particle);
+  }
+  this->group_cell_particles_by_colour();
+  this->update_active_nodes();
+  this->group_particles_by_material();
+}
+
+//! Group located particles by material
+//! \details Particles grouped by cell are appended to the list of their
+//! material in a single pass, so particles of a material keep the order of
+//! cells. The lists are split into batches for parallel stress updates.
+//! Particles are regrouped on relocation, and should be regrouped after
+//! materials are assigned to located particles.
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::Mesh<Tdim, Treal>::group_particles_by_material() {
+  // Particles of each material and index of the material by id
+  std::vector<std::pair<mpm::Material*, Particles>> materials;
+  std::map<unsigned, std::size_t> indices;
+
+  std::size_t index = 0;
+  unsigned id = std::numeric_limits<unsigned>::max();
+  for (const auto& cell_particles : cell_particles_) {
+    for (const auto& particle : cell_particles.second) {
+      // Consecutive particles mostly share the material
+      if (materials.empty() || particle->material_id() != id) {
+        mpm::Material* material = particle->material();
+        if (material == nullptr) continue;
+        id = particle->material_id();
+        auto itr = indices.find(id);
+        if (itr == indices.end()) {
+          itr = indices.emplace(id, materials.size()).first;
+          materials.emplace_back(material, Particles());
+        }
+        index = itr->second;
+      }
+      materials[index].second.emplace_back(particle);
+    }
+  }
+
+  material_particles_.clear();
+  for (const auto& material : materials) {
+    const auto& particles = material.second;
+    for (std::size_t begin = 0; begin < particles.size();
+         begin += material_batch_size_) {
+      const std::size_t end =
+          std::min(begin + material_batch_size_, particles.size());
+      material_particles_.emplace_back(
+          material.first,
+          Particles(particles.begin() + begin, particles.begin() + end));
+    }
+  }
+}
+
+//! Colour cells such that cells of the same colour share no node
+//! \details Cells are coloured greedily in the order of insertion: each
+//! cell takes the lowest colour not used by a cell sharing one of its
+//! nodes. Cartesian grids numbered lexicographically get 2^Tdim colours.
+//! \retval ncolours Number of colours
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+unsigned mpm::Mesh<Tdim, Treal>::colour_cells() {
+  // Colours of the cells attached to a node
+  std::map<Index, std::vector<unsigned>> node_colours;
+
+  ncolours_ = 0;
+  for (auto citr = cells_.cbegin(); citr != cells_.cend(); ++citr) {
+    const auto& cell = *citr;
+
+    // Colours of the cells sharing a node with this cell
+    std::set<unsigned> used;
+    for (unsigned i = 0; i < cell->nnodes(); ++i) {
+      const auto& node = cell->node(i);
+      if (node == nullptr) continue;
+      const auto& colours = node_colours[node->id()];
+      used.insert(colours.begin(), colours.end());
+    }
+
+    // Lowest colour not used by a neighbour
+    unsigned colour = 0;
+    while (used.count(colour)) ++colour;
+    cell->assign_colour(colour);
+    if (colour + 1 > ncolours_) ncolours_ = colour + 1;
+
+    for (unsigned i = 0; i < cell->nnodes(); ++i) {
+      const auto& node = cell->node(i);
+      if (node != nullptr) node_colours[node->id()].emplace_back(colour);
+    }
+  }
+
+  this->group_cell_particles_by_colour();
+  return ncolours_;
+}
+
+//! Group cells containing particles by colour
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::Mesh<Tdim, Treal>::group_cell_particles_by_colour() {
+  coloured_cell_particles_.clear();
+  coloured_cell_particles_.resize(ncolours_);
+  if (ncolours_ == 0) return;
+  for (std::size_t i = 0; i < cell_particles_.size(); ++i)
+    coloured_cell_particles_.at(cell_particles_[i].first->colour())
+        .emplace_back(i);
+}
+
+//! Group cells containing particles by node
+//! \details Cells sharing a node are listed in the order of cell ids
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::Mesh<Tdim, Treal>::group_cell_particles_by_node() {
+  //! Local node of a cell containing particles
+  struct CellNode {
+    Index node_id;
+    std::size_t cell_index;
+    unsigned local_id;
+  };
+
+  std::vector<CellNode> cell_nodes;
+  for (std::size_t i = 0; i < cell_particles_.size(); ++i) {
+    const auto& cell = cell_particles_[i].first;
+    for (unsigned j = 0; j < cell->nnodes(); ++j)
+      cell_nodes.emplace_back(CellNode{cell->node(j)->id(), i, j});
+  }
+
+  tbb::parallel_sort(cell_nodes.begin(), cell_nodes.end(),
+                     [](const CellNode& a, const CellNode& b) {
+                       return (a.node_id < b.node_id) ||
+                              (a.node_id == b.node_id &&
+                               a.cell_index < b.cell_index);
+                     });
+
+  node_cell_particles_.clear();
+  for (const auto& cell_node : cell_nodes) {
+    const auto& cell = cell_particles_[cell_node.cell_index].first;
+    if (node_cell_particles_.empty() ||
+        node_cell_particles_.back().first->id() != cell_node.node_id)
+      node_cell_particles_.emplace_back(
+          cell->node(cell_node.local_id),
+          std::vector<std::pair<std::size_t, unsigned>>());
+    node_cell_particles_.back().second.emplace_back(cell_node.cell_index,
+                                                    cell_node.local_id);
+  }
+  node_cell_particles_valid_ = true;
+}
+
+//! Update active nodes if the active cells changed
+//! \details Particles mostly stay in their cells, so the active cells are
+//! compared with those of the last relocation. Both lists are sorted by id,
+//! and their difference gives the cells entering and leaving the active set.
+//! Only the nodes of these cells update their count of active cells. A node
+//! is activated when its count becomes nonzero and deactivated when it drops
+//! to zero. Deactivated nodes are removed from the active nodes, and
+//! activated nodes are sorted and merged in.
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::Mesh<Tdim, Treal>::update_active_nodes() {
+  using CellPtr = mpm::Cell<Tdim>*;
+
+  std::vector<CellPtr> cells;
+  cells.reserve(cell_particles_.size());
+  for (const auto& cell_particles : cell_particles_)
+    cells.emplace_back(cell_particles.first);
+
+  if (cells == active_cells_) return;
+  node_cell_particles_valid_ = false;
+
+  // Cells are sorted by id, a cell re-created with the same id differs
+  const auto by_id = [](const CellPtr a, const CellPtr b) {
+    return (a->id() < b->id()) || (a->id() == b->id() && a < b);
+  };
+  std::vector<CellPtr> entering, leaving;
+  std::set_difference(cells.begin(), cells.end(), active_cells_.begin(),
+                      active_cells_.end(), std::back_inserter(entering),
+                      by_id);
+  std::set_difference(active_cells_.begin(), active_cells_.end(),
+                      cells.begin(), cells.end(), std::back_inserter(leaving),
+                      by_id);
+  active_cells_.swap(cells);
+  this->update_active_nodes(entering, leaving);
+}
+
+//! Update active nodes with the cells entering and leaving the active cells
+//! \details Entering cells are counted first, so a node shared by an
+//! entering and a leaving cell keeps its status. Activated nodes were used
+//! by no active cell, so no leaving cell deactivates them.
+//! \param[in] entering Cells entering the active cells
+//! \param[in] leaving Cells leaving the active cells
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::Mesh<Tdim, Treal>::update_active_nodes(
+    const std::vector<mpm::Cell<Tdim>*>& entering,
+    const std::vector<mpm::Cell<Tdim>*>& leaving) {
+  using NodePtr = mpm::Node<Tdim>*;
+
+  std::vector<NodePtr> activated;
+  for (const auto& cell : entering)
+    for (unsigned i = 0; i < cell->nnodes(); ++i) {
+      const NodePtr node = cell->node(i);
+      if (node != nullptr && active_node_counts_[node]++ == 0)
+        activated.emplace_back(node);
+    }
+
+  bool deactivated = false;
+  for (const auto& cell : leaving)
+    for (unsigned i = 0; i < cell->nnodes(); ++i) {
+      const NodePtr node = cell->node(i);
+      if (node == nullptr) continue;
+      auto itr = active_node_counts_.find(node);
+      if (--itr->second == 0) {
+        active_node_counts_.erase(itr);
+        node->assign_status(false);
+        deactivated = true;
+      }
+    }
+
+  if (deactivated)
+    active_nodes_.erase(
+        std::remove_if(active_nodes_.begin(), active_nodes_.end(),
+                       [](const NodePtr node) { return !node->status(); }),
+        active_nodes_.end());
+
+  if (activated.empty()) return;
+  const auto by_id = [](const NodePtr a, const NodePtr b) {
+    return a->id() < b->id();
+  };
+  for (const auto& node : activated) node->assign_status(true);
+  std::sort(activated.begin(), activated.end(), by_id);
+  const auto middle = active_nodes_.insert(
+      active_nodes_.end(), activated.begin(), activated.end());
+  std::inplace_merge(active_nodes_.begin(), middle, active_nodes_.end(), by_id);
+}
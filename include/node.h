@@ -4,6 +4,8 @@
 #include <array>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "node_base.h"
@@ -45,6 +47,12 @@ class Node : public NodeBase<Tdim> {
   //! Return degrees of freedom
   unsigned dof() const { return dof_; }
 
+  //! Assign status, a node is active if a cell containing particles uses it
+  void assign_status(bool status) { status_ = status; }
+
+  //! Return status
+  bool status() const { return status_; }
+
   //! Assign nodal mass
   void assign_mass(double mass) { mass_ = mass; }
 
@@ -55,25 +63,73 @@ class Node : public NodeBase<Tdim> {
   void assign_force(const Eigen::VectorXd& force);
 
   //! Return force
-  Eigen::VectorXd force() { return force_; }
+  const Eigen::VectorXd& force() const { return force_; }
 
   //! Assign velocity
   void assign_velocity(const Eigen::VectorXd& velocity);
 
   //! Return velocity
-  Eigen::VectorXd velocity() { return velocity_; }
+  const Eigen::VectorXd& velocity() const { return velocity_; }
 
   //! Assign momentum
   void assign_momentum(const Eigen::VectorXd& momentum);
 
   //! Return momentum
-  Eigen::VectorXd momentum() { return momentum_; }
+  const Eigen::VectorXd& momentum() const { return momentum_; }
 
   //! Assign acceleration
   void assign_acceleration(const Eigen::VectorXd& acceleration);
 
   //! Return acceleration
-  Eigen::VectorXd acceleration() { return acceleration_; }
+  const Eigen::VectorXd& acceleration() const { return acceleration_; }
+
+  //! Update mass (thread-safe)
+  void update_mass(bool update, double mass);
+
+  //! Update momentum (thread-safe)
+  void update_momentum(bool update,
+                       const Eigen::Ref<const Eigen::VectorXd>& momentum);
+
+  //! Update force (thread-safe)
+  void update_force(bool update,
+                    const Eigen::Ref<const Eigen::VectorXd>& force);
+
+  //! Accumulate mass, momentum and force
+  void update_mass_momentum_force(
+      double mass, const Eigen::Ref<const Eigen::VectorXd>& momentum,
+      const Eigen::Ref<const Eigen::VectorXd>& force, bool lock);
+
+  //! Compute velocity from momentum
+  void compute_velocity();
+
+  //! Compute acceleration from force and integrate velocity
+  bool compute_acceleration_velocity(double dt);
+
+  //! Assign velocity constraint
+  bool assign_velocity_constraint(unsigned dir, double velocity);
+
+  //! Apply velocity constraints
+  void apply_velocity_constraints();
+
+  //! Serialize
+  //! \details Status flags membership of the active nodes of a mesh and is
+  //! recomputed when particles are located, so it is not serialized
+  //! \tparam Archive Boost Archive
+  //! \param[in] ar Archive
+  friend class boost::serialization::access;
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /*version*/) {
+    ar& id_;
+    ar& coordinates_;
+    ar& nphases_;
+    ar& dof_;
+    ar& mass_;
+    ar& force_;
+    ar& velocity_;
+    ar& momentum_;
+    ar& acceleration_;
+    ar& velocity_constraints_;
+  }
 
  protected:
   //! node id
@@ -88,6 +144,8 @@ class Node : public NodeBase<Tdim> {
  private:
   //! Degrees of freedom
   unsigned dof_{std::numeric_limits<unsigned>::max()};
+  //! Status
+  bool status_{false};
   //! Mass solid
   double mass_{std::numeric_limits<double>::max()};
   //! Force
@@ -98,6 +156,10 @@ class Node : public NodeBase<Tdim> {
   Eigen::VectorXd momentum_;
   //! Acceleration
   Eigen::VectorXd acceleration_;
+  //! Velocity constraints (direction, velocity)
+  std::map<unsigned, double> velocity_constraints_;
+  //! Mutex to serialise concurrent updates from particles
+  std::mutex node_mutex_;
 };  // Node class
 }  // mpm namespace
 
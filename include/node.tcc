@@ -101,3 +101,154 @@ void mpm::Node<Tdim>::assign_acceleration(const Eigen::VectorXd& acceleration) {
     std::cerr << exception.what() << '\n';
   }
 }
+
+// Update nodal mass
+//! \param[in] update A boolean to update (true) or assign (false)
+//! \param[in] mass Mass from the particles in a cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Node<Tdim>::update_mass(bool update, double mass) {
+  // Decide to update or assign
+  const double factor = (update == true) ? 1. : 0.;
+  std::lock_guard<std::mutex> guard(node_mutex_);
+  mass_ = (mass_ * factor) + mass;
+}
+
+// Update nodal momentum
+//! \param[in] update A boolean to update (true) or assign (false)
+//! \param[in] momentum Momentum from the particles in a cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Node<Tdim>::update_momentum(
+    bool update, const Eigen::Ref<const Eigen::VectorXd>& momentum) {
+  try {
+    if (momentum.size() != momentum_.size()) {
+      throw std::runtime_error("Nodal momentum degrees of freedom don't match");
+    }
+    // Decide to update or assign
+    const double factor = (update == true) ? 1. : 0.;
+    std::lock_guard<std::mutex> guard(node_mutex_);
+    momentum_ = (momentum_ * factor) + momentum;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+}
+
+// Update nodal force
+//! \param[in] update A boolean to update (true) or assign (false)
+//! \param[in] force Internal or external force from the particles in a cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Node<Tdim>::update_force(
+    bool update, const Eigen::Ref<const Eigen::VectorXd>& force) {
+  try {
+    if (force.size() != force_.size()) {
+      throw std::runtime_error("Nodal force degrees of freedom don't match");
+    }
+    // Decide to update or assign
+    const double factor = (update == true) ? 1. : 0.;
+    std::lock_guard<std::mutex> guard(node_mutex_);
+    force_ = (force_ * factor) + force;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+}
+
+// Accumulate nodal mass, momentum and force
+//! \details Used to scatter the contributions of a cell in a single update.
+//! The node is locked unless the caller guarantees that no other thread
+//! updates it concurrently, e.g., when cells sharing the node are processed
+//! in different colours.
+//! \param[in] mass Mass from the particles in a cell
+//! \param[in] momentum Momentum from the particles in a cell
+//! \param[in] force Force from the particles in a cell
+//! \param[in] lock Serialise the update with other threads
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Node<Tdim>::update_mass_momentum_force(
+    double mass, const Eigen::Ref<const Eigen::VectorXd>& momentum,
+    const Eigen::Ref<const Eigen::VectorXd>& force, bool lock) {
+  try {
+    if (momentum.size() != momentum_.size() || force.size() != force_.size()) {
+      throw std::runtime_error("Nodal degrees of freedom don't match");
+    }
+    std::unique_lock<std::mutex> guard(node_mutex_, std::defer_lock);
+    if (lock) guard.lock();
+    mass_ += mass;
+    momentum_ += momentum;
+    force_ += force;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+}
+
+// Compute velocity from momentum
+//! \details Nodes without mass (not influenced by any particle) keep a zero
+//! velocity
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Node<Tdim>::compute_velocity() {
+  const double tolerance = std::numeric_limits<double>::epsilon();
+  if (mass_ > tolerance)
+    velocity_ = momentum_ / mass_;
+  else
+    velocity_.setZero();
+
+  // Apply velocity constraints, which also sets acceleration to 0,
+  // when velocity is set.
+  this->apply_velocity_constraints();
+}
+
+// Compute acceleration from force and integrate velocity
+//! \param[in] dt Time-step
+//! \retval status Return false if the node has no mass
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Node<Tdim>::compute_acceleration_velocity(double dt) {
+  bool status = false;
+  const double tolerance = std::numeric_limits<double>::epsilon();
+  if (mass_ > tolerance) {
+    // acceleration = force / mass
+    acceleration_ = force_ / mass_;
+    // Velocity += acceleration * dt
+    velocity_ += acceleration_ * dt;
+    // Apply velocity constraints, which also sets acceleration to 0,
+    // when velocity is set.
+    this->apply_velocity_constraints();
+    status = true;
+  }
+  return status;
+}
+
+// Assign velocity constraint
+//! \param[in] dir Direction of velocity constraint
+//! \param[in] velocity Applied velocity constraint
+//! \retval status Return the successful assignment of a velocity constraint
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+bool mpm::Node<Tdim>::assign_velocity_constraint(unsigned dir,
+                                                 double velocity) {
+  bool status = false;
+  try {
+    // Constrain directions can take values between 0 and dof * nphases
+    if (dir < velocity_.size()) {
+      velocity_constraints_[dir] = velocity;
+      status = true;
+    } else {
+      throw std::runtime_error("Constraint direction is out of bounds");
+    }
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+// Apply velocity constraints
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+void mpm::Node<Tdim>::apply_velocity_constraints() {
+  for (const auto& constraint : velocity_constraints_) {
+    velocity_(constraint.first) = constraint.second;
+    acceleration_(constraint.first) = 0.;
+  }
+}
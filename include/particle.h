@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "cell.h"
+#include "material/material.h"
 #include "serialize.h"
 
 namespace mpm {
@@ -17,13 +18,34 @@ using Index = unsigned long long;
 
 //! Particle class
 //! \brief Base class that stores the information about particles
-//! \details Particle class: id_ and coordinates.
+//! \details Particle class: id_ and coordinates. The cell and the material
+//! of a particle are non-owning handles: cells are owned by the mesh and
+//! materials must outlive their particles. The state of the particle is
+//! stored in Treal, while nodes, cells and materials compute in double,
+//! so a particle of floats halves the memory streamed by particle sweeps
+//! and its contributions are accumulated in double on the nodes.
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal = double>
 class Particle {
  public:
   //! Define a vector of size dimension
-  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+  using VectorDim = Eigen::Matrix<Treal, Tdim, 1>;
+
+  //! Define a vector of 6 dof (Voigt stress / strain)
+  using Vector6 = Eigen::Matrix<Treal, 6, 1>;
+
+  //! Define a vector of size dimension of nodal quantities
+  using VectorDimd = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Define a vector of 6 dof of nodal and material quantities
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  //! Define a vector of shape functions
+  using VectorX = Eigen::Matrix<Treal, Eigen::Dynamic, 1>;
+
+  //! Define a matrix of gradients of shape functions
+  using MatrixX = Eigen::Matrix<Treal, Eigen::Dynamic, Eigen::Dynamic>;
 
   //! Constructor with id and coordinates
   Particle(Index id, const VectorDim& coord);
@@ -32,13 +54,13 @@ class Particle {
   Particle(Index id, const VectorDim& coord, bool status);
 
   //! Destructor
-  virtual ~Particle(){};
+  virtual ~Particle();
 
   //! Delete copy constructor
-  Particle(const Particle<Tdim>&) = delete;
+  Particle(const Particle<Tdim, Treal>&) = delete;
 
   //! Delete assignement operator
-  Particle& operator=(const Particle<Tdim>&) = delete;
+  Particle& operator=(const Particle<Tdim, Treal>&) = delete;
 
   //! Return id of the particle
   Index id() const { return id_; }
@@ -51,8 +73,96 @@ class Particle {
   //! \retval coordinates_ return coordinates of the particle
   VectorDim coordinates() const { return coordinates_; }
 
-  //! Assign cell
-  bool assign_cell(const std::shared_ptr<Cell<Tdim>>& cellptr);
+  //! Assign cell, nullptr detaches the particle from its cell
+  bool assign_cell(Cell<Tdim>* cellptr);
+
+  //! Return cell
+  Cell<Tdim>* cell() const { return cell_; }
+
+  //! Assign material
+  bool assign_material(Material* material);
+
+  //! Return material
+  Material* material() const { return material_; }
+
+  //! Return id of the material
+  unsigned material_id() const { return material_id_; }
+
+  //! Return the slot in the pool of state variables of the material
+  std::size_t state() const { return state_; }
+
+  //! Assign mass
+  void assign_mass(Treal mass) { mass_ = mass; }
+
+  //! Return mass
+  Treal mass() const { return mass_; }
+
+  //! Assign volume
+  void assign_volume(Treal volume) { volume_ = volume; }
+
+  //! Return volume
+  Treal volume() const { return volume_; }
+
+  //! Assign velocity
+  void assign_velocity(const VectorDim& velocity) { velocity_ = velocity; }
+
+  //! Return velocity
+  VectorDim velocity() const { return velocity_; }
+
+  //! Assign stress
+  void assign_stress(const Vector6& stress) { stress_ = stress; }
+
+  //! Return stress
+  Vector6 stress() const { return stress_; }
+
+  //! Return strain
+  Vector6 strain() const { return strain_; }
+
+  //! Compute local coordinates of the particle in its cell
+  bool compute_reference_location();
+
+  //! Compute shape functions and their gradients
+  bool compute_shapefn();
+
+  //! Return shape functions
+  const VectorX& shapefn() const { return shapefn_; }
+
+  //! Return gradient of shape functions in real coordinates
+  const MatrixX& grad_shapefn() const { return grad_shapefn_; }
+
+  //! Map particle mass and momentum to nodes
+  void map_mass_momentum_to_nodes();
+
+  //! Map particle momentum to nodes
+  void map_momentum_to_nodes();
+
+  //! Map body and internal forces to nodes
+  void map_forces(const VectorDimd& pgravity);
+
+  //! Compute strain increment from nodal velocities
+  void compute_strain(double dt);
+
+  //! Compute strain increment from a strain rate
+  void compute_strain(const Vector6d& strain_rate, double dt);
+
+  //! Compute stress
+  bool compute_stress();
+
+  //! Compute stresses of particles in batches of the same material
+  static bool compute_stress(
+      const std::vector<Particle<Tdim, Treal>*>& particles);
+
+  //! Compute stresses of a batch of particles of a material
+  static bool compute_stress(
+      Material* material, const std::vector<Particle<Tdim, Treal>*>& particles);
+
+  //! Update velocity and position from nodal kinematics
+  void compute_updated_velocity_position(double dt);
+
+  //! Update velocity and position from interpolated nodal kinematics
+  void compute_updated_velocity_position(const VectorDimd& acceleration,
+                                         const VectorDimd& velocity,
+                                         double dt);
 
   //! Assign status
   void assign_status(bool status) { status_ = status; }
@@ -60,11 +170,21 @@ class Particle {
   //! Status
   bool status() const { return status_; }
 
+  //! Serialize
+  //! \tparam Archive Boost Archive
+  //! \param[in] ar Archive
   friend class boost::serialization::access;
   template <class Archive>
-  void serialize(Archive& ar, const unsigned int version) {
+  void serialize(Archive& ar, const unsigned int /*version*/) {
     ar& id_;
     ar& coordinates_;
+    ar& status_;
+    ar& mass_;
+    ar& volume_;
+    ar& velocity_;
+    ar& stress_;
+    ar& strain_;
+    ar& dstrain_;
   }
 
  private:
@@ -74,23 +194,47 @@ class Particle {
   //! coordinates
   VectorDim coordinates_;
 
-  //! Cell
-  std::shared_ptr<Cell<Tdim>> cell_;
+  //! Cell, owned by the mesh
+  Cell<Tdim>* cell_{nullptr};
+
+  //! Material, which outlives the particle
+  Material* material_{nullptr};
+
+  //! Material id
+  unsigned material_id_{std::numeric_limits<unsigned>::max()};
+
+  //! Slot in the pool of state variables of the material
+  std::size_t state_{std::numeric_limits<std::size_t>::max()};
 
   //! Status
   bool status_{true};
 
-  //! Serialize
-  //! \tparam Archive Boost Archive
-  //! \param[in] ar Archive
-  //! \param[in] version Version of class
-  friend class boost::serialization::access;
-  template <class Archive>
-  void serialize(Archive& ar, const unsigned int version) const {
-    // note, version is always the latest when saving
-    ar& id_;
-    ar& coordinates_;
-  }
+  //! Mass
+  Treal mass_{0.};
+
+  //! Volume
+  Treal volume_{0.};
+
+  //! Velocity
+  VectorDim velocity_;
+
+  //! Stress
+  Vector6 stress_;
+
+  //! Strain
+  Vector6 strain_;
+
+  //! Strain increment
+  Vector6 dstrain_;
+
+  //! Local coordinates in the cell
+  VectorDim xi_;
+
+  //! Shape functions
+  VectorX shapefn_;
+
+  //! Gradient of shape functions in real coordinates
+  MatrixX grad_shapefn_;
 };  // Particle class
 }  // mpm namespace
 
@@ -2,12 +2,19 @@
 //! \param[in] id Particle id
 //! \param[in] coord coordinates of the particle
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-mpm::Particle<Tdim>::Particle(Index id, const VectorDim& coord) : id_{id} {
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+mpm::Particle<Tdim, Treal>::Particle(Index id, const VectorDim& coord)
+    : id_{id} {
   // Check if the dimension is between 1 & 3
   static_assert((Tdim >= 1 && Tdim <= 3), "Invalid global dimension");
   coordinates_ = coord;
   status_ = true;
+  velocity_.setZero();
+  stress_.setZero();
+  strain_.setZero();
+  dstrain_.setZero();
+  xi_.setZero();
 }
 
 //! Constructor with id, coordinates and status
@@ -15,18 +22,268 @@ mpm::Particle<Tdim>::Particle(Index id, const VectorDim& coord) : id_{id} {
 //! \param[in] coord coordinates of the particle
 //! \param[in] status Particle status (active / inactive)
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-mpm::Particle<Tdim>::Particle(Index id, const VectorDim& coord, bool status)
-    : mpm::Particle<Tdim>::Particle(id, coord) {
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+mpm::Particle<Tdim, Treal>::Particle(Index id, const VectorDim& coord,
+                                     bool status)
+    : mpm::Particle<Tdim, Treal>::Particle(id, coord) {
   status_ = status;
 }
 
 // Assign a cell to particle
-//! \param[in] cellptr Pointer to a cell
+//! \param[in] cellptr Pointer to a cell, owned by the mesh, or nullptr to
+//! detach the particle from its cell
+//! \retval status Return false if the particle is not in a cell
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-bool mpm::Particle<Tdim>::assign_cell(
-    const std::shared_ptr<Cell<Tdim>>& cellptr) {
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::assign_cell(Cell<Tdim>* cellptr) {
+  // Remove the particle id from the previous cell
+  if (cell_ != nullptr && cell_ != cellptr)
+    cell_->remove_particle_id(this->id());
   cell_ = cellptr;
-  return cell_->add_particle_id(this->id());
+  return (cell_ != nullptr) && cell_->add_particle_id(this->id());
+}
+
+//! Destructor
+//! \details Releases the slot of the particle in the pool of state
+//! variables of its material
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+mpm::Particle<Tdim, Treal>::~Particle() {
+  if (material_ != nullptr) material_->state().release(state_);
+}
+
+// Assign a material to particle
+//! \details The particle is given a slot with initial values in the pool of
+//! state variables of the material, and releases its previous slot
+//! \param[in] material Pointer to a material, which outlives the particle
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::assign_material(Material* material) {
+  bool status = false;
+  try {
+    if (material != nullptr) {
+      if (material != material_) {
+        if (material_ != nullptr) material_->state().release(state_);
+        state_ = material->state().allocate();
+        material_ = material;
+        material_id_ = material->id();
+      }
+      status = true;
+    } else {
+      throw std::runtime_error("Material is undefined!");
+    }
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+// Compute local coordinates of the particle in its cell
+//! \details The cell computes in double
+//! \retval status Return false if the particle is not in a cell
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::compute_reference_location() {
+  bool status = false;
+  if (cell_ != nullptr) {
+    xi_ = cell_
+              ->transform_real_to_unit_cell(
+                  coordinates_.template cast<double>())
+              .template cast<Treal>();
+    status = true;
+  }
+  return status;
+}
+
+// Compute shape functions and gradients at the local coordinates
+//! \retval status Return false if the particle is not in a cell
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::compute_shapefn() {
+  bool status = false;
+  if (cell_ != nullptr) {
+    const VectorDimd xi = xi_.template cast<double>();
+    shapefn_ = cell_->compute_shapefn(xi).template cast<Treal>();
+    grad_shapefn_ = cell_->compute_grad_shapefn(xi).template cast<Treal>();
+    status = true;
+  }
+  return status;
+}
+
+// Map particle mass and momentum to nodes
+//! \details The particle is mapped by the cell-centric kernel of its cell
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::map_mass_momentum_to_nodes() {
+  const std::vector<Particle<Tdim, Treal>*> particles{this};
+  cell_->map_mass_momentum_to_nodes(particles);
+}
+
+// Map particle momentum to nodes
+//! \details The particle is mapped by the cell-centric kernel of its cell
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::map_momentum_to_nodes() {
+  const std::vector<Particle<Tdim, Treal>*> particles{this};
+  cell_->map_momentum_to_nodes(particles);
+}
+
+// Map body and internal forces to nodes
+//! \details The particle is mapped by the cell-centric kernel of its cell
+//! \param[in] pgravity Gravity acceleration
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::map_forces(const VectorDimd& pgravity) {
+  const std::vector<Particle<Tdim, Treal>*> particles{this};
+  cell_->map_forces_to_nodes(particles, pgravity);
+}
+
+// Compute strain increment from nodal velocities and update volume
+//! \details The strain rate is computed by the cell-centric kernel of its
+//! cell
+//! \param[in] dt Time-step
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::compute_strain(double dt) {
+  const std::vector<Particle<Tdim, Treal>*> particles{this};
+  cell_->compute_particles_strain(particles, dt);
+}
+
+// Compute strain increment from a strain rate and update volume
+//! \param[in] strain_rate Strain rate at the particle
+//! \param[in] dt Time-step
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::compute_strain(const Vector6d& strain_rate,
+                                         double dt) {
+  dstrain_ = (strain_rate * dt).template cast<Treal>();
+  strain_ += dstrain_;
+  // Update volume with the volumetric strain increment
+  volume_ *= (1. + dstrain_.head(3).sum());
+}
+
+// Compute stress
+//! \details The material computes in double
+//! \retval status Return false if no material is assigned
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::compute_stress() {
+  bool status = false;
+  if (material_ != nullptr) {
+    Vector6d stress = stress_.template cast<double>();
+    const Vector6d dstrain = dstrain_.template cast<double>();
+    material_->compute_stress(&stress, &dstrain, &state_, 1);
+    stress_ = stress.template cast<Treal>();
+    status = true;
+  }
+  return status;
+}
+
+// Compute stresses of particles in batches of the same material
+//! \details Runs of consecutive active particles with the same material are
+//! computed as batches of that material
+//! \param[in] particles Particles
+//! \retval status Return false if an active particle has no material
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::compute_stress(
+    const std::vector<Particle<Tdim, Treal>*>& particles) {
+  thread_local std::vector<Particle<Tdim, Treal>*> run;
+  bool status = true;
+  Material* material = nullptr;
+
+  for (const auto& particle : particles) {
+    if (!particle->status()) continue;
+    if (particle->material_ == nullptr) {
+      status = false;
+      continue;
+    }
+    if (particle->material_ != material) {
+      if (!run.empty()) compute_stress(material, run);
+      run.clear();
+      material = particle->material_;
+    }
+    run.emplace_back(particle);
+  }
+  if (!run.empty()) compute_stress(material, run);
+  run.clear();
+  return status;
+}
+
+// Compute stresses of a batch of particles of a material
+//! \details Stresses and strain increments of the active particles are
+//! gathered in double into buffers of the thread, so the material computes
+//! the batch with a single virtual call
+//! \param[in] material Material of the particles
+//! \param[in] particles Particles of the material
+//! \retval status Return false if the material is undefined
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+bool mpm::Particle<Tdim, Treal>::compute_stress(
+    Material* material, const std::vector<Particle<Tdim, Treal>*>& particles) {
+  using Buffer = std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>>;
+  thread_local Buffer stresses, strains;
+  thread_local std::vector<std::size_t> states;
+  thread_local std::vector<Particle<Tdim, Treal>*> batch;
+  if (material == nullptr) return false;
+
+  for (const auto& particle : particles) {
+    if (!particle->status()) continue;
+    stresses.emplace_back(particle->stress_.template cast<double>());
+    strains.emplace_back(particle->dstrain_.template cast<double>());
+    states.emplace_back(particle->state_);
+    batch.emplace_back(particle);
+  }
+
+  // Compute the batch and scatter stresses back to particles
+  if (!batch.empty())
+    material->compute_stress(stresses.data(), strains.data(), states.data(),
+                             batch.size());
+  for (std::size_t i = 0; i < batch.size(); ++i)
+    batch[i]->stress_ = stresses[i].template cast<Treal>();
+  stresses.clear();
+  strains.clear();
+  states.clear();
+  batch.clear();
+  return true;
+}
+
+// Update velocity and position from nodal kinematics
+//! \details velocity is updated with the interpolated nodal acceleration
+//! (FLIP) and position with the interpolated updated nodal velocity, by the
+//! cell-centric kernel of its cell
+//! \param[in] dt Time-step
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::compute_updated_velocity_position(double dt) {
+  const std::vector<Particle<Tdim, Treal>*> particles{this};
+  cell_->update_particles_velocity_position(particles, dt);
+}
+
+// Update velocity and position from interpolated nodal kinematics
+//! \param[in] acceleration Nodal acceleration interpolated at the particle
+//! \param[in] velocity Nodal velocity interpolated at the particle
+//! \param[in] dt Time-step
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of the particle
+template <unsigned Tdim, typename Treal>
+void mpm::Particle<Tdim, Treal>::compute_updated_velocity_position(
+    const VectorDimd& acceleration, const VectorDimd& velocity, double dt) {
+  velocity_ += (acceleration * dt).template cast<Treal>();
+  coordinates_ += (velocity * dt).template cast<Treal>();
 }
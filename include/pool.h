@@ -0,0 +1,172 @@
+#ifndef MPM_POOL_H_
+#define MPM_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// TBB
+#include <tbb/enumerable_thread_specific.h>
+
+namespace mpm {
+
+//! MemoryPool class
+//! \brief Pool of fixed size blocks carved from large slabs
+//! \details The block size is fixed by the first allocation. Each thread
+//! bumps through its own slab and keeps its own list of released blocks,
+//! so blocks are allocated and released without locks, and only a new slab
+//! takes the lock of the pool. A block may be released by any thread, it
+//! then joins the free list of that thread. Slabs are released with the
+//! pool.
+class MemoryPool {
+ public:
+  //! Alignment of blocks
+  static constexpr std::size_t alignment = 16;
+
+  //! Constructor with the number of blocks per slab
+  explicit MemoryPool(std::size_t nblocks_slab = 4096)
+      : nblocks_slab_{nblocks_slab > 0 ? nblocks_slab : 1} {}
+
+  //! Delete copy constructor
+  MemoryPool(const MemoryPool&) = delete;
+
+  //! Delete assignement operator
+  MemoryPool& operator=(const MemoryPool&) = delete;
+
+  //! Check if a block of the pool holds an object of a size
+  bool fits(std::size_t size);
+
+  //! Allocate a block
+  void* allocate();
+
+  //! Release a block
+  void deallocate(void* block);
+
+  //! Size of blocks, 0 before the first allocation
+  std::size_t block_size() const { return block_size_; }
+
+  //! Number of blocks per slab
+  std::size_t nblocks_slab() const { return nblocks_slab_; }
+
+  //! Number of slabs
+  std::size_t nslabs();
+
+ private:
+  //! Free list and current slab of a thread
+  struct Cache {
+    //! Released blocks, linked through their first bytes
+    void* free{nullptr};
+    //! Next unused block of the current slab
+    char* next{nullptr};
+    //! Number of unused blocks of the current slab
+    std::size_t nremaining{0};
+  };
+
+  //! Number of blocks per slab
+  std::size_t nblocks_slab_;
+  //! Size of blocks
+  std::atomic<std::size_t> block_size_{0};
+  //! Cache of each thread
+  tbb::enumerable_thread_specific<Cache> caches_;
+  //! Slabs
+  std::vector<std::unique_ptr<char[]>> slabs_;
+  //! Lock of slabs
+  std::mutex mutex_;
+};  // MemoryPool class
+
+//! PoolAllocator class
+//! \brief Standard allocator of single objects from a memory pool
+//! \details Objects that do not fit a block of the pool, and arrays, are
+//! allocated on the heap. The allocator shares ownership of the pool, so
+//! the pool lives as long as any object allocated from it.
+//! \tparam T Type of objects
+template <typename T>
+class PoolAllocator {
+ public:
+  //! Type of objects
+  using value_type = T;
+
+  //! Rebind to another type of objects
+  template <typename U>
+  struct rebind {
+    using other = PoolAllocator<U>;
+  };
+
+  //! Constructor with a pool
+  explicit PoolAllocator(const std::shared_ptr<MemoryPool>& pool)
+      : pool_{pool} {}
+
+  //! Constructor from an allocator of another type of objects
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& allocator) : pool_{allocator.pool()} {}
+
+  //! Allocate objects
+  T* allocate(std::size_t n);
+
+  //! Release objects
+  void deallocate(T* objects, std::size_t n);
+
+  //! Return the pool
+  const std::shared_ptr<MemoryPool>& pool() const { return pool_; }
+
+ private:
+  //! Check if objects are allocated from the pool
+  bool pooled(std::size_t n) const {
+    return n == 1 && alignof(T) <= MemoryPool::alignment &&
+           pool_->fits(sizeof(T));
+  }
+
+  //! Memory pool
+  std::shared_ptr<MemoryPool> pool_;
+};  // PoolAllocator class
+
+//! Allocators are equal if they share the pool
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+  return lhs.pool() == rhs.pool();
+}
+
+//! Allocators are not equal if they do not share the pool
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+//! Pool class
+//! \brief Typed pool of objects owned by shared pointers
+//! \details An object and the control block of its shared pointer are
+//! allocated together in a single block, so objects of a pool are close to
+//! each other in the order of creation and a released object is reused by
+//! the next object created on the same thread.
+//! \tparam T Type of objects
+template <typename T>
+class Pool {
+ public:
+  //! Constructor with the number of objects per slab
+  explicit Pool(std::size_t nobjects_slab = 4096)
+      : memory_{std::make_shared<MemoryPool>(nobjects_slab)} {}
+
+  //! Create an object
+  template <typename... Targs>
+  std::shared_ptr<T> create(Targs&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(memory_),
+                                   std::forward<Targs>(args)...);
+  }
+
+  //! Return the memory pool
+  const std::shared_ptr<MemoryPool>& memory() const { return memory_; }
+
+ private:
+  //! Memory pool
+  std::shared_ptr<MemoryPool> memory_;
+};  // Pool class
+}  // mpm namespace
+
+#include "pool.tcc"
+
+#endif  // MPM_POOL_H_
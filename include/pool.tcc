@@ -0,0 +1,74 @@
+//! Check if a block of the pool holds an object of a size
+//! \details The first call fixes the size of blocks
+//! \param[in] size Size of the object
+//! \retval status Object fits a block
+inline bool mpm::MemoryPool::fits(std::size_t size) {
+  std::size_t block_size = block_size_.load(std::memory_order_relaxed);
+  if (block_size == 0) {
+    // Blocks are aligned and hold the link of the free list
+    std::size_t aligned = std::max(size, sizeof(void*));
+    aligned = (aligned + alignment - 1) / alignment * alignment;
+    if (block_size_.compare_exchange_strong(block_size, aligned))
+      block_size = aligned;
+  }
+  return size <= block_size;
+}
+
+//! Allocate a block
+//! \details A released block of the thread is reused before the slab of the
+//! thread, and a new slab is allocated when the slab is exhausted
+//! \retval block Block of block_size bytes
+inline void* mpm::MemoryPool::allocate() {
+  Cache& cache = caches_.local();
+  if (cache.free != nullptr) {
+    void* block = cache.free;
+    cache.free = *static_cast<void**>(block);
+    return block;
+  }
+  if (cache.nremaining == 0) {
+    const std::size_t size = block_size_.load(std::memory_order_relaxed);
+    std::unique_ptr<char[]> slab(new char[size * nblocks_slab_]);
+    cache.next = slab.get();
+    cache.nremaining = nblocks_slab_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    slabs_.emplace_back(std::move(slab));
+  }
+  void* block = cache.next;
+  cache.next += block_size_.load(std::memory_order_relaxed);
+  --cache.nremaining;
+  return block;
+}
+
+//! Release a block to the free list of the thread
+//! \param[in] block Block allocated from the pool
+inline void mpm::MemoryPool::deallocate(void* block) {
+  Cache& cache = caches_.local();
+  *static_cast<void**>(block) = cache.free;
+  cache.free = block;
+}
+
+//! Number of slabs
+inline std::size_t mpm::MemoryPool::nslabs() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return slabs_.size();
+}
+
+//! Allocate objects
+//! \param[in] n Number of objects
+//! \retval objects Uninitialised storage of n objects
+template <typename T>
+T* mpm::PoolAllocator<T>::allocate(std::size_t n) {
+  if (pooled(n)) return static_cast<T*>(pool_->allocate());
+  return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+//! Release objects
+//! \param[in] objects Storage allocated by an equal allocator
+//! \param[in] n Number of objects
+template <typename T>
+void mpm::PoolAllocator<T>::deallocate(T* objects, std::size_t n) {
+  if (pooled(n))
+    pool_->deallocate(objects);
+  else
+    ::operator delete(objects);
+}
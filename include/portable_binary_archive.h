@@ -0,0 +1,308 @@
+#ifndef MPM_PORTABLE_BINARY_ARCHIVE_H_
+#define MPM_PORTABLE_BINARY_ARCHIVE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <boost/archive/basic_archive.hpp>
+#include <boost/archive/basic_binary_iprimitive.hpp>
+#include <boost/archive/basic_binary_oprimitive.hpp>
+#include <boost/archive/detail/common_iarchive.hpp>
+#include <boost/archive/detail/common_oarchive.hpp>
+#include <boost/archive/detail/register_archive.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/item_version_type.hpp>
+
+// Template definitions of the primitives and the serializer map
+#include <boost/archive/impl/archive_serializer_map.ipp>
+#include <boost/archive/impl/basic_binary_iprimitive.ipp>
+#include <boost/archive/impl/basic_binary_oprimitive.ipp>
+
+namespace mpm {
+
+//! PortableBinaryOArchive class
+//! \brief Binary output archive readable on any platform
+//! \details Integers are stored as 8 bytes and floating point numbers as
+//! IEEE 754, both little endian, so an archive does not depend on the
+//! sizes of types or the byte order of the machine that wrote it. Arrays
+//! of floating point numbers are written as a single block on little endian
+//! machines; arrays of integers are widened element by element.
+class PortableBinaryOArchive
+    : public boost::archive::basic_binary_oprimitive<
+          PortableBinaryOArchive, std::ostream::char_type,
+          std::ostream::traits_type>,
+      public boost::archive::detail::common_oarchive<PortableBinaryOArchive> {
+  //! Primitive base
+  typedef boost::archive::basic_binary_oprimitive<PortableBinaryOArchive,
+                                                  std::ostream::char_type,
+                                                  std::ostream::traits_type>
+      primitive_base_t;
+  //! Archive base
+  typedef boost::archive::detail::common_oarchive<PortableBinaryOArchive>
+      archive_base_t;
+
+  friend archive_base_t;
+  friend primitive_base_t;
+  friend class boost::archive::detail::interface_oarchive<
+      PortableBinaryOArchive>;
+  friend class boost::archive::save_access;
+
+ public:
+  //! Constructor with stream and archive flags
+  explicit PortableBinaryOArchive(std::ostream& os, unsigned flags = 0)
+      : primitive_base_t(*os.rdbuf(),
+                         0 != (flags & boost::archive::no_codecvt)),
+        archive_base_t(flags) {
+    if (0 == (flags & boost::archive::no_header)) {
+      *this << std::string(boost::archive::BOOST_ARCHIVE_SIGNATURE());
+      *this << boost::archive::BOOST_ARCHIVE_VERSION();
+    }
+  }
+
+  //! Save an array of numbers
+  template <class T>
+  void save_array(const boost::serialization::array_wrapper<T>& array,
+                  unsigned version) {
+    this->save_array(array, version, BlockArray<T>());
+  }
+
+  //! Arrays saved as a single block: float or double on little endian
+  //! machines, whose bytes are already those of the archive
+  template <class T>
+  struct BlockArray
+      : std::integral_constant<
+            bool, (BOOST_ENDIAN_LITTLE_BYTE != 0) &&
+                      (std::is_same<typename std::remove_const<T>::type,
+                                    float>::value ||
+                       std::is_same<typename std::remove_const<T>::type,
+                                    double>::value)> {};
+
+ private:
+  //! Save an array of numbers as a single block
+  template <class T>
+  void save_array(const boost::serialization::array_wrapper<T>& array,
+                  unsigned version, std::true_type) {
+    primitive_base_t::save_array(array, version);
+  }
+
+  //! Save an array of numbers element by element
+  template <class T>
+  void save_array(const boost::serialization::array_wrapper<T>& array,
+                  unsigned, std::false_type) {
+    for (std::size_t i = 0; i < array.count(); ++i)
+      this->save(array.address()[i]);
+  }
+
+  //! Save an integer or a serialization id
+  template <class T>
+  void save(const T& value) {
+    this->save_bytes(static_cast<std::uint64_t>(value));
+  }
+
+  //! Save a string
+  void save(const std::string& value) { primitive_base_t::save(value); }
+
+  //! Save a boolean
+  void save(const bool value) { primitive_base_t::save(value); }
+
+  //! Save a character
+  void save(const char value) { primitive_base_t::save(value); }
+
+  //! Save a signed character
+  void save(const signed char value) { primitive_base_t::save(value); }
+
+  //! Save an unsigned character
+  void save(const unsigned char value) { primitive_base_t::save(value); }
+
+  //! Save a single precision number
+  void save(const float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    this->save_bytes(bits);
+  }
+
+  //! Save a double precision number
+  void save(const double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    this->save_bytes(bits);
+  }
+
+  //! Save the bytes of an unsigned integer in little endian order
+  template <class T>
+  void save_bytes(T value) {
+    unsigned char bytes[sizeof(T)];
+    for (unsigned i = 0; i < sizeof(T); ++i)
+      bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    this->save_binary(bytes, sizeof(T));
+  }
+
+  //! Default processing by the archive base
+  template <class T>
+  void save_override(const T& value) {
+    archive_base_t::save_override(value);
+  }
+
+  //! Save a class name as a string
+  void save_override(const boost::archive::class_name_type& value) {
+    const std::string name(value);
+    *this << name;
+  }
+
+  //! Optional class ids are not saved
+  void save_override(const boost::archive::class_id_optional_type&) {}
+};  // PortableBinaryOArchive class
+
+//! PortableBinaryIArchive class
+//! \brief Binary input archive of PortableBinaryOArchive
+class PortableBinaryIArchive
+    : public boost::archive::basic_binary_iprimitive<
+          PortableBinaryIArchive, std::istream::char_type,
+          std::istream::traits_type>,
+      public boost::archive::detail::common_iarchive<PortableBinaryIArchive> {
+  //! Primitive base
+  typedef boost::archive::basic_binary_iprimitive<PortableBinaryIArchive,
+                                                  std::istream::char_type,
+                                                  std::istream::traits_type>
+      primitive_base_t;
+  //! Archive base
+  typedef boost::archive::detail::common_iarchive<PortableBinaryIArchive>
+      archive_base_t;
+
+  friend archive_base_t;
+  friend primitive_base_t;
+  friend class boost::archive::detail::interface_iarchive<
+      PortableBinaryIArchive>;
+  friend class boost::archive::load_access;
+
+ public:
+  //! Constructor with stream and archive flags
+  explicit PortableBinaryIArchive(std::istream& is, unsigned flags = 0)
+      : primitive_base_t(*is.rdbuf(),
+                         0 != (flags & boost::archive::no_codecvt)),
+        archive_base_t(flags) {
+    if (0 == (flags & boost::archive::no_header)) {
+      std::string signature;
+      *this >> signature;
+      if (signature != boost::archive::BOOST_ARCHIVE_SIGNATURE())
+        boost::serialization::throw_exception(
+            boost::archive::archive_exception(
+                boost::archive::archive_exception::invalid_signature));
+      boost::archive::library_version_type version;
+      *this >> version;
+      if (boost::archive::BOOST_ARCHIVE_VERSION() < version)
+        boost::serialization::throw_exception(
+            boost::archive::archive_exception(
+                boost::archive::archive_exception::unsupported_version));
+      this->set_library_version(version);
+    }
+  }
+
+  //! Load an array of numbers
+  template <class T>
+  void load_array(boost::serialization::array_wrapper<T>& array,
+                  unsigned version) {
+    this->load_array(array, version,
+                     PortableBinaryOArchive::BlockArray<T>());
+  }
+
+ private:
+  //! Load an array of numbers as a single block
+  template <class T>
+  void load_array(boost::serialization::array_wrapper<T>& array,
+                  unsigned version, std::true_type) {
+    primitive_base_t::load_array(array, version);
+  }
+
+  //! Load an array of numbers element by element
+  template <class T>
+  void load_array(boost::serialization::array_wrapper<T>& array, unsigned,
+                  std::false_type) {
+    for (std::size_t i = 0; i < array.count(); ++i)
+      this->load(array.address()[i]);
+  }
+
+  //! Load an integer or a serialization id
+  template <class T>
+  void load(T& value) {
+    value = T(this->load_bytes<std::uint64_t>());
+  }
+
+  //! Load a class id, which is constructible from int and size_t
+  void load(boost::archive::class_id_type& value) {
+    value = boost::archive::class_id_type(
+        static_cast<int>(this->load_bytes<std::uint64_t>()));
+  }
+
+  //! Load a string
+  void load(std::string& value) { primitive_base_t::load(value); }
+
+  //! Load a boolean
+  void load(bool& value) { primitive_base_t::load(value); }
+
+  //! Load a character
+  void load(char& value) { primitive_base_t::load(value); }
+
+  //! Load a signed character
+  void load(signed char& value) { primitive_base_t::load(value); }
+
+  //! Load an unsigned character
+  void load(unsigned char& value) { primitive_base_t::load(value); }
+
+  //! Load a single precision number
+  void load(float& value) {
+    const std::uint32_t bits = this->load_bytes<std::uint32_t>();
+    std::memcpy(&value, &bits, sizeof(bits));
+  }
+
+  //! Load a double precision number
+  void load(double& value) {
+    const std::uint64_t bits = this->load_bytes<std::uint64_t>();
+    std::memcpy(&value, &bits, sizeof(bits));
+  }
+
+  //! Load the bytes of an unsigned integer in little endian order
+  template <class T>
+  T load_bytes() {
+    unsigned char bytes[sizeof(T)];
+    this->load_binary(bytes, sizeof(T));
+    T value = 0;
+    for (unsigned i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(bytes[i]) << (8 * i);
+    return value;
+  }
+
+  //! Default processing by the archive base
+  template <class T>
+  void load_override(T& value) {
+    archive_base_t::load_override(value);
+  }
+
+  //! Load a class name from a string
+  void load_override(boost::archive::class_name_type& value) {
+    std::string name;
+    *this >> name;
+    if (name.size() > BOOST_SERIALIZATION_MAX_KEY_SIZE - 1)
+      boost::serialization::throw_exception(
+          boost::archive::archive_exception(
+              boost::archive::archive_exception::invalid_class_name));
+    std::memcpy(value, name.data(), name.size());
+    value.t[name.size()] = '\0';
+  }
+
+  //! Optional class ids are not saved
+  void load_override(boost::archive::class_id_optional_type&) {}
+};  // PortableBinaryIArchive class
+}  // mpm namespace
+
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(mpm::PortableBinaryOArchive)
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(mpm::PortableBinaryOArchive)
+BOOST_SERIALIZATION_REGISTER_ARCHIVE(mpm::PortableBinaryIArchive)
+BOOST_SERIALIZATION_USE_ARRAY_OPTIMIZATION(mpm::PortableBinaryIArchive)
+
+#endif  // MPM_PORTABLE_BINARY_ARCHIVE_H_
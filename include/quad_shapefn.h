@@ -13,23 +13,26 @@ namespace mpm {
 //! Quadrilateral shape function class derived from ShapeFn class
 //! \brief Shape functions of a quadrilateral element
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
-class QuadrilateralShapeFn : public ShapeFn<Tdim> {
+//! \tparam Treal Scalar type of local coordinates and shape functions
+template <unsigned Tdim, typename Treal = double>
+class QuadrilateralShapeFn : public ShapeFn<Tdim, Treal> {
 
  public:
   //! Define a vector of size dimension
-  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+  using VectorDim = Eigen::Matrix<Treal, Tdim, 1>;
+
+  //! Define a matrix of shape functions or of their gradients
+  using Matrix = Eigen::Matrix<Treal, Eigen::Dynamic, Eigen::Dynamic>;
 
   //! constructor with number of shape functions
-  QuadrilateralShapeFn(unsigned nfunctions) : mpm::ShapeFn<Tdim>(nfunctions) {
+  QuadrilateralShapeFn(unsigned nfunctions)
+      : mpm::ShapeFn<Tdim, Treal>(nfunctions) {
     static_assert(Tdim == 2, "Invalid dimension for a quadrilateral element");
     try {
       if (!(nfunctions == 4 || nfunctions == 8 || nfunctions == 9)) {
         throw std::runtime_error(
             "Specified number of shape functions is not defined");
       }
-      shapefn_.resize(this->nfunctions_, 1);
-      grad_shapefn_.resize(this->nfunctions_, Tdim);
     } catch (std::exception& exception) {
       std::cerr << exception.what() << '\n';
       std::abort();
@@ -38,19 +41,15 @@ class QuadrilateralShapeFn : public ShapeFn<Tdim> {
 
   //! Evaluate shape functions at given local coordinates
   //! \param[in] xi given local coordinates
-  Eigen::MatrixXd shapefn(const VectorDim& xi);
+  Matrix shapefn(const VectorDim& xi) const;
 
   //! Evaluate gradient of shape functions
   //! \param[in] xi given local coordinates
-  Eigen::MatrixXd grad_shapefn(const VectorDim& xi);
+  Matrix grad_shapefn(const VectorDim& xi) const;
 
  protected:
   // Number of functions
-  using ShapeFn<Tdim>::nfunctions_;
-  // Shape functions
-  using ShapeFn<Tdim>::shapefn_;
-  // Gradient shape functions
-  using ShapeFn<Tdim>::grad_shapefn_;
+  using ShapeFn<Tdim, Treal>::nfunctions_;
 };
 
 }  // namespace mpm
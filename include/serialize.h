@@ -1,9 +1,12 @@
 #ifndef MPM_SERIALIZE_H_
 #define MPM_SERIALIZE_H_
 
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/serialization/array.hpp>
+#include <boost/serialization/map.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/vector.hpp>
@@ -12,4 +15,6 @@
 #include "Eigen/Dense"
 #include "Eigen/src/Core/DenseBase.h"
 
+#include "portable_binary_archive.h"
+
 #endif
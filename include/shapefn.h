@@ -8,18 +8,19 @@ namespace mpm {
 //! Base class of shape functions
 //! \brief Base class that stores the information about shape functions
 //! \tparam Tdim Dimension
-template <unsigned Tdim>
+//! \tparam Treal Scalar type of local coordinates and shape functions
+template <unsigned Tdim, typename Treal = double>
 class ShapeFn {
  public:
   //! Define a vector of size dimension
-  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+  using VectorDim = Eigen::Matrix<Treal, Tdim, 1>;
+
+  //! Define a matrix of shape functions or of their gradients
+  using Matrix = Eigen::Matrix<Treal, Eigen::Dynamic, Eigen::Dynamic>;
 
   //! Constructor
   //! Assign variables to zero
-  ShapeFn(unsigned nfunctions) : nfunctions_{nfunctions} {
-    shapefn_.resize(nfunctions, 1);
-    grad_shapefn_.resize(nfunctions, Tdim);
-  }
+  ShapeFn(unsigned nfunctions) : nfunctions_{nfunctions} {}
 
   //! Destructor
   virtual ~ShapeFn() {}
@@ -29,20 +30,18 @@ class ShapeFn {
   unsigned nfunctions() const { return nfunctions_; }
 
   //! Evaluate shape functions at given local coordinates
+  //! \details Evaluation does not modify the object, so a shape function
+  //! can be shared by cells evaluated concurrently
   //! \param[in] xi given local coordinates
-  virtual Eigen::MatrixXd shapefn(const VectorDim& xi) = 0;
+  virtual Matrix shapefn(const VectorDim& xi) const = 0;
 
   //! Evaluate gradient of shape functions
   //! \param[in] xi given local coordinates
-  virtual Eigen::MatrixXd grad_shapefn(const VectorDim& xi) = 0;
+  virtual Matrix grad_shapefn(const VectorDim& xi) const = 0;
 
  protected:
   //! Number of functions
   unsigned nfunctions_;
-  //! Shape function
-  Eigen::MatrixXd shapefn_;
-  //! Gradient shape functions
-  Eigen::MatrixXd grad_shapefn_;
 };
 
 }  // namespace mpm
@@ -0,0 +1,140 @@
+#ifndef MPM_MPM_EXPLICIT_H_
+#define MPM_MPM_EXPLICIT_H_
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "Eigen/Dense"
+
+#include "io/checkpoint.h"
+#include "mesh.h"
+
+namespace mpm {
+
+//! Stress update scheme
+//! \brief USF: Update Stress First, USL: Update Stress Last,
+//! MUSL: Modified Update Stress Last
+enum class StressUpdate { USF, USL, MUSL };
+
+//! MPMExplicit class
+//! \brief Explicit single phase MPM time-step driver
+//! \details Each step locates particles, maps mass, momentum and forces to
+//! the nodes, integrates nodal kinematics and updates particles. Every stage
+//! runs in parallel over particles, active nodes or cells containing
+//! particles; transfers between particles and nodes use the cell-centric
+//! kernels.
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal = double>
+class MPMExplicit {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Constructor with mesh, time-step and stress update scheme
+  MPMExplicit(const std::shared_ptr<Mesh<Tdim, Treal>>& mesh, double dt,
+              StressUpdate stress_update = StressUpdate::USF);
+
+  //! Destructor
+  ~MPMExplicit(){};
+
+  //! Delete copy constructor
+  MPMExplicit(const MPMExplicit<Tdim, Treal>&) = delete;
+
+  //! Delete assignement operator
+  MPMExplicit& operator=(const MPMExplicit<Tdim, Treal>&) = delete;
+
+  //! Assign gravity
+  //! \param[in] gravity Gravity acceleration
+  void gravity(const VectorDim& gravity) { gravity_ = gravity; }
+
+  //! Return time-step
+  double dt() const { return dt_; }
+
+  //! Return stress update scheme
+  StressUpdate stress_update() const { return stress_update_; }
+
+  //! Assign scatter strategy of particle to node transfers
+  //! \param[in] scatter Scatter strategy
+  void scatter(Scatter scatter) { scatter_ = scatter; }
+
+  //! Return scatter strategy
+  Scatter scatter() const { return scatter_; }
+
+  //! Return number of steps computed
+  unsigned long long step() const { return step_; }
+
+  //! Assign number of steps computed, to continue from a checkpoint
+  //! \param[in] step Number of steps
+  void step(unsigned long long step) { step_ = step; }
+
+  //! Write a checkpoint of the mesh and the step counter
+  bool checkpoint(const std::string& filename) const;
+
+  //! Solve for a number of steps
+  bool solve(unsigned long long nsteps);
+
+  //! Compute a single explicit time-step
+  bool compute_step();
+
+  //! Return time spent in time-stepping (seconds)
+  double elapsed_time() const { return elapsed_time_; }
+
+  //! Return throughput in particle updates per second
+  double particle_updates_per_second() const;
+
+ private:
+  //! Locate particles and compute shape functions
+  bool compute_shapefn();
+
+  //! Reset nodal mass, momentum and force
+  void initialise_nodes();
+
+  //! Map particle mass and momentum to nodes and compute nodal velocity
+  void map_mass_momentum();
+
+  //! Map internal and external forces to nodes
+  void map_forces();
+
+  //! Map mass, momentum and forces to nodes and compute nodal velocity
+  void map_mass_momentum_forces();
+
+  //! Compute nodal acceleration and integrate nodal velocity
+  void compute_nodal_acceleration_velocity();
+
+  //! Update particle velocity and position
+  void update_particles();
+
+  //! Remap particle momentum to nodes and compute nodal velocity (MUSL)
+  void remap_momentum();
+
+  //! Compute particle strain and stress
+  void update_stress();
+
+ private:
+  //! Mesh
+  std::shared_ptr<Mesh<Tdim, Treal>> mesh_;
+  //! Time-step
+  double dt_{std::numeric_limits<double>::max()};
+  //! Stress update scheme
+  StressUpdate stress_update_{StressUpdate::USF};
+  //! Scatter strategy of particle to node transfers
+  Scatter scatter_{Scatter::Atomic};
+  //! Gravity
+  VectorDim gravity_;
+  //! Number of steps computed
+  unsigned long long step_{0};
+  //! Number of updates of active particles
+  unsigned long long particle_updates_{0};
+  //! Time spent in time-stepping (seconds)
+  double elapsed_time_{0.};
+};  // MPMExplicit class
+}  // mpm namespace
+
+#include "mpm_explicit.tcc"
+
+#endif  // MPM_MPM_EXPLICIT_H_
@@ -0,0 +1,242 @@
+//! Constructor with mesh, time-step and stress update scheme
+//! \param[in] mesh Mesh with nodes, cells and particles
+//! \param[in] dt Time-step
+//! \param[in] stress_update Stress update scheme
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::MPMExplicit<Tdim, Treal>::MPMExplicit(
+    const std::shared_ptr<Mesh<Tdim, Treal>>& mesh, double dt,
+    StressUpdate stress_update)
+    : mesh_{mesh}, dt_{dt}, stress_update_{stress_update} {
+  // Check if the dimension is between 1 & 3
+  static_assert((Tdim >= 1 && Tdim <= 3), "Invalid global dimension");
+  gravity_.setZero();
+}
+
+//! Solve for a number of steps
+//! \param[in] nsteps Number of steps
+//! \retval status Return false if a step failed
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::MPMExplicit<Tdim, Treal>::solve(unsigned long long nsteps) {
+  bool status = true;
+  for (unsigned long long i = 0; i < nsteps; ++i) {
+    if (!this->compute_step()) status = false;
+  }
+  return status;
+}
+
+//! Compute a single explicit time-step
+//! \retval status Return false if particles left the mesh
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::MPMExplicit<Tdim, Treal>::compute_step() {
+  const auto start = std::chrono::steady_clock::now();
+
+  // Locate particles and compute shape functions
+  bool status = this->compute_shapefn();
+
+  // Reset nodes
+  this->initialise_nodes();
+
+  if (stress_update_ == mpm::StressUpdate::USF) {
+    // Update stress first, forces use the updated stress
+    this->map_mass_momentum();
+    this->update_stress();
+    this->map_forces();
+  } else {
+    // Mass, momentum and forces are mapped in a single pass
+    this->map_mass_momentum_forces();
+  }
+
+  // Integrate nodal kinematics
+  this->compute_nodal_acceleration_velocity();
+
+  // Update particle velocity and position
+  this->update_particles();
+
+  // Update stress last, MUSL recomputes nodal velocity from particles
+  if (stress_update_ == mpm::StressUpdate::MUSL) this->remap_momentum();
+  if (stress_update_ != mpm::StressUpdate::USF) this->update_stress();
+
+  const auto end = std::chrono::steady_clock::now();
+  elapsed_time_ += std::chrono::duration<double>(end - start).count();
+  particle_updates_ += mesh_->nactive_particles();
+  ++step_;
+  return status;
+}
+
+//! Write a checkpoint of the mesh and the step counter
+//! \param[in] filename Name of the checkpoint file
+//! \details Checkpoints hold particles of doubles
+//! \retval status Return false if the checkpoint is not written
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::MPMExplicit<Tdim, Treal>::checkpoint(
+    const std::string& filename) const {
+  static_assert(std::is_same<Treal, double>::value,
+                "Checkpoints hold particles of doubles");
+  return mpm::Checkpoint<Tdim>().write(filename, mesh_, step_);
+}
+
+//! Return throughput in particle updates per second
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+double mpm::MPMExplicit<Tdim, Treal>::particle_updates_per_second() const {
+  return (elapsed_time_ > 0.) ? particle_updates_ / elapsed_time_ : 0.;
+}
+
+//! Locate particles and compute shape functions
+//! \retval status Return false if particles left the mesh
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::MPMExplicit<Tdim, Treal>::compute_shapefn() {
+  const bool status = mesh_->locate_particles_mesh();
+  mesh_->iterate_over_particles(
+      [](const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle) {
+        if (!particle->status()) return;
+        particle->compute_reference_location();
+        particle->compute_shapefn();
+      });
+  return status;
+}
+
+//! Reset nodal mass, momentum and force of active nodes
+//! \details Inactive nodes are not read by particles and are reset when
+//! they become active
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::initialise_nodes() {
+  mesh_->iterate_over_active_nodes([](mpm::Node<Tdim>* node) {
+    node->initialise();
+    node->update_mass(false, 0.);
+  });
+}
+
+//! Map particle mass and momentum to nodes and compute nodal velocity
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::map_mass_momentum() {
+  const VectorDim zero = VectorDim::Zero();
+  mesh_->scatter_to_nodes(
+      [&zero](mpm::Cell<Tdim>* cell,
+              const std::vector<mpm::Particle<Tdim, Treal>*>& particles) {
+        return cell->compute_nodal_contributions(particles, true, true, false,
+                                                 zero);
+      },
+      scatter_);
+
+  mesh_->iterate_over_active_nodes([](mpm::Node<Tdim>* node) {
+    node->compute_velocity();
+  });
+}
+
+//! Map internal and external forces to nodes
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::map_forces() {
+  const VectorDim gravity = gravity_;
+  mesh_->scatter_to_nodes(
+      [&gravity](mpm::Cell<Tdim>* cell,
+                 const std::vector<mpm::Particle<Tdim, Treal>*>& particles) {
+        return cell->compute_nodal_contributions(particles, false, false, true,
+                                                 gravity);
+      },
+      scatter_);
+}
+
+//! Map mass, momentum and forces to nodes and compute nodal velocity
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::map_mass_momentum_forces() {
+  const VectorDim gravity = gravity_;
+  mesh_->scatter_to_nodes(
+      [&gravity](mpm::Cell<Tdim>* cell,
+                 const std::vector<mpm::Particle<Tdim, Treal>*>& particles) {
+        return cell->compute_nodal_contributions(particles, true, true, true,
+                                                 gravity);
+      },
+      scatter_);
+
+  mesh_->iterate_over_active_nodes([](mpm::Node<Tdim>* node) {
+    node->compute_velocity();
+  });
+}
+
+//! Compute nodal acceleration and integrate nodal velocity
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::compute_nodal_acceleration_velocity() {
+  const double dt = dt_;
+  mesh_->iterate_over_active_nodes([dt](mpm::Node<Tdim>* node) {
+    node->compute_acceleration_velocity(dt);
+  });
+}
+
+//! Update particle velocity and position
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::update_particles() {
+  const double dt = dt_;
+  mesh_->iterate_over_cell_particles(
+      [dt](mpm::Cell<Tdim>* cell,
+           const std::vector<mpm::Particle<Tdim, Treal>*>& particles) {
+        cell->update_particles_velocity_position(particles, dt);
+      });
+}
+
+//! Remap particle momentum to nodes and compute nodal velocity (MUSL)
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::remap_momentum() {
+  mesh_->iterate_over_active_nodes([](mpm::Node<Tdim>* node) {
+    const Eigen::VectorXd zero = Eigen::VectorXd::Zero(node->momentum().size());
+    node->update_momentum(false, zero);
+  });
+
+  const VectorDim zero = VectorDim::Zero();
+  mesh_->scatter_to_nodes(
+      [&zero](mpm::Cell<Tdim>* cell,
+              const std::vector<mpm::Particle<Tdim, Treal>*>& particles) {
+        return cell->compute_nodal_contributions(particles, false, true, false,
+                                                 zero);
+      },
+      scatter_);
+
+  mesh_->iterate_over_active_nodes([](mpm::Node<Tdim>* node) {
+    node->compute_velocity();
+  });
+}
+
+//! Compute particle strain and stress
+//! \details Strains are computed per cell from the nodal velocities, and
+//! stresses per batch of particles of the same material, so that each
+//! batch is a single call of the constitutive model
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+void mpm::MPMExplicit<Tdim, Treal>::update_stress() {
+  using Particles = std::vector<mpm::Particle<Tdim, Treal>*>;
+  const double dt = dt_;
+  mesh_->iterate_over_cell_particles(
+      [dt](mpm::Cell<Tdim>* cell, const Particles& particles) {
+        cell->compute_particles_strain(particles, dt);
+      });
+  mesh_->iterate_over_material_particles(
+      [](mpm::Material* material, const Particles& particles) {
+        mpm::Particle<Tdim, Treal>::compute_stress(material, particles);
+      });
+}
@@ -0,0 +1,174 @@
+#ifndef MPM_SPARSE_MESH_H_
+#define MPM_SPARSE_MESH_H_
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/parallel_for.h>
+
+#include "mesh.h"
+#include "structured_mesh.h"
+
+namespace mpm {
+
+//! SparseMesh class
+//! \brief Unbounded Cartesian background grid stored in hashed blocks
+//! \details The grid is defined by an origin and a spacing only. Nodes and
+//! cells are grouped in blocks of block_size^Tdim, which are allocated in a
+//! hash map when a particle enters one of their cells and freed once no
+//! cell containing particles uses their nodes. Memory and per-step cost
+//! scale with the occupied volume rather than with the domain extent.
+//! Cell and node ids pack the signed index in each direction. Nodes and
+//! cells are not added or removed through the generic mesh interface.
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal = double>
+class SparseMesh : public Mesh<Tdim, Treal> {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Define a signed index in each direction
+  using IndexDim = std::array<long long, Tdim>;
+
+  //! Constructor with id, origin, spacing and block size
+  SparseMesh(unsigned id, const VectorDim& origin, const VectorDim& spacing,
+             unsigned block_size = 4, unsigned dof = Tdim);
+
+  //! Return block size (cells per block in each direction)
+  unsigned block_size() const { return block_size_; }
+
+  //! Number of allocated blocks
+  std::size_t nblocks() const { return blocks_.size(); }
+
+  //! Return the id of a cell or a node from its index in each direction
+  Index id(const IndexDim& index) const;
+
+  //! Return the index in each direction from a cell or a node id
+  IndexDim index(Index id) const;
+
+  //! Return the coordinates of a node
+  VectorDim node_coordinates(const IndexDim& index) const;
+
+  //! Find the index of the cell containing a point
+  bool locate_point(const VectorDim& point, IndexDim* index) const;
+
+  //! Return a cell, created with its block and nodes on first access
+  Cell<Tdim>* cell(const IndexDim& index);
+
+  //! Return a node if it is allocated, nullptr otherwise
+  Node<Tdim>* node(const IndexDim& index) const;
+
+  //! Nodes are created by the grid, a node is not added
+  bool add_node(const std::shared_ptr<Node<Tdim>>& node) override;
+
+  //! Nodes are created by the grid, nodes are not added
+  bool add_nodes(
+      const std::vector<std::shared_ptr<Node<Tdim>>>& nodes) override;
+
+  //! Nodes are created by the grid, a node is not removed
+  bool remove_node(const std::shared_ptr<Node<Tdim>>& node) override;
+
+  //! Cells are created by the grid, a cell is not added
+  bool add_cell(const std::shared_ptr<Cell<Tdim>>& cell) override;
+
+  //! Cells are created by the grid, cells are not added
+  bool add_cells(
+      const std::vector<std::shared_ptr<Cell<Tdim>>>& cells) override;
+
+  //! Cells are created by the grid, a cell is not removed
+  bool remove_cell(const std::shared_ptr<Cell<Tdim>>& cell) override;
+
+  //! Assign a velocity constraint to the nodes of a grid plane
+  bool assign_plane_velocity_constraint(unsigned axis, long long plane,
+                                        unsigned dir, double velocity);
+
+  //! Locate particles in cells and free vacated blocks
+  bool locate_particles_mesh() override;
+
+  //! Colour cells by the parity of their index, 2^Tdim colours
+  unsigned colour_cells() override;
+
+ protected:
+  //! Number of colours
+  using Mesh<Tdim, Treal>::ncolours_;
+
+  //! Container of particles
+  using Mesh<Tdim, Treal>::particles_;
+
+  //! Container of nodes
+  using Mesh<Tdim, Treal>::nodes_;
+
+  //! Container of cells
+  using Mesh<Tdim, Treal>::cells_;
+
+ private:
+  //! Block of cells and nodes, allocated as a whole
+  //! \details Cells and nodes are owned by the containers of the mesh
+  struct Block {
+    //! Cells of the block, nullptr if not created
+    std::vector<Cell<Tdim>*> cells;
+    //! Nodes of the block, nullptr if not created
+    std::vector<Node<Tdim>*> nodes;
+  };
+
+  //! Velocity constraint on a grid plane
+  struct PlaneConstraint {
+    //! Axis normal to the plane
+    unsigned axis;
+    //! Index of the plane
+    long long plane;
+    //! Direction of the velocity constraint
+    unsigned dir;
+    //! Velocity
+    double velocity;
+  };
+
+  //! Return the key of the block of a cell or node and its local index
+  Index block_key(const IndexDim& index, std::size_t* local) const;
+
+  //! Return a block, allocated on first access
+  Block& block(Index key);
+
+  //! Return a node, created on first access
+  Node<Tdim>* create_node(const IndexDim& index);
+
+  //! Report that nodes and cells are only created by the grid
+  bool grid_entities() const;
+
+  //! Free blocks whose nodes are not used by cells containing particles
+  std::size_t free_vacated_blocks();
+
+  //! Origin of the grid
+  VectorDim origin_;
+  //! Cell size in each direction
+  VectorDim spacing_;
+  //! Cells per block in each direction
+  unsigned block_size_{4};
+  //! Cells or nodes per block
+  std::size_t block_volume_{0};
+  //! Degrees of freedom of nodes
+  unsigned dof_{Tdim};
+  //! Bits per direction of a packed id
+  static constexpr unsigned bits_ = 63 / Tdim;
+  //! Shape function shared by all cells
+  std::shared_ptr<ShapeFn<Tdim>> shapefn_;
+  //! Allocated blocks
+  std::unordered_map<Index, Block> blocks_;
+  //! Velocity constraints on grid planes
+  std::vector<PlaneConstraint> plane_constraints_;
+};  // SparseMesh class
+}  // mpm namespace
+
+#include "sparse_mesh.tcc"
+
+#endif  // MPM_SPARSE_MESH_H_
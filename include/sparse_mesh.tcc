@@ -0,0 +1,443 @@
+//! Constructor with id, origin, spacing and block size
+//! \param[in] id Global mesh id
+//! \param[in] origin Coordinates of node (0, .., 0)
+//! \param[in] spacing Cell size in each direction
+//! \param[in] block_size Cells per block in each direction
+//! \param[in] dof Degrees of freedom of nodes
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::SparseMesh<Tdim, Treal>::SparseMesh(unsigned id,
+                                         const VectorDim& origin,
+                                         const VectorDim& spacing,
+                                         unsigned block_size, unsigned dof)
+    : mpm::Mesh<Tdim, Treal>(id),
+      origin_{origin},
+      spacing_{spacing},
+      block_size_{block_size},
+      dof_{dof} {
+  static_assert((Tdim == 2 || Tdim == 3), "Invalid sparse mesh dimension");
+  try {
+    if (block_size_ == 0)
+      throw std::runtime_error("Invalid sparse mesh block size");
+    for (unsigned i = 0; i < Tdim; ++i)
+      if (!(spacing_(i) > 0.))
+        throw std::runtime_error("Invalid sparse mesh spacing");
+    block_volume_ = 1;
+    for (unsigned i = 0; i < Tdim; ++i) block_volume_ *= block_size_;
+    shapefn_ = mpm::StructuredCell<Tdim>::shapefn();
+    // Cells are coloured by the parity of their index when created
+    ncolours_ = 1 << Tdim;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+    std::abort();
+  }
+}
+
+//! Return the id of a cell or a node from its index in each direction
+//! \param[in] index Index in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Index mpm::SparseMesh<Tdim, Treal>::id(const IndexDim& index) const {
+  const long long offset = 1LL << (bits_ - 1);
+  Index id = 0;
+  for (unsigned i = 0; i < Tdim; ++i)
+    id |= static_cast<Index>(index[i] + offset) << (bits_ * i);
+  return id;
+}
+
+//! Return the index in each direction from a cell or a node id
+//! \param[in] id Cell or node id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::SparseMesh<Tdim, Treal>::IndexDim
+    mpm::SparseMesh<Tdim, Treal>::index(Index id) const {
+  const long long offset = 1LL << (bits_ - 1);
+  const Index mask = (Index(1) << bits_) - 1;
+  IndexDim index;
+  for (unsigned i = 0; i < Tdim; ++i)
+    index[i] = static_cast<long long>((id >> (bits_ * i)) & mask) - offset;
+  return index;
+}
+
+//! Return the coordinates of a node
+//! \param[in] index Index of the node in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::SparseMesh<Tdim, Treal>::VectorDim
+    mpm::SparseMesh<Tdim, Treal>::node_coordinates(
+        const IndexDim& index) const {
+  VectorDim coordinates;
+  for (unsigned i = 0; i < Tdim; ++i)
+    coordinates(i) = origin_(i) + index[i] * spacing_(i);
+  return coordinates;
+}
+
+//! Find the index of the cell containing a point
+//! \param[in] point Coordinates of the point
+//! \param[out] index Index of the cell in each direction
+//! \retval status Return false if the point is beyond the range of ids
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::locate_point(const VectorDim& point,
+                                         IndexDim* index) const {
+  // Nodes of the cell must be representable
+  const double limit = static_cast<double>((1LL << (bits_ - 1)) - 1);
+  for (unsigned i = 0; i < Tdim; ++i) {
+    const double xi = std::floor((point(i) - origin_(i)) / spacing_(i));
+    if (!(xi >= -limit && xi < limit)) return false;
+    (*index)[i] = static_cast<long long>(xi);
+  }
+  return true;
+}
+
+//! Return the key of the block of a cell or node and its local index
+//! \param[in] index Index of the cell or node in each direction
+//! \param[out] local Index of the cell or node in the block
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Index mpm::SparseMesh<Tdim, Treal>::block_key(const IndexDim& index,
+                                            std::size_t* local) const {
+  const long long size = block_size_;
+  IndexDim block;
+  *local = 0;
+  for (unsigned i = Tdim; i-- > 0;) {
+    // Floor division for negative indices
+    block[i] = (index[i] >= 0) ? index[i] / size
+                               : -((-index[i] - 1) / size) - 1;
+    *local = *local * block_size_ + (index[i] - block[i] * size);
+  }
+  return this->id(block);
+}
+
+//! Return a block, allocated on first access
+//! \param[in] key Block key
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::SparseMesh<Tdim, Treal>::Block&
+    mpm::SparseMesh<Tdim, Treal>::block(Index key) {
+  auto itr = blocks_.find(key);
+  if (itr == blocks_.end()) {
+    itr = blocks_.emplace(key, Block()).first;
+    itr->second.cells.resize(block_volume_);
+    itr->second.nodes.resize(block_volume_);
+  }
+  return itr->second;
+}
+
+//! Return a cell, created with its block and nodes on first access
+//! \details Not thread-safe, cells are created serially
+//! \param[in] index Index of the cell in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Cell<Tdim>* mpm::SparseMesh<Tdim, Treal>::cell(const IndexDim& index) {
+  std::size_t local;
+  const Index key = this->block_key(index, &local);
+  auto& cell = this->block(key).cells[local];
+  if (cell == nullptr) {
+    const auto created = this->make_cell(
+        this->id(index), mpm::StructuredCell<Tdim>::nnodes(), shapefn_);
+    cell = created.get();
+    // Nodes in the order of the shape functions
+    for (unsigned n = 0; n < mpm::StructuredCell<Tdim>::nnodes(); ++n) {
+      IndexDim node = index;
+      node[0] += (n ^ (n >> 1)) & 1;
+      for (unsigned i = 1; i < Tdim; ++i) node[i] += (n >> i) & 1;
+      cell->add_node(n, this->create_node(node));
+    }
+    cell->initialise();
+    // Cells of the same index parity share no node
+    unsigned colour = 0;
+    for (unsigned i = 0; i < Tdim; ++i) colour |= (index[i] & 1) << i;
+    cell->assign_colour(colour);
+    cells_.add(created, false);
+  }
+  return cell;
+}
+
+//! Return a node if it is allocated, nullptr otherwise
+//! \param[in] index Index of the node in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Node<Tdim>* mpm::SparseMesh<Tdim, Treal>::node(
+    const IndexDim& index) const {
+  std::size_t local;
+  const Index key = this->block_key(index, &local);
+  const auto itr = blocks_.find(key);
+  return (itr != blocks_.end()) ? itr->second.nodes[local] : nullptr;
+}
+
+//! Return a node, created on first access
+//! \details Plane velocity constraints are applied to new nodes
+//! \param[in] index Index of the node in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Node<Tdim>* mpm::SparseMesh<Tdim, Treal>::create_node(
+    const IndexDim& index) {
+  std::size_t local;
+  const Index key = this->block_key(index, &local);
+  auto& node = this->block(key).nodes[local];
+  if (node == nullptr) {
+    const auto created = this->make_node(
+        this->id(index), this->node_coordinates(index), dof_);
+    node = created.get();
+    for (const auto& constraint : plane_constraints_)
+      if (index[constraint.axis] == constraint.plane)
+        node->assign_velocity_constraint(constraint.dir, constraint.velocity);
+    nodes_.add(created, false);
+  }
+  return node;
+}
+
+//! Report that nodes and cells are only created by the grid
+//! \details Blocks refer to nodes and cells owned by the containers of the
+//! mesh, so they are not added or removed through the mesh interface
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::grid_entities() const {
+  try {
+    throw std::runtime_error(
+        "Nodes and cells of a sparse mesh are created by the grid");
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return false;
+}
+
+//! Nodes are created by the grid, a node is not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::add_node(
+    const std::shared_ptr<mpm::Node<Tdim>>& /*node*/) {
+  return this->grid_entities();
+}
+
+//! Nodes are created by the grid, nodes are not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::add_nodes(
+    const std::vector<std::shared_ptr<mpm::Node<Tdim>>>& /*nodes*/) {
+  return this->grid_entities();
+}
+
+//! Nodes are created by the grid, a node is not removed
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::remove_node(
+    const std::shared_ptr<mpm::Node<Tdim>>& /*node*/) {
+  return this->grid_entities();
+}
+
+//! Cells are created by the grid, a cell is not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::add_cell(
+    const std::shared_ptr<mpm::Cell<Tdim>>& /*cell*/) {
+  return this->grid_entities();
+}
+
+//! Cells are created by the grid, cells are not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::add_cells(
+    const std::vector<std::shared_ptr<mpm::Cell<Tdim>>>& /*cells*/) {
+  return this->grid_entities();
+}
+
+//! Cells are created by the grid, a cell is not removed
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::remove_cell(
+    const std::shared_ptr<mpm::Cell<Tdim>>& /*cell*/) {
+  return this->grid_entities();
+}
+
+//! Assign a velocity constraint to the nodes of a grid plane
+//! \details The constraint is applied to allocated nodes and to nodes
+//! allocated later
+//! \param[in] axis Axis normal to the plane
+//! \param[in] plane Index of the nodes on the plane along the axis
+//! \param[in] dir Direction of the velocity constraint
+//! \param[in] velocity Velocity
+//! \retval status Return false if the axis or direction is invalid
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::assign_plane_velocity_constraint(
+    unsigned axis, long long plane, unsigned dir, double velocity) {
+  bool status = false;
+  try {
+    if (axis >= Tdim || dir >= dof_)
+      throw std::runtime_error("Invalid plane axis or constraint direction");
+
+    plane_constraints_.emplace_back(
+        PlaneConstraint{axis, plane, dir, velocity});
+    for (const auto& block : blocks_)
+      for (const auto& node : block.second.nodes)
+        if (node != nullptr && this->index(node->id())[axis] == plane)
+          node->assign_velocity_constraint(dir, velocity);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Locate particles in cells and free vacated blocks
+//! \details Cell indices are computed in parallel by floor division. Only
+//! particles changing cell look up the hash map, serially, which allocates
+//! blocks and cells on demand. Particles beyond the range of ids are
+//! deactivated.
+//! \retval status Return true if all active particles are located
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::SparseMesh<Tdim, Treal>::locate_particles_mesh() {
+  const auto particles = this->particle_pointers();
+  std::vector<IndexDim> indices(particles.size());
+  // 0: unchanged or inactive, 1: changes cell, 2: outside
+  std::vector<unsigned char> moves(particles.size(), 0);
+
+  // Cell of each particle
+  tbb::parallel_for(std::size_t(0), particles.size(),
+                    [this, &particles, &indices, &moves](std::size_t i) {
+                      const auto& particle = particles[i];
+                      if (!particle->status()) return;
+                      if (!this->locate_point(
+                              particle->coordinates().template cast<double>(),
+                              &indices[i])) {
+                        moves[i] = 2;
+                        return;
+                      }
+                      const auto cell = particle->cell();
+                      if (cell == nullptr ||
+                          cell->id() != this->id(indices[i]))
+                        moves[i] = 1;
+                    });
+
+  // Look up or create cells of particles changing cell
+  std::vector<mpm::Cell<Tdim>*> cells(particles.size(), nullptr);
+  for (std::size_t i = 0; i < particles.size(); ++i)
+    if (moves[i] == 1) cells[i] = this->cell(indices[i]);
+
+  // Assign cells
+  std::atomic<bool> status{true};
+  tbb::parallel_for(std::size_t(0), particles.size(),
+                    [&particles, &cells, &moves, &status](std::size_t i) {
+                      if (moves[i] == 1) {
+                        particles[i]->assign_cell(cells[i]);
+                      } else if (moves[i] == 2) {
+                        // Particle is outside the range of the grid
+                        particles[i]->assign_cell(nullptr);
+                        particles[i]->assign_status(false);
+                        status = false;
+                      }
+                    });
+
+  this->group_particles_by_cell();
+  this->free_vacated_blocks();
+  return status;
+}
+
+//! Free blocks whose nodes are not used by cells containing particles
+//! \details A block is kept if it holds a node of a cell containing
+//! particles, which includes the block of the cell itself. Deactivated
+//! particles are not located but keep their cell, so their cells are kept
+//! as well. Cells of kept blocks using nodes of freed blocks contain no
+//! particles and are removed as well, so no cell refers to a freed node and
+//! a node re-created in a freed block is the only node at its grid point.
+//! \retval nfreed Number of blocks freed
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+std::size_t mpm::SparseMesh<Tdim, Treal>::free_vacated_blocks() {
+  std::unordered_set<Index> used;
+  for (const auto& block : blocks_)
+    for (const auto& cell : block.second.cells) {
+      if (cell == nullptr || !cell->status()) continue;
+      for (unsigned n = 0; n < cell->nnodes(); ++n) {
+        std::size_t local;
+        used.insert(this->block_key(this->index(cell->node(n)->id()), &local));
+      }
+    }
+
+  // Ids of cells and nodes of vacated blocks
+  std::unordered_set<Index> cell_ids, node_ids;
+  std::size_t nfreed = 0;
+  for (auto itr = blocks_.begin(); itr != blocks_.end();) {
+    if (used.count(itr->first)) {
+      ++itr;
+      continue;
+    }
+    for (const auto& cell : itr->second.cells)
+      if (cell != nullptr) cell_ids.insert(cell->id());
+    for (const auto& node : itr->second.nodes)
+      if (node != nullptr) node_ids.insert(node->id());
+    itr = blocks_.erase(itr);
+    ++nfreed;
+  }
+
+  // Cells of kept blocks with nodes of freed blocks
+  if (!node_ids.empty()) {
+    for (auto& block : blocks_) {
+      for (auto& cell : block.second.cells) {
+        if (cell == nullptr) continue;
+        bool freed = false;
+        for (unsigned n = 0; n < cell->nnodes(); ++n)
+          if (node_ids.count(cell->node(n)->id())) freed = true;
+        if (freed) {
+          cell_ids.insert(cell->id());
+          cell = nullptr;
+        }
+      }
+    }
+  }
+
+  if (!cell_ids.empty())
+    cells_.remove_if(
+        [&cell_ids](const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
+          return cell_ids.count(cell->id()) > 0;
+        });
+  if (!node_ids.empty())
+    nodes_.remove_if(
+        [&node_ids](const std::shared_ptr<mpm::Node<Tdim>>& node) {
+          return node_ids.count(node->id()) > 0;
+        });
+  return nfreed;
+}
+
+//! Colour cells by the parity of their index, 2^Tdim colours
+//! \details Cells are coloured when they are created, cells with the same
+//! parity in every direction are at least two cells apart and share no node
+//! \retval ncolours Number of colours
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+unsigned mpm::SparseMesh<Tdim, Treal>::colour_cells() {
+  ncolours_ = 1 << Tdim;
+  this->group_cell_particles_by_colour();
+  return ncolours_;
+}
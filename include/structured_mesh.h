@@ -0,0 +1,202 @@
+#ifndef MPM_STRUCTURED_MESH_H_
+#define MPM_STRUCTURED_MESH_H_
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "Eigen/Dense"
+
+// TBB
+#include <tbb/parallel_for.h>
+
+#include "hex_shapefn.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+
+namespace mpm {
+
+//! Cells of a structured mesh
+//! \brief Number of nodes and shape function of a linear Cartesian cell
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+struct StructuredCell;
+
+//! Quadrilateral cell with 4 nodes
+template <>
+struct StructuredCell<2> {
+  //! Number of nodes per cell
+  static unsigned nnodes() { return 4; }
+  //! Shape function
+  static std::shared_ptr<ShapeFn<2>> shapefn() {
+    return std::make_shared<QuadrilateralShapeFn<2>>(4);
+  }
+};
+
+//! Hexahedron cell with 8 nodes
+template <>
+struct StructuredCell<3> {
+  //! Number of nodes per cell
+  static unsigned nnodes() { return 8; }
+  //! Shape function
+  static std::shared_ptr<ShapeFn<3>> shapefn() {
+    return std::make_shared<HexahedronShapeFn<3>>(8);
+  }
+};
+
+//! StructuredMesh class
+//! \brief Cartesian background grid with implicit connectivity
+//! \details Nodes and cells are defined by an origin, a spacing and the
+//! number of cells in each direction. Ids, connectivity and neighbours are
+//! computed arithmetically and a particle is located by a floor division.
+//! Node and Cell objects are only created for cells a particle enters, so
+//! the empty part of the grid costs a null pointer per node and cell. Nodes
+//! and cells are not added or removed through the generic mesh interface.
+//! Ids are lexicographic with x varying fastest.
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal = double>
+class StructuredMesh : public Mesh<Tdim, Treal> {
+ public:
+  //! Define a vector of size dimension
+  using VectorDim = Eigen::Matrix<double, Tdim, 1>;
+
+  //! Define an index in each direction
+  using IndexDim = std::array<Index, Tdim>;
+
+  //! Constructor with id, origin, spacing and number of cells
+  StructuredMesh(unsigned id, const VectorDim& origin, const VectorDim& spacing,
+                 const IndexDim& ncells_dir, unsigned dof = Tdim);
+
+  //! Return origin
+  const VectorDim& origin() const { return origin_; }
+
+  //! Return spacing
+  const VectorDim& spacing() const { return spacing_; }
+
+  //! Return number of cells in each direction
+  const IndexDim& ncells_dir() const { return ncells_dir_; }
+
+  //! Total number of cells of the grid
+  Index ngrid_cells() const { return cells_by_id_.size(); }
+
+  //! Total number of nodes of the grid
+  Index ngrid_nodes() const { return nodes_by_id_.size(); }
+
+  //! Return the id of a cell from its index in each direction
+  Index cell_id(const IndexDim& index) const;
+
+  //! Return the index in each direction of a cell
+  IndexDim cell_index(Index id) const;
+
+  //! Return the id of a node from its index in each direction
+  Index node_id(const IndexDim& index) const;
+
+  //! Return the index in each direction of a node
+  IndexDim node_index(Index id) const;
+
+  //! Return the coordinates of a node
+  VectorDim node_coordinates(Index id) const;
+
+  //! Return the node ids of a cell in the order of the shape functions
+  std::vector<Index> cell_node_ids(Index id) const;
+
+  //! Return the ids of the cells sharing a node or a face with a cell
+  std::vector<Index> neighbour_cell_ids(Index id) const;
+
+  //! Find the cell containing a point
+  bool locate_point(const VectorDim& point, Index* id) const;
+
+  //! Return a cell, created with its nodes on first access
+  Cell<Tdim>* cell(Index id);
+
+  //! Return a node if it was created, nullptr otherwise
+  Node<Tdim>* node(Index id) const { return nodes_by_id_[id]; }
+
+  //! Nodes are created by the grid, a node is not added
+  bool add_node(const std::shared_ptr<Node<Tdim>>& node) override;
+
+  //! Nodes are created by the grid, nodes are not added
+  bool add_nodes(
+      const std::vector<std::shared_ptr<Node<Tdim>>>& nodes) override;
+
+  //! Nodes are created by the grid, a node is not removed
+  bool remove_node(const std::shared_ptr<Node<Tdim>>& node) override;
+
+  //! Cells are created by the grid, a cell is not added
+  bool add_cell(const std::shared_ptr<Cell<Tdim>>& cell) override;
+
+  //! Cells are created by the grid, cells are not added
+  bool add_cells(
+      const std::vector<std::shared_ptr<Cell<Tdim>>>& cells) override;
+
+  //! Cells are created by the grid, a cell is not removed
+  bool remove_cell(const std::shared_ptr<Cell<Tdim>>& cell) override;
+
+  //! Assign a velocity constraint to the nodes on a boundary of the grid
+  bool assign_boundary_velocity_constraint(unsigned axis, bool upper,
+                                           unsigned dir, double velocity);
+
+  //! Locate particles in cells
+  bool locate_particles_mesh() override;
+
+  //! Colour cells by the parity of their index, 2^Tdim colours
+  unsigned colour_cells() override;
+
+ protected:
+  //! Number of colours
+  using Mesh<Tdim, Treal>::ncolours_;
+
+  //! Container of particles
+  using Mesh<Tdim, Treal>::particles_;
+
+  //! Container of nodes
+  using Mesh<Tdim, Treal>::nodes_;
+
+  //! Container of cells
+  using Mesh<Tdim, Treal>::cells_;
+
+ private:
+  //! Return a node, created on first access
+  Node<Tdim>* create_node(Index id);
+
+  //! Report that nodes and cells are only created by the grid
+  bool grid_entities() const;
+
+  //! Boundary velocity constraint
+  struct BoundaryConstraint {
+    //! Axis normal to the boundary
+    unsigned axis;
+    //! Upper or lower boundary
+    bool upper;
+    //! Direction of the velocity constraint
+    unsigned dir;
+    //! Velocity
+    double velocity;
+  };
+
+  //! Origin of the grid
+  VectorDim origin_;
+  //! Cell size in each direction
+  VectorDim spacing_;
+  //! Number of cells in each direction
+  IndexDim ncells_dir_;
+  //! Degrees of freedom of nodes
+  unsigned dof_{Tdim};
+  //! Shape function shared by all cells
+  std::shared_ptr<ShapeFn<Tdim>> shapefn_;
+  //! Cells indexed by id, owned by cells_, nullptr if not created
+  std::vector<Cell<Tdim>*> cells_by_id_;
+  //! Nodes indexed by id, owned by nodes_, nullptr if not created
+  std::vector<Node<Tdim>*> nodes_by_id_;
+  //! Velocity constraints on the boundaries of the grid
+  std::vector<BoundaryConstraint> boundary_constraints_;
+};  // StructuredMesh class
+}  // mpm namespace
+
+#include "structured_mesh.tcc"
+
+#endif  // MPM_STRUCTURED_MESH_H_
@@ -0,0 +1,401 @@
+//! Constructor with id, origin, spacing and number of cells
+//! \param[in] id Global mesh id
+//! \param[in] origin Coordinates of the first node
+//! \param[in] spacing Cell size in each direction
+//! \param[in] ncells_dir Number of cells in each direction
+//! \param[in] dof Degrees of freedom of nodes
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::StructuredMesh<Tdim, Treal>::StructuredMesh(unsigned id,
+                                                 const VectorDim& origin,
+                                                 const VectorDim& spacing,
+                                                 const IndexDim& ncells_dir,
+                                                 unsigned dof)
+    : mpm::Mesh<Tdim, Treal>(id),
+      origin_{origin},
+      spacing_{spacing},
+      ncells_dir_(ncells_dir),
+      dof_{dof} {
+  static_assert((Tdim == 2 || Tdim == 3), "Invalid structured mesh dimension");
+  try {
+    Index ncells = 1, nnodes = 1;
+    for (unsigned i = 0; i < Tdim; ++i) {
+      if (ncells_dir_[i] == 0 || !(spacing_(i) > 0.))
+        throw std::runtime_error("Invalid structured mesh size or spacing");
+      ncells *= ncells_dir_[i];
+      nnodes *= ncells_dir_[i] + 1;
+    }
+    cells_by_id_.resize(ncells);
+    nodes_by_id_.resize(nnodes);
+    shapefn_ = mpm::StructuredCell<Tdim>::shapefn();
+    // Cells are coloured by the parity of their index when created
+    ncolours_ = 1 << Tdim;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+    std::abort();
+  }
+}
+
+//! Return the id of a cell from its index in each direction
+//! \param[in] index Index of the cell in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Index mpm::StructuredMesh<Tdim, Treal>::cell_id(
+    const IndexDim& index) const {
+  Index id = 0;
+  for (unsigned i = Tdim; i-- > 0;) id = id * ncells_dir_[i] + index[i];
+  return id;
+}
+
+//! Return the index in each direction of a cell
+//! \param[in] id Cell id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::StructuredMesh<Tdim, Treal>::IndexDim
+    mpm::StructuredMesh<Tdim, Treal>::cell_index(Index id) const {
+  IndexDim index;
+  for (unsigned i = 0; i < Tdim; ++i) {
+    index[i] = id % ncells_dir_[i];
+    id /= ncells_dir_[i];
+  }
+  return index;
+}
+
+//! Return the id of a node from its index in each direction
+//! \param[in] index Index of the node in each direction
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Index mpm::StructuredMesh<Tdim, Treal>::node_id(
+    const IndexDim& index) const {
+  Index id = 0;
+  for (unsigned i = Tdim; i-- > 0;) id = id * (ncells_dir_[i] + 1) + index[i];
+  return id;
+}
+
+//! Return the index in each direction of a node
+//! \param[in] id Node id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::StructuredMesh<Tdim, Treal>::IndexDim
+    mpm::StructuredMesh<Tdim, Treal>::node_index(Index id) const {
+  IndexDim index;
+  for (unsigned i = 0; i < Tdim; ++i) {
+    index[i] = id % (ncells_dir_[i] + 1);
+    id /= (ncells_dir_[i] + 1);
+  }
+  return index;
+}
+
+//! Return the coordinates of a node
+//! \param[in] id Node id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+typename mpm::StructuredMesh<Tdim, Treal>::VectorDim
+    mpm::StructuredMesh<Tdim, Treal>::node_coordinates(Index id) const {
+  const IndexDim index = this->node_index(id);
+  VectorDim coordinates;
+  for (unsigned i = 0; i < Tdim; ++i)
+    coordinates(i) = origin_(i) + index[i] * spacing_(i);
+  return coordinates;
+}
+
+//! Return the node ids of a cell in the order of the shape functions
+//! \details Local node n is offset by ((n ^ n >> 1) & 1, n >> 1 & 1,
+//! n >> 2 & 1) from the first node: counter-clockwise in a quadrilateral,
+//! bottom then top face in a hexahedron
+//! \param[in] id Cell id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+std::vector<mpm::Index> mpm::StructuredMesh<Tdim, Treal>::cell_node_ids(
+    Index id) const {
+  const IndexDim index = this->cell_index(id);
+  const unsigned nnodes = mpm::StructuredCell<Tdim>::nnodes();
+  std::vector<Index> ids(nnodes);
+  for (unsigned n = 0; n < nnodes; ++n) {
+    IndexDim node = index;
+    node[0] += (n ^ (n >> 1)) & 1;
+    for (unsigned i = 1; i < Tdim; ++i) node[i] += (n >> i) & 1;
+    ids[n] = this->node_id(node);
+  }
+  return ids;
+}
+
+//! Return the ids of the cells sharing a node or a face with a cell
+//! \param[in] id Cell id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+std::vector<mpm::Index> mpm::StructuredMesh<Tdim, Treal>::neighbour_cell_ids(
+    Index id) const {
+  const IndexDim index = this->cell_index(id);
+  std::vector<Index> ids;
+  // Offsets of -1, 0 or 1 in each direction
+  unsigned noffsets = 1;
+  for (unsigned i = 0; i < Tdim; ++i) noffsets *= 3;
+  for (unsigned n = 0; n < noffsets; ++n) {
+    IndexDim neighbour = index;
+    bool inside = true;
+    unsigned offsets = n;
+    for (unsigned i = 0; i < Tdim; ++i, offsets /= 3) {
+      const long long shifted =
+          static_cast<long long>(index[i]) + static_cast<int>(offsets % 3) - 1;
+      if (shifted < 0 || shifted >= static_cast<long long>(ncells_dir_[i]))
+        inside = false;
+      neighbour[i] = shifted;
+    }
+    if (inside && this->cell_id(neighbour) != id)
+      ids.emplace_back(this->cell_id(neighbour));
+  }
+  return ids;
+}
+
+//! Find the cell containing a point
+//! \details Points on the upper boundary belong to the last cell
+//! \param[in] point Coordinates of the point
+//! \param[out] id Id of the cell containing the point
+//! \retval status Return false if the point is outside the grid
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::locate_point(const VectorDim& point,
+                                             Index* id) const {
+  IndexDim index;
+  for (unsigned i = 0; i < Tdim; ++i) {
+    const double xi = (point(i) - origin_(i)) / spacing_(i);
+    if (!(xi >= 0.) || xi > ncells_dir_[i]) return false;
+    index[i] = std::min(static_cast<Index>(std::floor(xi)), ncells_dir_[i] - 1);
+  }
+  *id = this->cell_id(index);
+  return true;
+}
+
+//! Return a cell, created with its nodes on first access
+//! \details Not thread-safe, cells are created serially
+//! \param[in] id Cell id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Cell<Tdim>* mpm::StructuredMesh<Tdim, Treal>::cell(Index id) {
+  auto& cell = cells_by_id_.at(id);
+  if (cell == nullptr) {
+    const auto created =
+        this->make_cell(id, mpm::StructuredCell<Tdim>::nnodes(), shapefn_);
+    cell = created.get();
+    const auto node_ids = this->cell_node_ids(id);
+    for (unsigned n = 0; n < node_ids.size(); ++n)
+      cell->add_node(n, this->create_node(node_ids[n]));
+    cell->initialise();
+    // Cells of the same index parity share no node
+    const IndexDim index = this->cell_index(id);
+    unsigned colour = 0;
+    for (unsigned i = 0; i < Tdim; ++i) colour |= (index[i] & 1) << i;
+    cell->assign_colour(colour);
+    // Ids are unique, skip the linear search of the container
+    cells_.add(created, false);
+  }
+  return cell;
+}
+
+//! Return a node, created on first access
+//! \details Boundary velocity constraints are applied to new nodes
+//! \param[in] id Node id
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+mpm::Node<Tdim>* mpm::StructuredMesh<Tdim, Treal>::create_node(Index id) {
+  auto& node = nodes_by_id_.at(id);
+  if (node == nullptr) {
+    const auto created =
+        this->make_node(id, this->node_coordinates(id), dof_);
+    node = created.get();
+    const IndexDim index = this->node_index(id);
+    for (const auto& constraint : boundary_constraints_) {
+      const Index boundary =
+          constraint.upper ? ncells_dir_[constraint.axis] : 0;
+      if (index[constraint.axis] == boundary)
+        node->assign_velocity_constraint(constraint.dir, constraint.velocity);
+    }
+    nodes_.add(created, false);
+  }
+  return node;
+}
+
+//! Report that nodes and cells are only created by the grid
+//! \details Nodes and cells indexed by id are owned by the containers of the
+//! mesh, so they are not added or removed through the mesh interface
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::grid_entities() const {
+  try {
+    throw std::runtime_error(
+        "Nodes and cells of a structured mesh are created by the grid");
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return false;
+}
+
+//! Nodes are created by the grid, a node is not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::add_node(
+    const std::shared_ptr<mpm::Node<Tdim>>& /*node*/) {
+  return this->grid_entities();
+}
+
+//! Nodes are created by the grid, nodes are not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::add_nodes(
+    const std::vector<std::shared_ptr<mpm::Node<Tdim>>>& /*nodes*/) {
+  return this->grid_entities();
+}
+
+//! Nodes are created by the grid, a node is not removed
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::remove_node(
+    const std::shared_ptr<mpm::Node<Tdim>>& /*node*/) {
+  return this->grid_entities();
+}
+
+//! Cells are created by the grid, a cell is not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::add_cell(
+    const std::shared_ptr<mpm::Cell<Tdim>>& /*cell*/) {
+  return this->grid_entities();
+}
+
+//! Cells are created by the grid, cells are not added
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::add_cells(
+    const std::vector<std::shared_ptr<mpm::Cell<Tdim>>>& /*cells*/) {
+  return this->grid_entities();
+}
+
+//! Cells are created by the grid, a cell is not removed
+//! \retval status Return false
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::remove_cell(
+    const std::shared_ptr<mpm::Cell<Tdim>>& /*cell*/) {
+  return this->grid_entities();
+}
+
+//! Assign a velocity constraint to the nodes on a boundary of the grid
+//! \details The constraint is applied to existing nodes and to nodes
+//! created later
+//! \param[in] axis Axis normal to the boundary
+//! \param[in] upper Upper (true) or lower (false) boundary
+//! \param[in] dir Direction of the velocity constraint
+//! \param[in] velocity Velocity
+//! \retval status Return false if the axis or direction is invalid
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::assign_boundary_velocity_constraint(
+    unsigned axis, bool upper, unsigned dir, double velocity) {
+  bool status = false;
+  try {
+    if (axis >= Tdim || dir >= dof_)
+      throw std::runtime_error("Invalid boundary axis or constraint direction");
+
+    boundary_constraints_.emplace_back(
+        BoundaryConstraint{axis, upper, dir, velocity});
+    const Index boundary = upper ? ncells_dir_[axis] : 0;
+    for (const auto& node : nodes_by_id_)
+      if (node != nullptr && this->node_index(node->id())[axis] == boundary)
+        node->assign_velocity_constraint(dir, velocity);
+    status = true;
+  } catch (std::exception& exception) {
+    std::cerr << exception.what() << '\n';
+  }
+  return status;
+}
+
+//! Locate particles in cells
+//! \details Cell ids are computed in parallel by floor division, cells
+//! entered for the first time are created serially and particles are then
+//! assigned in parallel. Particles outside the grid are deactivated.
+//! \retval status Return true if all active particles are located
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+bool mpm::StructuredMesh<Tdim, Treal>::locate_particles_mesh() {
+  const Index invalid = std::numeric_limits<Index>::max();
+
+  const auto particles = this->particle_pointers();
+  std::vector<Index> cell_ids(particles.size(), invalid);
+
+  // Cell of each particle
+  tbb::parallel_for(std::size_t(0), particles.size(),
+                    [this, &particles, &cell_ids](std::size_t i) {
+                      const auto& particle = particles[i];
+                      if (!particle->status()) return;
+                      Index id;
+                      if (this->locate_point(
+                              particle->coordinates().template cast<double>(),
+                              &id))
+                        cell_ids[i] = id;
+                    });
+
+  // Create cells entered for the first time
+  for (const auto id : cell_ids)
+    if (id != invalid && cells_by_id_[id] == nullptr) this->cell(id);
+
+  // Assign cells
+  std::atomic<bool> status{true};
+  tbb::parallel_for(std::size_t(0), particles.size(),
+                    [this, &particles, &cell_ids, &status,
+                     invalid](std::size_t i) {
+                      const auto& particle = particles[i];
+                      if (!particle->status()) return;
+                      if (cell_ids[i] == invalid) {
+                        // Particle is outside the grid
+                        particle->assign_cell(nullptr);
+                        particle->assign_status(false);
+                        status = false;
+                        return;
+                      }
+                      const auto cell = cells_by_id_[cell_ids[i]];
+                      if (particle->cell() != cell) particle->assign_cell(cell);
+                    });
+
+  this->group_particles_by_cell();
+  return status;
+}
+
+//! Colour cells by the parity of their index, 2^Tdim colours
+//! \details Cells are coloured when they are created, cells with the same
+//! parity in every direction are at least two cells apart and share no node
+//! \retval ncolours Number of colours
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+unsigned mpm::StructuredMesh<Tdim, Treal>::colour_cells() {
+  ncolours_ = 1 << Tdim;
+  this->group_cell_particles_by_colour();
+  return ncolours_;
+}
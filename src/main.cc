@@ -1,30 +1,245 @@
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <memory>
-
-#include "container.h"
-#include "handler.h"
-#include "node.h"
+#include <string>
 
 #include "Eigen/Dense"
+#include "json.hpp"
 
-int main(int argc, char** argv) {
-  unsigned long long id = 0;
+#include "factory.h"
+#include "io/result_writer.h"
+#include "material/drucker_prager.h"
+#include "material/linear_elastic.h"
+#include "material/modified_cam_clay.h"
+#include "material/mohr_coulomb.h"
+#include "mesh.h"
+#include "solvers/mpm_explicit.h"
+#include "structured_mesh.h"
+
+// JSON
+using Json = nlohmann::json;
+
+//! Create a block of hexahedron cells with particles in its lower half
+//! \param[in] ncells Number of cells in each direction
+//! \param[in] material Material assigned to particles
+//! \retval mesh Structured mesh with particles, cells are created as
+//! particles enter them
+//! \tparam Treal Scalar type of the state of particles
+template <typename Treal>
+std::shared_ptr<mpm::Mesh<3, Treal>> create_block(
+    unsigned ncells, const std::shared_ptr<mpm::Material>& material) {
   const unsigned Dim = 3;
-  const unsigned Dof = 6;
-  Eigen::Matrix<double, Dim, 1> coord;
-  coord.setZero();
+  // Cell size, density and particles per cell direction
+  const double spacing = 1.0;
+  const double density = 1000.;
+  const unsigned nppc = 2;
 
-  auto node = std::make_shared<mpm::Node<Dim>>(id, coord, Dof);
-  std::cout << "Node id: " << node->id() << '\n';
+  auto mesh = std::make_shared<mpm::StructuredMesh<Dim, Treal>>(
+      0, Eigen::Vector3d::Zero(), Eigen::Vector3d::Constant(spacing),
+      std::array<mpm::Index, Dim>{{ncells, ncells, ncells}});
+
+  // Bottom nodes are fixed
+  for (unsigned dir = 0; dir < Dim; ++dir)
+    mesh->assign_boundary_velocity_constraint(2, false, dir, 0.);
+
+  // Particles in the lower half of the block
+  const double pspacing = spacing / nppc;
+  const double pvolume = pspacing * pspacing * pspacing;
+  mpm::Index particle_id = 0;
+  for (unsigned k = 0; k < (ncells * nppc) / 2; ++k)
+    for (unsigned j = 0; j < ncells * nppc; ++j)
+      for (unsigned i = 0; i < ncells * nppc; ++i) {
+        Eigen::Vector3d coords((i + 0.5) * pspacing, (j + 0.5) * pspacing,
+                               (k + 0.5) * pspacing);
+        auto particle =
+            mesh->make_particle(particle_id++, coords.cast<Treal>());
+        particle->assign_volume(pvolume);
+        particle->assign_mass(pvolume * density);
+        particle->assign_material(material.get());
+        mesh->add_particle(particle);
+      }
+  return mesh;
+}
+
+//! Write results of particles in the background
+//! \param[in] writer Result writer
+//! \param[in] mesh Mesh with particles
+//! \param[in] filename Name of the result file
+//! \param[in] step Step of the results
+//! \retval status Return false if results are not written
+bool write_results(mpm::ResultWriter<3>& writer,
+                   const std::shared_ptr<mpm::Mesh<3>>& mesh,
+                   const std::string& filename, unsigned long long step) {
+  return writer.write_particles(mesh, {"mass", "velocity", "stress"}, filename,
+                                step);
+}
+
+//! Results are written for particles of doubles only
+//! \retval status Return false
+//! \tparam Treal Scalar type of the state of particles
+template <typename Treal>
+bool write_results(mpm::ResultWriter<3>&,
+                   const std::shared_ptr<mpm::Mesh<3, Treal>>&,
+                   const std::string&, unsigned long long) {
+  std::cerr << "Results are written for particles of doubles only\n";
+  return false;
+}
+
+//! Report counters of stress updates of a step and reset them
+//! \details Yielding increments that do not converge with the maximum number
+//! of substeps are applied elastically, and are reported as a warning
+//! \param[in,out] material Modified Cam-Clay material
+//! \param[in] step Step of the counters
+//! \param[in,out] total Counters of all steps
+void report_statistics(mpm::ModifiedCamClay& material, unsigned long long step,
+                       mpm::ModifiedCamClay::Statistics& total) {
+  const auto statistics = material.statistics();
+  material.reset_statistics();
+  if (statistics.nfailed > 0) {
+    const unsigned max_substeps = mpm::ModifiedCamClay::max_substeps;
+    std::cerr << "Warning: step " << step << ": " << statistics.nfailed
+              << " yielding stress updates did not converge with "
+              << max_substeps << " substeps and are elastic\n";
+  }
+  total.nupdates += statistics.nupdates;
+  total.nyielding += statistics.nyielding;
+  total.niterations += statistics.niterations;
+  total.nsubstepped += statistics.nsubstepped;
+  total.nsubsteps += statistics.nsubsteps;
+  total.nfailed += statistics.nfailed;
+}
 
-  auto nodehandler = std::make_shared<mpm::Handler<mpm::Node<Dim>>>();
-  nodehandler->insert(node);
+//! Run the gravity block
+//! \param[in] argc Number of arguments
+//! \param[in] argv Arguments
+//! \param[in] material Material assigned to particles
+//! \retval status Return false if a step or the results fail
+//! \tparam Treal Scalar type of the state of particles
+template <typename Treal>
+bool run(int argc, char** argv,
+         const std::shared_ptr<mpm::Material>& material) {
+  const unsigned Dim = 3;
+
+  // Number of steps, stress update scheme (usf, usl or musl), number of
+  // cells, scatter strategy (atomic, colouring or reduction), number of
+  // steps between results (0 for none) and result format (vtk, vtu or vtuz)
+  const unsigned long long nsteps = (argc > 1) ? std::stoull(argv[1]) : 100;
+  const std::string scheme = (argc > 2) ? argv[2] : "usf";
+  const unsigned ncells = (argc > 3) ? std::stoul(argv[3]) : 10;
+  const std::string scatter = (argc > 4) ? argv[4] : "atomic";
+  const unsigned long long output_steps =
+      (argc > 5) ? std::stoull(argv[5]) : 0;
+  const std::string format = (argc > 6) ? argv[6] : "vtk";
+
+  mpm::StressUpdate stress_update = mpm::StressUpdate::USF;
+  if (scheme == "usl")
+    stress_update = mpm::StressUpdate::USL;
+  else if (scheme == "musl")
+    stress_update = mpm::StressUpdate::MUSL;
+
+  auto mesh = create_block<Treal>(ncells, material);
+
+  // Explicit solver under gravity
+  const double dt = 1.0E-3;
+  mpm::MPMExplicit<Dim, Treal> solver(mesh, dt, stress_update);
+  solver.gravity(Eigen::Vector3d(0., 0., -9.81));
+  if (scatter == "colouring") {
+    solver.scatter(mpm::Scatter::Colouring);
+    std::cout << "Colours: " << mesh->colour_cells() << '\n';
+  } else if (scatter == "reduction") {
+    solver.scatter(mpm::Scatter::Reduction);
+  }
+
+  // Results are written in the background while the next steps compute
+  mpm::ResultFormat result_format = mpm::ResultFormat::LegacyVTK;
+  std::string extension = ".vtk";
+  if (format == "vtu" || format == "vtuz") {
+    result_format = (format == "vtuz") ? mpm::ResultFormat::CompressedVTK
+                                       : mpm::ResultFormat::VTK;
+    extension = ".vtp";
+  }
+  mpm::ResultWriter<Dim> writer(2, result_format);
+
+  // Counters of Modified Cam-Clay stress updates are reported every step
+  auto camclay = std::dynamic_pointer_cast<mpm::ModifiedCamClay>(material);
+  mpm::ModifiedCamClay::Statistics statistics{0, 0, 0, 0, 0, 0};
+  if (camclay) camclay->reset_statistics();
+
+  bool status = true;
+  for (unsigned long long step = 0; step < nsteps; ++step) {
+    if (!solver.solve(1)) status = false;
+    if (camclay) report_statistics(*camclay, solver.step(), statistics);
+    if (output_steps > 0 &&
+        ((step + 1) % output_steps == 0 || step + 1 == nsteps) &&
+        !write_results(writer, mesh,
+                       "particles" + std::to_string(solver.step()) + extension,
+                       solver.step()))
+      status = false;
+  }
+  if (output_steps > 0 && !writer.flush()) status = false;
+
+  std::cout << "Scheme: " << scheme << " scatter: " << scatter
+            << " particles: " << mesh->nparticles()
+            << " cells: " << mesh->ncells() << " steps: " << solver.step()
+            << '\n'
+            << "Elapsed time (s): " << solver.elapsed_time() << '\n'
+            << "Particle updates per second: "
+            << solver.particle_updates_per_second() << '\n';
+  if (camclay) {
+    const double niterations =
+        (statistics.nyielding > 0)
+            ? static_cast<double>(statistics.niterations) /
+                  statistics.nyielding
+            : 0.;
+    std::cout << "Stress updates: " << statistics.nupdates
+              << " yielding: " << statistics.nyielding
+              << " iterations per yielding update: " << niterations
+              << " substepped: " << statistics.nsubstepped
+              << " failed: " << statistics.nfailed << '\n';
+  }
+  if (output_steps > 0) {
+    const auto metrics = writer.metrics();
+    std::cout << "Results: " << metrics.nsnapshots
+              << " snapshot time (s): " << metrics.snapshot_time
+              << " wait time (s): " << metrics.wait_time
+              << " write time (s): " << metrics.write_time
+              << " overlap: " << metrics.overlap() << '\n';
+  }
+  return status;
+}
+
+int main(int argc, char** argv) {
+  // Precision of particles after the arguments of the run: double, or mixed
+  // for particles of floats with nodes and materials in double
+  const std::string precision = (argc > 7) ? argv[7] : "double";
+  // Material of particles: LinearElastic or ModifiedCamClay
+  const std::string model = (argc > 8) ? argv[8] : "LinearElastic";
 
-  for (auto itr = nodehandler->begin(); itr != nodehandler->end(); ++itr)
-    std::cout << ((*itr).second)->id() << '\n';
+  // Material
+  unsigned material_id = 0;
+  std::shared_ptr<mpm::Material> material;
+  Json jmaterial;
+  jmaterial["poisson_ratio"] = 0.3;
+  if (model == "ModifiedCamClay") {
+    material = Factory<mpm::Material, unsigned>::instance()->create(
+        "ModifiedCamClay", std::move(material_id));
+    jmaterial["kappa"] = 0.05;
+    jmaterial["lambda"] = 0.2;
+    jmaterial["critical_state_ratio"] = 1.2;
+    jmaterial["void_ratio"] = 1.;
+    jmaterial["preconsolidation_pressure"] = 20.E+3;
+  } else {
+    material = Factory<mpm::Material, unsigned>::instance()->create(
+        "LinearElastic", std::move(material_id));
+    jmaterial["youngs_modulus"] = 1.0E+6;
+  }
+  material->properties(jmaterial);
+  material->elastic_tensor();
 
-  auto nodecontainer = std::make_shared<mpm::Container<mpm::Node<Dim>>>();
-  nodecontainer->add(node);
-  nodecontainer->add(node);
+  std::cout << "Precision: " << precision << " material: " << model << '\n';
+  const bool status = (precision == "mixed")
+                          ? run<float>(argc, argv, material)
+                          : run<double>(argc, argv, material);
+  return status ? 0 : 1;
 }
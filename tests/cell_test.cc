@@ -7,6 +7,7 @@
 #include "cell.h"
 #include "hex_shapefn.h"
 #include "node.h"
+#include "particle.h"
 #include "quad_shapefn.h"
 #include "shapefn.h"
 
@@ -53,10 +54,10 @@ TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
   SECTION("Add nodes") {
     mpm::Index id = 0;
     auto cell = std::make_shared<mpm::Cell<Dim>>(id, Nnodes);
-    cell->add_node(0, node0);
-    cell->add_node(1, node1);
-    cell->add_node(2, node2);
-    cell->add_node(3, node3);
+    cell->add_node(0, node0.get());
+    cell->add_node(1, node1.get());
+    cell->add_node(2, node2.get());
+    cell->add_node(3, node3.get());
     REQUIRE(cell->nnodes() == 4);
   }
 
@@ -64,7 +65,7 @@ TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
     auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes);
     auto neighbourcell = std::make_shared<mpm::Cell<Dim>>(1, Nnodes);
     REQUIRE(cell->nneighbours() == 0);
-    cell->add_neighbour(0, neighbourcell);
+    cell->add_neighbour(0, neighbourcell.get());
     REQUIRE(cell->nneighbours() == 1);
   }
 
@@ -93,6 +94,166 @@ TEST_CASE("Cell is checked for 2D case", "[cell][2D]") {
     cell->remove_particle_id(pid);
     REQUIRE(cell->status() == false);
   }
+
+  SECTION("Check point in cell and shape functions") {
+    const double Tolerance = 1.E-7;
+    auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+    auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, shapefn);
+    // Cell is not initialised without nodes
+    REQUIRE(cell->initialise() == false);
+
+    // Nodes in counter-clockwise order
+    cell->add_node(0, node0.get());
+    cell->add_node(1, node3.get());
+    cell->add_node(2, node2.get());
+    cell->add_node(3, node1.get());
+    REQUIRE(cell->initialise() == true);
+
+    Eigen::Vector2d point(0.25, 0.75);
+    REQUIRE(cell->point_in_cell(point) == true);
+    auto xi = cell->transform_real_to_unit_cell(point);
+    REQUIRE(xi(0) == Approx(-0.5).epsilon(Tolerance));
+    REQUIRE(xi(1) == Approx(0.5).epsilon(Tolerance));
+
+    // Shape functions sum to one, gradients to zero
+    auto shapefns = cell->compute_shapefn(xi);
+    REQUIRE(shapefns.size() == Nnodes);
+    REQUIRE(shapefns.sum() == Approx(1.).epsilon(Tolerance));
+    auto grad_shapefns = cell->compute_grad_shapefn(xi);
+    REQUIRE(grad_shapefns.rows() == Nnodes);
+    REQUIRE(grad_shapefns.cols() == Dim);
+    REQUIRE(grad_shapefns(0, 0) == Approx(-0.25).epsilon(Tolerance));
+    REQUIRE(grad_shapefns.col(0).sum() == Approx(0.).epsilon(Tolerance));
+    REQUIRE(grad_shapefns.col(1).sum() == Approx(0.).epsilon(Tolerance));
+
+    point << 1.5, 0.5;
+    REQUIRE(cell->point_in_cell(point) == false);
+  }
+
+  SECTION("Check cell-centric transfers") {
+    const double Tolerance = 1.E-7;
+    auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+    auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, shapefn);
+    cell->add_node(0, node0.get());
+    cell->add_node(1, node3.get());
+    cell->add_node(2, node2.get());
+    cell->add_node(3, node1.get());
+    REQUIRE(cell->initialise() == true);
+
+    // Particles in cell
+    std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    for (unsigned i = 0; i < 3; ++i) {
+      Eigen::Vector2d pcoords(0.2 + 0.3 * i, 0.7 - 0.2 * i);
+      auto particle = std::make_shared<mpm::Particle<Dim>>(i, pcoords);
+      particle->assign_mass(1. + i);
+      particle->assign_volume(0.5);
+      particle->assign_velocity(Eigen::Vector2d(1. + i, -2. * i));
+      Eigen::Matrix<double, 6, 1> stress;
+      stress << 10. * i, -5., 0., 2. + i, 0., 0.;
+      particle->assign_stress(stress);
+      REQUIRE(particle->assign_cell(cell.get()) == true);
+      REQUIRE(particle->compute_reference_location() == true);
+      REQUIRE(particle->compute_shapefn() == true);
+      particles.emplace_back(particle);
+    }
+    // Cells refer to particles without ownership
+    std::vector<mpm::Particle<Dim>*> located;
+    for (const auto& particle : particles) located.emplace_back(particle.get());
+    const Eigen::Vector2d gravity(0., -10.);
+
+    // Reference from the shape functions of particles
+    std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes = {node0, node3, node2,
+                                                          node1};
+    std::vector<double> mass(Nnodes, 0.);
+    std::vector<Eigen::VectorXd> momentum(Nnodes, Eigen::VectorXd::Zero(Dim));
+    std::vector<Eigen::VectorXd> force(Nnodes, Eigen::VectorXd::Zero(Dim));
+    for (const auto& particle : particles) {
+      const auto& shapefn = particle->shapefn();
+      const auto& grad_shapefn = particle->grad_shapefn();
+      const auto& stress = particle->stress();
+      for (unsigned i = 0; i < Nnodes; ++i) {
+        mass[i] += shapefn(i) * particle->mass();
+        momentum[i] += shapefn(i) * particle->mass() * particle->velocity();
+        force[i] += shapefn(i) * particle->mass() * gravity;
+        force[i](0) -= particle->volume() * (grad_shapefn(i, 0) * stress(0) +
+                                             grad_shapefn(i, 1) * stress(3));
+        force[i](1) -= particle->volume() * (grad_shapefn(i, 0) * stress(3) +
+                                             grad_shapefn(i, 1) * stress(1));
+      }
+    }
+
+    // Cell-centric transfer
+    for (const auto& node : nodes) {
+      node->initialise();
+      node->update_mass(false, 0.);
+    }
+    cell->map_mass_momentum_forces_to_nodes(located, gravity);
+    for (unsigned i = 0; i < nodes.size(); ++i) {
+      REQUIRE(nodes[i]->mass() == Approx(mass[i]).epsilon(Tolerance));
+      for (unsigned j = 0; j < Dim; ++j) {
+        REQUIRE(nodes[i]->momentum()(j) ==
+                Approx(momentum[i](j)).epsilon(Tolerance));
+        REQUIRE(nodes[i]->force()(j) == Approx(force[i](j)).epsilon(Tolerance));
+      }
+    }
+
+    // Separate passes give the same result
+    for (const auto& node : nodes) {
+      node->initialise();
+      node->update_mass(false, 0.);
+    }
+    cell->map_mass_momentum_to_nodes(located);
+    cell->map_forces_to_nodes(located, gravity);
+    for (unsigned i = 0; i < nodes.size(); ++i) {
+      REQUIRE(nodes[i]->mass() == Approx(mass[i]).epsilon(Tolerance));
+      for (unsigned j = 0; j < Dim; ++j)
+        REQUIRE(nodes[i]->force()(j) == Approx(force[i](j)).epsilon(Tolerance));
+    }
+
+    // Particles map through the kernels of their cell
+    for (const auto& node : nodes) {
+      node->initialise();
+      node->update_mass(false, 0.);
+    }
+    for (const auto& particle : particles) {
+      particle->map_mass_momentum_to_nodes();
+      particle->map_forces(gravity);
+    }
+    for (unsigned i = 0; i < nodes.size(); ++i) {
+      REQUIRE(nodes[i]->mass() == Approx(mass[i]).epsilon(Tolerance));
+      for (unsigned j = 0; j < Dim; ++j) {
+        REQUIRE(nodes[i]->momentum()(j) ==
+                Approx(momentum[i](j)).epsilon(Tolerance));
+        REQUIRE(nodes[i]->force()(j) == Approx(force[i](j)).epsilon(Tolerance));
+      }
+    }
+
+    // Grid to particle: strain rate and kinematics match interpolation
+    for (const auto& node : nodes) node->compute_velocity();
+    for (const auto& node : nodes) node->compute_acceleration_velocity(0.1);
+    Eigen::Matrix<double, 6, 1> strain_rate =
+        Eigen::Matrix<double, 6, 1>::Zero();
+    Eigen::Vector2d velocity = Eigen::Vector2d::Zero();
+    const auto& shapefn1 = particles[1]->shapefn();
+    const auto& grad_shapefn1 = particles[1]->grad_shapefn();
+    for (unsigned i = 0; i < Nnodes; ++i) {
+      const Eigen::VectorXd nvelocity = nodes[i]->velocity();
+      velocity += shapefn1(i) * nvelocity.head(Dim);
+      strain_rate(0) += grad_shapefn1(i, 0) * nvelocity(0);
+      strain_rate(1) += grad_shapefn1(i, 1) * nvelocity(1);
+      strain_rate(3) += grad_shapefn1(i, 1) * nvelocity(0) +
+                        grad_shapefn1(i, 0) * nvelocity(1);
+    }
+    const auto coordinates = particles[1]->coordinates();
+    cell->compute_particles_strain(located, 1.);
+    cell->update_particles_velocity_position(located, 1.);
+    for (unsigned j = 0; j < 6; ++j)
+      REQUIRE(particles[1]->strain()(j) ==
+              Approx(strain_rate(j)).epsilon(Tolerance));
+    for (unsigned j = 0; j < Dim; ++j)
+      REQUIRE(particles[1]->coordinates()(j) ==
+              Approx(coordinates(j) + velocity(j)).epsilon(Tolerance));
+  }
 }
 
 //! \brief Check cell class for 3D case
@@ -152,14 +313,14 @@ TEST_CASE("Cell is checked for 3D case", "[cell][3D]") {
   SECTION("Add nodes") {
     mpm::Index id = 0;
     auto cell = std::make_shared<mpm::Cell<Dim>>(id, Nnodes);
-    cell->add_node(0, node0);
-    cell->add_node(1, node1);
-    cell->add_node(2, node2);
-    cell->add_node(3, node3);
-    cell->add_node(4, node4);
-    cell->add_node(5, node5);
-    cell->add_node(6, node6);
-    cell->add_node(7, node7);
+    cell->add_node(0, node0.get());
+    cell->add_node(1, node1.get());
+    cell->add_node(2, node2.get());
+    cell->add_node(3, node3.get());
+    cell->add_node(4, node4.get());
+    cell->add_node(5, node5.get());
+    cell->add_node(6, node6.get());
+    cell->add_node(7, node7.get());
     REQUIRE(cell->nnodes() == 8);
   }
 
@@ -167,7 +328,7 @@ TEST_CASE("Cell is checked for 3D case", "[cell][3D]") {
     auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes);
     auto neighbourcell = std::make_shared<mpm::Cell<Dim>>(1, Nnodes);
     REQUIRE(cell->nneighbours() == 0);
-    cell->add_neighbour(0, neighbourcell);
+    cell->add_neighbour(0, neighbourcell.get());
     REQUIRE(cell->nneighbours() == 1);
   }
 
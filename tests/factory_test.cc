@@ -0,0 +1,153 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "factory.h"
+#include "material/linear_elastic.h"
+
+namespace {
+//! Base class of the factory test
+class Shape {
+ public:
+  //! Constructor with size
+  Shape(int size) : size_{size} {}
+
+  //! Destructor
+  virtual ~Shape() { ++ndestroyed; }
+
+  //! Return the number of sides
+  virtual unsigned nsides() const = 0;
+
+  //! Return size
+  int size() const { return size_; }
+
+  //! Number of destroyed instances
+  static unsigned ndestroyed;
+
+ private:
+  //! Size
+  int size_;
+};
+
+unsigned Shape::ndestroyed = 0;
+
+//! Triangle
+class Triangle : public Shape {
+ public:
+  Triangle(int size) : Shape(size) {}
+  unsigned nsides() const { return 3; }
+};
+
+//! Square
+class Square : public Shape {
+ public:
+  Square(int size) : Shape(size) {}
+  unsigned nsides() const { return 4; }
+};
+
+static Register<Shape, Triangle, int> triangle("Triangle");
+static Register<Shape, Square, int> square("Square");
+}  // namespace
+
+//! \brief Check factory
+TEST_CASE("Factory is checked", "[factory]") {
+  auto factory = Factory<Shape, int>::instance();
+
+  SECTION("Check creation by key and handle") {
+    auto shape = factory->create("Triangle", 2);
+    REQUIRE(shape->nsides() == 3);
+    REQUIRE(shape->size() == 2);
+    REQUIRE_THROWS(factory->create("Circle", 2));
+    REQUIRE_THROWS(factory->handle("Circle"));
+
+    auto handle = factory->handle("Square");
+    shape = factory->create(handle, 3);
+    REQUIRE(shape->nsides() == 4);
+    REQUIRE(shape->size() == 3);
+
+    // Handle stays valid if the key is registered again
+    factory->register_factory<Triangle>("Square");
+    REQUIRE(factory->create(handle, 3)->nsides() == 4);
+    REQUIRE(factory->create("Square", 3)->nsides() == 3);
+    factory->register_factory<Square>("Square");
+  }
+
+  SECTION("Check creation in bulk") {
+    auto handle = factory->handle("Square");
+    std::vector<std::shared_ptr<Shape>> shapes;
+    shapes.emplace_back(factory->create("Triangle", 1));
+    factory->create_n(handle, 4, shapes, 5);
+    REQUIRE(shapes.size() == 5);
+    REQUIRE(shapes.capacity() >= 5);
+    for (unsigned i = 1; i < 5; ++i) {
+      REQUIRE(shapes[i]->nsides() == 4);
+      REQUIRE(shapes[i]->size() == 5);
+      // Instances are contiguous
+      REQUIRE(reinterpret_cast<const char*>(shapes[i].get()) -
+                  reinterpret_cast<const char*>(shapes[1].get()) ==
+              static_cast<long>((i - 1) * sizeof(Square)));
+    }
+    factory->create_n(handle, 0, shapes, 5);
+    REQUIRE(shapes.size() == 5);
+
+    // Storage is freed with the last instance
+    const unsigned ndestroyed = Shape::ndestroyed;
+    shapes.resize(4);
+    shapes.erase(shapes.begin() + 1, shapes.begin() + 3);
+    REQUIRE(Shape::ndestroyed == ndestroyed);
+    shapes.clear();
+    REQUIRE(Shape::ndestroyed == ndestroyed + 5);
+  }
+
+  SECTION("Check materials created in bulk") {
+    auto materials = Factory<mpm::Material, unsigned>::instance();
+    std::vector<std::shared_ptr<mpm::Material>> objects;
+    materials->create_n(materials->handle("LinearElastic"), 3, objects, 7);
+    REQUIRE(objects.size() == 3);
+    for (const auto& material : objects) REQUIRE(material->id() == 7);
+  }
+}
+
+//! \brief Benchmark creation of materials, run with [benchmark]
+TEST_CASE("Factory creation throughput", "[.][benchmark][factory]") {
+  const unsigned n = 1000000;
+  auto factory = Factory<mpm::Material, unsigned>::instance();
+  std::vector<std::shared_ptr<mpm::Material>> objects;
+
+  // Lookup of the key and an allocation per instance
+  objects.reserve(n);
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    unsigned id = i;
+    objects.emplace_back(factory->create("LinearElastic", std::move(id)));
+  }
+  const std::chrono::duration<double> key =
+      std::chrono::steady_clock::now() - start;
+  objects.clear();
+
+  // Handle without lookup
+  auto handle = factory->handle("LinearElastic");
+  start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    unsigned id = i;
+    objects.emplace_back(factory->create(handle, std::move(id)));
+  }
+  const std::chrono::duration<double> single =
+      std::chrono::steady_clock::now() - start;
+  objects.clear();
+  objects.shrink_to_fit();
+
+  // Single allocation
+  start = std::chrono::steady_clock::now();
+  factory->create_n(handle, n, objects, 0);
+  const std::chrono::duration<double> bulk =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << "Factory creation: key " << n / key.count() / 1.E6
+            << " M/s, handle " << n / single.count() / 1.E6
+            << " M/s, bulk " << n / bulk.count() / 1.E6 << " M/s\n";
+}
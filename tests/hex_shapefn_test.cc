@@ -761,4 +761,27 @@ TEST_CASE("Hexahedron shape functions are checked",
       REQUIRE(gradsf(19, 2) == Approx(0.28125).epsilon(Tolerance));
     }
   }
+
+  //! Check shape functions evaluated in single precision
+  SECTION("Hexahedron shape functions of floats") {
+    Eigen::Matrix<double, Dim, 1> xi;
+    xi << 0.3, -0.7, 0.5;
+    for (const unsigned nfunctions : {8, 20}) {
+      auto sf = std::make_shared<mpm::HexahedronShapeFn<Dim>>(nfunctions);
+      auto fsf =
+          std::make_shared<mpm::HexahedronShapeFn<Dim, float>>(nfunctions);
+      const Eigen::MatrixXd shapefn = sf->shapefn(xi);
+      const Eigen::MatrixXf fshapefn = fsf->shapefn(xi.cast<float>());
+      const Eigen::MatrixXd gradsf = sf->grad_shapefn(xi);
+      const Eigen::MatrixXf fgradsf = fsf->grad_shapefn(xi.cast<float>());
+      REQUIRE(fshapefn.rows() == nfunctions);
+      REQUIRE(fgradsf.rows() == nfunctions);
+      REQUIRE(fgradsf.cols() == Dim);
+
+      // Partition of unity holds in single precision
+      REQUIRE(fshapefn.sum() == Approx(1.).epsilon(1.E-6));
+      REQUIRE(fshapefn.cast<double>().isApprox(shapefn, 1.E-6));
+      REQUIRE(fgradsf.cast<double>().isApprox(gradsf, 1.E-6));
+    }
+  }
 }
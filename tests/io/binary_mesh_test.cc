@@ -0,0 +1,183 @@
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+
+#include "io/binary_mesh.h"
+#include "mesh.h"
+
+//! \brief Check binary mesh for 2D case
+TEST_CASE("Binary mesh is checked for 2D case", "[io][binary][2D]") {
+  const unsigned Dim = 2;
+  const double Tolerance = 1.E-12;
+  const std::string filename = "binary_mesh_test_2d.bin";
+
+  // Two unit quad4 cells with nodes added in reverse order
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+  for (unsigned i = 0; i < 6; ++i) {
+    const mpm::Index id = 5 - i;
+    const Eigen::Vector2d coordinates(id % 3, id / 3);
+    nodes.emplace_back(
+        std::make_shared<mpm::Node<Dim>>(10 + id, coordinates, Dim));
+  }
+  REQUIRE(mesh->add_nodes(nodes) == true);
+  const unsigned connectivity[2][4] = {{0, 1, 4, 3}, {1, 2, 5, 4}};
+  for (unsigned c = 0; c < 2; ++c) {
+    auto cell = std::make_shared<mpm::Cell<Dim>>(
+        c, 4, std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(4));
+    for (unsigned j = 0; j < 4; ++j)
+      cell->add_node(j, nodes[5 - connectivity[c][j]].get());
+    cell->initialise();
+    REQUIRE(mesh->add_cell(cell) == true);
+  }
+  for (unsigned i = 0; i < 3; ++i) {
+    auto particle = std::make_shared<mpm::Particle<Dim>>(
+        100 + i, Eigen::Vector2d(0.25 + 0.5 * i, 0.5));
+    particle->assign_mass(1. + i);
+    particle->assign_volume(0.1 * i);
+    REQUIRE(mesh->add_particle(particle) == true);
+  }
+
+  REQUIRE(mpm::BinaryMesh<Dim>::write(filename, mesh) == true);
+
+  SECTION("Check columns and mesh") {
+    mpm::BinaryMesh<Dim> binary;
+    REQUIRE(binary.read(filename) == true);
+    REQUIRE(binary.nnodes() == 6);
+    REQUIRE(binary.ncells() == 2);
+    REQUIRE(binary.nnodes_cell() == 4);
+    REQUIRE(binary.nparticles() == 3);
+
+    // Columns are sorted by id and aligned
+    for (unsigned i = 0; i < 6; ++i) {
+      REQUIRE(binary.node_ids()[i] == 10 + i);
+      REQUIRE(binary.node_coordinates()[2 * i] ==
+              Approx(i % 3).epsilon(Tolerance));
+    }
+    REQUIRE(reinterpret_cast<std::uintptr_t>(binary.node_coordinates()) %
+                mpm::BinaryMesh<Dim>::alignment ==
+            0);
+    REQUIRE(binary.cell_nodes()[4 + 2] == 15);
+    REQUIRE(binary.particle_mass()[2] == Approx(3.).epsilon(Tolerance));
+    REQUIRE(binary.particle_volume()[1] == Approx(0.1).epsilon(Tolerance));
+
+    auto copy = std::make_shared<mpm::Mesh<Dim>>(1);
+    REQUIRE(binary.create_mesh(copy) == true);
+    REQUIRE(copy->nnodes() == 6);
+    REQUIRE(copy->ncells() == 2);
+    REQUIRE(copy->nparticles() == 3);
+    tbb::concurrent_vector<std::shared_ptr<mpm::Cell<Dim>>> cells;
+    copy->iterate_over_cells([&cells](std::shared_ptr<mpm::Cell<Dim>> cell) {
+      cells.push_back(cell);
+    });
+    REQUIRE(cells.size() == 2);
+    for (const auto& cell : cells) {
+      const double x = 0.5 + cell->id();
+      REQUIRE(cell->point_in_cell(Eigen::Vector2d(x, 0.5)));
+      REQUIRE(!cell->point_in_cell(Eigen::Vector2d(x + 1., 0.5)));
+    }
+    tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    copy->iterate_over_particles(
+        [&particles](std::shared_ptr<mpm::Particle<Dim>> particle) {
+          particles.push_back(particle);
+        });
+    REQUIRE(particles.size() == 3);
+    for (const auto& particle : particles) {
+      const unsigned i = particle->id() - 100;
+      REQUIRE(particle->coordinates()(0) ==
+              Approx(0.25 + 0.5 * i).epsilon(Tolerance));
+      REQUIRE(particle->mass() == Approx(1. + i).epsilon(Tolerance));
+    }
+    REQUIRE(copy->locate_particles_mesh() == true);
+
+    // Elements exist in the mesh
+    REQUIRE(binary.create_mesh(copy) == false);
+  }
+
+  SECTION("Check invalid files") {
+    mpm::BinaryMesh<Dim> binary;
+    REQUIRE(binary.read("binary_mesh_test_missing.bin") == false);
+    REQUIRE(binary.create_mesh(mesh) == false);
+
+    // Different dimension
+    mpm::BinaryMesh<3> binary3d;
+    REQUIRE(binary3d.read(filename) == false);
+
+    // Truncated file
+    std::string content;
+    {
+      std::ifstream file(filename, std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file.write(content.data(), content.size() - 16);
+    }
+    REQUIRE(binary.read(filename) == false);
+    REQUIRE(binary.nnodes() == 0);
+
+    // Invalid magic
+    content[0] = 'X';
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file.write(content.data(), content.size());
+    }
+    REQUIRE(binary.read(filename) == false);
+  }
+
+  std::remove(filename.c_str());
+}
+
+//! \brief Check binary mesh for 3D case
+TEST_CASE("Binary mesh is checked for 3D case", "[io][binary][3D]") {
+  const unsigned Dim = 3;
+  const std::string filename = "binary_mesh_test_3d.bin";
+
+  // Unit hexahedron without particles
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  auto cell = std::make_shared<mpm::Cell<Dim>>(
+      7, 8, std::make_shared<mpm::HexahedronShapeFn<Dim>>(8));
+  const double coordinates[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0},
+                                    {0, 1, 0}, {0, 0, 1}, {1, 0, 1},
+                                    {1, 1, 1}, {0, 1, 1}};
+  for (unsigned i = 0; i < 8; ++i) {
+    auto node = std::make_shared<mpm::Node<Dim>>(
+        i, Eigen::Vector3d(coordinates[i][0], coordinates[i][1],
+                           coordinates[i][2]),
+        Dim);
+    REQUIRE(mesh->add_node(node) == true);
+    cell->add_node(i, node.get());
+  }
+  cell->initialise();
+  REQUIRE(mesh->add_cell(cell) == true);
+
+  REQUIRE(mpm::BinaryMesh<Dim>::write(filename, mesh) == true);
+
+  mpm::BinaryMesh<Dim> binary;
+  REQUIRE(binary.read(filename) == true);
+  REQUIRE(binary.nparticles() == 0);
+
+  auto copy = std::make_shared<mpm::Mesh<Dim>>(1);
+  REQUIRE(binary.create_mesh(copy, 6) == true);
+  REQUIRE(copy->nnodes() == 8);
+  REQUIRE(copy->ncells() == 1);
+  tbb::concurrent_vector<std::shared_ptr<mpm::Cell<Dim>>> cells;
+  copy->iterate_over_cells([&cells](std::shared_ptr<mpm::Cell<Dim>> cell) {
+    cells.push_back(cell);
+  });
+  REQUIRE(cells.size() == 1);
+  REQUIRE(cells[0]->id() == 7);
+  REQUIRE(cells[0]->point_in_cell(Eigen::Vector3d(0.5, 0.5, 0.5)));
+  REQUIRE(!cells[0]->point_in_cell(Eigen::Vector3d(0.5, 0.5, 1.5)));
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,277 @@
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "serialize.h"
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+#include "factory.h"
+#include "io/checkpoint.h"
+#include "material/linear_elastic.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+#include "solvers/mpm_explicit.h"
+
+//! \brief Create a 2 x 2 quadrilateral mesh with 4 particles per cell
+//! \param[in] material Material assigned to particles
+static std::shared_ptr<mpm::Mesh<2>> create_checkpoint_mesh(
+    const std::shared_ptr<mpm::Material>& material) {
+  const unsigned Dim = 2;
+  const unsigned Nnodes = 4;
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+
+  std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+  for (unsigned j = 0; j < 3; ++j)
+    for (unsigned i = 0; i < 3; ++i) {
+      Eigen::Vector2d coords(i, j);
+      auto node = std::make_shared<mpm::Node<Dim>>(nodes.size(), coords, Dim);
+      // Fixed base
+      if (j == 0) node->assign_velocity_constraint(1, 0.);
+      nodes.emplace_back(node);
+      mesh->add_node(node);
+    }
+
+  for (unsigned j = 0; j < 2; ++j)
+    for (unsigned i = 0; i < 2; ++i) {
+      auto cell = std::make_shared<mpm::Cell<Dim>>(j * 2 + i, Nnodes, shapefn);
+      cell->add_node(0, nodes.at(j * 3 + i).get());
+      cell->add_node(1, nodes.at(j * 3 + i + 1).get());
+      cell->add_node(2, nodes.at((j + 1) * 3 + i + 1).get());
+      cell->add_node(3, nodes.at((j + 1) * 3 + i).get());
+      cell->initialise();
+      mesh->add_cell(cell);
+    }
+
+  mpm::Index id = 0;
+  for (unsigned j = 0; j < 4; ++j)
+    for (unsigned i = 0; i < 4; ++i) {
+      Eigen::Vector2d coords(0.25 + 0.5 * i, 0.25 + 0.5 * j);
+      auto particle = std::make_shared<mpm::Particle<Dim>>(id++, coords);
+      particle->assign_volume(0.25);
+      particle->assign_mass(250.);
+      particle->assign_material(material.get());
+      mesh->add_particle(particle);
+    }
+  return mesh;
+}
+
+//! \brief Check checkpoint and restart for 2D case
+TEST_CASE("Checkpoint is checked for 2D case", "[io][checkpoint][2D]") {
+  const unsigned Dim = 2;
+  const double Tolerance = 1.E-12;
+  const std::string filename = "checkpoint_test_2d.ckpt";
+
+  // Material
+  unsigned material_id = 3;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(material_id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  material->elastic_tensor();
+  const std::map<unsigned, std::shared_ptr<mpm::Material>> materials{
+      {3, material}};
+
+  const double dt = 1.E-3;
+  const Eigen::Vector2d gravity(0., -10.);
+
+  SECTION("Check state of mesh") {
+    auto mesh = create_checkpoint_mesh(material);
+    mpm::MPMExplicit<Dim> solver(mesh, dt);
+    solver.gravity(gravity);
+    REQUIRE(solver.solve(5) == true);
+
+    // Small chunks to split elements across several chunks
+    REQUIRE(mpm::Checkpoint<Dim>(3).write(filename, mesh, solver.step()) ==
+            true);
+
+    mpm::Checkpoint<Dim> checkpoint;
+    REQUIRE(checkpoint.read(filename) == true);
+    REQUIRE(checkpoint.step() == 5);
+    REQUIRE(checkpoint.nnodes() == 9);
+    REQUIRE(checkpoint.ncells() == 4);
+    REQUIRE(checkpoint.nparticles() == 16);
+
+    auto copy = std::make_shared<mpm::Mesh<Dim>>(1);
+    REQUIRE(checkpoint.create_mesh(copy, materials) == true);
+    REQUIRE(copy->nnodes() == 9);
+    REQUIRE(copy->ncells() == 4);
+    REQUIRE(copy->nparticles() == 16);
+
+    // Particles
+    std::map<mpm::Index, std::shared_ptr<mpm::Particle<Dim>>> originals;
+    std::mutex mutex;
+    mesh->iterate_over_particles(
+        [&](std::shared_ptr<mpm::Particle<Dim>> particle) {
+          std::lock_guard<std::mutex> lock(mutex);
+          originals[particle->id()] = particle;
+        });
+    std::map<mpm::Index, std::shared_ptr<mpm::Particle<Dim>>> restored;
+    copy->iterate_over_particles(
+        [&](std::shared_ptr<mpm::Particle<Dim>> particle) {
+          std::lock_guard<std::mutex> lock(mutex);
+          restored[particle->id()] = particle;
+        });
+    REQUIRE(restored.size() == 16);
+    for (const auto& original : originals) {
+      const auto particle = restored.at(original.first);
+      REQUIRE(particle->material() == material.get());
+      REQUIRE(particle->mass() ==
+              Approx(original.second->mass()).epsilon(Tolerance));
+      REQUIRE(particle->volume() ==
+              Approx(original.second->volume()).epsilon(Tolerance));
+      for (unsigned i = 0; i < Dim; ++i) {
+        REQUIRE(particle->coordinates()(i) ==
+                original.second->coordinates()(i));
+        REQUIRE(particle->velocity()(i) == original.second->velocity()(i));
+      }
+      for (unsigned i = 0; i < 6; ++i) {
+        REQUIRE(particle->stress()(i) == original.second->stress()(i));
+        REQUIRE(particle->strain()(i) == original.second->strain()(i));
+      }
+    }
+
+    // Nodes keep kinematics and velocity constraints
+    std::map<mpm::Index, std::shared_ptr<mpm::Node<Dim>>> nodes;
+    mesh->iterate_over_nodes([&](std::shared_ptr<mpm::Node<Dim>> node) {
+      std::lock_guard<std::mutex> lock(mutex);
+      nodes[node->id()] = node;
+    });
+    std::map<mpm::Index, std::shared_ptr<mpm::Node<Dim>>> restored_nodes;
+    copy->iterate_over_nodes([&](std::shared_ptr<mpm::Node<Dim>> node) {
+      std::lock_guard<std::mutex> lock(mutex);
+      restored_nodes[node->id()] = node;
+    });
+    REQUIRE(restored_nodes.size() == nodes.size());
+    for (const auto& restored_node : restored_nodes) {
+      const auto& node = restored_node.second;
+      const auto original = nodes.at(node->id());
+      REQUIRE(node->coordinates()(0) == original->coordinates()(0));
+      REQUIRE(node->mass() == original->mass());
+      REQUIRE(node->velocity()(1) == original->velocity()(1));
+      node->assign_velocity(Eigen::Vector2d(1., 1.));
+      node->apply_velocity_constraints();
+      REQUIRE(node->velocity()(1) == Approx(original->id() < 3 ? 0. : 1.));
+    }
+
+    // Cells reference restored nodes
+    std::map<mpm::Index, std::shared_ptr<mpm::Cell<Dim>>> cells;
+    copy->iterate_over_cells([&](std::shared_ptr<mpm::Cell<Dim>> cell) {
+      std::lock_guard<std::mutex> lock(mutex);
+      cells[cell->id()] = cell;
+    });
+    REQUIRE(cells.size() == 4);
+    for (const auto& cell : cells) {
+      const double x = 0.5 + cell.first % 2;
+      const double y = 0.5 + cell.first / 2;
+      REQUIRE(cell.second->point_in_cell(Eigen::Vector2d(x, y)));
+    }
+
+    // Elements exist in the mesh
+    REQUIRE(checkpoint.create_mesh(copy, materials) == false);
+  }
+
+  SECTION("Check restart continuity") {
+    const unsigned nsteps = 10;
+    auto mesh = create_checkpoint_mesh(material);
+    mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::MUSL);
+    solver.gravity(gravity);
+    REQUIRE(solver.solve(nsteps) == true);
+    REQUIRE(solver.checkpoint(filename) == true);
+    REQUIRE(solver.solve(nsteps) == true);
+
+    mpm::Checkpoint<Dim> checkpoint;
+    REQUIRE(checkpoint.read(filename) == true);
+    auto restart = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(checkpoint.create_mesh(restart, materials) == true);
+    mpm::MPMExplicit<Dim> restarted(restart, dt, mpm::StressUpdate::MUSL);
+    restarted.gravity(gravity);
+    restarted.step(checkpoint.step());
+    REQUIRE(restarted.solve(nsteps) == true);
+    REQUIRE(restarted.step() == solver.step());
+
+    std::map<mpm::Index, std::shared_ptr<mpm::Particle<Dim>>> particles;
+    std::mutex mutex;
+    mesh->iterate_over_particles(
+        [&](std::shared_ptr<mpm::Particle<Dim>> particle) {
+          std::lock_guard<std::mutex> lock(mutex);
+          particles[particle->id()] = particle;
+        });
+    std::map<mpm::Index, std::shared_ptr<mpm::Particle<Dim>>> restored;
+    restart->iterate_over_particles(
+        [&](std::shared_ptr<mpm::Particle<Dim>> particle) {
+          std::lock_guard<std::mutex> lock(mutex);
+          restored[particle->id()] = particle;
+        });
+    REQUIRE(restored.size() == particles.size());
+    for (const auto& restored_particle : restored) {
+      const auto& particle = restored_particle.second;
+      const auto original = particles.at(particle->id());
+      for (unsigned i = 0; i < Dim; ++i) {
+        REQUIRE(particle->coordinates()(i) ==
+                Approx(original->coordinates()(i)).epsilon(Tolerance));
+        REQUIRE(particle->velocity()(i) ==
+                Approx(original->velocity()(i)).epsilon(Tolerance));
+      }
+      REQUIRE(particle->stress()(1) ==
+              Approx(original->stress()(1)).epsilon(1.E-9));
+    }
+  }
+
+  SECTION("Check invalid checkpoints") {
+    auto mesh = create_checkpoint_mesh(material);
+    REQUIRE(mpm::Checkpoint<Dim>().write(filename, mesh, 7) == true);
+
+    mpm::Checkpoint<Dim> checkpoint;
+    REQUIRE(checkpoint.read("checkpoint_test_missing.ckpt") == false);
+    auto copy = std::make_shared<mpm::Mesh<Dim>>(1);
+    REQUIRE(checkpoint.create_mesh(copy, materials) == false);
+    REQUIRE(checkpoint.create_particles(copy, materials) == false);
+
+    // Different dimension
+    mpm::Checkpoint<3> checkpoint3d;
+    REQUIRE(checkpoint3d.read(filename) == false);
+
+    // Material is not defined
+    REQUIRE(checkpoint.read(filename) == true);
+    REQUIRE(checkpoint.step() == 7);
+    const std::map<unsigned, std::shared_ptr<mpm::Material>> none;
+    REQUIRE(checkpoint.create_particles(copy, none) == false);
+    REQUIRE(copy->nparticles() == 0);
+    REQUIRE(checkpoint.create_particles(copy, materials) == true);
+    REQUIRE(copy->nparticles() == 16);
+
+    // Truncated file
+    std::string content;
+    {
+      std::ifstream file(filename, std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file.write(content.data(), content.size() - 16);
+    }
+    REQUIRE(checkpoint.read(filename) == false);
+    REQUIRE(checkpoint.nparticles() == 0);
+
+    // Invalid magic
+    content[0] = 'X';
+    {
+      std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+      file.write(content.data(), content.size());
+    }
+    REQUIRE(checkpoint.read(filename) == false);
+  }
+
+  std::remove(filename.c_str());
+}
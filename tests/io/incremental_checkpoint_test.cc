@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "serialize.h"
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+#include "factory.h"
+#include "io/checkpoint.h"
+#include "io/incremental_checkpoint.h"
+#include "material/linear_elastic.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+#include "solvers/mpm_explicit.h"
+
+//! \brief Read a file
+//! \param[in] filename Name of the file
+static std::string read_checkpoint_file(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+//! \brief Create a quadrilateral mesh of ncells x ncells with 4 particles
+//! per cell in its lower half
+//! \param[in] ncells Number of cells in each direction
+//! \param[in] material Material assigned to particles
+static std::shared_ptr<mpm::Mesh<2>> create_incremental_mesh(
+    unsigned ncells, const std::shared_ptr<mpm::Material>& material) {
+  const unsigned Dim = 2;
+  const unsigned Nnodes = 4;
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+
+  std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+  for (unsigned j = 0; j <= ncells; ++j)
+    for (unsigned i = 0; i <= ncells; ++i) {
+      auto node = std::make_shared<mpm::Node<Dim>>(
+          nodes.size(), Eigen::Vector2d(i, j), Dim);
+      // Fixed base
+      if (j == 0) node->assign_velocity_constraint(1, 0.);
+      nodes.emplace_back(node);
+      mesh->add_node(node);
+    }
+
+  const unsigned n = ncells + 1;
+  for (unsigned j = 0; j < ncells; ++j)
+    for (unsigned i = 0; i < ncells; ++i) {
+      auto cell =
+          std::make_shared<mpm::Cell<Dim>>(j * ncells + i, Nnodes, shapefn);
+      cell->add_node(0, nodes.at(j * n + i).get());
+      cell->add_node(1, nodes.at(j * n + i + 1).get());
+      cell->add_node(2, nodes.at((j + 1) * n + i + 1).get());
+      cell->add_node(3, nodes.at((j + 1) * n + i).get());
+      cell->initialise();
+      mesh->add_cell(cell);
+    }
+
+  mpm::Index id = 0;
+  for (unsigned j = 0; j < ncells; ++j)
+    for (unsigned i = 0; i < 2 * ncells; ++i) {
+      Eigen::Vector2d coords(0.25 + 0.5 * i, 0.25 + 0.5 * j);
+      auto particle = std::make_shared<mpm::Particle<Dim>>(id++, coords);
+      particle->assign_volume(0.25);
+      particle->assign_mass(250.);
+      particle->assign_material(material.get());
+      mesh->add_particle(particle);
+    }
+  return mesh;
+}
+
+//! \brief Check incremental checkpoints for 2D case
+TEST_CASE("Incremental checkpoint is checked for 2D case",
+          "[io][checkpoint][2D]") {
+  const unsigned Dim = 2;
+
+  // Material
+  unsigned material_id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(material_id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  material->elastic_tensor();
+
+  auto mesh = create_incremental_mesh(16, material);
+  mpm::MPMExplicit<Dim> solver(mesh, 1.E-3);
+  solver.gravity(Eigen::Vector2d(0., -10.));
+
+  SECTION("Check bases, deltas and reconstruction") {
+    const unsigned ncheckpoints = 8;
+    // A base every 4 checkpoints and small blocks
+    mpm::IncrementalCheckpoint<Dim> incremental(4, 1, 1024);
+    for (unsigned i = 0; i < ncheckpoints; ++i) {
+      const std::string filename =
+          "incremental_checkpoint_test_" + std::to_string(i) + ".ckpt";
+      REQUIRE(solver.solve(1) == true);
+      REQUIRE(incremental.write(filename, mesh, solver.step()) == true);
+      REQUIRE(incremental.base() == (i % 4 == 0));
+      REQUIRE(mpm::Checkpoint<Dim>().write("incremental_checkpoint_test.ckpt",
+                                            mesh, solver.step()) == true);
+      const std::string full =
+          read_checkpoint_file("incremental_checkpoint_test.ckpt");
+      if (!incremental.base())
+        REQUIRE(read_checkpoint_file(filename).size() < full.size() / 2);
+
+      // Reconstructed checkpoints are identical to full checkpoints
+      REQUIRE(mpm::IncrementalCheckpoint<Dim>::reconstruct(
+                  filename, "incremental_checkpoint_test_full.ckpt") == true);
+      REQUIRE(read_checkpoint_file("incremental_checkpoint_test_full.ckpt") ==
+              full);
+    }
+    REQUIRE(incremental.nbytes() < incremental.nbytes_full() / 2);
+
+    // Restart from a delta
+    mpm::Checkpoint<Dim> checkpoint;
+    REQUIRE(mpm::IncrementalCheckpoint<Dim>::reconstruct(
+                "incremental_checkpoint_test_5.ckpt",
+                "incremental_checkpoint_test_full.ckpt") == true);
+    REQUIRE(checkpoint.read("incremental_checkpoint_test_full.ckpt") == true);
+    REQUIRE(checkpoint.step() == 6);
+    REQUIRE(checkpoint.nparticles() == mesh->nparticles());
+
+    // Delta without its base
+    std::remove("incremental_checkpoint_test_4.ckpt");
+    REQUIRE(mpm::IncrementalCheckpoint<Dim>::reconstruct(
+                "incremental_checkpoint_test_5.ckpt",
+                "incremental_checkpoint_test_full.ckpt") == false);
+    // Base of another dimension
+    REQUIRE(mpm::IncrementalCheckpoint<3>::reconstruct(
+                "incremental_checkpoint_test_1.ckpt",
+                "incremental_checkpoint_test_full.ckpt") == false);
+
+    for (unsigned i = 0; i < ncheckpoints; ++i)
+      std::remove(("incremental_checkpoint_test_" + std::to_string(i) +
+                   ".ckpt")
+                      .c_str());
+    std::remove("incremental_checkpoint_test.ckpt");
+    std::remove("incremental_checkpoint_test_full.ckpt");
+  }
+
+  SECTION("Check invalid checkpoints") {
+    const std::string filename = "incremental_checkpoint_test_invalid.ckpt";
+    mpm::IncrementalCheckpoint<Dim> incremental;
+    // A base that is not written is written again
+    REQUIRE(incremental.write("incremental_missing/a.ckpt", mesh, 0) ==
+            false);
+    REQUIRE(incremental.write(filename, mesh, 1) == true);
+    REQUIRE(incremental.base() == true);
+    REQUIRE(incremental.nbytes() == incremental.nbytes_full());
+
+    REQUIRE(mpm::IncrementalCheckpoint<Dim>::reconstruct(
+                "incremental_checkpoint_test_missing.ckpt",
+                "incremental_checkpoint_test_full.ckpt") == false);
+    std::ofstream(filename) << "invalid checkpoint";
+    REQUIRE(mpm::IncrementalCheckpoint<Dim>::reconstruct(
+                filename, "incremental_checkpoint_test_full.ckpt") == false);
+    std::remove(filename.c_str());
+  }
+}
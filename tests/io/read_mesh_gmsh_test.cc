@@ -0,0 +1,279 @@
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+
+#include "io/read_mesh_gmsh.h"
+#include "mesh.h"
+
+namespace {
+//! Write a file
+void write_file(const std::string& filename, const std::string& content) {
+  std::ofstream file(filename, std::ios::binary);
+  file << content;
+}
+
+//! Append the bytes of a value to a string
+template <typename T>
+void append(std::string* content, T value) {
+  content->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//! Check a 2D mesh of 2 x 1 unit quad4 cells
+void check_quadrilaterals(const std::shared_ptr<mpm::Mesh<2>>& mesh) {
+  const double Tolerance = 1.E-7;
+  REQUIRE(mesh->nnodes() == 6);
+  REQUIRE(mesh->ncells() == 2);
+
+  tbb::concurrent_vector<std::shared_ptr<mpm::Node<2>>> nodes;
+  mesh->iterate_over_nodes(
+      [&nodes](std::shared_ptr<mpm::Node<2>> node) { nodes.push_back(node); });
+  REQUIRE(nodes.size() == 6);
+  for (const auto& node : nodes) {
+    const double x = static_cast<double>((node->id() - 1) % 3);
+    const double y = static_cast<double>((node->id() - 1) / 3);
+    REQUIRE(node->coordinates()(0) == Approx(x).epsilon(Tolerance));
+    REQUIRE(node->coordinates()(1) == Approx(y).epsilon(Tolerance));
+  }
+
+  tbb::concurrent_vector<std::shared_ptr<mpm::Cell<2>>> cells;
+  mesh->iterate_over_cells(
+      [&cells](std::shared_ptr<mpm::Cell<2>> cell) { cells.push_back(cell); });
+  REQUIRE(cells.size() == 2);
+  for (const auto& cell : cells) {
+    REQUIRE(cell->nnodes() == 4);
+    REQUIRE(cell->nfunctions() == 4);
+    // Cell 3 spans x in [0, 1] and cell 4 spans x in [1, 2]
+    const double x = (cell->id() == 3) ? 0.5 : 1.5;
+    REQUIRE(cell->point_in_cell(Eigen::Vector2d(x, 0.5)));
+    REQUIRE(!cell->point_in_cell(Eigen::Vector2d(x + 1., 0.5)));
+  }
+}
+}  // namespace
+
+//! \brief Check Gmsh reader for 2D case
+TEST_CASE("Gmsh reader is checked for 2D case", "[io][gmsh][2D]") {
+  const unsigned Dim = 2;
+  const std::string filename = "gmsh_test_2d.msh";
+
+  // Nodes 1 to 6 on a 3 x 2 grid, a point and a line element are skipped
+  SECTION("Check version 2 ASCII") {
+    write_file(filename,
+               "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+               "$PhysicalNames\n1\n2 1 \"domain\"\n$EndPhysicalNames\n"
+               "$Nodes\n6\n1 0 0 0\n2 1 0 0\n3 2 0 0\n"
+               "4 0 1 0\n5 1.0 1.0 0\n6 2e0 1e0 0\n$EndNodes\n"
+               "$Elements\n4\n1 15 2 0 1 1\n2 1 2 0 1 1 2\n"
+               "3 3 2 0 1 1 2 5 4\n4 3 2 0 1 2 3 6 5\n$EndElements\n");
+
+    mpm::ReadMeshGmsh<Dim> reader;
+    REQUIRE(reader.read_mesh(filename) == true);
+    REQUIRE(reader.version() == 2);
+    REQUIRE(reader.binary() == false);
+    REQUIRE(reader.nnodes() == 6);
+    REQUIRE(reader.ncells() == 2);
+
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_mesh(mesh) == true);
+    check_quadrilaterals(mesh);
+    // Nodes and cells are not added twice
+    REQUIRE(reader.create_mesh(mesh) == false);
+  }
+
+  // Sparse node tags are not indexed by the largest tag
+  SECTION("Check sparse node tags") {
+    write_file(filename,
+               "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+               "$Nodes\n6\n7 0 0 0\n3 1 0 0\n100000000000 2 0 0\n"
+               "5000 0 1 0\n11 1 1 0\n4000000000 2 1 0\n$EndNodes\n"
+               "$Elements\n2\n"
+               "3 3 2 0 1 7 3 11 5000\n"
+               "4 3 2 0 1 3 100000000000 4000000000 11\n$EndElements\n");
+
+    mpm::ReadMeshGmsh<Dim> reader;
+    REQUIRE(reader.read_mesh(filename) == true);
+    REQUIRE(reader.nnodes() == 6);
+    REQUIRE(reader.ncells() == 2);
+
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_mesh(mesh) == true);
+    REQUIRE(mesh->nnodes() == 6);
+    REQUIRE(mesh->ncells() == 2);
+
+    // Particles are located in the cells of their nodes
+    for (unsigned i = 0; i < 2; ++i)
+      REQUIRE(mesh->add_particle(std::make_shared<mpm::Particle<Dim>>(
+                  i, Eigen::Vector2d(0.5 + i, 0.5))) == true);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nactive_cells() == 2);
+    REQUIRE(mesh->nactive_nodes() == 6);
+  }
+
+  SECTION("Check version 2 binary") {
+    std::string content = "$MeshFormat\n2.2 1 8\n";
+    append<int>(&content, 1);
+    content += "\n$EndMeshFormat\n$Nodes\n6\n";
+    for (int id = 1; id <= 6; ++id) {
+      append<int>(&content, id);
+      append<double>(&content, (id - 1) % 3);
+      append<double>(&content, (id - 1) / 3);
+      append<double>(&content, 0.);
+    }
+    content += "\n$EndNodes\n$Elements\n3\n";
+    // A point element, then two quad4 elements
+    const int point[] = {15, 1, 2, 1, 0, 1, 1};
+    const int quads[] = {3, 2, 2, 3, 0, 1, 1, 2, 5, 4, 4, 0, 1, 2, 3, 6, 5};
+    for (int value : point) append<int>(&content, value);
+    for (int value : quads) append<int>(&content, value);
+    content += "\n$EndElements\n";
+    write_file(filename, content);
+
+    mpm::ReadMeshGmsh<Dim> reader;
+    REQUIRE(reader.read_mesh(filename) == true);
+    REQUIRE(reader.version() == 2);
+    REQUIRE(reader.binary() == true);
+
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_mesh(mesh) == true);
+    check_quadrilaterals(mesh);
+  }
+
+  // Node 1 on a point entity, nodes 2 to 6 on a surface with parametric
+  // coordinates
+  SECTION("Check version 4.1 ASCII") {
+    write_file(filename,
+               "$MeshFormat\n4.1 0 8\n$EndMeshFormat\n"
+               "$Entities\n1 0 0 1\n1 0 0 0 0\n"
+               "1 0 0 0 2 1 0 0 0\n$EndEntities\n"
+               "$Nodes\n2 6 1 6\n0 1 0 1\n1\n0 0 0\n"
+               "2 1 1 5\n2\n3\n4\n5\n6\n"
+               "1 0 0 0.5 0\n2 0 0 1 0\n0 1 0 0 1\n"
+               "1 1 0 0.5 1\n2 1 0 1 1\n$EndNodes\n"
+               "$Elements\n2 3 1 4\n0 1 15 1\n1 1\n"
+               "2 1 3 2\n3 1 2 5 4\n4 2 3 6 5\n$EndElements\n");
+
+    mpm::ReadMeshGmsh<Dim> reader;
+    REQUIRE(reader.read_mesh(filename) == true);
+    REQUIRE(reader.version() == 4);
+    REQUIRE(reader.binary() == false);
+
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_mesh(mesh) == true);
+    check_quadrilaterals(mesh);
+  }
+
+  SECTION("Check version 4.1 binary") {
+    std::string content = "$MeshFormat\n4.1 1 8\n";
+    append<int>(&content, 1);
+    content += "\n$EndMeshFormat\n$Nodes\n";
+    const std::size_t nodes_header[] = {1, 6, 1, 6};
+    for (std::size_t value : nodes_header) append<std::size_t>(&content, value);
+    const int entity[] = {2, 1, 0};
+    for (int value : entity) append<int>(&content, value);
+    append<std::size_t>(&content, 6);
+    for (std::size_t id = 1; id <= 6; ++id) append<std::size_t>(&content, id);
+    for (std::size_t id = 1; id <= 6; ++id) {
+      append<double>(&content, (id - 1) % 3);
+      append<double>(&content, (id - 1) / 3);
+      append<double>(&content, 0.);
+    }
+    content += "\n$EndNodes\n$Elements\n";
+    const std::size_t elements_header[] = {1, 2, 3, 4};
+    for (std::size_t value : elements_header)
+      append<std::size_t>(&content, value);
+    const int block[] = {2, 1, 3};
+    for (int value : block) append<int>(&content, value);
+    append<std::size_t>(&content, 2);
+    const std::size_t quads[] = {3, 1, 2, 5, 4, 4, 2, 3, 6, 5};
+    for (std::size_t value : quads) append<std::size_t>(&content, value);
+    content += "\n$EndElements\n";
+    write_file(filename, content);
+
+    mpm::ReadMeshGmsh<Dim> reader;
+    REQUIRE(reader.read_mesh(filename) == true);
+    REQUIRE(reader.version() == 4);
+    REQUIRE(reader.binary() == true);
+
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_mesh(mesh) == true);
+    check_quadrilaterals(mesh);
+  }
+
+  SECTION("Check invalid files") {
+    mpm::ReadMeshGmsh<Dim> reader;
+    REQUIRE(reader.read_mesh("gmsh_test_missing.msh") == false);
+
+    // Version 4.0 is not supported
+    write_file(filename,
+               "$MeshFormat\n4 0 8\n$EndMeshFormat\n"
+               "$Nodes\n0 0\n$EndNodes\n");
+    REQUIRE(reader.read_mesh(filename) == false);
+
+    // Section without end marker
+    write_file(filename,
+               "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n1\n1 0 0 0\n");
+    REQUIRE(reader.read_mesh(filename) == false);
+
+    // Cell with a missing node
+    write_file(filename,
+               "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+               "$Nodes\n3\n1 0 0 0\n2 1 0 0\n3 1 1 0\n$EndNodes\n"
+               "$Elements\n1\n1 3 0 1 2 3 4\n$EndElements\n");
+    REQUIRE(reader.read_mesh(filename) == true);
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_mesh(mesh) == false);
+    REQUIRE(mesh->ncells() == 0);
+  }
+
+  std::remove(filename.c_str());
+}
+
+//! \brief Check Gmsh reader for 3D case
+TEST_CASE("Gmsh reader is checked for 3D case", "[io][gmsh][3D]") {
+  const unsigned Dim = 3;
+  const double Tolerance = 1.E-7;
+  const std::string filename = "gmsh_test_3d.msh";
+
+  // Unit hexahedron with a quad4 face that is skipped
+  write_file(filename,
+             "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+             "$Nodes\n8\n1 0 0 0\n2 1 0 0\n3 1 1 0\n4 0 1 0\n"
+             "5 0 0 1\n6 1 0 1\n7 1 1 1\n8 0 1 1\n$EndNodes\n"
+             "$Elements\n2\n1 3 2 0 1 1 2 3 4\n"
+             "2 5 2 0 1 1 2 3 4 5 6 7 8\n$EndElements\n");
+
+  mpm::ReadMeshGmsh<Dim> reader(6);
+  REQUIRE(reader.read_mesh(filename) == true);
+  REQUIRE(reader.nnodes() == 8);
+  REQUIRE(reader.ncells() == 1);
+
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  REQUIRE(reader.create_mesh(mesh) == true);
+  REQUIRE(mesh->nnodes() == 8);
+  REQUIRE(mesh->ncells() == 1);
+
+  tbb::concurrent_vector<std::shared_ptr<mpm::Cell<Dim>>> cells;
+  mesh->iterate_over_cells([&cells](std::shared_ptr<mpm::Cell<Dim>> cell) {
+    cells.push_back(cell);
+  });
+  REQUIRE(cells.size() == 1);
+  const auto& cell = cells[0];
+  REQUIRE(cell->id() == 2);
+  REQUIRE(cell->nfunctions() == 8);
+  REQUIRE(cell->point_in_cell(Eigen::Vector3d(0.5, 0.5, 0.5)));
+  REQUIRE(!cell->point_in_cell(Eigen::Vector3d(0.5, 1.5, 0.5)));
+  // Node 7 of Gmsh is the local node 6
+  const auto coordinates = cell->nodal_coordinates();
+  REQUIRE(coordinates(6, 0) == Approx(1.).epsilon(Tolerance));
+  REQUIRE(coordinates(6, 1) == Approx(1.).epsilon(Tolerance));
+  REQUIRE(coordinates(6, 2) == Approx(1.).epsilon(Tolerance));
+
+  std::remove(filename.c_str());
+}
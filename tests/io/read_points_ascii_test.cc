@@ -0,0 +1,143 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+
+#include "io/read_points_ascii.h"
+#include "mesh.h"
+
+//! \brief Check ASCII points reader for 2D case
+TEST_CASE("ASCII points reader is checked for 2D case",
+          "[io][points][2D]") {
+  const unsigned Dim = 2;
+  const double Tolerance = 1.E-12;
+  const std::string filename = "points_test_2d.txt";
+
+  SECTION("Check coordinates and attributes") {
+    {
+      std::ofstream file(filename);
+      file << "# x y mass volume\n\n"
+           << "0.5 1.5 2.0 0.25\n"
+           << "  -1e-3\t+2.5E2 3 0.5 # comment\r\n"
+           << "# interior comment\n"
+           << "7 8 9 10";
+    }
+
+    mpm::ReadPointsAscii<Dim> reader;
+    REQUIRE(reader.read_points(filename) == true);
+    REQUIRE(reader.npoints() == 3);
+    REQUIRE(reader.nattributes() == 2);
+    REQUIRE(reader.coordinates(0)(0) == Approx(0.5).epsilon(Tolerance));
+    REQUIRE(reader.coordinates(1)(0) == Approx(-1e-3).epsilon(Tolerance));
+    REQUIRE(reader.coordinates(1)(1) == Approx(250.).epsilon(Tolerance));
+    REQUIRE(reader.attribute(1, 0) == Approx(3.).epsilon(Tolerance));
+    REQUIRE(reader.attribute(2, 1) == Approx(10.).epsilon(Tolerance));
+
+    // Particles with mass and volume
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(reader.create_particles(mesh, 10, {"mass", "volume"}) == true);
+    REQUIRE(mesh->nparticles() == 3);
+    tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    mesh->iterate_over_particles(
+        [&particles](std::shared_ptr<mpm::Particle<Dim>> particle) {
+          particles.push_back(particle);
+        });
+    REQUIRE(particles.size() == 3);
+    for (const auto& particle : particles) {
+      const mpm::Index point = particle->id() - 10;
+      REQUIRE(particle->coordinates()(1) ==
+              Approx(reader.coordinates(point)(1)).epsilon(Tolerance));
+      REQUIRE(particle->mass() ==
+              Approx(reader.attribute(point, 0)).epsilon(Tolerance));
+      REQUIRE(particle->volume() ==
+              Approx(reader.attribute(point, 1)).epsilon(Tolerance));
+    }
+    // Ids exist, an attribute is unknown or names do not match
+    REQUIRE(reader.create_particles(mesh, 10) == false);
+    REQUIRE(reader.create_particles(mesh, 20, {"mass", "density"}) == false);
+    REQUIRE(reader.create_particles(mesh, 20, {"mass"}) == false);
+    REQUIRE(mesh->nparticles() == 3);
+
+    // Nodes ignore attributes
+    REQUIRE(reader.create_nodes(mesh, 0) == true);
+    REQUIRE(mesh->nnodes() == 3);
+  }
+
+  SECTION("Check chunks") {
+    // Lines of varying length split by chunks smaller than lines
+    const unsigned npoints = 1000;
+    {
+      std::ofstream file(filename);
+      for (unsigned i = 0; i < npoints; ++i) {
+        file << i << ".25 " << -static_cast<double>(i) / 8. << '\n';
+        if (i % 7 == 0) file << "# comment " << i << "\n\n";
+      }
+    }
+
+    for (const std::size_t chunk_size : {1, 5, 64, 4096, 1 << 22}) {
+      mpm::ReadPointsAscii<Dim> reader(chunk_size);
+      REQUIRE(reader.read_points(filename) == true);
+      REQUIRE(reader.npoints() == npoints);
+      REQUIRE(reader.nattributes() == 0);
+      for (unsigned i = 0; i < npoints; ++i) {
+        // Values are exact in binary
+        REQUIRE(reader.coordinates(i)(0) == i + 0.25);
+        REQUIRE(reader.coordinates(i)(1) == -static_cast<double>(i) / 8.);
+      }
+    }
+  }
+
+  SECTION("Check invalid files") {
+    mpm::ReadPointsAscii<Dim> reader(16);
+    REQUIRE(reader.read_points("points_test_missing.txt") == false);
+
+    const std::string invalid[] = {
+        // Fewer columns than dimensions
+        "1\n2\n",
+        // Missing column on line 3
+        "1 2 3\n4 5 6\n7 8\n",
+        // Extra column on line 2
+        "1 2\n3 4 5\n",
+        // Invalid token
+        "1 2\n3 4\n5 x\n",
+        // Number followed by characters
+        "1 2\n3 4a\n",
+        // No points
+        "# comment\n\n"};
+    for (const auto& content : invalid) {
+      {
+        std::ofstream file(filename);
+        file << content;
+      }
+      REQUIRE(reader.read_points(filename) == false);
+      REQUIRE(reader.npoints() == 0);
+    }
+  }
+
+  SECTION("Check numbers are correctly rounded") {
+    const std::string numbers[] = {
+        "0.1", "-2.5E2", "1e23", "8.98846567431158e307",
+        "1.7976931348623157e308", "2.2250738585072014e-308", "4.9e-324",
+        "9007199254740993", "123456789012345678901234567890",
+        "3.14159265358979323846264338327950288e-30"};
+    for (const auto& number : numbers) {
+      double value = 0.;
+      const char* next = nullptr;
+      const char* end = number.data() + number.size();
+      REQUIRE(mpm::parse_double(number.data(), end, &value, &next) == true);
+      REQUIRE(next == end);
+      REQUIRE(value == std::strtod(number.c_str(), nullptr));
+    }
+  }
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+#include "io/result_writer.h"
+#include "mesh.h"
+
+//! \brief Decode a big endian double
+//! \param[in] bytes First byte of the value
+static double big_endian_double(const char* bytes) {
+  std::uint64_t bits = 0;
+  for (unsigned i = 0; i < 8; ++i)
+    bits = (bits << 8) | static_cast<unsigned char>(bytes[i]);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+//! \brief Check result writer for 2D case
+TEST_CASE("Result writer is checked for 2D case", "[io][result][2D]") {
+  const unsigned Dim = 2;
+  const double Tolerance = 1.E-12;
+
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  for (unsigned i = 0; i < 4; ++i) {
+    auto particle = std::make_shared<mpm::Particle<Dim>>(
+        i, Eigen::Vector2d(0.5 * i, 1.5));
+    particle->assign_mass(2. + i);
+    particle->assign_velocity(Eigen::Vector2d(i, -1.));
+    REQUIRE(mesh->add_particle(particle) == true);
+  }
+  // Inactive particles are not written
+  auto inactive =
+      std::make_shared<mpm::Particle<Dim>>(9, Eigen::Vector2d(9., 9.), false);
+  REQUIRE(mesh->add_particle(inactive) == true);
+  for (unsigned i = 0; i < 3; ++i) {
+    auto node = std::make_shared<mpm::Node<Dim>>(
+        10 + i, Eigen::Vector2d(i, 0.), Dim);
+    node->assign_mass(1.);
+    REQUIRE(mesh->add_node(node) == true);
+  }
+
+  SECTION("Check particle and nodal results") {
+    const std::string particles = "result_writer_test_particles.vtk";
+    const std::string nodes = "result_writer_test_nodes.vtk";
+    {
+      mpm::ResultWriter<Dim> writer;
+      REQUIRE(writer.write_particles(mesh, {"mass", "velocity", "stress"},
+                                     particles, 10) == true);
+      REQUIRE(writer.write_nodes(mesh, {"mass", "velocity"}, nodes, 10) ==
+              true);
+      REQUIRE(writer.flush() == true);
+      const auto metrics = writer.metrics();
+      REQUIRE(metrics.nsnapshots == 2);
+      REQUIRE(metrics.nfailed == 0);
+      // Time blocked in flush is wait time
+      REQUIRE(metrics.wait_time > 0.);
+      REQUIRE(metrics.overlap() >= 0.);
+      REQUIRE(metrics.overlap() <= 1.);
+    }
+
+    std::ifstream file(particles, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    REQUIRE(content.find("MPM step 10\nBINARY\nDATASET POLYDATA\n") !=
+            std::string::npos);
+    const std::string points = "POINTS 4 double\n";
+    const auto position = content.find(points);
+    REQUIRE(position != std::string::npos);
+    REQUIRE(content.find("VERTICES 4 8\n") != std::string::npos);
+    REQUIRE(content.find("FIELD FieldData 4\n") != std::string::npos);
+    REQUIRE(content.find("velocity 2 4 double\n") != std::string::npos);
+    REQUIRE(content.find("stress 6 4 double\n") != std::string::npos);
+
+    // Points are padded to 3 components and ids match coordinates
+    const char* coordinates = content.data() + position + points.size();
+    const std::string ids = "id 1 4 double\n";
+    const char* id = content.data() + content.find(ids) + ids.size();
+    const std::string mass = "mass 1 4 double\n";
+    const char* masses = content.data() + content.find(mass) + mass.size();
+    for (unsigned i = 0; i < 4; ++i) {
+      const double pid = big_endian_double(id + 8 * i);
+      REQUIRE(big_endian_double(coordinates + 24 * i) ==
+              Approx(0.5 * pid).epsilon(Tolerance));
+      REQUIRE(big_endian_double(coordinates + 24 * i + 8) ==
+              Approx(1.5).epsilon(Tolerance));
+      REQUIRE(big_endian_double(coordinates + 24 * i + 16) ==
+              Approx(0.).epsilon(Tolerance));
+      REQUIRE(big_endian_double(masses + 8 * i) ==
+              Approx(2. + pid).epsilon(Tolerance));
+    }
+
+    std::ifstream node_file(nodes, std::ios::binary);
+    const std::string node_content((std::istreambuf_iterator<char>(node_file)),
+                                   std::istreambuf_iterator<char>());
+    REQUIRE(node_content.find("POINTS 3 double\n") != std::string::npos);
+    REQUIRE(node_content.find("velocity 2 3 double\n") != std::string::npos);
+
+    std::remove(particles.c_str());
+    std::remove(nodes.c_str());
+  }
+
+  SECTION("Check back-pressure with a single buffer") {
+    const unsigned nsnapshots = 8;
+    mpm::ResultWriter<Dim> writer(1);
+    for (unsigned i = 0; i < nsnapshots; ++i)
+      REQUIRE(writer.write_particles(
+                  mesh, {"mass", "volume", "strain"},
+                  "result_writer_test_" + std::to_string(i) + ".vtk", i) ==
+              true);
+    REQUIRE(writer.flush() == true);
+    REQUIRE(writer.metrics().nsnapshots == nsnapshots);
+    for (unsigned i = 0; i < nsnapshots; ++i) {
+      const std::string filename =
+          "result_writer_test_" + std::to_string(i) + ".vtk";
+      std::ifstream file(filename);
+      REQUIRE(file.good() == true);
+      file.close();
+      std::remove(filename.c_str());
+    }
+  }
+
+  SECTION("Check invalid results") {
+    mpm::ResultWriter<Dim> writer;
+    REQUIRE(writer.write_particles(mesh, {"pressure"}, "invalid.vtk", 0) ==
+            false);
+    REQUIRE(writer.write_nodes(mesh, {"stress"}, "invalid.vtk", 0) == false);
+
+    // Failures are reported by the next flush
+    REQUIRE(writer.write_particles(mesh, {"mass"},
+                                   "result_writer_missing/results.vtk",
+                                   0) == true);
+    REQUIRE(writer.flush() == false);
+    REQUIRE(writer.metrics().nfailed == 1);
+    REQUIRE(writer.flush() == true);
+  }
+}
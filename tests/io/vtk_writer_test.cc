@@ -0,0 +1,284 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+#include "io/snapshot.h"
+#include "io/vtk_writer.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+
+//! \brief Read a file
+//! \param[in] filename Name of the file
+static std::string read_vtk_file(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+//! \brief Decode an appended array of a VTK XML file
+//! \param[in] content Content of the file
+//! \param[in] name Attribute that identifies the array, e.g. Name="id"
+//! \param[in] compressed Arrays are compressed with zlib
+static std::string appended_array(const std::string& content,
+                                  const std::string& name, bool compressed) {
+  const auto element = content.find(name);
+  const auto attribute = content.find("offset=\"", element) + 8;
+  const std::size_t offset = std::stoull(content.substr(attribute));
+  const char* block =
+      content.data() + content.find("encoding=\"raw\">\n_") + 17 + offset;
+  std::uint64_t header[3];
+  std::memcpy(header, block, sizeof(header));
+  if (!compressed) return std::string(block + 8, header[0]);
+
+  // Number of blocks, size of blocks, size of the last partial block
+  std::string data;
+  const char* compressed_data = block + 8 * (3 + header[0]);
+  for (std::uint64_t i = 0; i < header[0]; ++i) {
+    std::uint64_t size;
+    std::memcpy(&size, block + 8 * (3 + i), sizeof(size));
+    uLongf length =
+        (i + 1 == header[0] && header[2] != 0) ? header[2] : header[1];
+    std::string part(length, '\0');
+    REQUIRE(uncompress(reinterpret_cast<Bytef*>(&part[0]), &length,
+                       reinterpret_cast<const Bytef*>(compressed_data),
+                       size) == Z_OK);
+    data += part;
+    compressed_data += size;
+  }
+  return data;
+}
+
+//! \brief Check VTK writer for particles
+TEST_CASE("VTK writer is checked for particles", "[io][vtk][2D]") {
+  const unsigned Dim = 2;
+  const double Tolerance = 1.E-12;
+  const unsigned nparticles = 1000;
+
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  for (unsigned i = 0; i < nparticles; ++i) {
+    auto particle = std::make_shared<mpm::Particle<Dim>>(
+        i, Eigen::Vector2d(0.01 * i, 2.));
+    particle->assign_mass(1.);
+    particle->assign_velocity(Eigen::Vector2d(i, -1.));
+    REQUIRE(mesh->add_particle(particle) == true);
+  }
+
+  mpm::Snapshot snapshot;
+  REQUIRE(snapshot.copy_particles(mesh, {"mass", "velocity", "stress"}) ==
+          true);
+  REQUIRE(snapshot.npoints == nparticles);
+  REQUIRE(snapshot.ncells() == 0);
+  REQUIRE(snapshot.fields.at(1).ncomponents == Dim);
+  REQUIRE(snapshot.fields.at(2).ncomponents == 6);
+
+  // Coordinates of a particle by its id
+  const auto check_points = [&](const std::string& ids,
+                                const std::string& points) {
+    REQUIRE(ids.size() == 8 * nparticles);
+    REQUIRE(points.size() == 24 * nparticles);
+    for (unsigned i = 0; i < nparticles; ++i) {
+      std::uint64_t id;
+      double coordinates[3];
+      std::memcpy(&id, ids.data() + 8 * i, sizeof(id));
+      std::memcpy(coordinates, points.data() + 24 * i, sizeof(coordinates));
+      REQUIRE(coordinates[0] == Approx(0.01 * id).epsilon(Tolerance));
+      REQUIRE(coordinates[1] == Approx(2.).epsilon(Tolerance));
+      REQUIRE(coordinates[2] == Approx(0.).epsilon(Tolerance));
+    }
+  };
+
+  SECTION("Check appended raw poly data") {
+    const std::string filename = "vtk_writer_test_particles.vtp";
+    REQUIRE(mpm::VtkWriter().write(snapshot, filename) == true);
+    const std::string content = read_vtk_file(filename);
+    REQUIRE(content.find("type=\"PolyData\"") != std::string::npos);
+    REQUIRE(content.find("compressor") == std::string::npos);
+    REQUIRE(content.find("NumberOfPoints=\"1000\" NumberOfVerts=\"1000\"") !=
+            std::string::npos);
+    check_points(appended_array(content, "Name=\"id\"", false),
+                 appended_array(content, "<Points>", false));
+
+    const std::string offsets =
+        appended_array(content, "Name=\"offsets\"", false);
+    std::uint64_t last;
+    std::memcpy(&last, offsets.data() + offsets.size() - 8, sizeof(last));
+    REQUIRE(last == nparticles);
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Check compressed poly data") {
+    const std::string raw = "vtk_writer_test_raw.vtp";
+    const std::string filename = "vtk_writer_test_compressed.vtp";
+    REQUIRE(mpm::VtkWriter().write(snapshot, raw) == true);
+    // Small blocks to compress arrays in several blocks
+    REQUIRE(mpm::VtkWriter(true, 6, 4096).write(snapshot, filename) == true);
+    const std::string content = read_vtk_file(filename);
+    REQUIRE(content.find("compressor=\"vtkZLibDataCompressor\"") !=
+            std::string::npos);
+    REQUIRE(content.size() < read_vtk_file(raw).size() / 2);
+    check_points(appended_array(content, "Name=\"id\"", true),
+                 appended_array(content, "<Points>", true));
+    const std::string velocity =
+        appended_array(content, "Name=\"velocity\"", true);
+    REQUIRE(velocity == appended_array(read_vtk_file(raw),
+                                       "Name=\"velocity\"", false));
+    std::remove(raw.c_str());
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Check pieces of particles") {
+    const std::string filename = "vtk_writer_test_particles.pvtp";
+    REQUIRE(mpm::VtkWriter().write_pieces(snapshot, filename, 3) == true);
+    const std::string content = read_vtk_file(filename);
+    REQUIRE(content.find("type=\"PPolyData\"") != std::string::npos);
+    REQUIRE(content.find("<PDataArray type=\"Float64\" Name=\"stress\" "
+                         "NumberOfComponents=\"6\"/>") != std::string::npos);
+    unsigned npoints = 0;
+    for (unsigned i = 0; i < 3; ++i) {
+      const std::string piece =
+          "vtk_writer_test_particles_" + std::to_string(i) + ".vtp";
+      REQUIRE(content.find("<Piece Source=\"" + piece + "\"/>") !=
+              std::string::npos);
+      const std::string ids =
+          appended_array(read_vtk_file(piece), "Name=\"id\"", false);
+      npoints += ids.size() / 8;
+      std::remove(piece.c_str());
+    }
+    REQUIRE(npoints == nparticles);
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Check invalid results") {
+    mpm::Snapshot invalid;
+    REQUIRE(invalid.copy_particles(mesh, {"pressure"}) == false);
+    REQUIRE(mpm::VtkWriter().write(snapshot, "vtk_writer_missing/a.vtp") ==
+            false);
+    REQUIRE(mpm::VtkWriter().write_pieces(
+                snapshot, "vtk_writer_missing/a.pvtp", 2) == false);
+    REQUIRE(mpm::VtkWriter::write_legacy(snapshot,
+                                         "vtk_writer_missing/a.vtk") == false);
+  }
+}
+
+//! \brief Check VTK writer for meshes
+TEST_CASE("VTK writer is checked for meshes", "[io][vtk][2D]") {
+  const unsigned Dim = 2;
+  const double Tolerance = 1.E-12;
+
+  // Two quadrilaterals with nodes added in reverse order
+  auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+  std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+  for (unsigned i = 0; i < 6; ++i) {
+    const mpm::Index id = 5 - i;
+    nodes.emplace_back(std::make_shared<mpm::Node<Dim>>(
+        10 + id, Eigen::Vector2d(id % 3, id / 3), Dim));
+    nodes.back()->assign_mass(id);
+  }
+  REQUIRE(mesh->add_nodes(nodes) == true);
+  const unsigned connectivity[2][4] = {{0, 1, 4, 3}, {1, 2, 5, 4}};
+  for (unsigned c = 0; c < 2; ++c) {
+    auto cell = std::make_shared<mpm::Cell<Dim>>(
+        c, 4, std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(4));
+    for (unsigned j = 0; j < 4; ++j)
+      cell->add_node(j, nodes[5 - connectivity[c][j]].get());
+    cell->initialise();
+    REQUIRE(mesh->add_cell(cell) == true);
+  }
+
+  mpm::Snapshot snapshot;
+  REQUIRE(snapshot.copy_mesh(mesh, {"mass", "velocity"}) == true);
+  REQUIRE(snapshot.npoints == 6);
+  REQUIRE(snapshot.ncells() == 2);
+  // Nodes are sorted by id
+  for (unsigned i = 0; i < 6; ++i) {
+    REQUIRE(snapshot.ids[i] == 10 + i);
+    REQUIRE(snapshot.fields[0].values[i] == Approx(i).epsilon(Tolerance));
+  }
+  for (unsigned j = 0; j < 4; ++j) {
+    REQUIRE(snapshot.connectivity[j] == connectivity[0][j]);
+    REQUIRE(snapshot.connectivity[4 + j] == connectivity[1][j]);
+  }
+  REQUIRE(snapshot.offsets[1] == 8);
+  REQUIRE(snapshot.types[0] == 9);
+
+  SECTION("Check unstructured grid") {
+    const std::string filename = "vtk_writer_test_mesh.vtu";
+    REQUIRE(mpm::VtkWriter(true).write(snapshot, filename) == true);
+    const std::string content = read_vtk_file(filename);
+    REQUIRE(content.find("type=\"UnstructuredGrid\"") != std::string::npos);
+    REQUIRE(content.find("NumberOfPoints=\"6\" NumberOfCells=\"2\"") !=
+            std::string::npos);
+    const std::string cells =
+        appended_array(content, "Name=\"connectivity\"", true);
+    REQUIRE(cells.size() == 64);
+    std::uint64_t point;
+    std::memcpy(&point, cells.data() + 8 * 6, sizeof(point));
+    REQUIRE(point == 5);
+    const std::string types = appended_array(content, "Name=\"types\"", true);
+    REQUIRE(types == std::string(2, char(9)));
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Check pieces of a mesh") {
+    const std::string filename = "vtk_writer_test_mesh.pvtu";
+    REQUIRE(mpm::VtkWriter().write_pieces(snapshot, filename, 2) == true);
+    const std::string content = read_vtk_file(filename);
+    REQUIRE(content.find("type=\"PUnstructuredGrid\"") != std::string::npos);
+    for (unsigned i = 0; i < 2; ++i) {
+      const std::string piece =
+          "vtk_writer_test_mesh_" + std::to_string(i) + ".vtu";
+      REQUIRE(content.find("<Piece Source=\"" + piece + "\"/>") !=
+              std::string::npos);
+      const std::string piece_content = read_vtk_file(piece);
+      REQUIRE(piece_content.find("NumberOfPoints=\"4\" NumberOfCells=\"1\"") !=
+              std::string::npos);
+      // Cells refer to the points of their piece
+      const std::string ids =
+          appended_array(piece_content, "Name=\"id\"", false);
+      const std::string cells =
+          appended_array(piece_content, "Name=\"connectivity\"", false);
+      for (unsigned j = 0; j < 4; ++j) {
+        std::uint64_t point, id;
+        std::memcpy(&point, cells.data() + 8 * j, sizeof(point));
+        std::memcpy(&id, ids.data() + 8 * point, sizeof(id));
+        REQUIRE(id == 10 + connectivity[i][j]);
+      }
+      std::remove(piece.c_str());
+    }
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Check legacy unstructured grid") {
+    const std::string filename = "vtk_writer_test_mesh.vtk";
+    REQUIRE(mpm::VtkWriter::write_legacy(snapshot, filename) == true);
+    const std::string content = read_vtk_file(filename);
+    REQUIRE(content.find("DATASET UNSTRUCTURED_GRID\n") != std::string::npos);
+    REQUIRE(content.find("CELLS 2 10\n") != std::string::npos);
+    REQUIRE(content.find("CELL_TYPES 2\n") != std::string::npos);
+    std::remove(filename.c_str());
+  }
+
+  SECTION("Check cell types") {
+    std::vector<unsigned> order;
+    REQUIRE(mpm::Snapshot::cell_type<2>(9, &order) == 28);
+    REQUIRE(order.size() == 9);
+    REQUIRE(mpm::Snapshot::cell_type<2>(3, &order) == 0);
+    REQUIRE(mpm::Snapshot::cell_type<3>(27, &order) == 12);
+    REQUIRE(order.size() == 8);
+    // Edges of 20-node hexahedra in VTK order
+    REQUIRE(mpm::Snapshot::cell_type<3>(20, &order) == 25);
+    REQUIRE(order.size() == 20);
+    REQUIRE(order[9] == 11);
+    REQUIRE(order[16] == 10);
+  }
+}
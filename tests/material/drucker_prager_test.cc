@@ -0,0 +1,203 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+#include "factory.h"
+#include "material/drucker_prager.h"
+#include "material/linear_elastic.h"
+
+//! \brief Check DruckerPrager class
+TEST_CASE("DruckerPrager is checked", "[material][drucker_prager]") {
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  using Vector6d = mpm::Material::Vector6d;
+
+  // Material properties
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  jmaterial["friction"] = 30.;
+  jmaterial["dilation"] = 0.;
+  jmaterial["cohesion"] = 1.0E+4;
+
+  // Coefficients of the cone
+  const double alpha = 2. * 0.5 / (std::sqrt(3.) * 2.5);
+  const double k = 6. * 1.0E+4 * std::cos(M_PI / 6.) / (std::sqrt(3.) * 2.5);
+
+  //! Check for id
+  SECTION("DruckerPrager id and factory") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "DruckerPrager", std::move(id));
+    REQUIRE(material->id() == 0);
+    REQUIRE(material->state_variables().size() == 1);
+
+    auto max = std::make_shared<mpm::DruckerPrager>(
+        std::numeric_limits<unsigned>::max());
+    REQUIRE(max->id() == std::numeric_limits<unsigned>::max());
+  }
+
+  //! Check elastic stresses
+  SECTION("DruckerPrager check elastic stresses") {
+    auto material = std::make_shared<mpm::DruckerPrager>(0);
+    material->properties(jmaterial);
+    auto elastic = std::make_shared<mpm::LinearElastic>(1);
+    elastic->properties(jmaterial);
+
+    // Elastic tensor is the linear elastic tensor
+    const mpm::Material::Matrix6x6 de = material->elastic_tensor();
+    REQUIRE((de - elastic->elastic_tensor()).norm() ==
+            Approx(0.).epsilon(Tolerance));
+
+    Vector6d strain;
+    strain << -1.E-5, 2.E-5, -3.E-5, 1.E-5, -2.E-5, 4.E-5;
+    Vector6d stress = Vector6d::Zero();
+    Vector6d check = Vector6d::Zero();
+    material->compute_stress(stress, strain);
+    elastic->compute_stress(check, strain);
+    REQUIRE(material->yield(stress) < 0.);
+    for (unsigned i = 0; i < stress.size(); ++i)
+      REQUIRE(stress(i) == Approx(check(i)).epsilon(Tolerance));
+  }
+
+  //! Check return mapping to the cone
+  SECTION("DruckerPrager check return to the cone") {
+    auto material = std::make_shared<mpm::DruckerPrager>(0);
+    material->properties(jmaterial);
+
+    // Shear under compression
+    Vector6d stress;
+    stress << -1.E+4, -1.E+4, -1.E+4, 0., 0., 0.;
+    Vector6d strain;
+    strain << -1.E-3, 1.E-3, 0., 2.E-2, 0., 0.;
+    material->compute_stress(stress, strain);
+
+    // Stress is on the cone
+    REQUIRE(material->yield(stress) / k == Approx(0.).epsilon(Tolerance));
+    // Mean stress is preserved without dilation
+    REQUIRE((stress(0) + stress(1) + stress(2)) / 3. ==
+            Approx(-1.E+4).epsilon(Tolerance));
+
+    // Plastic dilation increases the confinement
+    jmaterial["dilation"] = 30.;
+    material->properties(jmaterial);
+    Vector6d dilated;
+    dilated << -1.E+4, -1.E+4, -1.E+4, 0., 0., 0.;
+    material->compute_stress(dilated, strain);
+    REQUIRE(material->yield(dilated) / k == Approx(0.).epsilon(Tolerance));
+    REQUIRE((dilated(0) + dilated(1) + dilated(2)) / 3. < -1.E+4);
+  }
+
+  //! Check return mapping to the apex
+  SECTION("DruckerPrager check return to the apex") {
+    auto material = std::make_shared<mpm::DruckerPrager>(0);
+    material->properties(jmaterial);
+
+    Vector6d stress = Vector6d::Zero();
+    Vector6d strain;
+    strain << 1.E-2, 1.E-2, 1.E-2, 1.E-4, 0., 0.;
+    material->compute_stress(stress, strain);
+    for (unsigned i = 0; i < 3; ++i)
+      REQUIRE(stress(i) == Approx(k / (3. * alpha)).epsilon(Tolerance));
+    for (unsigned i = 3; i < 6; ++i)
+      REQUIRE(stress(i) == Approx(0.).epsilon(Tolerance));
+  }
+
+  //! Check batches against single stress updates
+  SECTION("DruckerPrager check batched stresses") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "DruckerPrager", std::move(id));
+    material->properties(jmaterial);
+
+    const unsigned nparticles = 64;
+    std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+        nparticles),
+        strains(nparticles), check(nparticles);
+    std::vector<std::size_t> states(nparticles);
+    std::srand(44);
+    for (unsigned i = 0; i < nparticles; ++i) {
+      stresses[i] = Vector6d::Random() * 1.E+3;
+      stresses[i].head(3).array() -= 5.E+4;
+      // Every other particle yields
+      strains[i] = Vector6d::Random() * ((i % 2 == 0) ? 1.E-6 : 1.E-2);
+      check[i] = stresses[i];
+      material->compute_stress(check[i], strains[i]);
+      states[i] = material->state().allocate();
+    }
+
+    material->compute_stress(stresses.data(), strains.data(), states.data(),
+                             nparticles);
+    const double* multipliers = material->state().column(0);
+    unsigned nyielding = 0;
+    for (unsigned i = 0; i < nparticles; ++i) {
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(stresses[i](j) == Approx(check[i](j)).epsilon(Tolerance));
+      // Multipliers accumulate for yielding particles only
+      REQUIRE(multipliers[states[i]] >= 0.);
+      if (multipliers[states[i]] > 0.) ++nyielding;
+    }
+    REQUIRE(nyielding >= nparticles / 4);
+    REQUIRE(nyielding <= nparticles / 2);
+  }
+}
+
+//! \brief Benchmark stress update of DruckerPrager, run with [benchmark]
+TEST_CASE("DruckerPrager stress update throughput",
+          "[.][benchmark][material][drucker_prager]") {
+  const unsigned nparticles = 10000;
+  const unsigned nrepeats = 500;
+
+  auto material = std::make_shared<mpm::DruckerPrager>(0);
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  jmaterial["friction"] = 30.;
+  jmaterial["dilation"] = 10.;
+  jmaterial["cohesion"] = 1.0E+4;
+  material->properties(jmaterial);
+  std::shared_ptr<mpm::Material> base = material;
+
+  using Vector6d = mpm::Material::Vector6d;
+  std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+      nparticles),
+      strains(nparticles);
+
+  // Elastic and yielding particles
+  for (const double magnitude : {1.E-9, 1.E-3}) {
+    for (auto& strain : strains) strain = Vector6d::Random() * magnitude;
+    for (auto& stress : stresses) {
+      stress.setZero();
+      stress.head(3).setConstant(-1.E+4);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < nrepeats; ++r)
+      for (unsigned i = 0; i < nparticles; ++i)
+        base->compute_stress(stresses[i], strains[i]);
+    const std::chrono::duration<double> single =
+        std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < nrepeats; ++r)
+      base->compute_stress(stresses.data(), strains.data(), nullptr,
+                           nparticles);
+    const std::chrono::duration<double> batch =
+        std::chrono::steady_clock::now() - start;
+
+    const double n = static_cast<double>(nparticles) * nrepeats;
+    std::cout << "DruckerPrager "
+              << (magnitude < 1.E-6 ? "elastic" : "yielding")
+              << " stress updates: single " << n / single.count() / 1.E6
+              << " M/s, batched " << n / batch.count() / 1.E6 << " M/s ("
+              << stresses[0](0) << ")\n";
+  }
+}
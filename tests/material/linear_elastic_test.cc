@@ -1,4 +1,7 @@
+#include <chrono>
+#include <iostream>
 #include <limits>
+#include <vector>
 
 #include "Eigen/Dense"
 #include "catch.hpp"
@@ -155,5 +158,123 @@ TEST_CASE("LinearElastic is checked", "[material][linear_elastic]") {
     REQUIRE(stress(3) == Approx(3.84615384615385e+01).epsilon(Tolerance));
     REQUIRE(stress(4) == Approx(7.69230769230769e+01).epsilon(Tolerance));
     REQUIRE(stress(5) == Approx(1.15384615384615e+02).epsilon(Tolerance));
+
+    // Stresses from zero are the elastic tensor times the strain
+    const mpm::Material::Vector6d elastic = de * strain;
+    for (unsigned i = 0; i < 6; ++i)
+      REQUIRE(stress(i) == Approx(elastic(i)).epsilon(Tolerance));
+  }
+
+  SECTION("LinearElastic check batched stresses") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "LinearElastic", std::move(id));
+
+    // Initialise material
+    Json jmaterial;
+    jmaterial["youngs_modulus"] = 1.0E+7;
+    jmaterial["poisson_ratio"] = 0.3;
+    material->properties(jmaterial);
+    material->elastic_tensor();
+
+    // Batch of strains and initial stresses
+    const unsigned nparticles = 5;
+    std::vector<mpm::Material::Vector6d,
+                Eigen::aligned_allocator<mpm::Material::Vector6d>>
+        stresses(nparticles), strains(nparticles);
+    for (unsigned i = 0; i < nparticles; ++i) {
+      stresses[i].setConstant(100. * i);
+      strains[i] << 0.001 * i, 0.0005, -0.0005 * i, 0.00001, 0.00002 * i,
+          0.00003;
+    }
+    auto expected = stresses;
+    for (unsigned i = 0; i < nparticles; ++i)
+      material->compute_stress(expected[i], strains[i]);
+
+    // Compute updated stresses of the batch
+    material->compute_stress(stresses.data(), strains.data(), nullptr,
+                             nparticles);
+    for (unsigned i = 0; i < nparticles; ++i)
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(stresses[i](j) == Approx(expected[i](j)).epsilon(Tolerance));
   }
+
+  SECTION("LinearElastic check stresses without elastic tensor") {
+    const unsigned id = 0;
+    auto material = std::make_shared<mpm::LinearElastic>(id);
+
+    // Initialise material
+    Json jmaterial;
+    jmaterial["youngs_modulus"] = 1.0E+7;
+    jmaterial["poisson_ratio"] = 0.3;
+    material->properties(jmaterial);
+
+    // Lame constants
+    REQUIRE(material->lambda() == Approx(5769230.769230769).epsilon(Tolerance));
+    REQUIRE(material->shear_modulus() ==
+            Approx(3846153.846153846).epsilon(Tolerance));
+
+    // Compute updated stress before the elastic tensor
+    mpm::Material::Vector6d stress;
+    stress.setZero();
+    mpm::Material::Vector6d strain;
+    strain << 0.001, 0.0005, 0.0005, 0.00001, 0.00002, 0.00003;
+    material->compute_stress(stress, strain);
+
+    const mpm::Material::Vector6d dense = material->elastic_tensor() * strain;
+    for (unsigned i = 0; i < 6; ++i)
+      REQUIRE(stress(i) == Approx(dense(i)).epsilon(Tolerance));
+  }
+}
+
+//! \brief Benchmark stress update of LinearElastic, run with [benchmark]
+TEST_CASE("LinearElastic stress update throughput",
+          "[.][benchmark][material][linear_elastic]") {
+  const unsigned nparticles = 10000;
+  const unsigned nrepeats = 1000;
+
+  auto material = std::make_shared<mpm::LinearElastic>(0);
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  const mpm::Material::Matrix6x6 de = material->elastic_tensor();
+
+  using Vector6d = mpm::Material::Vector6d;
+  std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+      nparticles, Vector6d::Zero()),
+      strains(nparticles);
+  for (auto& strain : strains) strain = Vector6d::Random() * 1.E-6;
+
+  // Dense product with the elastic tensor
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < nrepeats; ++r)
+    for (unsigned i = 0; i < nparticles; ++i)
+      stresses[i].noalias() += de * strains[i];
+  const std::chrono::duration<double> dense =
+      std::chrono::steady_clock::now() - start;
+
+  // Closed form per particle
+  std::shared_ptr<mpm::Material> base = material;
+  start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < nrepeats; ++r)
+    for (unsigned i = 0; i < nparticles; ++i)
+      base->compute_stress(stresses[i], strains[i]);
+  const std::chrono::duration<double> single =
+      std::chrono::steady_clock::now() - start;
+
+  // Closed form in batches
+  start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < nrepeats; ++r)
+    base->compute_stress(stresses.data(), strains.data(), nullptr,
+                         nparticles);
+  const std::chrono::duration<double> batch =
+      std::chrono::steady_clock::now() - start;
+
+  const double n = static_cast<double>(nparticles) * nrepeats;
+  std::cout << "LinearElastic stress updates: dense "
+            << n / dense.count() / 1.E6 << " M/s, closed form "
+            << n / single.count() / 1.E6 << " M/s, batched "
+            << n / batch.count() / 1.E6 << " M/s (" << stresses[0](0)
+            << ")\n";
 }
@@ -0,0 +1,197 @@
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "serialize.h"
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+
+#include "io/checkpoint.h"
+#include "material/linear_elastic.h"
+#include "material/material.h"
+#include "material/material_state.h"
+#include "mesh.h"
+#include "particle.h"
+
+namespace {
+//! Material accumulating the strain of particles in state variables
+class AccumulatedStrain : public mpm::Material {
+ public:
+  //! Constructor with id
+  AccumulatedStrain(unsigned id) : mpm::Material(id) {}
+
+  //! Read material properties
+  void properties(const Json&) {}
+
+  //! Compute elastic tensor
+  Matrix6x6 elastic_tensor() { return Matrix6x6::Identity(); }
+
+  //! Compute stress
+  void compute_stress(Vector6d& stress, const Vector6d& strain) {
+    stress += strain;
+  }
+
+  //! Compute stresses of a batch of particles
+  void compute_stress(Vector6d* stresses, const Vector6d* strains,
+                      const std::size_t* states, std::size_t nparticles) {
+    double* volumetric = this->state().column(0);
+    double* strain = this->state().column(1);
+    for (std::size_t i = 0; i < nparticles; ++i) {
+      stresses[i] += strains[i];
+      volumetric[states[i]] += strains[i].head(3).sum();
+      for (unsigned j = 0; j < 6; ++j)
+        strain[6 * states[i] + j] += strains[i](j);
+    }
+  }
+
+  //! Return the state variables of particles of the material
+  std::vector<StateVariable> state_variables() const {
+    return {{"volumetric_strain", 1, 0.}, {"strain", 6, 1.}};
+  }
+};
+}  // namespace
+
+//! \brief Check pool of material state variables
+TEST_CASE("Material state is checked", "[material][state]") {
+  const double Tolerance = 1.E-12;
+
+  SECTION("Check slots and columns") {
+    mpm::MaterialState state;
+    state.initialise({{"pc", 1, 100.}, {"back_stress", 6, 0.}});
+    REQUIRE(state.nvariables() == 2);
+    REQUIRE(state.size() == 7);
+    REQUIRE(state.index("back_stress") == 1);
+    REQUIRE(state.index("unknown") == 2);
+    REQUIRE(state.variable(1).size == 6);
+
+    // Slots have initial values
+    for (std::size_t i = 0; i < 3; ++i) REQUIRE(state.allocate() == i);
+    REQUIRE(state.nslots() == 3);
+    REQUIRE(state.nparticles() == 3);
+    for (std::size_t i = 0; i < 3; ++i) {
+      REQUIRE(state.column(0)[i] == Approx(100.).epsilon(Tolerance));
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(state.column(1)[6 * i + j] == Approx(0.).epsilon(Tolerance));
+    }
+
+    // Values of a slot in order of declaration
+    std::vector<double> values{50., 1., 2., 3., 4., 5., 6.};
+    state.assign(1, values);
+    REQUIRE(state.values(1) == values);
+    REQUIRE(state.column(0)[1] == Approx(50.).epsilon(Tolerance));
+    REQUIRE(state.column(1)[6 + 5] == Approx(6.).epsilon(Tolerance));
+    REQUIRE_THROWS_AS(state.assign(1, std::vector<double>(3)),
+                      const std::runtime_error&);
+    REQUIRE_THROWS_AS(state.assign(3, values), const std::runtime_error&);
+
+    // Released slots are reused with initial values
+    state.release(1);
+    REQUIRE(state.nparticles() == 2);
+    REQUIRE(state.allocate() == 1);
+    REQUIRE(state.column(0)[1] == Approx(100.).epsilon(Tolerance));
+    REQUIRE(state.allocate() == 3);
+    REQUIRE(state.nslots() == 4);
+
+    // Variables are declared before allocation
+    REQUIRE_THROWS_AS(state.initialise({}), const std::runtime_error&);
+  }
+
+  SECTION("Check state of particles") {
+    const unsigned Dim = 2;
+    using Vector6d = mpm::Material::Vector6d;
+    auto material = std::make_shared<AccumulatedStrain>(0);
+    auto other = std::make_shared<AccumulatedStrain>(1);
+
+    std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    for (unsigned i = 0; i < 4; ++i) {
+      particles.emplace_back(std::make_shared<mpm::Particle<Dim>>(
+          i, Eigen::Vector2d(i, 0.)));
+      REQUIRE(particles[i]->assign_material(material.get()) == true);
+      REQUIRE(particles[i]->state() == i);
+    }
+    REQUIRE(material->state().nparticles() == 4);
+    REQUIRE(material->state().column(1)[6] == Approx(1.).epsilon(Tolerance));
+
+    // Particles move to another material
+    REQUIRE(particles[1]->assign_material(other.get()) == true);
+    REQUIRE(particles[1]->state() == 0);
+    REQUIRE(material->state().nparticles() == 3);
+    REQUIRE(other->state().nparticles() == 1);
+    REQUIRE(particles[1]->assign_material(other.get()) == true);
+    REQUIRE(other->state().nparticles() == 1);
+
+    // Batches update state variables at the slots of particles
+    for (unsigned i = 0; i < 4; ++i)
+      particles[i]->compute_strain(Vector6d::Constant(i + 1.), 1.);
+    std::vector<mpm::Particle<Dim>*> batch;
+    for (const auto& particle : particles) batch.emplace_back(particle.get());
+    REQUIRE(mpm::Particle<Dim>::compute_stress(batch) == true);
+    REQUIRE(mpm::Particle<Dim>::compute_stress(batch) == true);
+    for (unsigned i = 0; i < 4; ++i) {
+      const auto& state = particles[i]->material()->state();
+      const auto values = state.values(particles[i]->state());
+      REQUIRE(values[0] == Approx(6. * (i + 1)).epsilon(Tolerance));
+      REQUIRE(values[1] == Approx(1. + 2. * (i + 1)).epsilon(Tolerance));
+      REQUIRE(particles[i]->stress()(0) ==
+              Approx(2. * (i + 1)).epsilon(Tolerance));
+    }
+
+    // Destroyed particles release their slots
+    particles.pop_back();
+    REQUIRE(material->state().nparticles() == 2);
+  }
+
+  SECTION("Check checkpoint of state variables") {
+    const unsigned Dim = 2;
+    const std::string filename = "material_state_test.ckpt";
+    std::shared_ptr<mpm::Material> material =
+        std::make_shared<AccumulatedStrain>(0);
+
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    for (unsigned i = 0; i < 5; ++i) {
+      auto particle = std::make_shared<mpm::Particle<Dim>>(
+          i, Eigen::Vector2d(i, 0.));
+      particle->assign_material(material.get());
+      particle->compute_strain(mpm::Material::Vector6d::Constant(i), 1.);
+      REQUIRE(particle->compute_stress() == true);
+      REQUIRE(mesh->add_particle(particle) == true);
+    }
+    REQUIRE(mpm::Checkpoint<Dim>(2).write(filename, mesh, 1) == true);
+
+    // Restored particles have new slots with the saved values
+    std::shared_ptr<mpm::Material> restored =
+        std::make_shared<AccumulatedStrain>(0);
+    restored->state().allocate();
+    mpm::Checkpoint<Dim> checkpoint;
+    REQUIRE(checkpoint.read(filename) == true);
+    auto copy = std::make_shared<mpm::Mesh<Dim>>(1);
+    REQUIRE(checkpoint.create_particles(copy, {{0, restored}}) == true);
+    tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    copy->iterate_over_particles(
+        [&](const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+          particles.push_back(particle);
+        });
+    REQUIRE(particles.size() == 5);
+    for (const auto& particle : particles) {
+      const auto values = restored->state().values(particle->state());
+      REQUIRE(particle->state() != 0);
+      REQUIRE(values[0] == Approx(3. * particle->id()).epsilon(Tolerance));
+      REQUIRE(values[6] == Approx(1. + particle->id()).epsilon(Tolerance));
+    }
+
+    // Material with other state variables
+    auto linear = std::make_shared<mpm::Mesh<Dim>>(2);
+    REQUIRE(checkpoint.create_particles(
+                linear, {{0, std::make_shared<mpm::LinearElastic>(0)}}) ==
+            false);
+    std::remove(filename.c_str());
+  }
+}
@@ -0,0 +1,275 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+#include "factory.h"
+#include "material/modified_cam_clay.h"
+
+//! \brief Check ModifiedCamClay class
+TEST_CASE("ModifiedCamClay is checked", "[material][modified_cam_clay]") {
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  using Vector6d = mpm::Material::Vector6d;
+
+  // Material properties
+  Json jmaterial;
+  jmaterial["poisson_ratio"] = 0.3;
+  jmaterial["kappa"] = 0.05;
+  jmaterial["lambda"] = 0.2;
+  jmaterial["critical_state_ratio"] = 1.2;
+  jmaterial["void_ratio"] = 1.;
+  jmaterial["preconsolidation_pressure"] = 200.;
+
+  // Isotropic stress of a mean stress of 100
+  Vector6d isotropic = Vector6d::Zero();
+  isotropic.head(3).setConstant(-100.);
+
+  //! Check for id
+  SECTION("ModifiedCamClay id and factory") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "ModifiedCamClay", std::move(id));
+    REQUIRE(material->id() == 0);
+    material->properties(jmaterial);
+
+    // State variables have the initial values
+    const auto variables = material->state_variables();
+    REQUIRE(variables.size() == 2);
+    REQUIRE(variables[0].name == "preconsolidation_pressure");
+    REQUIRE(variables[0].initial == Approx(200.).epsilon(Tolerance));
+    REQUIRE(variables[1].name == "specific_volume");
+    REQUIRE(variables[1].initial == Approx(2.).epsilon(Tolerance));
+
+    auto max = std::make_shared<mpm::ModifiedCamClay>(
+        std::numeric_limits<unsigned>::max());
+    REQUIRE(max->id() == std::numeric_limits<unsigned>::max());
+  }
+
+  //! Check elastic stresses
+  SECTION("ModifiedCamClay check elastic stresses") {
+    auto material = std::make_shared<mpm::ModifiedCamClay>(0);
+    material->properties(jmaterial);
+
+    // Moduli at the initial preconsolidation pressure
+    const double K = 2. * 200. / 0.05;
+    const double G = 1.5 * K * 0.4 / 1.3;
+    const mpm::Material::Matrix6x6 de = material->elastic_tensor();
+    REQUIRE(de(0, 0) == Approx(K + 4. / 3. * G).epsilon(Tolerance));
+    REQUIRE(de(0, 1) == Approx(K - 2. / 3. * G).epsilon(Tolerance));
+    REQUIRE(de(3, 3) == Approx(G).epsilon(Tolerance));
+
+    // Moduli at the mean stress at the start of the increment
+    Vector6d strain;
+    strain << -1.E-5, 2.E-5, -3.E-5, 1.E-5, -2.E-5, 4.E-5;
+    Vector6d stress = isotropic;
+    material->compute_stress(stress, strain);
+    const mpm::Material::Vector6d check =
+        isotropic + 0.5 * material->elastic_tensor() * strain;
+    for (unsigned i = 0; i < stress.size(); ++i)
+      REQUIRE(stress(i) == Approx(check(i)).epsilon(Tolerance));
+    REQUIRE(material->yield(stress, 200.) < 0.);
+
+    const auto statistics = material->statistics();
+    REQUIRE(statistics.nupdates == 1);
+    REQUIRE(statistics.nyielding == 0);
+    REQUIRE(statistics.niterations == 0);
+  }
+
+  //! Check isotropic compression beyond the preconsolidation pressure
+  SECTION("ModifiedCamClay check isotropic compression") {
+    auto material = std::make_shared<mpm::ModifiedCamClay>(0);
+    material->properties(jmaterial);
+    std::vector<std::size_t> states{material->state().allocate()};
+
+    Vector6d stress = isotropic;
+    stress.head(3).setConstant(-190.);
+    Vector6d strain = Vector6d::Zero();
+    strain.head(3).setConstant(-1.E-2);
+    material->compute_stress(&stress, &strain, states.data(), 1);
+
+    // Stress is at the preconsolidation pressure, which has increased
+    const double pc = material->state().column(0)[states[0]];
+    REQUIRE(pc > 200.);
+    for (unsigned i = 0; i < 3; ++i)
+      REQUIRE(stress(i) == Approx(-pc).epsilon(Tolerance));
+    REQUIRE(material->yield(stress, pc) / (pc * pc) ==
+            Approx(0.).epsilon(Tolerance));
+    // Specific volume follows the volumetric strain
+    REQUIRE(material->state().column(1)[states[0]] ==
+            Approx(2. * std::exp(-3.E-2)).epsilon(Tolerance));
+
+    const auto statistics = material->statistics();
+    REQUIRE(statistics.nyielding == 1);
+    REQUIRE(statistics.niterations > 0);
+    REQUIRE(statistics.nfailed == 0);
+
+    // Stress on the surface within the tolerance is elastic
+    material->reset_statistics();
+    const Vector6d returned = stress;
+    strain.setZero();
+    material->compute_stress(&stress, &strain, states.data(), 1);
+    for (unsigned i = 0; i < stress.size(); ++i)
+      REQUIRE(stress(i) == Approx(returned(i)).epsilon(Tolerance));
+    REQUIRE(material->statistics().nyielding == 0);
+    REQUIRE(material->statistics().niterations == 0);
+  }
+
+  //! Check shear of lightly and heavily overconsolidated stresses
+  SECTION("ModifiedCamClay check shear") {
+    auto material = std::make_shared<mpm::ModifiedCamClay>(0);
+    material->properties(jmaterial);
+    std::vector<std::size_t> states{material->state().allocate(),
+                                    material->state().allocate()};
+
+    // Mean stresses of 150 and 40, on either side of pc / 2
+    std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+        2, isotropic),
+        strains(2, Vector6d::Zero());
+    stresses[0].head(3).setConstant(-150.);
+    stresses[1].head(3).setConstant(-40.);
+    for (auto& strain : strains) strain(3) = 1.E-1;
+    material->compute_stress(stresses.data(), strains.data(), states.data(),
+                             2);
+
+    // Hardening below the critical state line and softening above it
+    const double* pcs = material->state().column(0);
+    REQUIRE(pcs[states[0]] > 200.);
+    REQUIRE(pcs[states[1]] < 200.);
+    for (unsigned i = 0; i < 2; ++i) {
+      const double pc = pcs[states[i]];
+      REQUIRE(material->yield(stresses[i], pc) / (pc * pc) ==
+              Approx(0.).epsilon(Tolerance));
+      // Shear does not rotate the stress
+      REQUIRE(stresses[i](0) == Approx(stresses[i](1)).epsilon(Tolerance));
+      REQUIRE(stresses[i](4) == Approx(0.).epsilon(Tolerance));
+    }
+    REQUIRE(material->statistics().nyielding == 2);
+
+    // Counters are reset
+    material->reset_statistics();
+    REQUIRE(material->statistics().nupdates == 0);
+    REQUIRE(material->statistics().niterations == 0);
+  }
+
+  //! Check substepping of large increments
+  SECTION("ModifiedCamClay check substepping") {
+    auto material = std::make_shared<mpm::ModifiedCamClay>(0);
+    material->properties(jmaterial);
+    std::vector<std::size_t> states{material->state().allocate()};
+
+    // Isotropic extension softens the material to the origin
+    Vector6d stress = isotropic;
+    Vector6d strain = Vector6d::Zero();
+    strain.head(3).setConstant(1.E-1);
+    material->compute_stress(&stress, &strain, states.data(), 1);
+
+    const double pc = material->state().column(0)[states[0]];
+    REQUIRE(material->yield(stress, pc) / (pc * pc) ==
+            Approx(0.).epsilon(Tolerance));
+    const auto statistics = material->statistics();
+    const unsigned max_iterations = mpm::ModifiedCamClay::max_iterations;
+    REQUIRE(statistics.nsubstepped == 1);
+    REQUIRE(statistics.nsubsteps > 1);
+    REQUIRE(statistics.nfailed == 0);
+    REQUIRE(statistics.niterations <= statistics.nsubsteps * max_iterations);
+  }
+
+  //! Check batches against single stress updates
+  SECTION("ModifiedCamClay check batched stresses") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "ModifiedCamClay", std::move(id));
+    material->properties(jmaterial);
+
+    const unsigned nparticles = 64;
+    std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+        nparticles),
+        strains(nparticles), check(nparticles);
+    std::vector<std::size_t> states(nparticles);
+    std::srand(45);
+    for (unsigned i = 0; i < nparticles; ++i) {
+      stresses[i] = isotropic + Vector6d::Random() * 10.;
+      // Every other particle yields
+      strains[i] = Vector6d::Random() * ((i % 2 == 0) ? 1.E-5 : 1.E-1);
+      check[i] = stresses[i];
+      material->compute_stress(check[i], strains[i]);
+      states[i] = material->state().allocate();
+    }
+
+    material->compute_stress(stresses.data(), strains.data(), states.data(),
+                             nparticles);
+    const double* pcs = material->state().column(0);
+    unsigned nyielding = 0;
+    for (unsigned i = 0; i < nparticles; ++i) {
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(stresses[i](j) == Approx(check[i](j)).epsilon(Tolerance));
+      if (pcs[states[i]] != 200.) ++nyielding;
+    }
+    REQUIRE(nyielding >= nparticles / 4);
+    REQUIRE(nyielding <= nparticles / 2);
+  }
+}
+
+//! \brief Benchmark stress update of ModifiedCamClay, run with [benchmark]
+TEST_CASE("ModifiedCamClay stress update throughput",
+          "[.][benchmark][material][modified_cam_clay]") {
+  const unsigned nparticles = 10000;
+  const unsigned nrepeats = 100;
+
+  auto material = std::make_shared<mpm::ModifiedCamClay>(0);
+  Json jmaterial;
+  jmaterial["poisson_ratio"] = 0.3;
+  jmaterial["kappa"] = 0.05;
+  jmaterial["lambda"] = 0.2;
+  jmaterial["critical_state_ratio"] = 1.2;
+  jmaterial["void_ratio"] = 1.;
+  jmaterial["preconsolidation_pressure"] = 200.;
+  material->properties(jmaterial);
+
+  using Vector6d = mpm::Material::Vector6d;
+  std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+      nparticles),
+      strains(nparticles);
+  std::vector<std::size_t> states(nparticles);
+  for (auto& state : states) state = material->state().allocate();
+
+  // Elastic and yielding particles
+  for (const double magnitude : {1.E-7, 1.E-3}) {
+    for (auto& strain : strains) {
+      strain = Vector6d::Random() * magnitude;
+      strain.head(3).array() -= magnitude;
+    }
+    for (auto& stress : stresses) {
+      stress.setZero();
+      stress.head(3).setConstant(-100.);
+    }
+    material->reset_statistics();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < nrepeats; ++r)
+      material->compute_stress(stresses.data(), strains.data(),
+                               states.data(), nparticles);
+    const std::chrono::duration<double> batch =
+        std::chrono::steady_clock::now() - start;
+
+    const auto statistics = material->statistics();
+    const double n = static_cast<double>(nparticles) * nrepeats;
+    const double nyielding = std::max<double>(statistics.nyielding, 1.);
+    std::cout << "ModifiedCamClay "
+              << (magnitude < 1.E-6 ? "elastic" : "yielding")
+              << " stress updates: batched " << n / batch.count() / 1.E6
+              << " M/s, yielding " << statistics.nyielding / n * 100.
+              << "%, iterations per yielding update "
+              << statistics.niterations / nyielding << ", substepped "
+              << statistics.nsubstepped / nyielding * 100. << "%, failed "
+              << statistics.nfailed << " (" << stresses[0](0) << ")\n";
+  }
+}
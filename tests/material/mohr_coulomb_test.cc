@@ -0,0 +1,276 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+#include "factory.h"
+#include "material/linear_elastic.h"
+#include "material/mohr_coulomb.h"
+
+//! \brief Check MohrCoulomb class
+TEST_CASE("MohrCoulomb is checked", "[material][mohr_coulomb]") {
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  using Vector6d = mpm::Material::Vector6d;
+
+  // Material properties
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  jmaterial["friction"] = 30.;
+  jmaterial["dilation"] = 0.;
+  jmaterial["cohesion"] = 1.0E+4;
+
+  // Twice the cohesion times the cosine of the friction angle
+  const double cohesion_term = 2. * 1.0E+4 * std::cos(M_PI / 6.);
+
+  // Yield functions of all planes are not positive
+  const auto admissible = [&](const Eigen::Vector3d& principal) {
+    for (unsigned i = 0; i < 3; ++i)
+      for (unsigned j = 0; j < 3; ++j)
+        if ((principal(i) - principal(j) +
+             (principal(i) + principal(j)) * 0.5 - cohesion_term) /
+                cohesion_term >
+            Tolerance)
+          return false;
+    return true;
+  };
+
+  //! Check for id
+  SECTION("MohrCoulomb id and factory") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "MohrCoulomb", std::move(id));
+    REQUIRE(material->id() == 0);
+    REQUIRE(material->state_variables().size() == 1);
+
+    auto max = std::make_shared<mpm::MohrCoulomb>(
+        std::numeric_limits<unsigned>::max());
+    REQUIRE(max->id() == std::numeric_limits<unsigned>::max());
+  }
+
+  //! Check principal stresses from invariants
+  SECTION("MohrCoulomb check principal stresses") {
+    std::srand(44);
+    for (unsigned n = 0; n < 20; ++n) {
+      const Vector6d stress = Vector6d::Random() * 1.E+4;
+      Eigen::Matrix3d tensor;
+      // clang-format off
+      tensor << stress(0), stress(3), stress(5),
+                stress(3), stress(1), stress(4),
+                stress(5), stress(4), stress(2);
+      // clang-format on
+      const Eigen::Vector3d check =
+          Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d>(tensor)
+              .eigenvalues()
+              .reverse();
+      const Eigen::Vector3d principal =
+          mpm::MohrCoulomb::principal_stresses(stress);
+      for (unsigned i = 0; i < 3; ++i)
+        REQUIRE(principal(i) / 1.E+4 ==
+                Approx(check(i) / 1.E+4).epsilon(Tolerance));
+    }
+
+    // Hydrostatic stress
+    const Eigen::Vector3d principal =
+        mpm::MohrCoulomb::principal_stresses(Vector6d::Constant(0.));
+    REQUIRE(principal.norm() == Approx(0.).epsilon(Tolerance));
+  }
+
+  //! Check elastic stresses
+  SECTION("MohrCoulomb check elastic stresses") {
+    auto material = std::make_shared<mpm::MohrCoulomb>(0);
+    material->properties(jmaterial);
+    auto elastic = std::make_shared<mpm::LinearElastic>(1);
+    elastic->properties(jmaterial);
+
+    const mpm::Material::Matrix6x6 de = material->elastic_tensor();
+    REQUIRE((de - elastic->elastic_tensor()).norm() ==
+            Approx(0.).epsilon(Tolerance));
+
+    Vector6d strain;
+    strain << -1.E-5, 2.E-5, -3.E-5, 1.E-5, -2.E-5, 4.E-5;
+    Vector6d stress = Vector6d::Zero();
+    Vector6d check = Vector6d::Zero();
+    material->compute_stress(stress, strain);
+    elastic->compute_stress(check, strain);
+    REQUIRE(material->yield(mpm::MohrCoulomb::principal_stresses(stress)) <
+            0.);
+    for (unsigned i = 0; i < stress.size(); ++i)
+      REQUIRE(stress(i) == Approx(check(i)).epsilon(Tolerance));
+  }
+
+  //! Check return mapping to the main plane
+  SECTION("MohrCoulomb check return to the main plane") {
+    auto material = std::make_shared<mpm::MohrCoulomb>(0);
+    material->properties(jmaterial);
+
+    Vector6d stress;
+    stress << -1.E+4, -1.E+4, -1.E+4, 0., 0., 0.;
+    Vector6d strain;
+    strain << 0., 0., 0., 1.E-2, 0., 0.;
+    material->compute_stress(stress, strain);
+
+    const Eigen::Vector3d principal =
+        mpm::MohrCoulomb::principal_stresses(stress);
+    REQUIRE(material->yield(principal) / cohesion_term ==
+            Approx(0.).epsilon(Tolerance));
+    REQUIRE(admissible(principal) == true);
+    // Mean stress is preserved without dilation
+    REQUIRE(principal.sum() / 3. == Approx(-1.E+4).epsilon(Tolerance));
+    // Principal directions are preserved
+    REQUIRE(stress(0) == Approx(stress(1)).epsilon(Tolerance));
+    REQUIRE(stress(4) == Approx(0.).epsilon(Tolerance));
+    REQUIRE(stress(5) == Approx(0.).epsilon(Tolerance));
+  }
+
+  //! Check return mapping to the edges
+  SECTION("MohrCoulomb check return to the edges") {
+    auto material = std::make_shared<mpm::MohrCoulomb>(0);
+    jmaterial["dilation"] = 10.;
+    material->properties(jmaterial);
+
+    // Two equal largest principal stresses return to the left edge
+    Vector6d stress;
+    stress << -1.E+4, -1.E+4, -1.E+4, 0., 0., 0.;
+    Vector6d strain;
+    strain << 5.E-3, 5.E-3, -1.E-2, 0., 0., 0.;
+    material->compute_stress(stress, strain);
+    Eigen::Vector3d principal = mpm::MohrCoulomb::principal_stresses(stress);
+    REQUIRE(material->yield(principal) / cohesion_term ==
+            Approx(0.).epsilon(Tolerance));
+    REQUIRE(principal(0) == Approx(principal(1)).epsilon(Tolerance));
+
+    // Two equal smallest principal stresses return to the right edge
+    stress << -1.E+4, -1.E+4, -1.E+4, 0., 0., 0.;
+    strain << 1.E-2, -5.E-3, -5.E-3, 0., 0., 0.;
+    material->compute_stress(stress, strain);
+    principal = mpm::MohrCoulomb::principal_stresses(stress);
+    REQUIRE(material->yield(principal) / cohesion_term ==
+            Approx(0.).epsilon(Tolerance));
+    REQUIRE(principal(1) == Approx(principal(2)).epsilon(Tolerance));
+  }
+
+  //! Check return mapping to the apex
+  SECTION("MohrCoulomb check return to the apex") {
+    auto material = std::make_shared<mpm::MohrCoulomb>(0);
+    material->properties(jmaterial);
+
+    Vector6d stress = Vector6d::Zero();
+    Vector6d strain;
+    strain << 1.E-2, 1.E-2, 1.E-2, 1.E-4, 0., 0.;
+    material->compute_stress(stress, strain);
+    const double apex = 1.0E+4 / std::tan(M_PI / 6.);
+    for (unsigned i = 0; i < 3; ++i)
+      REQUIRE(stress(i) == Approx(apex).epsilon(Tolerance));
+    for (unsigned i = 3; i < 6; ++i)
+      REQUIRE(stress(i) / apex == Approx(0.).epsilon(Tolerance));
+  }
+
+  //! Check batches against single stress updates
+  SECTION("MohrCoulomb check batched stresses") {
+    unsigned id = 0;
+    auto material = Factory<mpm::Material, unsigned>::instance()->create(
+        "MohrCoulomb", std::move(id));
+    jmaterial["dilation"] = 20.;
+    material->properties(jmaterial);
+    auto model = std::static_pointer_cast<mpm::MohrCoulomb>(material);
+
+    const unsigned nparticles = 64;
+    std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+        nparticles),
+        strains(nparticles), check(nparticles);
+    std::vector<std::size_t> states(nparticles);
+    std::srand(44);
+    for (unsigned i = 0; i < nparticles; ++i) {
+      stresses[i] = Vector6d::Random() * 1.E+3;
+      stresses[i].head(3).array() -= 5.E+4;
+      // Every other particle yields
+      strains[i] = Vector6d::Random() * ((i % 2 == 0) ? 1.E-6 : 1.E-2);
+      check[i] = stresses[i];
+      material->compute_stress(check[i], strains[i]);
+      states[i] = material->state().allocate();
+    }
+
+    material->compute_stress(stresses.data(), strains.data(), states.data(),
+                             nparticles);
+    const double* multipliers = material->state().column(0);
+    unsigned nyielding = 0;
+    for (unsigned i = 0; i < nparticles; ++i) {
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(stresses[i](j) / 1.E+4 ==
+                Approx(check[i](j) / 1.E+4).epsilon(Tolerance));
+      const Eigen::Vector3d principal =
+          mpm::MohrCoulomb::principal_stresses(stresses[i]);
+      REQUIRE(admissible(principal) == true);
+      // Multipliers accumulate for yielding particles only
+      REQUIRE(multipliers[states[i]] >= 0.);
+      if (multipliers[states[i]] > 0.) {
+        REQUIRE(model->yield(principal) / cohesion_term ==
+                Approx(0.).epsilon(Tolerance));
+        ++nyielding;
+      }
+    }
+    REQUIRE(nyielding >= nparticles / 4);
+    REQUIRE(nyielding <= nparticles / 2);
+  }
+}
+
+//! \brief Benchmark stress update of MohrCoulomb, run with [benchmark]
+TEST_CASE("MohrCoulomb stress update throughput",
+          "[.][benchmark][material][mohr_coulomb]") {
+  const unsigned nparticles = 10000;
+  const unsigned nrepeats = 200;
+
+  auto material = std::make_shared<mpm::MohrCoulomb>(0);
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  jmaterial["friction"] = 30.;
+  jmaterial["dilation"] = 10.;
+  jmaterial["cohesion"] = 1.0E+4;
+  material->properties(jmaterial);
+  std::shared_ptr<mpm::Material> base = material;
+
+  using Vector6d = mpm::Material::Vector6d;
+  std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> stresses(
+      nparticles),
+      strains(nparticles);
+
+  // Elastic and yielding particles
+  for (const double magnitude : {1.E-9, 1.E-3}) {
+    for (auto& strain : strains) strain = Vector6d::Random() * magnitude;
+    for (auto& stress : stresses) {
+      stress.setZero();
+      stress.head(3).setConstant(-1.E+4);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < nrepeats; ++r)
+      for (unsigned i = 0; i < nparticles; ++i)
+        base->compute_stress(stresses[i], strains[i]);
+    const std::chrono::duration<double> single =
+        std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < nrepeats; ++r)
+      base->compute_stress(stresses.data(), strains.data(), nullptr,
+                           nparticles);
+    const std::chrono::duration<double> batch =
+        std::chrono::steady_clock::now() - start;
+
+    const double n = static_cast<double>(nparticles) * nrepeats;
+    std::cout << "MohrCoulomb "
+              << (magnitude < 1.E-6 ? "elastic" : "yielding")
+              << " stress updates: single " << n / single.count() / 1.E6
+              << " M/s, batched " << n / batch.count() / 1.E6 << " M/s ("
+              << stresses[0](0) << ")\n";
+  }
+}
@@ -1,10 +1,16 @@
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "Eigen/Dense"
 #include "catch.hpp"
 
 #include "hex_shapefn.h"
+#include "material/linear_elastic.h"
 #include "mesh.h"
 #include "node.h"
 #include "quad_shapefn.h"
@@ -40,7 +46,7 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
     auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
     auto neighbourmesh = std::make_shared<mpm::Mesh<Dim>>(1);
     REQUIRE(mesh->nneighbours() == 0);
-    mesh->add_neighbour(0, neighbourmesh);
+    mesh->add_neighbour(0, neighbourmesh.get());
     REQUIRE(mesh->nneighbours() == 1);
   }
 
@@ -153,6 +159,220 @@ TEST_CASE("Mesh is checked for 2D case", "[mesh][2D]") {
     // Check number of cells in mesh
     REQUIRE(mesh->ncells() == 1);
   }
+
+  // Check colouring of cells
+  SECTION("Check cell colouring") {
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    REQUIRE(mesh->ncolours() == 0);
+
+    // 3 x 3 grid of nodes and 2 x 2 grid of cells
+    std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+    for (unsigned j = 0; j < 3; ++j)
+      for (unsigned i = 0; i < 3; ++i) {
+        Eigen::Vector2d coords(i, j);
+        auto node = std::make_shared<mpm::Node<Dim>>(nodes.size(), coords, Dof);
+        nodes.emplace_back(node);
+        mesh->add_node(node);
+      }
+
+    std::vector<std::shared_ptr<mpm::Cell<Dim>>> cells;
+    for (unsigned j = 0; j < 2; ++j)
+      for (unsigned i = 0; i < 2; ++i) {
+        auto cell = std::make_shared<mpm::Cell<Dim>>(cells.size(), Nnodes);
+        cell->add_node(0, nodes.at(j * 3 + i).get());
+        cell->add_node(1, nodes.at(j * 3 + i + 1).get());
+        cell->add_node(2, nodes.at((j + 1) * 3 + i + 1).get());
+        cell->add_node(3, nodes.at((j + 1) * 3 + i).get());
+        cells.emplace_back(cell);
+        mesh->add_cell(cell);
+      }
+
+    // A Cartesian grid needs 2^Tdim colours
+    REQUIRE(mesh->colour_cells() == 4);
+    REQUIRE(mesh->ncolours() == 4);
+
+    // Cells of the same colour share no node
+    for (unsigned i = 0; i < cells.size(); ++i)
+      for (unsigned j = i + 1; j < cells.size(); ++j) {
+        if (cells[i]->colour() != cells[j]->colour()) continue;
+        for (unsigned m = 0; m < Nnodes; ++m)
+          for (unsigned n = 0; n < Nnodes; ++n)
+            REQUIRE(cells[i]->node(m) != cells[j]->node(n));
+      }
+
+    // Adding a cell invalidates the colouring
+    auto cell = std::make_shared<mpm::Cell<Dim>>(cells.size(), Nnodes);
+    mesh->add_cell(cell);
+    REQUIRE(mesh->ncolours() == 0);
+  }
+
+  // Check particles grouped by material
+  SECTION("Check particles grouped by material") {
+    // Materials outlive the particles of the mesh
+    std::vector<std::shared_ptr<mpm::Material>> materials;
+    for (unsigned i = 0; i < 2; ++i)
+      materials.emplace_back(std::make_shared<mpm::LinearElastic>(10 + i));
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+
+    // 3 x 2 grid of nodes and 2 x 1 grid of cells
+    std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+    for (unsigned j = 0; j < 2; ++j)
+      for (unsigned i = 0; i < 3; ++i) {
+        Eigen::Vector2d coords(i, j);
+        nodes.emplace_back(
+            std::make_shared<mpm::Node<Dim>>(nodes.size(), coords, Dof));
+        mesh->add_node(nodes.back());
+      }
+    for (unsigned i = 0; i < 2; ++i) {
+      auto cell = std::make_shared<mpm::Cell<Dim>>(1 - i, Nnodes, shapefn);
+      cell->add_node(0, nodes.at(i).get());
+      cell->add_node(1, nodes.at(i + 1).get());
+      cell->add_node(2, nodes.at(i + 4).get());
+      cell->add_node(3, nodes.at(i + 3).get());
+      cell->initialise();
+      mesh->add_cell(cell);
+    }
+
+    // Materials alternate between particles of both cells
+    for (unsigned i = 0; i < 8; ++i) {
+      Eigen::Vector2d coords(0.1 + 0.25 * i, 0.5);
+      auto particle = std::make_shared<mpm::Particle<Dim>>(i, coords);
+      // Last particle has no material
+      if (i < 7) particle->assign_material(materials.at(i % 2).get());
+      mesh->add_particle(particle);
+    }
+    REQUIRE(mesh->nmaterial_batches() == 0);
+
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nmaterial_batches() == 2);
+
+    // Particles of a batch share the material, in the order of cells
+    std::mutex mutex;
+    std::map<unsigned, std::vector<mpm::Index>> batches;
+    mesh->iterate_over_material_particles(
+        [&](mpm::Material* material,
+            const std::vector<mpm::Particle<Dim>*>& particles) {
+          std::lock_guard<std::mutex> lock(mutex);
+          auto& ids = batches[material->id()];
+          for (const auto& particle : particles) {
+            ids.emplace_back(particle->id());
+            if (particle->material() != material) ids.emplace_back(100);
+          }
+        });
+    REQUIRE(batches.size() == 2);
+    REQUIRE(batches.at(10) == std::vector<mpm::Index>({4, 6, 0, 2}));
+    REQUIRE(batches.at(11) == std::vector<mpm::Index>({5, 1, 3}));
+
+    // Regrouped after materials are reassigned
+    mesh->iterate_over_particles(
+        [&](const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+          particle->assign_material(materials.at(0).get());
+        });
+    mesh->group_particles_by_material();
+    REQUIRE(mesh->nmaterial_batches() == 1);
+  }
+
+  // Check active cells and nodes
+  SECTION("Check active cells and nodes") {
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+
+    // 3 x 3 grid of nodes and 2 x 2 grid of cells
+    std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+    for (unsigned j = 0; j < 3; ++j)
+      for (unsigned i = 0; i < 3; ++i) {
+        Eigen::Vector2d coords(i, j);
+        auto node = std::make_shared<mpm::Node<Dim>>(nodes.size(), coords, Dof);
+        nodes.emplace_back(node);
+        mesh->add_node(node);
+      }
+
+    mpm::Index cell_id = 0;
+    for (unsigned j = 0; j < 2; ++j)
+      for (unsigned i = 0; i < 2; ++i) {
+        auto cell =
+            std::make_shared<mpm::Cell<Dim>>(cell_id++, Nnodes, shapefn);
+        cell->add_node(0, nodes.at(j * 3 + i).get());
+        cell->add_node(1, nodes.at(j * 3 + i + 1).get());
+        cell->add_node(2, nodes.at((j + 1) * 3 + i + 1).get());
+        cell->add_node(3, nodes.at((j + 1) * 3 + i).get());
+        cell->initialise();
+        mesh->add_cell(cell);
+      }
+
+    // Particle in the first cell
+    Eigen::Vector2d coords(0.5, 0.5);
+    auto particle = std::make_shared<mpm::Particle<Dim>>(0, coords);
+    mesh->add_particle(particle);
+    REQUIRE(mesh->nactive_cells() == 0);
+    REQUIRE(mesh->nactive_nodes() == 0);
+    REQUIRE(mesh->nactive_particles() == 0);
+
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nactive_cells() == 1);
+    REQUIRE(mesh->nactive_particles() == 1);
+    REQUIRE(mesh->nactive_nodes() == 4);
+    for (auto id : {0, 1, 3, 4}) REQUIRE(nodes.at(id)->status() == true);
+    for (auto id : {2, 5, 6, 7, 8}) REQUIRE(nodes.at(id)->status() == false);
+
+    // Only active nodes are iterated
+    std::atomic<unsigned> nactive{0};
+    mesh->iterate_over_active_nodes(
+        [&nactive](mpm::Node<Dim>* node) {
+          if (node->status()) ++nactive;
+        });
+    REQUIRE(nactive == 4);
+
+    // Move the particle to the last cell
+    coords << 1.5, 1.5;
+    particle->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nactive_cells() == 1);
+    REQUIRE(mesh->nactive_nodes() == 4);
+    for (auto id : {4, 5, 7, 8}) REQUIRE(nodes.at(id)->status() == true);
+    for (auto id : {0, 1, 2, 3, 6}) REQUIRE(nodes.at(id)->status() == false);
+
+    // Second particle in the second cell shares two nodes
+    coords << 1.5, 0.5;
+    auto second = std::make_shared<mpm::Particle<Dim>>(1, coords);
+    mesh->add_particle(second);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nactive_cells() == 2);
+    REQUIRE(mesh->nactive_nodes() == 6);
+    for (auto id : {1, 2, 4, 5, 7, 8}) REQUIRE(nodes.at(id)->status() == true);
+    for (auto id : {0, 3, 6}) REQUIRE(nodes.at(id)->status() == false);
+
+    // Nodes of both cells are iterated once
+    std::mutex mutex;
+    std::vector<mpm::Index> ids;
+    mesh->iterate_over_active_nodes([&](mpm::Node<Dim>* node) {
+      std::lock_guard<std::mutex> lock(mutex);
+      ids.emplace_back(node->id());
+    });
+    std::sort(ids.begin(), ids.end());
+    REQUIRE(ids == std::vector<mpm::Index>({1, 2, 4, 5, 7, 8}));
+
+    // Second particle joins the first, shared nodes stay active
+    coords << 1.25, 1.5;
+    second->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nactive_cells() == 1);
+    REQUIRE(mesh->nactive_nodes() == 4);
+    for (auto id : {4, 5, 7, 8}) REQUIRE(nodes.at(id)->status() == true);
+    for (auto id : {0, 1, 2, 3, 6}) REQUIRE(nodes.at(id)->status() == false);
+
+    // Particles leave the mesh
+    coords << 2.5, 2.5;
+    particle->coordinates(coords);
+    second->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == false);
+    REQUIRE(mesh->nactive_cells() == 0);
+    REQUIRE(mesh->nparticles() == 2);
+    REQUIRE(mesh->nactive_particles() == 0);
+    REQUIRE(mesh->nactive_nodes() == 0);
+    for (const auto& node : nodes) REQUIRE(node->status() == false);
+  }
 }
 
 //! \brief Check mesh class for 3D case
@@ -185,7 +405,7 @@ TEST_CASE("Mesh is checked for 3D case", "[mesh][3D]") {
     auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
     auto neighbourmesh = std::make_shared<mpm::Mesh<Dim>>(1);
     REQUIRE(mesh->nneighbours() == 0);
-    mesh->add_neighbour(0, neighbourmesh);
+    mesh->add_neighbour(0, neighbourmesh.get());
     REQUIRE(mesh->nneighbours() == 1);
   }
 
@@ -32,10 +32,10 @@ TEST_CASE("NodeBase handler is checked for 2D case", "[nodebasehandler][2D]") {
   // Check insert nodebase
   SECTION("Check insert nodebase functionality") {
     // Insert nodebase 1 and check status
-    bool status1 = nodebasehandler->insert(nodebase1);
+    bool status1 = nodebasehandler->insert(nodebase1.get());
     REQUIRE(status1 == true);
     // Insert nodebase 2 and check status
-    bool status2 = nodebasehandler->insert(nodebase2->id(), nodebase2);
+    bool status2 = nodebasehandler->insert(nodebase2->id(), nodebase2.get());
     REQUIRE(status2 == true);
     // Check size of nodebase hanlder
     REQUIRE(nodebasehandler->size() == 2);
@@ -44,9 +44,9 @@ TEST_CASE("NodeBase handler is checked for 2D case", "[nodebasehandler][2D]") {
   // Check iterator
   SECTION("Check nodebase range iterator") {
     // Insert nodebase 1
-    nodebasehandler->insert(nodebase1);
+    nodebasehandler->insert(nodebase1.get());
     // Insert nodebase 2
-    nodebasehandler->insert(nodebase2);
+    nodebasehandler->insert(nodebase2.get());
     // Check size of nodebase hanlder
     std::size_t counter = 0;
     for (auto itr = nodebasehandler->begin(); itr != nodebasehandler->end();
@@ -65,9 +65,9 @@ TEST_CASE("NodeBase handler is checked for 2D case", "[nodebasehandler][2D]") {
   // Check for_each
   SECTION("Check nodebase for_each") {
     // Insert nodebase 1
-    nodebasehandler->insert(nodebase1);
+    nodebasehandler->insert(nodebase1.get());
     // Insert nodebase 2
-    nodebasehandler->insert(nodebase2);
+    nodebasehandler->insert(nodebase2.get());
     // Check size of nodebase hanlder
     REQUIRE(nodebasehandler->size() == 2);
 
@@ -126,10 +126,10 @@ TEST_CASE("NodeBase handler is checked for 3D case", "[nodebasehandler][3D]") {
   // Check insert nodebase
   SECTION("Check insert nodebase functionality") {
     // Insert nodebase 1 and check status
-    bool status1 = nodebasehandler->insert(nodebase1);
+    bool status1 = nodebasehandler->insert(nodebase1.get());
     REQUIRE(status1 == true);
     // Insert nodebase 2 and check status
-    bool status2 = nodebasehandler->insert(nodebase2->id(), nodebase2);
+    bool status2 = nodebasehandler->insert(nodebase2->id(), nodebase2.get());
     REQUIRE(status2 == true);
     // Check size of nodebase hanlder
     REQUIRE(nodebasehandler->size() == 2);
@@ -138,9 +138,9 @@ TEST_CASE("NodeBase handler is checked for 3D case", "[nodebasehandler][3D]") {
   // Check iterator
   SECTION("Check nodebase range iterator") {
     // Insert nodebase 1
-    nodebasehandler->insert(nodebase1);
+    nodebasehandler->insert(nodebase1.get());
     // Insert nodebase 2
-    nodebasehandler->insert(nodebase2);
+    nodebasehandler->insert(nodebase2.get());
     // Check size of nodebase hanlder
     std::size_t counter = 0;
     for (auto itr = nodebasehandler->begin(); itr != nodebasehandler->end();
@@ -159,9 +159,9 @@ TEST_CASE("NodeBase handler is checked for 3D case", "[nodebasehandler][3D]") {
   // Check for_each
   SECTION("Check nodebase for_each") {
     // Insert nodebase 1
-    nodebasehandler->insert(nodebase1);
+    nodebasehandler->insert(nodebase1.get());
     // Insert nodebase 2
-    nodebasehandler->insert(nodebase2);
+    nodebasehandler->insert(nodebase2.get());
     // Check size of nodebase hanlder
     REQUIRE(nodebasehandler->size() == 2);
 
@@ -34,10 +34,10 @@ TEST_CASE("Node handler is checked for 2D case", "[nodehandler][2D]") {
   // Check insert node
   SECTION("Check insert node functionality") {
     // Insert node 1 and check status
-    bool status1 = nodehandler->insert(node1);
+    bool status1 = nodehandler->insert(node1.get());
     REQUIRE(status1 == true);
     // Insert node 2 and check status
-    bool status2 = nodehandler->insert(node2->id(), node2);
+    bool status2 = nodehandler->insert(node2->id(), node2.get());
     REQUIRE(status2 == true);
     // Check size of node hanlder
     REQUIRE(nodehandler->size() == 2);
@@ -46,9 +46,9 @@ TEST_CASE("Node handler is checked for 2D case", "[nodehandler][2D]") {
   // Check iterator
   SECTION("Check node range iterator") {
     // Insert node 1
-    nodehandler->insert(node1);
+    nodehandler->insert(node1.get());
     // Insert node 2
-    nodehandler->insert(node2);
+    nodehandler->insert(node2.get());
     // Check size of node hanlder
     std::size_t counter = 0;
     for (auto itr = nodehandler->begin(); itr != nodehandler->end(); ++itr) {
@@ -66,9 +66,9 @@ TEST_CASE("Node handler is checked for 2D case", "[nodehandler][2D]") {
   // Check for_each
   SECTION("Check node for_each") {
     // Insert node 1
-    nodehandler->insert(node1);
+    nodehandler->insert(node1.get());
     // Insert node 2
-    nodehandler->insert(node2);
+    nodehandler->insert(node2.get());
     // Check size of node hanlder
     REQUIRE(nodehandler->size() == 2);
 
@@ -127,10 +127,10 @@ TEST_CASE("Node handler is checked for 3D case", "[nodehandler][3D]") {
   // Check insert node
   SECTION("Check insert node functionality") {
     // Insert node 1 and check status
-    bool status1 = nodehandler->insert(node1);
+    bool status1 = nodehandler->insert(node1.get());
     REQUIRE(status1 == true);
     // Insert node 2 and check status
-    bool status2 = nodehandler->insert(node2->id(), node2);
+    bool status2 = nodehandler->insert(node2->id(), node2.get());
     REQUIRE(status2 == true);
     // Check size of node hanlder
     REQUIRE(nodehandler->size() == 2);
@@ -139,9 +139,9 @@ TEST_CASE("Node handler is checked for 3D case", "[nodehandler][3D]") {
   // Check iterator
   SECTION("Check node range iterator") {
     // Insert node 1
-    nodehandler->insert(node1);
+    nodehandler->insert(node1.get());
     // Insert node 2
-    nodehandler->insert(node2);
+    nodehandler->insert(node2.get());
     // Check size of node hanlder
     std::size_t counter = 0;
     for (auto itr = nodehandler->begin(); itr != nodehandler->end(); ++itr) {
@@ -159,9 +159,9 @@ TEST_CASE("Node handler is checked for 3D case", "[nodehandler][3D]") {
   // Check for_each
   SECTION("Check node for_each") {
     // Insert node 1
-    nodehandler->insert(node1);
+    nodehandler->insert(node1.get());
     // Insert node 2
-    nodehandler->insert(node2);
+    nodehandler->insert(node2.get());
     // Check size of node hanlder
     REQUIRE(nodehandler->size() == 2);
 
@@ -249,6 +249,48 @@ TEST_CASE("Node is checked for 2D case", "[node][2D]") {
     for (unsigned i = 0; i < acceleration.size(); ++i)
       REQUIRE(node->acceleration()(i) == Approx(1.).epsilon(Tolerance));
   }
+  SECTION("Check nodal kinematics update") {
+    mpm::Index id = 0;
+    const double Tolerance = 1.E-7;
+    auto node = std::make_shared<mpm::Node<Dim>>(id, coords, Dof);
+
+    // Assign and accumulate mass
+    node->update_mass(false, 10.);
+    node->update_mass(true, 10.);
+    REQUIRE(node->mass() == Approx(20.).epsilon(Tolerance));
+
+    // Accumulate momentum and compute velocity
+    Eigen::VectorXd momentum(Dof);
+    momentum << 10., 20.;
+    node->update_momentum(true, momentum);
+    node->update_momentum(true, momentum);
+    node->compute_velocity();
+    REQUIRE(node->velocity()(0) == Approx(1.).epsilon(Tolerance));
+    REQUIRE(node->velocity()(1) == Approx(2.).epsilon(Tolerance));
+
+    // Accumulate force and integrate velocity
+    Eigen::VectorXd force(Dof);
+    force << 20., 40.;
+    node->update_force(false, force);
+    const double dt = 0.1;
+    REQUIRE(node->compute_acceleration_velocity(dt) == true);
+    REQUIRE(node->acceleration()(0) == Approx(1.).epsilon(Tolerance));
+    REQUIRE(node->acceleration()(1) == Approx(2.).epsilon(Tolerance));
+    REQUIRE(node->velocity()(0) == Approx(1.1).epsilon(Tolerance));
+    REQUIRE(node->velocity()(1) == Approx(2.2).epsilon(Tolerance));
+
+    // Velocity constraints
+    REQUIRE(node->assign_velocity_constraint(1, -0.5) == true);
+    REQUIRE(node->assign_velocity_constraint(Dof, 0.) == false);
+    REQUIRE(node->compute_acceleration_velocity(dt) == true);
+    REQUIRE(node->velocity()(0) == Approx(1.2).epsilon(Tolerance));
+    REQUIRE(node->velocity()(1) == Approx(-0.5).epsilon(Tolerance));
+    REQUIRE(node->acceleration()(1) == Approx(0.).epsilon(Tolerance));
+
+    // Node without mass
+    node->update_mass(false, 0.);
+    REQUIRE(node->compute_acceleration_velocity(dt) == false);
+  }
 }
 
 //! \brief Check node class for 3D case
@@ -1,12 +1,18 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <sstream>
 
 #include "serialize.h"
 
 #include "catch.hpp"
 
 #include "cell.h"
+#include "material/linear_elastic.h"
 #include "particle.h"
+#include "quad_shapefn.h"
 
 //! \brief Check particle class for 1D case
 TEST_CASE("Particle is checked for 1D case", "[particle][1D]") {
@@ -192,18 +198,165 @@ TEST_CASE("Particle is checked for 2D case", "[particle][2D]") {
 
     coords << 1, 0;
     auto node3 = std::make_shared<mpm::Node<Dim>>(3, coords, Dof);
-    cell->add_node(0, node0);
-    cell->add_node(1, node1);
-    cell->add_node(2, node2);
-    cell->add_node(3, node3);
+    cell->add_node(0, node0.get());
+    cell->add_node(1, node1.get());
+    cell->add_node(2, node2.get());
+    cell->add_node(3, node3.get());
     REQUIRE(cell->nnodes() == 4);
 
     // Add cell to particle
     REQUIRE(cell->status() == false);
-    particle->assign_cell(cell);
+    particle->assign_cell(cell.get());
     REQUIRE(cell->status() == true);
   }
 
+  //! Check stresses computed in batches of the same material
+  SECTION("Stresses are computed in batches") {
+    using Vector6d = mpm::Particle<Dim>::Vector6d;
+    // Materials with different stiffness
+    std::vector<std::shared_ptr<mpm::Material>> materials;
+    for (unsigned i = 0; i < 2; ++i) {
+      materials.emplace_back(std::make_shared<mpm::LinearElastic>(i));
+      Json jmaterial;
+      jmaterial["youngs_modulus"] = 1.0E+7 * (i + 1);
+      jmaterial["poisson_ratio"] = 0.3;
+      materials[i]->properties(jmaterial);
+      materials[i]->elastic_tensor();
+    }
+
+    // Runs of particles with each material and an inactive particle
+    const unsigned material_ids[6] = {0, 0, 1, 0, 1, 1};
+    std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    for (unsigned i = 0; i < 6; ++i) {
+      particles.emplace_back(
+          std::make_shared<mpm::Particle<Dim>>(i, coords, i != 4));
+      particles[i]->assign_material(materials[material_ids[i]].get());
+      REQUIRE(particles[i]->material_id() == material_ids[i]);
+      Vector6d strain_rate;
+      strain_rate << 0.1 * i, -0.2, 0.3, 0.01 * i, 0.02, -0.03;
+      particles[i]->compute_strain(strain_rate, 1.E-3);
+    }
+    std::vector<mpm::Particle<Dim>*> batch;
+    for (const auto& particle : particles) batch.emplace_back(particle.get());
+    REQUIRE(mpm::Particle<Dim>::compute_stress(batch) == true);
+
+    for (unsigned i = 0; i < 6; ++i) {
+      Vector6d stress = Vector6d::Zero();
+      Vector6d strain_rate;
+      strain_rate << 0.1 * i, -0.2, 0.3, 0.01 * i, 0.02, -0.03;
+      // Inactive particles are not updated
+      if (i != 4)
+        materials[material_ids[i]]->compute_stress(stress, strain_rate * 1.E-3);
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(particles[i]->stress()(j) == Approx(stress(j)).epsilon(1.E-12));
+    }
+
+    // Active particle without a material
+    particles.emplace_back(std::make_shared<mpm::Particle<Dim>>(6, coords));
+    batch.emplace_back(particles.back().get());
+    REQUIRE(mpm::Particle<Dim>::compute_stress(batch) == false);
+
+    // Batch of a material updates the current stresses
+    std::vector<mpm::Particle<Dim>*> run{particles[0].get(),
+                                         particles[1].get()};
+    std::vector<Vector6d> previous{particles[0]->stress(),
+                                   particles[1]->stress()};
+    REQUIRE(mpm::Particle<Dim>::compute_stress(materials[0].get(), run) ==
+            true);
+    for (unsigned i = 0; i < 2; ++i) {
+      Vector6d stress = previous[i];
+      Vector6d strain_rate;
+      strain_rate << 0.1 * i, -0.2, 0.3, 0.01 * i, 0.02, -0.03;
+      materials[0]->compute_stress(stress, strain_rate * 1.E-3);
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(particles[i]->stress()(j) == Approx(stress(j)).epsilon(1.E-12));
+    }
+    REQUIRE(mpm::Particle<Dim>::compute_stress(nullptr, run) == false);
+  }
+
+  //! Check particles of floats against particles of doubles
+  SECTION("Particle of floats is checked") {
+    using Vector6d = mpm::Particle<Dim>::Vector6d;
+    REQUIRE(sizeof(mpm::Particle<Dim, float>) < sizeof(mpm::Particle<Dim>));
+
+    auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+    auto cell = std::make_shared<mpm::Cell<Dim>>(0, Nnodes, shapefn);
+    const double node_coords[4][2] = {{0., 0.}, {1., 0.}, {1., 1.}, {0., 1.}};
+    std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+    for (unsigned i = 0; i < 4; ++i) {
+      coords << node_coords[i][0], node_coords[i][1];
+      nodes.emplace_back(std::make_shared<mpm::Node<Dim>>(i, coords, Dof));
+      nodes.back()->update_mass(false, 0.);
+      cell->add_node(i, nodes.back().get());
+    }
+    REQUIRE(cell->initialise() == true);
+
+    auto material = std::make_shared<mpm::LinearElastic>(0);
+    Json jmaterial;
+    jmaterial["youngs_modulus"] = 1.0E+7;
+    jmaterial["poisson_ratio"] = 0.3;
+    material->properties(jmaterial);
+    material->elastic_tensor();
+
+    coords << 0.3, 0.6;
+    auto particle = std::make_shared<mpm::Particle<Dim>>(0, coords);
+    auto fparticle = std::make_shared<mpm::Particle<Dim, float>>(
+        1, coords.cast<float>());
+    Vector6d strain_rate;
+    strain_rate << 0.1, -0.2, 0.3, 0.01, 0.02, -0.03;
+    const Eigen::Vector2d velocity(1.5, -2.5);
+
+    // Same operations on both particles
+    particle->assign_mass(2.);
+    fparticle->assign_mass(2.f);
+    particle->assign_volume(0.5);
+    fparticle->assign_volume(0.5f);
+    particle->assign_velocity(velocity);
+    fparticle->assign_velocity(velocity.cast<float>());
+    particle->assign_material(material.get());
+    fparticle->assign_material(material.get());
+    particle->assign_cell(cell.get());
+    fparticle->assign_cell(cell.get());
+    REQUIRE(particle->compute_reference_location() == true);
+    REQUIRE(fparticle->compute_reference_location() == true);
+    REQUIRE(particle->compute_shapefn() == true);
+    REQUIRE(fparticle->compute_shapefn() == true);
+    particle->compute_strain(strain_rate, 1.E-3);
+    fparticle->compute_strain(strain_rate, 1.E-3);
+    REQUIRE(particle->compute_stress() == true);
+    REQUIRE(fparticle->compute_stress() == true);
+
+    const double FloatTolerance = 1.E-5;
+    for (unsigned i = 0; i < Nnodes; ++i)
+      REQUIRE(fparticle->shapefn()(i) ==
+              Approx(particle->shapefn()(i)).epsilon(FloatTolerance));
+    for (unsigned i = 0; i < 6; ++i)
+      REQUIRE(fparticle->stress()(i) ==
+              Approx(particle->stress()(i)).epsilon(FloatTolerance));
+
+    // Contributions of the particle of floats are accumulated in double
+    std::vector<mpm::Particle<Dim, float>*> particles{fparticle.get()};
+    cell->map_mass_momentum_forces_to_nodes(particles,
+                                            Eigen::Vector2d(0., -10.));
+    double mass = 0.;
+    for (unsigned i = 0; i < Nnodes; ++i) mass += cell->node(i)->mass();
+    REQUIRE(mass == Approx(2.).epsilon(FloatTolerance));
+
+    // Nodal kinematics in double update the particle of floats
+    const Eigen::Vector2d acceleration(0., -10.);
+    particle->compute_updated_velocity_position(acceleration, velocity, 0.1);
+    fparticle->compute_updated_velocity_position(acceleration, velocity, 0.1);
+    // Nodes at rest, interpolated by the cell
+    particle->compute_updated_velocity_position(0.1);
+    fparticle->compute_updated_velocity_position(0.1);
+    for (unsigned i = 0; i < Dim; ++i) {
+      REQUIRE(fparticle->velocity()(i) ==
+              Approx(particle->velocity()(i)).epsilon(FloatTolerance));
+      REQUIRE(fparticle->coordinates()(i) ==
+              Approx(particle->coordinates()(i)).epsilon(FloatTolerance));
+    }
+  }
+
   //! Test serialize function
   SECTION("Serialisation is checked") {
     mpm::Index id = 0;
@@ -347,19 +500,19 @@ TEST_CASE("Particle is checked for 3D case", "[particle][3D]") {
     coords << 1, 1, 1;
     auto node7 = std::make_shared<mpm::Node<Dim>>(7, coords, Dof);
 
-    cell->add_node(0, node0);
-    cell->add_node(1, node1);
-    cell->add_node(2, node2);
-    cell->add_node(3, node3);
-    cell->add_node(4, node4);
-    cell->add_node(5, node5);
-    cell->add_node(6, node6);
-    cell->add_node(7, node7);
+    cell->add_node(0, node0.get());
+    cell->add_node(1, node1.get());
+    cell->add_node(2, node2.get());
+    cell->add_node(3, node3.get());
+    cell->add_node(4, node4.get());
+    cell->add_node(5, node5.get());
+    cell->add_node(6, node6.get());
+    cell->add_node(7, node7.get());
     REQUIRE(cell->nnodes() == 8);
 
     // Add cell to particle
     REQUIRE(cell->status() == false);
-    particle->assign_cell(cell);
+    particle->assign_cell(cell.get());
     REQUIRE(cell->status() == true);
   }
 
@@ -397,4 +550,137 @@ TEST_CASE("Particle is checked for 3D case", "[particle][3D]") {
         REQUIRE(coordinates(i) == Approx(coords(i)).epsilon(Tolerance));
     }
   }
+
+  //! Test serialize function with binary archives
+  SECTION("Binary serialisation is checked") {
+    for (unsigned i = 0; i < coords.size(); ++i) coords(i) = -0.1 * i;
+
+    // Native binary archive
+    std::stringstream binary;
+    {
+      auto particle = std::make_shared<mpm::Particle<Dim>>(7, coords);
+      boost::archive::binary_oarchive oa(binary);
+      oa << *particle;
+    }
+    // Portable binary archive
+    std::stringstream portable;
+    {
+      auto particle = std::make_shared<mpm::Particle<Dim>>(8, coords);
+      mpm::PortableBinaryOArchive oa(portable);
+      oa << *particle << coords;
+    }
+    // The last coordinate ends the archive in little endian order
+    const std::string bytes = portable.str();
+    std::uint64_t bits = 0;
+    for (unsigned i = 0; i < 8; ++i)
+      bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(
+                  bytes[bytes.size() - 8 + i]))
+              << (8 * i);
+    double last;
+    std::memcpy(&last, &bits, sizeof(last));
+    REQUIRE(last == coords(Dim - 1));
+
+    Eigen::Vector3d coordinates;
+    coordinates.setZero();
+    {
+      auto particle = std::make_shared<mpm::Particle<Dim>>(1, coordinates);
+      boost::archive::binary_iarchive(binary) >> *particle;
+      REQUIRE(particle->id() == 7);
+      // Binary values are exact
+      for (unsigned i = 0; i < Dim; ++i)
+        REQUIRE(particle->coordinates()(i) == coords(i));
+    }
+    {
+      auto particle = std::make_shared<mpm::Particle<Dim>>(1, coordinates);
+      mpm::PortableBinaryIArchive(portable) >> *particle;
+      REQUIRE(particle->id() == 8);
+      for (unsigned i = 0; i < Dim; ++i)
+        REQUIRE(particle->coordinates()(i) == coords(i));
+    }
+
+    // Invalid portable archive
+    std::stringstream invalid("not an archive");
+    REQUIRE_THROWS(mpm::PortableBinaryIArchive ia(invalid));
+  }
+}
+
+namespace {
+//! Stream buffer that counts and discards characters
+class CountingBuffer : public std::streambuf {
+ public:
+  std::streamsize count() const { return count_; }
+
+ protected:
+  int_type overflow(int_type c) override {
+    ++count_;
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char*, std::streamsize n) override {
+    count_ += n;
+    return n;
+  }
+
+ private:
+  std::streamsize count_{0};
+};
+
+//! Save and load particles and print the throughput
+//! \tparam Toarchive Output archive
+//! \tparam Tiarchive Input archive
+template <typename Toarchive, typename Tiarchive>
+void benchmark_serialization(const std::string& name) {
+  const unsigned Dim = 3;
+  const unsigned nparticles = 10000;
+  const unsigned nrepeats = 1000;
+
+  std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+  for (unsigned i = 0; i < nparticles; ++i)
+    particles.emplace_back(std::make_shared<mpm::Particle<Dim>>(
+        i, Eigen::Vector3d::Random().eval()));
+
+  // Save 10^7 particles to a stream that discards them
+  CountingBuffer buffer;
+  std::ostream os(&buffer);
+  auto start = std::chrono::steady_clock::now();
+  {
+    Toarchive oa(os);
+    for (unsigned r = 0; r < nrepeats; ++r)
+      for (const auto& particle : particles) oa << *particle;
+  }
+  const std::chrono::duration<double> save =
+      std::chrono::steady_clock::now() - start;
+
+  // Load 10^7 particles from an archive of 10^4 particles
+  std::stringstream ss;
+  {
+    Toarchive oa(ss);
+    for (const auto& particle : particles) oa << *particle;
+  }
+  const std::string archive = ss.str();
+  auto particle =
+      std::make_shared<mpm::Particle<Dim>>(0, Eigen::Vector3d::Zero().eval());
+  start = std::chrono::steady_clock::now();
+  for (unsigned r = 0; r < nrepeats; ++r) {
+    std::istringstream is(archive);
+    Tiarchive ia(is);
+    for (unsigned i = 0; i < nparticles; ++i) ia >> *particle;
+  }
+  const std::chrono::duration<double> load =
+      std::chrono::steady_clock::now() - start;
+
+  const double n = static_cast<double>(nparticles) * nrepeats;
+  std::cout << name << ": " << buffer.count() / n << " bytes/particle, save "
+            << n / save.count() / 1.E6 << " M particles/s, load "
+            << n / load.count() / 1.E6 << " M particles/s\n";
+}
+}  // namespace
+
+//! \brief Benchmark particle serialization, run with [benchmark]
+TEST_CASE("Particle serialization throughput", "[.][benchmark][particle]") {
+  benchmark_serialization<boost::archive::text_oarchive,
+                          boost::archive::text_iarchive>("text");
+  benchmark_serialization<boost::archive::binary_oarchive,
+                          boost::archive::binary_iarchive>("binary");
+  benchmark_serialization<mpm::PortableBinaryOArchive,
+                          mpm::PortableBinaryIArchive>("portable binary");
 }
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+
+#include "mesh.h"
+#include "particle.h"
+#include "pool.h"
+
+//! \brief Check pool of objects
+TEST_CASE("Pool is checked", "[pool]") {
+  const unsigned Dim = 3;
+  const Eigen::Vector3d coords(1., 2., 3.);
+
+  SECTION("Check blocks of a pool") {
+    mpm::Pool<mpm::Particle<Dim>> pool(4);
+    const auto& memory = pool.memory();
+    REQUIRE(memory->block_size() == 0);
+    REQUIRE(memory->nslabs() == 0);
+
+    std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    for (mpm::Index id = 0; id < 4; ++id)
+      particles.emplace_back(pool.create(id, coords));
+    REQUIRE(memory->nslabs() == 1);
+
+    // Particle and control block share a block
+    const std::size_t block_size = memory->block_size();
+    REQUIRE(block_size >= sizeof(mpm::Particle<Dim>));
+    REQUIRE(block_size % mpm::MemoryPool::alignment == 0);
+
+    // Particles of a thread are contiguous
+    for (unsigned i = 0; i < particles.size(); ++i) {
+      REQUIRE(particles[i]->id() == i);
+      REQUIRE(particles[i]->coordinates()(2) == Approx(3.).epsilon(1.E-12));
+      REQUIRE(reinterpret_cast<const char*>(particles[i].get()) -
+                  reinterpret_cast<const char*>(particles[0].get()) ==
+              static_cast<long>(i * block_size));
+    }
+
+    // Released blocks are reused before a new slab
+    const auto* released = particles[2].get();
+    particles[2].reset();
+    particles[2] = pool.create(10, coords);
+    REQUIRE(particles[2].get() == released);
+    REQUIRE(particles[2]->id() == 10);
+    REQUIRE(memory->nslabs() == 1);
+
+    particles.emplace_back(pool.create(4, coords));
+    REQUIRE(memory->nslabs() == 2);
+  }
+
+  SECTION("Check objects outlive the pool") {
+    std::shared_ptr<mpm::Particle<Dim>> particle;
+    std::weak_ptr<mpm::MemoryPool> memory;
+    {
+      mpm::Pool<mpm::Particle<Dim>> pool;
+      particle = pool.create(7, coords);
+      memory = pool.memory();
+    }
+    REQUIRE(!memory.expired());
+    REQUIRE(particle->id() == 7);
+    particle.reset();
+    REQUIRE(memory.expired());
+  }
+
+  SECTION("Check objects created and released on many threads") {
+    mpm::Pool<mpm::Particle<Dim>> pool(64);
+    const unsigned nparticles = 10000;
+    std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles(nparticles);
+    for (unsigned round = 0; round < 2; ++round) {
+      tbb::parallel_for(0u, nparticles, [&](unsigned i) {
+        particles[i] = pool.create(i, coords);
+      });
+      std::set<const void*> addresses;
+      for (unsigned i = 0; i < nparticles; ++i) {
+        REQUIRE(particles[i]->id() == i);
+        addresses.insert(particles[i].get());
+      }
+      REQUIRE(addresses.size() == nparticles);
+      tbb::parallel_for(0u, nparticles,
+                        [&](unsigned i) { particles[i].reset(); });
+    }
+  }
+
+  SECTION("Check particles created by a mesh") {
+    auto mesh = std::make_shared<mpm::Mesh<Dim>>(0);
+    auto particle = mesh->make_particle(0, coords);
+    REQUIRE(mesh->add_particle(particle));
+    REQUIRE(mesh->nparticles() == 1);
+
+    // Particles remain valid after the mesh
+    mesh.reset();
+    REQUIRE(particle->id() == 0);
+  }
+}
+
+//! \brief Benchmark creation and release of particles, run with [benchmark]
+TEST_CASE("Pool creation throughput", "[.][benchmark][pool]") {
+  const unsigned Dim = 3;
+  const unsigned nparticles = 1000000;
+  const Eigen::Vector3d coords(1., 2., 3.);
+  std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles(nparticles);
+  mpm::Pool<mpm::Particle<Dim>> pool;
+
+  // Creation and release on all threads, the second round reuses blocks
+  for (const bool pooled : {false, true, false, true}) {
+    const auto start = std::chrono::steady_clock::now();
+    tbb::parallel_for(0u, nparticles, [&](unsigned i) {
+      particles[i] = pooled ? pool.create(i, coords)
+                            : std::make_shared<mpm::Particle<Dim>>(i, coords);
+    });
+    const std::chrono::duration<double> create =
+        std::chrono::steady_clock::now() - start;
+    tbb::parallel_for(0u, nparticles,
+                      [&](unsigned i) { particles[i].reset(); });
+    const std::chrono::duration<double> total =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << "Particles " << (pooled ? "pool" : "make_shared")
+              << ": create " << nparticles / create.count() / 1.E6
+              << " M/s, release "
+              << nparticles / (total - create).count() / 1.E6 << " M/s\n";
+  }
+}
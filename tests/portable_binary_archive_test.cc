@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "serialize.h"
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+
+//! \brief Check portable binary archive
+TEST_CASE("Portable binary archive is checked", "[serialize][portable]") {
+  SECTION("Check round-trip of numbers, strings and arrays") {
+    const bool flag = true;
+    const char letter = 'm';
+    const int negative = -42;
+    const unsigned positive = 4000000000u;
+    const long long large = -(1LL << 40);
+    const std::size_t size = std::numeric_limits<std::size_t>::max();
+    const float fvalue = 1.25e-3f;
+    const double dvalue = -3.141592653589793;
+    const std::string name = "portable";
+    const std::vector<int> integers{1, -2, 300000, -400000};
+    const std::vector<unsigned long long> ids{0, 1, 1ULL << 50};
+    const std::vector<float> floats{0.5f, -1.5f, 3.e10f};
+    const std::vector<double> doubles{1.e-300, -2.5, 1.e300};
+    const Eigen::Vector3d vector(1., -2., 3.);
+
+    std::stringstream stream;
+    {
+      mpm::PortableBinaryOArchive archive(stream);
+      archive << flag << letter << negative << positive << large << size
+              << fvalue << dvalue << name << integers << ids << floats
+              << doubles << vector;
+    }
+
+    bool rflag = false;
+    char rletter = ' ';
+    int rnegative = 0;
+    unsigned rpositive = 0;
+    long long rlarge = 0;
+    std::size_t rsize = 0;
+    float rfvalue = 0.f;
+    double rdvalue = 0.;
+    std::string rname;
+    std::vector<int> rintegers;
+    std::vector<unsigned long long> rids;
+    std::vector<float> rfloats;
+    std::vector<double> rdoubles;
+    Eigen::Vector3d rvector = Eigen::Vector3d::Zero();
+    {
+      mpm::PortableBinaryIArchive archive(stream);
+      archive >> rflag >> rletter >> rnegative >> rpositive >> rlarge >>
+          rsize >> rfvalue >> rdvalue >> rname >> rintegers >> rids >>
+          rfloats >> rdoubles >> rvector;
+    }
+
+    REQUIRE(rflag == flag);
+    REQUIRE(rletter == letter);
+    REQUIRE(rnegative == negative);
+    REQUIRE(rpositive == positive);
+    REQUIRE(rlarge == large);
+    REQUIRE(rsize == size);
+    REQUIRE(rfvalue == fvalue);
+    REQUIRE(rdvalue == dvalue);
+    REQUIRE(rname == name);
+    REQUIRE(rintegers == integers);
+    REQUIRE(rids == ids);
+    REQUIRE(rfloats == floats);
+    REQUIRE(rdoubles == doubles);
+    for (unsigned i = 0; i < 3; ++i) REQUIRE(rvector(i) == vector(i));
+  }
+
+  SECTION("Check integers of arrays are 8 byte little endian") {
+    const int values[2] = {1, -2};
+    std::stringstream stream;
+    {
+      mpm::PortableBinaryOArchive archive(stream, boost::archive::no_header);
+      archive << boost::serialization::make_array(values, 2);
+    }
+    const std::string bytes = stream.str();
+    REQUIRE(bytes.size() == 16);
+    REQUIRE(static_cast<unsigned char>(bytes[0]) == 1);
+    for (unsigned i = 1; i < 8; ++i) REQUIRE(bytes[i] == 0);
+    REQUIRE(static_cast<unsigned char>(bytes[8]) == 0xFE);
+    for (unsigned i = 9; i < 16; ++i)
+      REQUIRE(static_cast<unsigned char>(bytes[i]) == 0xFF);
+
+    int loaded[2] = {0, 0};
+    {
+      mpm::PortableBinaryIArchive archive(stream, boost::archive::no_header);
+      archive >> boost::serialization::make_array(loaded, 2);
+    }
+    REQUIRE(loaded[0] == 1);
+    REQUIRE(loaded[1] == -2);
+  }
+
+  SECTION("Check doubles of arrays are 8 byte IEEE 754 little endian") {
+    const double values[1] = {1.};
+    std::stringstream stream;
+    {
+      mpm::PortableBinaryOArchive archive(stream, boost::archive::no_header);
+      archive << boost::serialization::make_array(values, 1);
+    }
+    // 1.0 is 0x3FF0000000000000
+    const std::string bytes = stream.str();
+    REQUIRE(bytes.size() == 8);
+    for (unsigned i = 0; i < 6; ++i) REQUIRE(bytes[i] == 0);
+    REQUIRE(static_cast<unsigned char>(bytes[6]) == 0xF0);
+    REQUIRE(static_cast<unsigned char>(bytes[7]) == 0x3F);
+  }
+}
@@ -379,4 +379,27 @@ TEST_CASE("Quadrilateral shape functions are checked",
       REQUIRE(gradsf(8, 1) == Approx(0.0).epsilon(Tolerance));
     }
   }
+
+  //! Check shape functions evaluated in single precision
+  SECTION("Quadrilateral shape functions of floats") {
+    Eigen::Matrix<double, Dim, 1> xi;
+    xi << 0.3, -0.7;
+    for (const unsigned nfunctions : {4, 8, 9}) {
+      auto sf = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(nfunctions);
+      auto fsf =
+          std::make_shared<mpm::QuadrilateralShapeFn<Dim, float>>(nfunctions);
+      const Eigen::MatrixXd shapefn = sf->shapefn(xi);
+      const Eigen::MatrixXf fshapefn = fsf->shapefn(xi.cast<float>());
+      const Eigen::MatrixXd gradsf = sf->grad_shapefn(xi);
+      const Eigen::MatrixXf fgradsf = fsf->grad_shapefn(xi.cast<float>());
+      REQUIRE(fshapefn.rows() == nfunctions);
+      REQUIRE(fgradsf.rows() == nfunctions);
+      REQUIRE(fgradsf.cols() == Dim);
+
+      // Partition of unity holds in single precision
+      REQUIRE(fshapefn.sum() == Approx(1.).epsilon(1.E-6));
+      REQUIRE(fshapefn.cast<double>().isApprox(shapefn, 1.E-6));
+      REQUIRE(fgradsf.cast<double>().isApprox(gradsf, 1.E-6));
+    }
+  }
 }
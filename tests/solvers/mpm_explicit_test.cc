@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+#include "tbb/task_arena.h"
+
+#include "factory.h"
+#include "material/linear_elastic.h"
+#include "mesh.h"
+#include "quad_shapefn.h"
+#include "solvers/mpm_explicit.h"
+#include "structured_mesh.h"
+
+//! \brief Create a 2 x 2 quadrilateral mesh with 4 particles per cell
+//! \param[in] material Material assigned to particles
+//! \tparam Treal Scalar type of the state of particles
+template <typename Treal = double>
+std::shared_ptr<mpm::Mesh<2, Treal>> create_mesh_2d(
+    const std::shared_ptr<mpm::Material>& material) {
+  const unsigned Dim = 2;
+  const unsigned Nnodes = 4;
+  auto mesh = std::make_shared<mpm::Mesh<Dim, Treal>>(0);
+  auto shapefn = std::make_shared<mpm::QuadrilateralShapeFn<Dim>>(Nnodes);
+
+  std::vector<std::shared_ptr<mpm::Node<Dim>>> nodes;
+  for (unsigned j = 0; j < 3; ++j)
+    for (unsigned i = 0; i < 3; ++i) {
+      Eigen::Vector2d coords(i, j);
+      auto node = std::make_shared<mpm::Node<Dim>>(nodes.size(), coords, Dim);
+      nodes.emplace_back(node);
+      mesh->add_node(node);
+    }
+
+  for (unsigned j = 0; j < 2; ++j)
+    for (unsigned i = 0; i < 2; ++i) {
+      auto cell = std::make_shared<mpm::Cell<Dim>>(j * 2 + i, Nnodes, shapefn);
+      cell->add_node(0, nodes.at(j * 3 + i).get());
+      cell->add_node(1, nodes.at(j * 3 + i + 1).get());
+      cell->add_node(2, nodes.at((j + 1) * 3 + i + 1).get());
+      cell->add_node(3, nodes.at((j + 1) * 3 + i).get());
+      cell->initialise();
+      mesh->add_cell(cell);
+    }
+
+  mpm::Index id = 0;
+  for (unsigned j = 0; j < 4; ++j)
+    for (unsigned i = 0; i < 4; ++i) {
+      Eigen::Vector2d coords(0.25 + 0.5 * i, 0.25 + 0.5 * j);
+      auto particle = std::make_shared<mpm::Particle<Dim, Treal>>(
+          id++, coords.cast<Treal>());
+      particle->assign_volume(0.25);
+      particle->assign_mass(250.);
+      particle->assign_material(material.get());
+      mesh->add_particle(particle);
+    }
+  return mesh;
+}
+
+//! \brief Create a block of hexahedron cells with particles in its lower half
+//! \param[in] ncells Number of cells in each direction
+//! \param[in] material Material assigned to particles
+//! \tparam Treal Scalar type of the state of particles
+template <typename Treal>
+std::shared_ptr<mpm::Mesh<3, Treal>> create_block(
+    unsigned ncells, const std::shared_ptr<mpm::Material>& material) {
+  const unsigned Dim = 3;
+  const unsigned nppc = 2;
+  const double density = 1000.;
+  auto mesh = std::make_shared<mpm::StructuredMesh<Dim, Treal>>(
+      0, Eigen::Vector3d::Zero(), Eigen::Vector3d::Ones(),
+      std::array<mpm::Index, Dim>{{ncells, ncells, ncells}});
+  for (unsigned dir = 0; dir < Dim; ++dir)
+    mesh->assign_boundary_velocity_constraint(2, false, dir, 0.);
+
+  const double pspacing = 1. / nppc;
+  const double pvolume = pspacing * pspacing * pspacing;
+  std::vector<std::shared_ptr<mpm::Particle<Dim, Treal>>> particles;
+  for (unsigned k = 0; k < (ncells * nppc) / 2; ++k)
+    for (unsigned j = 0; j < ncells * nppc; ++j)
+      for (unsigned i = 0; i < ncells * nppc; ++i) {
+        const Eigen::Vector3d coords((i + 0.5) * pspacing,
+                                     (j + 0.5) * pspacing,
+                                     (k + 0.5) * pspacing);
+        auto particle =
+            mesh->make_particle(particles.size(), coords.cast<Treal>());
+        particle->assign_volume(pvolume);
+        particle->assign_mass(pvolume * density);
+        particle->assign_material(material.get());
+        particles.emplace_back(particle);
+      }
+  mesh->add_particles(particles);
+  return mesh;
+}
+
+//! \brief Return the particles of a mesh ordered by id
+//! \param[in] mesh Mesh with particles numbered from zero
+//! \tparam Tdim Dimension
+//! \tparam Treal Scalar type of the state of particles
+template <unsigned Tdim, typename Treal>
+std::vector<std::shared_ptr<mpm::Particle<Tdim, Treal>>> particles_by_id(
+    const std::shared_ptr<mpm::Mesh<Tdim, Treal>>& mesh) {
+  std::vector<std::shared_ptr<mpm::Particle<Tdim, Treal>>> particles(
+      mesh->nparticles());
+  mesh->iterate_over_particles(
+      [&particles](
+          const std::shared_ptr<mpm::Particle<Tdim, Treal>>& particle) {
+        particles.at(particle->id()) = particle;
+      });
+  return particles;
+}
+
+//! \brief Check explicit MPM solver for 2D case
+TEST_CASE("MPM explicit is checked for 2D case", "[mpm][explicit][2D]") {
+  // Dimension
+  const unsigned Dim = 2;
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  // Material
+  unsigned material_id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(material_id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  material->elastic_tensor();
+
+  const double dt = 1.E-3;
+  const unsigned nsteps = 10;
+  const Eigen::Vector2d gravity(0., -10.);
+
+  // A free falling body moves as a rigid body for all schemes
+  SECTION("Free falling body") {
+    for (auto stress_update :
+         {mpm::StressUpdate::USF, mpm::StressUpdate::USL,
+          mpm::StressUpdate::MUSL}) {
+      auto mesh = create_mesh_2d(material);
+      mpm::MPMExplicit<Dim> solver(mesh, dt, stress_update);
+      REQUIRE(solver.stress_update() == stress_update);
+      solver.gravity(gravity);
+
+      REQUIRE(solver.solve(nsteps) == true);
+      REQUIRE(solver.step() == nsteps);
+      REQUIRE(solver.particle_updates_per_second() > 0.);
+
+      std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles(
+          mesh->nparticles());
+      mesh->iterate_over_particles(
+          [&particles](const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+            particles.at(particle->id()) = particle;
+          });
+      for (const auto& particle : particles) {
+        const auto velocity = particle->velocity();
+        REQUIRE(velocity(0) == Approx(0.).epsilon(Tolerance));
+        REQUIRE(velocity(1) ==
+                Approx(gravity(1) * nsteps * dt).epsilon(Tolerance));
+        // Rigid body motion generates no stress
+        const auto stress = particle->stress();
+        for (unsigned i = 0; i < stress.size(); ++i)
+          REQUIRE(stress(i) == Approx(0.).epsilon(Tolerance));
+      }
+    }
+  }
+
+  // Fixed bottom nodes generate compressive stresses
+  SECTION("Body resting on a fixed base") {
+    auto mesh = create_mesh_2d(material);
+    mesh->iterate_over_nodes(
+        [](const std::shared_ptr<mpm::Node<Dim>>& node) {
+          if (node->coordinates()(1) < 1.E-10)
+            node->assign_velocity_constraint(1, 0.);
+        });
+    mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::MUSL);
+    solver.gravity(gravity);
+    REQUIRE(solver.solve(nsteps) == true);
+
+    std::vector<std::shared_ptr<mpm::Particle<Dim>>> particles(
+        mesh->nparticles());
+    mesh->iterate_over_particles(
+        [&particles](const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+          particles.at(particle->id()) = particle;
+        });
+    for (const auto& particle : particles) {
+      REQUIRE(particle->stress()(1) < 0.);
+      REQUIRE(particle->velocity()(1) > gravity(1) * nsteps * dt);
+    }
+  }
+
+  // Colouring and reduction scatter without locks and match the atomic
+  // scatter, reduction is reproducible
+  SECTION("Scatter strategies") {
+    // The last reduction runs on a single thread
+    const std::vector<mpm::Scatter> scatters = {
+        mpm::Scatter::Atomic, mpm::Scatter::Colouring, mpm::Scatter::Reduction,
+        mpm::Scatter::Reduction};
+    std::vector<std::shared_ptr<mpm::Mesh<Dim>>> meshes;
+    for (unsigned s = 0; s < scatters.size(); ++s) {
+      const auto scatter = scatters.at(s);
+      auto mesh = create_mesh_2d(material);
+      mesh->iterate_over_nodes(
+          [](const std::shared_ptr<mpm::Node<Dim>>& node) {
+            if (node->coordinates()(1) < 1.E-10)
+              node->assign_velocity_constraint(1, 0.);
+          });
+      mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::USF);
+      solver.scatter(scatter);
+      REQUIRE(solver.scatter() == scatter);
+      solver.gravity(gravity);
+      tbb::task_arena arena(s + 1 == scatters.size()
+                                ? 1
+                                : static_cast<int>(tbb::task_arena::automatic));
+      bool status = false;
+      arena.execute(
+          [&solver, &status, nsteps]() { status = solver.solve(nsteps); });
+      REQUIRE(status == true);
+      meshes.emplace_back(mesh);
+    }
+    REQUIRE(meshes.at(0)->ncolours() == 0);
+    REQUIRE(meshes.at(1)->ncolours() == 4);
+
+    // Particles are compared by id
+    std::vector<std::vector<std::shared_ptr<mpm::Particle<Dim>>>> particles;
+    for (const auto& mesh : meshes) {
+      particles.emplace_back(mesh->nparticles());
+      auto& mesh_particles = particles.back();
+      mesh->iterate_over_particles(
+          [&mesh_particles](
+              const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+            mesh_particles.at(particle->id()) = particle;
+          });
+    }
+
+    const auto& atomic = particles.at(0);
+    for (unsigned m = 1; m < particles.size(); ++m) {
+      const auto& other = particles.at(m);
+      REQUIRE(atomic.size() == other.size());
+      for (unsigned i = 0; i < atomic.size(); ++i) {
+        REQUIRE(atomic[i]->id() == other[i]->id());
+        for (unsigned j = 0; j < Dim; ++j)
+          REQUIRE(atomic[i]->velocity()(j) ==
+                  Approx(other[i]->velocity()(j)).epsilon(Tolerance));
+        for (unsigned j = 0; j < 6; ++j)
+          REQUIRE(atomic[i]->stress()(j) ==
+                  Approx(other[i]->stress()(j)).epsilon(Tolerance));
+      }
+    }
+
+    // Reduction gives bitwise identical results on any number of threads
+    for (unsigned i = 0; i < particles.at(2).size(); ++i) {
+      const auto& first = particles.at(2)[i];
+      const auto& second = particles.at(3)[i];
+      for (unsigned j = 0; j < Dim; ++j) {
+        REQUIRE(first->velocity()(j) == second->velocity()(j));
+        REQUIRE(first->coordinates()(j) == second->coordinates()(j));
+      }
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(first->stress()(j) == second->stress()(j));
+    }
+  }
+
+  // Particles of floats with nodes in double follow particles of doubles
+  SECTION("Mixed precision") {
+    const auto fix_base = [](const std::shared_ptr<mpm::Node<Dim>>& node) {
+      if (node->coordinates()(1) < 1.E-10)
+        node->assign_velocity_constraint(1, 0.);
+    };
+    auto mesh = create_mesh_2d(material);
+    auto fmesh = create_mesh_2d<float>(material);
+    mesh->iterate_over_nodes(fix_base);
+    fmesh->iterate_over_nodes(fix_base);
+
+    mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::MUSL);
+    mpm::MPMExplicit<Dim, float> fsolver(fmesh, dt, mpm::StressUpdate::MUSL);
+    solver.gravity(gravity);
+    fsolver.gravity(gravity);
+    REQUIRE(solver.solve(nsteps) == true);
+    REQUIRE(fsolver.solve(nsteps) == true);
+
+    const auto particles = particles_by_id(mesh);
+    const auto fparticles = particles_by_id(fmesh);
+    REQUIRE(particles.size() == fparticles.size());
+    double stress_scale = 0.;
+    for (const auto& particle : particles)
+      stress_scale = std::max(stress_scale, particle->stress().norm());
+    REQUIRE(stress_scale > 0.);
+
+    // Differences are of the order of the precision of floats
+    const double FloatTolerance = 1.E-5;
+    for (unsigned i = 0; i < particles.size(); ++i) {
+      const auto& particle = particles[i];
+      const auto& fparticle = fparticles[i];
+      for (unsigned j = 0; j < Dim; ++j) {
+        REQUIRE(fparticle->coordinates()(j) ==
+                Approx(particle->coordinates()(j)).epsilon(FloatTolerance));
+        REQUIRE(std::fabs(fparticle->velocity()(j) -
+                          particle->velocity()(j)) <
+                FloatTolerance * gravity.norm() * nsteps * dt);
+      }
+      for (unsigned j = 0; j < 6; ++j)
+        REQUIRE(std::fabs(fparticle->stress()(j) - particle->stress()(j)) <
+                FloatTolerance * stress_scale);
+    }
+  }
+}
+
+//! \brief Benchmark particles of doubles and of floats on a gravity block,
+//! and report the accuracy of floats, run with [benchmark]
+TEST_CASE("MPM explicit mixed precision throughput",
+          "[.][benchmark][mpm][explicit][precision]") {
+  const unsigned Dim = 3;
+  const unsigned ncells = 16;
+  const unsigned nsteps = 200;
+  const double dt = 1.E-3;
+  const Eigen::Vector3d gravity(0., 0., -9.81);
+
+  unsigned material_id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(material_id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+6;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  material->elastic_tensor();
+
+  auto mesh = create_block<double>(ncells, material);
+  auto fmesh = create_block<float>(ncells, material);
+  const auto particles = particles_by_id(mesh);
+  const auto fparticles = particles_by_id(fmesh);
+  std::vector<Eigen::Vector3d> initial;
+  for (const auto& particle : particles)
+    initial.emplace_back(particle->coordinates());
+
+  mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::USF);
+  mpm::MPMExplicit<Dim, float> fsolver(fmesh, dt, mpm::StressUpdate::USF);
+  solver.gravity(gravity);
+  fsolver.gravity(gravity);
+  REQUIRE(solver.solve(nsteps) == true);
+  REQUIRE(fsolver.solve(nsteps) == true);
+
+  // Differences relative to the largest displacement and stress
+  double displacement = 0., position = 0., stress = 0., stress_scale = 0.;
+  for (unsigned i = 0; i < particles.size(); ++i) {
+    const auto& particle = particles[i];
+    const auto& fparticle = fparticles[i];
+    displacement =
+        std::max(displacement, (particle->coordinates() - initial[i]).norm());
+    position = std::max(position, (fparticle->coordinates().cast<double>() -
+                                   particle->coordinates())
+                                      .norm());
+    stress_scale = std::max(stress_scale, particle->stress().norm());
+    stress = std::max(stress, (fparticle->stress().cast<double>() -
+                               particle->stress())
+                                  .norm());
+  }
+
+  std::cout << "Gravity block of " << particles.size() << " particles, "
+            << nsteps << " steps: double "
+            << solver.particle_updates_per_second() / 1.E6 << " M/s ("
+            << sizeof(mpm::Particle<Dim>) << " bytes per particle), mixed "
+            << fsolver.particle_updates_per_second() / 1.E6 << " M/s ("
+            << sizeof(mpm::Particle<Dim, float>)
+            << " bytes per particle), position error "
+            << position / displacement << " of max displacement "
+            << displacement << ", stress error " << stress / stress_scale
+            << " of max stress " << stress_scale << '\n';
+}
@@ -0,0 +1,220 @@
+#include <limits>
+#include <memory>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+
+#include "factory.h"
+#include "material/linear_elastic.h"
+#include "solvers/mpm_explicit.h"
+#include "sparse_mesh.h"
+
+//! \brief Check sparse mesh class for 2D case
+TEST_CASE("Sparse mesh is checked for 2D case", "[mesh][sparse][2D]") {
+  // Dimension
+  const unsigned Dim = 2;
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  // Material outlives the particles of the mesh
+  unsigned material_id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(material_id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  material->elastic_tensor();
+
+  // Unit cells from the origin in blocks of 4 x 4 cells
+  const Eigen::Vector2d origin(0., 0.);
+  const Eigen::Vector2d spacing(1., 1.);
+  auto mesh = std::make_shared<mpm::SparseMesh<Dim>>(0, origin, spacing, 4);
+  REQUIRE(mesh->block_size() == 4);
+  REQUIRE(mesh->nblocks() == 0);
+
+  SECTION("Check ids and location") {
+    const mpm::SparseMesh<Dim>::IndexDim index{{-3, 7}};
+    const auto unpacked = mesh->index(mesh->id(index));
+    REQUIRE(unpacked[0] == -3);
+    REQUIRE(unpacked[1] == 7);
+
+    mpm::SparseMesh<Dim>::IndexDim located;
+    REQUIRE(mesh->locate_point(Eigen::Vector2d(-2.5, 7.5), &located) == true);
+    REQUIRE(located[0] == -3);
+    REQUIRE(located[1] == 7);
+    REQUIRE(mesh->locate_point(Eigen::Vector2d(1.E+12, 0.), &located) ==
+            false);
+
+    // Cell across the lower boundary of a block
+    auto cell = mesh->cell(located);
+    REQUIRE(cell->id() == mesh->id(located));
+    REQUIRE(mesh->cell(located) == cell);
+    REQUIRE(mesh->ncells() == 1);
+    REQUIRE(mesh->nnodes() == 4);
+    // Nodes (-3, 7), (-2, 7) lie in one block, (-3, 8), (-2, 8) in another
+    REQUIRE(mesh->nblocks() == 2);
+    REQUIRE(cell->point_in_cell(Eigen::Vector2d(-2.5, 7.5)) == true);
+
+    const auto node = mesh->node(mpm::SparseMesh<Dim>::IndexDim{{-2, 8}});
+    REQUIRE(node != nullptr);
+    REQUIRE(node->coordinates()(0) == Approx(-2.).epsilon(Tolerance));
+    REQUIRE(node->coordinates()(1) == Approx(8.).epsilon(Tolerance));
+    REQUIRE(mesh->node(mpm::SparseMesh<Dim>::IndexDim{{-1, 8}}) == nullptr);
+
+    // Nodes and cells are not added or removed through the mesh interface
+    std::shared_ptr<mpm::Mesh<Dim>> base = mesh;
+    auto other_node = base->make_node(100, Eigen::Vector2d(0., 0.), Dim);
+    auto other = base->make_cell(100, 4, mpm::StructuredCell<Dim>::shapefn());
+    REQUIRE(base->add_node(other_node) == false);
+    REQUIRE(base->add_nodes({other_node}) == false);
+    REQUIRE(base->remove_node(other_node) == false);
+    REQUIRE(base->add_cell(other) == false);
+    REQUIRE(base->add_cells({other}) == false);
+    REQUIRE(base->remove_cell(other) == false);
+    REQUIRE(mesh->ncells() == 1);
+    REQUIRE(mesh->nnodes() == 4);
+  }
+
+  SECTION("Check blocks are allocated and freed with particles") {
+    Eigen::Vector2d coords(0.5, 0.5);
+    auto particle = std::make_shared<mpm::Particle<Dim>>(0, coords);
+    mesh->add_particle(particle);
+
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nblocks() == 1);
+    REQUIRE(mesh->ncells() == 1);
+    REQUIRE(mesh->nnodes() == 4);
+    REQUIRE(mesh->nactive_nodes() == 4);
+
+    // Move far away, the vacated block is freed
+    coords << 1001.5, -2001.5;
+    particle->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(particle->cell()->id() ==
+            mesh->id(mpm::SparseMesh<Dim>::IndexDim{{1001, -2002}}));
+    REQUIRE(mesh->nblocks() == 1);
+    REQUIRE(mesh->ncells() == 1);
+    REQUIRE(mesh->nnodes() == 4);
+    REQUIRE(mesh->node(mpm::SparseMesh<Dim>::IndexDim{{0, 0}}) == nullptr);
+
+    // Particles beyond the range of ids are deactivated
+    coords << 1.E+12, 0.;
+    particle->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == false);
+    REQUIRE(particle->status() == false);
+    REQUIRE(mesh->nblocks() == 0);
+    REQUIRE(mesh->ncells() == 0);
+  }
+
+  SECTION("Check blocks of deactivated particles are kept") {
+    using IndexDim = mpm::SparseMesh<Dim>::IndexDim;
+    auto particle =
+        std::make_shared<mpm::Particle<Dim>>(0, Eigen::Vector2d(0.5, 0.5));
+    Eigen::Vector2d coords(1.5, 0.5);
+    auto other = std::make_shared<mpm::Particle<Dim>>(1, coords);
+    mesh->add_particle(particle);
+    mesh->add_particle(other);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nblocks() == 1);
+    const auto cell = particle->cell();
+
+    // Deactivated particle keeps its cell after the others move away
+    particle->assign_status(false);
+    coords << 1001.5, -2001.5;
+    other->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nblocks() == 2);
+    REQUIRE(mesh->nactive_cells() == 1);
+    REQUIRE(particle->cell() == cell);
+    REQUIRE(mesh->cell(IndexDim{{0, 0}}) == cell);
+
+    // Reactivated particle is located in its cell
+    particle->assign_status(true);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(particle->cell() == cell);
+    REQUIRE(cell->id() == mesh->id(IndexDim{{0, 0}}));
+    REQUIRE(mesh->nactive_cells() == 2);
+  }
+
+  SECTION("Check a freed block is re-entered next to a kept block") {
+    using IndexDim = mpm::SparseMesh<Dim>::IndexDim;
+    // Cell (3, 0) uses nodes (4, 0) and (4, 1) of the next block
+    Eigen::Vector2d coords(3.5, 0.5);
+    auto particle = std::make_shared<mpm::Particle<Dim>>(0, coords);
+    mesh->add_particle(particle);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nblocks() == 2);
+
+    // The next block is freed with the cells using its nodes
+    coords << 0.5, 0.5;
+    particle->coordinates(coords);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nblocks() == 1);
+    REQUIRE(mesh->ncells() == 1);
+    REQUIRE(mesh->nnodes() == 6);
+    REQUIRE(mesh->node(IndexDim{{4, 0}}) == nullptr);
+
+    // Particles re-enter the freed block and the kept block
+    coords << 3.5, 0.5;
+    particle->coordinates(coords);
+    auto neighbour =
+        std::make_shared<mpm::Particle<Dim>>(1, Eigen::Vector2d(4.5, 0.5));
+    mesh->add_particle(neighbour);
+    REQUIRE(mesh->locate_particles_mesh() == true);
+    REQUIRE(mesh->nblocks() == 2);
+    REQUIRE(mesh->nactive_cells() == 2);
+    REQUIRE(mesh->nnodes() == 10);
+    REQUIRE(mesh->nactive_nodes() == 6);
+
+    // Both cells share the single node at (4, 0)
+    const auto node = mesh->node(IndexDim{{4, 0}});
+    REQUIRE(node != nullptr);
+    REQUIRE(particle->cell()->node(1) == node);
+    REQUIRE(neighbour->cell()->node(0) == node);
+  }
+
+  SECTION("Check explicit solver") {
+    // Block of 2 x 2 cells at negative coordinates resting on plane y = -4
+    REQUIRE(mesh->assign_plane_velocity_constraint(1, -4, 1, 0.) == true);
+    REQUIRE(mesh->assign_plane_velocity_constraint(2, -4, 1, 0.) == false);
+    mpm::Index id = 0;
+    for (unsigned j = 0; j < 4; ++j)
+      for (unsigned i = 0; i < 4; ++i) {
+        Eigen::Vector2d coords(-1.75 + 0.5 * i, -3.75 + 0.5 * j);
+        auto particle = std::make_shared<mpm::Particle<Dim>>(id++, coords);
+        particle->assign_volume(0.25);
+        particle->assign_mass(250.);
+        particle->assign_material(material.get());
+        mesh->add_particle(particle);
+      }
+
+    const double dt = 1.E-3;
+    const unsigned nsteps = 10;
+    const Eigen::Vector2d gravity(0., -10.);
+    mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::MUSL);
+    solver.scatter(mpm::Scatter::Colouring);
+    solver.gravity(gravity);
+    REQUIRE(solver.solve(nsteps) == true);
+
+    REQUIRE(mesh->ncells() == 4);
+    REQUIRE(mesh->nactive_cells() == 4);
+    REQUIRE(mesh->nnodes() == 9);
+    REQUIRE(mesh->ncolours() == 4);
+
+    tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    mesh->iterate_over_particles(
+        [&particles](const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+          particles.push_back(particle);
+        });
+    REQUIRE(particles.size() == 16);
+    for (const auto& particle : particles) {
+      REQUIRE(particle->stress()(1) < 0.);
+      REQUIRE(particle->velocity()(1) > gravity(1) * nsteps * dt);
+    }
+  }
+}
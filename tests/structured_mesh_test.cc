@@ -0,0 +1,361 @@
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Dense"
+#include "catch.hpp"
+#include "json.hpp"
+
+// TBB
+#include <tbb/concurrent_vector.h>
+
+#include "factory.h"
+#include "material/linear_elastic.h"
+#include "solvers/mpm_explicit.h"
+#include "structured_mesh.h"
+
+namespace {
+//! Update strains, velocities and positions of the particles of a cell
+struct CellSweep {
+  template <typename Tcell, typename Tparticles>
+  void operator()(const Tcell& cell, const Tparticles& particles) const {
+    cell->compute_particles_strain(particles, 0.);
+    cell->update_particles_velocity_position(particles, 0.);
+  }
+};
+
+//! Update stresses of a batch of particles of the same material
+struct MaterialSweep {
+  template <typename Tmaterial, typename Tparticles>
+  void operator()(const Tmaterial& material,
+                  const Tparticles& particles) const {
+    mpm::Particle<3>::compute_stress(material, particles);
+  }
+};
+
+//! Compute mass, momentum and force contributions of the particles of a cell
+struct CellContributions {
+  template <typename Tcell, typename Tparticles>
+  typename mpm::Cell<3>::NodalContributions operator()(
+      const Tcell& cell, const Tparticles& particles) const {
+    return cell->compute_nodal_contributions(particles, true, true, true,
+                                             Eigen::Vector3d(0., 0., -9.81));
+  }
+};
+
+//! Fill a cube of cells with nppc^3 particles per cell of a material
+//! \param[in] mesh Structured mesh
+//! \param[in] ncells Number of cells in each direction
+//! \param[in] nppc Number of particles per cell in each direction
+//! \param[in] material Material of the particles
+void fill_particles(const std::shared_ptr<mpm::StructuredMesh<3>>& mesh,
+                    unsigned ncells, unsigned nppc,
+                    const std::shared_ptr<mpm::Material>& material) {
+  const double spacing = 1. / nppc;
+  std::vector<std::shared_ptr<mpm::Particle<3>>> particles;
+  for (unsigned k = 0; k < ncells * nppc; ++k)
+    for (unsigned j = 0; j < ncells * nppc; ++j)
+      for (unsigned i = 0; i < ncells * nppc; ++i) {
+        Eigen::Vector3d coords((i + 0.5) * spacing, (j + 0.5) * spacing,
+                               (k + 0.5) * spacing);
+        particles.emplace_back(mesh->make_particle(particles.size(), coords));
+        particles.back()->assign_volume(spacing * spacing * spacing);
+        particles.back()->assign_mass(spacing * spacing * spacing);
+        particles.back()->assign_material(material.get());
+      }
+  REQUIRE(mesh->add_particles(particles) == true);
+  REQUIRE(mesh->locate_particles_mesh() == true);
+  mesh->iterate_over_particles(
+      [](const std::shared_ptr<mpm::Particle<3>>& particle) {
+        particle->compute_reference_location();
+        particle->compute_shapefn();
+      });
+}
+}  // namespace
+
+//! \brief Check structured mesh class for 2D case
+TEST_CASE("Structured mesh is checked for 2D case", "[mesh][structured][2D]") {
+  // Dimension
+  const unsigned Dim = 2;
+  // Tolerance
+  const double Tolerance = 1.E-7;
+
+  // Material outlives the particles of the mesh
+  unsigned material_id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(material_id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+7;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+  material->elastic_tensor();
+
+  // 3 x 2 cells of 0.5 x 1 from (1, 2)
+  const Eigen::Vector2d origin(1., 2.);
+  const Eigen::Vector2d spacing(0.5, 1.);
+  const std::array<mpm::Index, Dim> ncells{{3, 2}};
+  auto mesh =
+      std::make_shared<mpm::StructuredMesh<Dim>>(0, origin, spacing, ncells);
+
+  SECTION("Check ids and connectivity") {
+    REQUIRE(mesh->ngrid_cells() == 6);
+    REQUIRE(mesh->ngrid_nodes() == 12);
+    // No node or cell is created
+    REQUIRE(mesh->ncells() == 0);
+    REQUIRE(mesh->nnodes() == 0);
+
+    for (mpm::Index id = 0; id < mesh->ngrid_cells(); ++id)
+      REQUIRE(mesh->cell_id(mesh->cell_index(id)) == id);
+    for (mpm::Index id = 0; id < mesh->ngrid_nodes(); ++id)
+      REQUIRE(mesh->node_id(mesh->node_index(id)) == id);
+
+    // Node coordinates
+    const auto coordinates = mesh->node_coordinates(6);
+    REQUIRE(coordinates(0) == Approx(2.).epsilon(Tolerance));
+    REQUIRE(coordinates(1) == Approx(3.).epsilon(Tolerance));
+
+    // Nodes of cell 4 (1, 1) are counter-clockwise
+    const auto node_ids = mesh->cell_node_ids(4);
+    REQUIRE(node_ids.size() == 4);
+    REQUIRE(node_ids.at(0) == 5);
+    REQUIRE(node_ids.at(1) == 6);
+    REQUIRE(node_ids.at(2) == 10);
+    REQUIRE(node_ids.at(3) == 9);
+
+    // Neighbours of a corner and of a central cell
+    REQUIRE(mesh->neighbour_cell_ids(0).size() == 3);
+    REQUIRE(mesh->neighbour_cell_ids(1).size() == 5);
+    REQUIRE(mesh->neighbour_cell_ids(4).size() == 5);
+  }
+
+  SECTION("Check point location and cell creation") {
+    mpm::Index id = std::numeric_limits<mpm::Index>::max();
+    REQUIRE(mesh->locate_point(Eigen::Vector2d(1.6, 3.2), &id) == true);
+    REQUIRE(id == 4);
+    // Upper boundary belongs to the last cell
+    REQUIRE(mesh->locate_point(Eigen::Vector2d(2.5, 4.), &id) == true);
+    REQUIRE(id == 5);
+    // Outside the grid
+    REQUIRE(mesh->locate_point(Eigen::Vector2d(0.9, 3.), &id) == false);
+    REQUIRE(mesh->locate_point(Eigen::Vector2d(1.2, 4.1), &id) == false);
+
+    // Cell and its nodes are created on first access
+    REQUIRE(mesh->node(5) == nullptr);
+    auto cell = mesh->cell(4);
+    REQUIRE(cell->id() == 4);
+    REQUIRE(mesh->cell(4) == cell);
+    REQUIRE(mesh->ncells() == 1);
+    REQUIRE(mesh->nnodes() == 4);
+    REQUIRE(mesh->node(5) != nullptr);
+    REQUIRE(cell->point_in_cell(Eigen::Vector2d(1.6, 3.2)) == true);
+
+    // Neighbour shares two nodes
+    mesh->cell(3);
+    REQUIRE(mesh->ncells() == 2);
+    REQUIRE(mesh->nnodes() == 6);
+
+    // Nodes and cells are not added or removed through the mesh interface
+    std::shared_ptr<mpm::Mesh<Dim>> base = mesh;
+    auto node = base->make_node(100, Eigen::Vector2d(0., 0.), Dim);
+    auto other = base->make_cell(100, 4, mpm::StructuredCell<Dim>::shapefn());
+    REQUIRE(base->add_node(node) == false);
+    REQUIRE(base->add_nodes({node}) == false);
+    REQUIRE(base->remove_node(node) == false);
+    REQUIRE(base->add_cell(other) == false);
+    REQUIRE(base->add_cells({other}) == false);
+    REQUIRE(base->remove_cell(other) == false);
+    REQUIRE(mesh->ncells() == 2);
+    REQUIRE(mesh->nnodes() == 6);
+  }
+
+  SECTION("Check boundary velocity constraints") {
+    auto cell = mesh->cell(0);
+    REQUIRE(mesh->assign_boundary_velocity_constraint(1, false, 1, 0.) ==
+            true);
+    REQUIRE(mesh->assign_boundary_velocity_constraint(2, false, 1, 0.) ==
+            false);
+
+    // Constraint applies to existing and new nodes on the boundary
+    mesh->cell(1);
+    mesh->cell(2);
+    for (mpm::Index id = 0; id < 4; ++id) {
+      auto node = mesh->node(id);
+      REQUIRE(node != nullptr);
+      Eigen::VectorXd velocity(Dim);
+      velocity << 1., 1.;
+      node->assign_velocity(velocity);
+      node->apply_velocity_constraints();
+      REQUIRE(node->velocity()(0) == Approx(1.).epsilon(Tolerance));
+      REQUIRE(node->velocity()(1) == Approx(0.).epsilon(Tolerance));
+    }
+  }
+
+  SECTION("Check colouring") {
+    // Cells are coloured when created
+    REQUIRE(mesh->ncolours() == 4);
+    for (mpm::Index id = 0; id < mesh->ngrid_cells(); ++id) mesh->cell(id);
+    REQUIRE(mesh->ncolours() == 4);
+    for (mpm::Index i = 0; i < mesh->ngrid_cells(); ++i)
+      for (mpm::Index j = i + 1; j < mesh->ngrid_cells(); ++j) {
+        if (mesh->cell(i)->colour() != mesh->cell(j)->colour()) continue;
+        const auto inodes = mesh->cell_node_ids(i);
+        const auto jnodes = mesh->cell_node_ids(j);
+        for (auto inode : inodes)
+          for (auto jnode : jnodes) REQUIRE(inode != jnode);
+      }
+    REQUIRE(mesh->colour_cells() == 4);
+  }
+
+  SECTION("Check explicit solver") {
+    // Particles in the lower left cells
+    mpm::Index id = 0;
+    for (unsigned j = 0; j < 2; ++j)
+      for (unsigned i = 0; i < 4; ++i) {
+        Eigen::Vector2d coords(1.125 + 0.25 * i, 2.25 + 0.5 * j);
+        auto particle = std::make_shared<mpm::Particle<Dim>>(id++, coords);
+        particle->assign_volume(0.125);
+        particle->assign_mass(125.);
+        particle->assign_material(material.get());
+        mesh->add_particle(particle);
+      }
+
+    const double dt = 1.E-3;
+    const unsigned nsteps = 10;
+    const Eigen::Vector2d gravity(0., -10.);
+    mpm::MPMExplicit<Dim> solver(mesh, dt, mpm::StressUpdate::USF);
+    solver.scatter(mpm::Scatter::Colouring);
+    solver.gravity(gravity);
+    REQUIRE(solver.solve(nsteps) == true);
+
+    // Only the cells containing particles are created
+    REQUIRE(mesh->ncells() == 2);
+    REQUIRE(mesh->nactive_cells() == 2);
+    REQUIRE(mesh->nnodes() == 6);
+
+    // Free fall
+    tbb::concurrent_vector<std::shared_ptr<mpm::Particle<Dim>>> particles;
+    mesh->iterate_over_particles(
+        [&particles](const std::shared_ptr<mpm::Particle<Dim>>& particle) {
+          particles.push_back(particle);
+        });
+    REQUIRE(particles.size() == 8);
+    for (const auto& particle : particles) {
+      REQUIRE(particle->velocity()(0) == Approx(0.).epsilon(Tolerance));
+      REQUIRE(particle->velocity()(1) ==
+              Approx(gravity(1) * nsteps * dt).epsilon(Tolerance));
+    }
+  }
+}
+
+//! \brief Benchmark sweeps over all particles, run with [benchmark]
+TEST_CASE("Structured mesh particle sweep throughput",
+          "[.][benchmark][mesh][structured]") {
+  const unsigned Dim = 3;
+  const unsigned ncells = 32;
+  const unsigned nppc = 2;
+  const unsigned nrepeats = 20;
+
+  // Material outlives the particles of the mesh
+  unsigned id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+6;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+
+  auto mesh = std::make_shared<mpm::StructuredMesh<Dim>>(
+      0, Eigen::Vector3d::Zero(), Eigen::Vector3d::Ones(),
+      std::array<mpm::Index, Dim>{{ncells, ncells, ncells}});
+
+  // Particles fill the mesh
+  fill_particles(mesh, ncells, nppc, material);
+
+  // Relocation and grouping, then sweeps by cell and by material
+  std::chrono::duration<double> locate{0.}, cells{0.}, materials{0.};
+  for (unsigned r = 0; r < nrepeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    mesh->locate_particles_mesh();
+    auto end = std::chrono::steady_clock::now();
+    locate += end - start;
+
+    start = end;
+    mesh->iterate_over_cell_particles(CellSweep());
+    end = std::chrono::steady_clock::now();
+    cells += end - start;
+
+    start = end;
+    mesh->iterate_over_material_particles(MaterialSweep());
+    end = std::chrono::steady_clock::now();
+    materials += end - start;
+  }
+
+  const double n = static_cast<double>(mesh->nparticles()) * nrepeats;
+  std::cout << "Particle sweeps of " << mesh->nparticles()
+            << " particles: locate " << n / locate.count() / 1.E6
+            << " M/s, cells " << n / cells.count() / 1.E6 << " M/s, materials "
+            << n / materials.count() / 1.E6 << " M/s\n";
+}
+
+//! \brief Benchmark scatter strategies of particle to node transfers, run
+//! with [benchmark]
+TEST_CASE("Structured mesh scatter throughput",
+          "[.][benchmark][mesh][structured]") {
+  const unsigned Dim = 3;
+  const unsigned ncells = 32;
+  const unsigned nppc = 2;
+  const unsigned nrepeats = 20;
+
+  // Material outlives the particles of the mesh
+  unsigned id = 0;
+  auto material = Factory<mpm::Material, unsigned>::instance()->create(
+      "LinearElastic", std::move(id));
+  Json jmaterial;
+  jmaterial["youngs_modulus"] = 1.0E+6;
+  jmaterial["poisson_ratio"] = 0.3;
+  material->properties(jmaterial);
+
+  auto mesh = std::make_shared<mpm::StructuredMesh<Dim>>(
+      0, Eigen::Vector3d::Zero(), Eigen::Vector3d::Ones(),
+      std::array<mpm::Index, Dim>{{ncells, ncells, ncells}});
+
+  // Particles fill the mesh, cells are coloured once
+  fill_particles(mesh, ncells, nppc, material);
+  mesh->colour_cells();
+
+  const std::vector<std::pair<mpm::Scatter, std::string>> scatters{
+      {mpm::Scatter::Atomic, "atomic"},
+      {mpm::Scatter::Colouring, "colouring"},
+      {mpm::Scatter::Reduction, "reduction"}};
+
+  const double n = static_cast<double>(mesh->nparticles()) * nrepeats;
+  std::cout << "Scatter of " << mesh->nparticles() << " particles:";
+  for (const auto& scatter : scatters) {
+    std::chrono::duration<double> elapsed{0.};
+    for (unsigned r = 0; r < nrepeats; ++r) {
+      mesh->iterate_over_active_nodes([](mpm::Node<Dim>* node) {
+        node->initialise();
+        node->update_mass(false, 0.);
+      });
+      const auto start = std::chrono::steady_clock::now();
+      mesh->scatter_to_nodes(CellContributions(), scatter.first);
+      elapsed += std::chrono::steady_clock::now() - start;
+    }
+
+    // Every strategy maps the total mass
+    tbb::concurrent_vector<double> masses;
+    mesh->iterate_over_active_nodes(
+        [&masses](mpm::Node<Dim>* node) { masses.push_back(node->mass()); });
+    double mass = 0.;
+    for (const auto nodal_mass : masses) mass += nodal_mass;
+    REQUIRE(mass == Approx(ncells * ncells * ncells).epsilon(1.E-7));
+
+    std::cout << ' ' << scatter.second << ' ' << n / elapsed.count() / 1.E6
+              << " M/s";
+  }
+  std::cout << '\n';
+}